@@ -96,6 +96,7 @@ CVar* sim_spawn_running;
 CVar* sim_replay_enabled;
 CVar* sim_replay_length;
 CVar* sim_replay_stepping;
+CVar* sim_replay_memory;
 CVar* sim_realistic_commands;
 CVar* sim_races_enabled;
 CVar* sim_no_collisions;
@@ -103,6 +104,7 @@ CVar* sim_no_self_collisions;
 CVar* sim_gearbox_mode;
 CVar* sim_soft_reset_mode;
 CVar* sim_quickload_dialog;
+CVar* sim_legacy_collision_hash;
 
 // Multiplayer
 CVar* mp_state;
@@ -111,6 +113,7 @@ CVar* mp_chat_auto_hide;
 CVar* mp_hide_net_labels;
 CVar* mp_hide_own_net_label;
 CVar* mp_pseudo_collisions;
+CVar* mp_wheel_update_range;
 CVar* mp_server_host;
 CVar* mp_server_port;
 CVar* mp_server_password;
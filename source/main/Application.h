@@ -272,6 +272,7 @@ extern CVar* sim_spawn_running;
 extern CVar* sim_replay_enabled;
 extern CVar* sim_replay_length;
 extern CVar* sim_replay_stepping;
+extern CVar* sim_replay_memory;
 extern CVar* sim_realistic_commands;
 extern CVar* sim_races_enabled;
 extern CVar* sim_no_collisions;
@@ -279,6 +280,7 @@ extern CVar* sim_no_self_collisions;
 extern CVar* sim_gearbox_mode;
 extern CVar* sim_soft_reset_mode;
 extern CVar* sim_quickload_dialog;
+extern CVar* sim_legacy_collision_hash;
 
 // Multiplayer
 extern CVar* mp_state;
@@ -287,6 +289,7 @@ extern CVar* mp_chat_auto_hide;
 extern CVar* mp_hide_net_labels;
 extern CVar* mp_hide_own_net_label;
 extern CVar* mp_pseudo_collisions;
+extern CVar* mp_wheel_update_range;
 extern CVar* mp_server_host;
 extern CVar* mp_server_port;
 extern CVar* mp_server_password;
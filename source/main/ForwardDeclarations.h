@@ -104,6 +104,7 @@ namespace RoR
     class  SoundScriptInstance;
     class  SoundScriptManager;
     class  Task;
+    class  TaskHandle;
     class  TerrainEditor;
     class  TerrainGeometryManager;
     class  TerrainManager;
@@ -77,6 +77,13 @@ bool GameContext::HasMessages()
     return !m_msg_queue.empty();
 }
 
+MsgType GameContext::PeekMessageType()
+{
+    std::lock_guard<std::mutex> lock(m_msg_mutex);
+    ROR_ASSERT(m_msg_queue.size() > 0);
+    return m_msg_queue.front().type;
+}
+
 Message GameContext::PopMessage()
 {
     std::lock_guard<std::mutex> lock(m_msg_mutex);
@@ -274,6 +281,44 @@ Actor* GameContext::SpawnActor(ActorSpawnRequest& rq)
     return fresh_actor;
 }
 
+void GameContext::QueueActorSpawn(ActorSpawnRequest* rq)
+{
+    if (rq->asr_cache_entry != nullptr)
+    {
+        rq->asr_filename = rq->asr_cache_entry->fname;
+    }
+
+    PendingSpawn spawn;
+    spawn.ps_request = rq;
+    spawn.ps_load = m_actor_manager.FetchActorDefAsync(
+        rq->asr_filename, rq->asr_origin == ActorSpawnRequest::Origin::TERRN_DEF);
+    if (spawn.ps_load == nullptr)
+    {
+        delete rq; // Error already reported
+        return;
+    }
+    m_pending_spawns.push_back(spawn);
+}
+
+void GameContext::UpdateActorSpawns()
+{
+    while (!m_pending_spawns.empty())
+    {
+        PendingSpawn& spawn = m_pending_spawns.front();
+        if (spawn.ps_load->adl_task && !spawn.ps_load->adl_task->IsFinished())
+        {
+            break; // Keep order
+        }
+
+        if (m_actor_manager.FinishActorDef(*spawn.ps_load) != nullptr)
+        {
+            this->SpawnActor(*spawn.ps_request); // Picks up the parsed truckfile from the cache entry
+        }
+        delete spawn.ps_request;
+        m_pending_spawns.pop_front();
+    }
+}
+
 void GameContext::ModifyActor(ActorModifyRequest& rq)
 {
     if (rq.amr_type == ActorModifyRequest::Type::SOFT_RESET)
@@ -290,7 +335,10 @@ void GameContext::ModifyActor(ActorModifyRequest& rq)
     }
     else if (rq.amr_type == ActorModifyRequest::Type::RESTORE_SAVED)
     {
-        m_actor_manager.RestoreSavedState(rq.amr_actor, *rq.amr_saved_state.get());
+        SavedActorState const& state = *rq.amr_saved_state.get();
+        const bool arrays_ok = ActorManager::RestoreSavedNodesAndBeams(rq.amr_actor,
+            state.sas_nodes.data(), state.sas_nodes.size(), state.sas_beams.data(), state.sas_beams.size());
+        m_actor_manager.RestoreSavedState(rq.amr_actor, state.sas_entry, (arrays_ok) ? state.sas_beams.data() : nullptr);
     }
     else if (rq.amr_type == ActorModifyRequest::Type::WAKE_UP &&
         rq.amr_actor->ar_state == ActorState::LOCAL_SLEEPING)
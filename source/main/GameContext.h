@@ -33,6 +33,7 @@
 #include "SceneMouse.h"
 #include "SimData.h"
 
+#include <deque>
 #include <list>
 #include <mutex>
 #include <queue>
@@ -92,6 +93,7 @@ public:
     void                PushMessage(Message m);  //!< Doesn't guarantee order! Use ChainMessage() if order matters.
     void                ChainMessage(Message m); //!< Add to last pushed message's chain
     bool                HasMessages();
+    MsgType             PeekMessageType(); //!< Type of the next message to be popped; must have messages
     Message             PopMessage();
 
     // ----------------------------
@@ -104,6 +106,9 @@ public:
     // Actors
 
     Actor*              SpawnActor(ActorSpawnRequest& rq);
+    void                QueueActorSpawn(ActorSpawnRequest* rq); //!< Takes ownership; truckfile is parsed in background, actor is spawned by `UpdateActorSpawns()`
+    void                UpdateActorSpawns();                    //!< Spawns queued actors whose truckfiles are ready, in order of queueing
+    bool                HasPendingActorSpawns() const { return !m_pending_spawns.empty(); }
     void                ModifyActor(ActorModifyRequest& rq);
     void                DeleteActor(Actor* actor);
     void                UpdateActors();
@@ -173,6 +178,13 @@ private:
     Ogre::String        m_last_section_config;
     ActorSpawnRequest   m_current_selection;                //!< Context of the loader UI
 
+    struct PendingSpawn
+    {
+        ActorSpawnRequest*            ps_request;
+        std::shared_ptr<ActorDefLoad> ps_load;
+    };
+    std::deque<PendingSpawn> m_pending_spawns;              //!< Truckfiles being parsed; spawned strictly in order (savegames rely on it)
+
     // Characters (simplified physics and netcode)
     CharacterFactory    m_character_factory;
 
@@ -30,6 +30,8 @@
 
 #include <OgreResourceGroupManager.h>
 
+#include <algorithm>
+
 using namespace Ogre;
 using namespace RoR;
 
@@ -45,32 +47,6 @@ SoundScriptManager::SoundScriptManager() :
     , reference_distance(7.5f)
     , sound_manager(nullptr)
 {
-    for (int i = 0; i < SS_MAX_TRIG; i++)
-    {
-        free_trigs[i] = 0;
-    }
-
-    for (int i = 0; i < SS_MAX_MOD; i++)
-    {
-        free_pitches[i] = 0;
-        free_gains[i] = 0;
-    }
-
-    // TODO: there is a memory corruption going on here, need to fix
-    for (int i = 0; i < SS_MAX_TRIG * MAX_INSTANCES_PER_GROUP; i++)
-    {
-        trigs[i] = 0;
-    }
-
-    for (int i = 0; i < SS_MAX_MOD * MAX_INSTANCES_PER_GROUP; i++)
-    {
-        pitches[i] = 0;
-        gains[i] = 0;
-    }
-
-    // reset all states
-    state_map.clear();
-
     sound_manager = new SoundManager();
 
     if (!sound_manager)
@@ -98,6 +74,87 @@ SoundScriptManager::~SoundScriptManager()
         delete sound_manager;
 }
 
+SoundOwnerTable::Link::Link(int type, int item_id)
+    : link_type(type)
+    , link_item_id(item_id)
+{
+    for (int i = 0; i < STATE_WORDS; i++)
+    {
+        trig_state[i] = 0;
+    }
+}
+
+namespace {
+
+bool LinkLess(std::unique_ptr<SoundOwnerTable::Link> const& link, std::pair<int, int> const& key)
+{
+    return std::make_pair(link->link_type, link->link_item_id) < key;
+}
+
+/// Sets the trigger bit, returns the previous state
+bool ExchangeTrigState(SoundOwnerTable::Link* link, int trig, bool state)
+{
+    const uint32_t mask = 1u << (trig % 32);
+    std::atomic<uint32_t>& word = link->trig_state[trig / 32];
+    const uint32_t prev = (state) ? word.fetch_or(mask) : word.fetch_and(~mask);
+    return (prev & mask) != 0;
+}
+
+template<typename F> void ForEachInstance(SoundOwnerTable::InstanceList const& list, int key, F func)
+{
+    auto itor = std::lower_bound(list.begin(), list.end(), key,
+        [](std::pair<int, SoundScriptInstance*> const& entry, int k) { return entry.first < k; });
+    for (; itor != list.end() && itor->first == key; ++itor)
+    {
+        func(itor->second);
+    }
+}
+
+void AddInstance(SoundOwnerTable::InstanceList& list, int key, SoundScriptInstance* inst)
+{
+    // After existing instances with the same key, to keep the creation order
+    auto itor = std::upper_bound(list.begin(), list.end(), key,
+        [](int k, std::pair<int, SoundScriptInstance*> const& entry) { return k < entry.first; });
+    list.insert(itor, std::make_pair(key, inst));
+}
+
+} // namespace
+
+void SoundScriptManager::registerOwner(int actor_id)
+{
+    const size_t index = static_cast<size_t>(actor_id + 1);
+    if (actor_id < -1)
+        return;
+
+    if (index >= owner_tables.size())
+    {
+        owner_tables.resize(index + 1);
+    }
+    if (!owner_tables[index])
+    {
+        owner_tables[index].reset(new SoundOwnerTable());
+        owner_tables[index]->links.emplace_back(new SoundOwnerTable::Link(SL_DEFAULT, -1));
+    }
+}
+
+SoundOwnerTable::Link* SoundScriptManager::findLink(int actor_id, int linkType, int linkItemID)
+{
+    const size_t index = static_cast<size_t>(actor_id + 1);
+    if (actor_id < -1 || index >= owner_tables.size() || !owner_tables[index])
+        return nullptr;
+
+    std::vector<std::unique_ptr<SoundOwnerTable::Link>>& links = owner_tables[index]->links;
+    if (linkType == SL_DEFAULT && linkItemID == -1)
+        return links[0].get(); // Fast path, the vast majority of calls
+
+    const std::pair<int, int> key(linkType, linkItemID);
+    auto itor = std::lower_bound(links.begin(), links.end(), key, LinkLess);
+    if (itor != links.end() && (*itor)->link_type == linkType && (*itor)->link_item_id == linkItemID)
+        return itor->get();
+
+    return nullptr;
+}
+
 void SoundScriptManager::trigOnce(Actor* actor, int trig, int linkType, int linkItemID)
 {
     if (disabled)
@@ -114,16 +171,11 @@ void SoundScriptManager::trigOnce(int actor_id, int trig, int linkType, int link
     if (disabled)
         return;
 
-    for (int i = 0; i < free_trigs[trig]; i++)
-    {
-        // cycle through all instance groups
-        SoundScriptInstance* inst = trigs[trig + i * SS_MAX_TRIG];
+    SoundOwnerTable::Link* link = this->findLink(actor_id, linkType, linkItemID);
+    if (!link)
+        return;
 
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
-        {
-            inst->runOnce();
-        }
-    }
+    ForEachInstance(link->trig_instances, trig, [](SoundScriptInstance* inst) { inst->runOnce(); });
 }
 
 void SoundScriptManager::trigStart(Actor* actor, int trig, int linkType, int linkItemID)
@@ -141,20 +193,12 @@ void SoundScriptManager::trigStart(int actor_id, int trig, int linkType, int lin
 {
     if (disabled)
         return;
-    if (getTrigState(actor_id, trig, linkType, linkItemID))
-        return;
 
-    state_map[linkType][linkItemID][actor_id][trig] = true;
-
-    for (int i = 0; i < free_trigs[trig]; i++)
-    {
-        SoundScriptInstance* inst = trigs[trig + i * SS_MAX_TRIG];
+    SoundOwnerTable::Link* link = this->findLink(actor_id, linkType, linkItemID);
+    if (!link || ExchangeTrigState(link, trig, true))
+        return;
 
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
-        {
-            inst->start();
-        }
-    }
+    ForEachInstance(link->trig_instances, trig, [](SoundScriptInstance* inst) { inst->start(); });
 }
 
 void SoundScriptManager::trigStop(Actor* actor, int trig, int linkType, int linkItemID)
@@ -172,19 +216,12 @@ void SoundScriptManager::trigStop(int actor_id, int trig, int linkType, int link
 {
     if (disabled)
         return;
-    if (!getTrigState(actor_id, trig, linkType, linkItemID))
-        return;
 
-    state_map[linkType][linkItemID][actor_id][trig] = false;
-    for (int i = 0; i < free_trigs[trig]; i++)
-    {
-        SoundScriptInstance* inst = trigs[trig + i * SS_MAX_TRIG];
+    SoundOwnerTable::Link* link = this->findLink(actor_id, linkType, linkItemID);
+    if (!link || !ExchangeTrigState(link, trig, false))
+        return;
 
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
-        {
-            inst->stop();
-        }
-    }
+    ForEachInstance(link->trig_instances, trig, [](SoundScriptInstance* inst) { inst->stop(); });
 }
 
 void SoundScriptManager::trigKill(Actor* actor, int trig, int linkType, int linkItemID)
@@ -202,19 +239,12 @@ void SoundScriptManager::trigKill(int actor_id, int trig, int linkType, int link
 {
     if (disabled)
         return;
-    if (!getTrigState(actor_id, trig, linkType, linkItemID))
-        return;
 
-    state_map[linkType][linkItemID][actor_id][trig] = false;
-    for (int i = 0; i < free_trigs[trig]; i++)
-    {
-        SoundScriptInstance* inst = trigs[trig + i * SS_MAX_TRIG];
+    SoundOwnerTable::Link* link = this->findLink(actor_id, linkType, linkItemID);
+    if (!link || !ExchangeTrigState(link, trig, false))
+        return;
 
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
-        {
-            inst->kill();
-        }
-    }
+    ForEachInstance(link->trig_instances, trig, [](SoundScriptInstance* inst) { inst->kill(); });
 }
 
 void SoundScriptManager::trigToggle(Actor* actor, int trig, int linkType, int linkItemID)
@@ -255,7 +285,11 @@ bool SoundScriptManager::getTrigState(int actor_id, int trig, int linkType, int
     if (disabled)
         return false;
 
-    return state_map[linkType][linkItemID][actor_id][trig];
+    SoundOwnerTable::Link* link = this->findLink(actor_id, linkType, linkItemID);
+    if (!link)
+        return false;
+
+    return (link->trig_state[trig / 32].load() & (1u << (trig % 32))) != 0;
 }
 
 void SoundScriptManager::modulate(Actor* actor, int mod, float value, int linkType, int linkItemID)
@@ -277,30 +311,26 @@ void SoundScriptManager::modulate(int actor_id, int mod, float value, int linkTy
     if (mod >= SS_MAX_MOD)
         return;
 
-    for (int i = 0; i < free_gains[mod]; i++)
+    SoundOwnerTable::Link* link = this->findLink(actor_id, linkType, linkItemID);
+    if (!link)
+        return;
+
+    ForEachInstance(link->gain_instances, mod, [value](SoundScriptInstance* inst)
     {
-        SoundScriptInstance* inst = gains[mod + i * SS_MAX_MOD];
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
-        {
-            // this one requires modulation
-            float gain = value * value * inst->templ->gain_square + value * inst->templ->gain_multiplier + inst->templ->gain_offset;
-            gain = std::max(0.0f, gain);
-            gain = std::min(gain, 1.0f);
-            inst->setGain(gain);
-        }
-    }
+        // this one requires modulation
+        float gain = value * value * inst->templ->gain_square + value * inst->templ->gain_multiplier + inst->templ->gain_offset;
+        gain = std::max(0.0f, gain);
+        gain = std::min(gain, 1.0f);
+        inst->setGain(gain);
+    });
 
-    for (int i = 0; i < free_pitches[mod]; i++)
+    ForEachInstance(link->pitch_instances, mod, [value](SoundScriptInstance* inst)
     {
-        SoundScriptInstance* inst = pitches[mod + i * SS_MAX_MOD];
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
-        {
-            // this one requires modulation
-            float pitch = value * value * inst->templ->pitch_square + value * inst->templ->pitch_multiplier + inst->templ->pitch_offset;
-            pitch = std::max(0.0f, pitch);
-            inst->setPitch(pitch);
-        }
-    }
+        // this one requires modulation
+        float pitch = value * value * inst->templ->pitch_square + value * inst->templ->pitch_multiplier + inst->templ->pitch_offset;
+        pitch = std::max(0.0f, pitch);
+        inst->setPitch(pitch);
+    });
 }
 
 void SoundScriptManager::update(float dt_sec)
@@ -368,30 +398,33 @@ SoundScriptInstance* SoundScriptManager::createInstance(Ogre::String templatenam
         return NULL; // invalid template!
     }
 
-    if (free_trigs[templ->trigger_source] >= MAX_INSTANCES_PER_GROUP
-        || (free_gains[templ->trigger_source] >= MAX_INSTANCES_PER_GROUP && templ->gain_source != SS_MOD_NONE)
-        || (free_pitches[templ->trigger_source] >= MAX_INSTANCES_PER_GROUP && templ->pitch_source != SS_MOD_NONE))
+    if (actor_id < -1)
     {
-        LOG("SoundScriptManager: Reached MAX_INSTANCES_PER_GROUP limit (" + TOSTRING(MAX_INSTANCES_PER_GROUP) + ")");
-        return NULL; // reached limit!
+        return NULL; // no lookup table for this owner
     }
 
     SoundScriptInstance* inst = new SoundScriptInstance(actor_id, templ, sound_manager, templ->file_name + "-" + TOSTRING(actor_id) + "-" + TOSTRING(instance_counter), soundLinkType, soundLinkItemId);
     instance_counter++;
 
     // register to lookup tables
-    trigs[templ->trigger_source + free_trigs[templ->trigger_source] * SS_MAX_TRIG] = inst;
-    free_trigs[templ->trigger_source]++;
+    this->registerOwner(actor_id);
+    std::vector<std::unique_ptr<SoundOwnerTable::Link>>& links = owner_tables[actor_id + 1]->links;
+    const std::pair<int, int> key(soundLinkType, soundLinkItemId);
+    auto link_itor = std::lower_bound(links.begin(), links.end(), key, LinkLess);
+    if (link_itor == links.end() || (*link_itor)->link_type != soundLinkType || (*link_itor)->link_item_id != soundLinkItemId)
+    {
+        link_itor = links.emplace(link_itor, new SoundOwnerTable::Link(soundLinkType, soundLinkItemId));
+    }
+    SoundOwnerTable::Link* link = link_itor->get();
 
+    AddInstance(link->trig_instances, templ->trigger_source, inst);
     if (templ->gain_source != SS_MOD_NONE)
     {
-        gains[templ->gain_source + free_gains[templ->gain_source] * SS_MAX_MOD] = inst;
-        free_gains[templ->gain_source]++;
+        AddInstance(link->gain_instances, templ->gain_source, inst);
     }
     if (templ->pitch_source != SS_MOD_NONE)
     {
-        pitches[templ->pitch_source + free_pitches[templ->pitch_source] * SS_MAX_MOD] = inst;
-        free_pitches[templ->pitch_source]++;
+        AddInstance(link->pitch_instances, templ->pitch_source, inst);
     }
 
     // SoundTrigger: SS_TRIG_ALWAYSON
@@ -27,6 +27,10 @@
 
 #include <OgreScriptLoader.h>
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #define SOUND_PLAY_ONCE(_ACTOR_, _TRIG_)        App::GetSoundScriptManager()->trigOnce    ( (_ACTOR_), (_TRIG_) )
 #define SOUND_START(_ACTOR_, _TRIG_)            App::GetSoundScriptManager()->trigStart   ( (_ACTOR_), (_TRIG_) )
 #define SOUND_STOP(_ACTOR_, _TRIG_)             App::GetSoundScriptManager()->trigStop    ( (_ACTOR_), (_TRIG_) )
@@ -38,8 +42,7 @@
 namespace RoR {
 
 enum {
-    MAX_SOUNDS_PER_SCRIPT = 16,
-    MAX_INSTANCES_PER_GROUP = 256
+    MAX_SOUNDS_PER_SCRIPT = 16
 };
 
 enum SoundTriggers {
@@ -247,6 +250,31 @@ private:
     int sound_link_item_id; // holds the item number this is for
 };
 
+/// Trigger states and instance lookup of one sound owner (actor, terrain object, main menu).
+/// Only grown on the main thread while the owner spawns (physics is synced then); afterwards
+/// it's read-only apart from the atomic state bits, so the `SOUND_*` macros are usable from physics tasks.
+struct SoundOwnerTable
+{
+    typedef std::vector<std::pair<int, SoundScriptInstance*>> InstanceList; //!< Sorted by trigger/modulation source
+
+    static const int STATE_WORDS = (SS_MAX_TRIG + 31) / 32;
+
+    /// Everything bound to one (link type, link item) pair, i.e. a single command
+    struct Link
+    {
+        Link(int type, int item_id);
+
+        int                    link_type;
+        int                    link_item_id;
+        std::atomic<uint32_t>  trig_state[STATE_WORDS]; //!< Bit per trigger
+        InstanceList           trig_instances;
+        InstanceList           gain_instances;
+        InstanceList           pitch_instances;
+    };
+
+    std::vector<std::unique_ptr<Link>> links; //!< Sorted by (link type, link item); the first is always (SL_DEFAULT, -1)
+};
+
 class SoundScriptManager : public Ogre::ScriptLoader, public ZeroedMemoryAllocator
 {
 public:
@@ -260,6 +288,7 @@ public:
     Ogre::Real getLoadingOrder(void) const;
 
     SoundScriptInstance* createInstance(Ogre::String templatename, int actor_id, Ogre::SceneNode *toAttach=NULL, int soundLinkType=SL_DEFAULT, int soundLinkItemId=-1);
+    void registerOwner(int actor_id); //!< Allocates the trigger states; call at spawn. Owners with sound instances are registered automatically.
 
     // functions
     void trigOnce    (int actor_id, int trig, int linkType = SL_DEFAULT, int linkItemID=-1);
@@ -291,6 +320,7 @@ private:
     SoundScriptTemplate* createTemplate(Ogre::String name, Ogre::String groupname, Ogre::String filename);
     void skipToNextCloseBrace(Ogre::DataStreamPtr& chunk);
     void skipToNextOpenBrace(Ogre::DataStreamPtr& chunk);
+    SoundOwnerTable::Link* findLink(int actor_id, int linkType, int linkItemID); //!< Lookup only, nullptr if not registered
 
     bool disabled;
     bool loading_base;
@@ -302,19 +332,8 @@ private:
 
     std::map <Ogre::String, SoundScriptTemplate*> templates;
 
-    // instances lookup tables
-    int free_trigs[SS_MAX_TRIG];
-    SoundScriptInstance *trigs[SS_MAX_TRIG * MAX_INSTANCES_PER_GROUP];
-
-    int free_pitches[SS_MAX_MOD];
-    SoundScriptInstance *pitches[SS_MAX_MOD * MAX_INSTANCES_PER_GROUP];
-    
-    int free_gains[SS_MAX_MOD];
-    SoundScriptInstance *gains[SS_MAX_MOD * MAX_INSTANCES_PER_GROUP];
-
-    // state map
-    // soundLinks, soundItems, actor_ids, triggers
-    std::map <int, std::map <int, std::map <int, std::map <int, bool > > > > state_map;
+    // instances lookup tables + trigger states, index = owner ID + 1 (the main menu uses -1)
+    std::vector<std::unique_ptr<SoundOwnerTable>> owner_tables;
 
     SoundManager* sound_manager;
 };
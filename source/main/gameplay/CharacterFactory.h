@@ -40,7 +40,7 @@ public:
     void UndoRemoteActorCoupling(Actor* actor);
     void Update(float dt);
 #ifdef USE_SOCKETW
-    void handleStreamData(std::vector<RoR::NetRecvPacket> packet);
+    void handleStreamData(std::vector<RoR::NetRecvPacket*> const& packet_buffer);
 #endif // USE_SOCKETW
 
 private:
@@ -22,7 +22,7 @@
 #include "EngineSim.h"
 
 #include "AppContext.h"
-#include "ApproxMath.h" // frand()
+#include "ApproxMath.h"
 #include "Actor.h"
 #include "ActorManager.h"
 #include "Console.h"
@@ -375,7 +375,7 @@ void EngineSim::UpdateEngineSim(float dt, int doUpdate)
                 // anti lag
                 if (m_turbo_has_antilag && m_cur_acc < 0.5)
                 {
-                    float f = frand();
+                    float f = m_actor->ar_physics_rng.Next01();
                     if (m_cur_engine_rpm > m_antilag_min_rpm && f > m_antilag_rand_chance)
                     {
                         if (m_cur_turbo_rpm[i] > m_max_turbo_rpm * 0.35 && m_cur_turbo_rpm[i] < m_max_turbo_rpm)
@@ -29,30 +29,60 @@
 #include "Language.h"
 #include "Utils.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 using namespace Ogre;
 using namespace RoR;
 
+static const int    REPLAY_KEYFRAME_INTERVAL = 50;                   //!< Frames
+static const float  REPLAY_POSITION_UNITS    = 1000.f;               //!< Delta frame units per meter
+static const float  REPLAY_VELOCITY_UNITS    = 100.f;                //!< Delta frame units per m/s
+static const size_t REPLAY_BLOCK_SIZE_MIN    = 4 * 1024 * 1024;
+
+static size_t AlignReplayRecord(size_t size)
+{
+    return (size + 7) & ~size_t(7);
+}
+
+static bool QuantizeReplayDelta(float value, float units, int16_t& out)
+{
+    const float q = std::round(value * units);
+    if (!(q >= -32767.f && q <= 32767.f)) // Also rejects NaN
+        return false;
+    out = static_cast<int16_t>(q);
+    return true;
+}
+
 Replay::Replay(Actor* actor, int _numFrames)
 {
     m_actor = actor;
-    numFrames = _numFrames;
+    numFrames = std::max(_numFrames, 0);
 
     curFrameTime = 0;
 
     replayTimer = new Timer();
 
-    // DO NOT get memory here, get memory when we use it first time!
-    nodes = 0;
-    beams = 0;
-    times = 0;
-
     outOfMemory = false;
 
-    unsigned long bsize = (actor->ar_num_nodes * numFrames * sizeof(node_simple_t) + actor->ar_num_beams * numFrames * sizeof(beam_simple_t) + numFrames * sizeof(unsigned long)) / 1024.0f;
-    LOG("replay buffer size: " + TOSTRING(bsize) + " kB");
+    // Only the frame table is allocated upfront, blocks are added as the recording grows.
+    m_frames.resize(numFrames);
+    m_beam_states.resize(actor->ar_num_beams, 0);
+    m_beam_touched.resize(actor->ar_num_beams, 0);
+
+    // A block must fit a few keyframes + the beam change lists of their deltas.
+    const size_t max_record_size =
+        AlignReplayRecord(actor->ar_num_nodes * sizeof(ReplayKeyNode)) +
+        AlignReplayRecord(actor->ar_num_beams) +
+        AlignReplayRecord(actor->ar_num_beams * sizeof(uint32_t));
+    const size_t align = MappedScratchFile::SEGMENT_ALIGNMENT;
+    m_block_size = std::max(REPLAY_BLOCK_SIZE_MIN, max_record_size * 4);
+    m_block_size = ((m_block_size + align - 1) / align) * align;
+    m_ram_limit = static_cast<size_t>(std::max(App::sim_replay_memory->getInt(), 0)) * 1024 * 1024;
 
-    writeIndex = 0;
-    firstRun = 1;
+    LOG("replay: " + TOSTRING(numFrames) + " frames, block size: " + TOSTRING(m_block_size / 1024)
+        + " kB, memory limit: " + TOSTRING(m_ram_limit / (1024 * 1024)) + " MB");
 
     int steps = App::sim_replay_stepping->getInt();
 
@@ -60,117 +90,264 @@ Replay::Replay(Actor* actor, int _numFrames)
         this->ar_replay_precision = 0.0f;
     else
         this->ar_replay_precision = 1.0f / ((float)steps);
-
-    // windowing
-    int width = 300;
-    int height = 60;
-    int x = (MyGUI::RenderManager::getInstance().getViewSize().width - width) / 2;
-    int y = 0;
 }
 
 Replay::~Replay()
 {
-    if (nodes)
+    for (Block& block: m_blocks)
     {
-        free(nodes);
-        nodes = 0;
-        free(beams);
-        beams = 0;
-        free(times);
-        times = 0;
+        if (!block.rb_mapped)
+            free(block.rb_data);
     }
     delete replayTimer;
 }
 
-void* Replay::getWriteBuffer(int type)
+int Replay::allocBlock()
 {
-    if (outOfMemory)
-        return 0;
-    if (!nodes)
+    if (!m_free_blocks.empty())
+    {
+        const int index = m_free_blocks.back();
+        m_free_blocks.pop_back();
+        m_blocks[index].rb_used = 0;
+        return index;
+    }
+
+    Block block;
+    if (m_ram_size + m_block_size <= m_ram_limit)
+    {
+        block.rb_data = static_cast<char*>(malloc(m_block_size));
+        if (block.rb_data)
+            m_ram_size += m_block_size;
+    }
+
+    if (!block.rb_data && !m_spill_failed)
     {
-        // get memory
-        nodes = (node_simple_t*)calloc(m_actor->ar_num_nodes * numFrames, sizeof(node_simple_t));
-        if (!nodes)
+        if (!m_spill_file.IsOpen())
         {
-            outOfMemory = true;
-            return 0;
+            const std::string path = PathCombine(App::sys_cache_dir->getStr(),
+                "replay_" + TOSTRING(m_actor->ar_instance_id) + ".tmp");
+            if (m_spill_file.Open(path.c_str()))
+                LOG("replay: memory limit reached, continuing in file: " + path);
         }
-        beams = (beam_simple_t*)calloc(m_actor->ar_num_beams * numFrames, sizeof(beam_simple_t));
-        if (!beams)
+        block.rb_data = (m_spill_file.IsOpen()) ? m_spill_file.AddSegment(m_block_size) : nullptr;
+        block.rb_mapped = (block.rb_data != nullptr);
+        if (!block.rb_data)
         {
-            free(nodes);
-            nodes = 0;
-            outOfMemory = true;
-            return 0;
+            LOG("replay: cannot extend scratch file, oldest frames will be overwritten");
+            m_spill_failed = true;
         }
-        times = (unsigned long*)calloc(numFrames, sizeof(unsigned long));
-        if (!times)
+    }
+
+    if (!block.rb_data)
+        return -1;
+
+    m_blocks.push_back(block);
+    return static_cast<int>(m_blocks.size()) - 1;
+}
+
+void Replay::releaseBlockFrame(int index)
+{
+    Block& block = m_blocks[index];
+    block.rb_num_frames--;
+    if (block.rb_num_frames == 0 && index != m_write_block)
+        m_free_blocks.push_back(index);
+}
+
+void Replay::dropOldestFrame()
+{
+    Frame& frame = m_frames[m_first_frame % numFrames];
+    this->releaseBlockFrame(frame.rf_block);
+    frame = Frame();
+    m_first_frame++;
+}
+
+bool Replay::startNewBlock()
+{
+    const int prev_block = m_write_block;
+    m_write_block = -1;
+    if (prev_block != -1 && m_blocks[prev_block].rb_num_frames == 0)
+        m_free_blocks.push_back(prev_block);
+
+    int index = this->allocBlock();
+    if (index == -1)
+    {
+        // Out of storage - give up the oldest frames until a block is released.
+        while (m_free_blocks.empty() && m_first_frame < m_frames_written)
+            this->dropOldestFrame();
+
+        if (m_free_blocks.empty())
         {
-            free(nodes);
-            nodes = 0;
-            free(beams);
-            beams = 0;
             outOfMemory = true;
-            return 0;
+            return false;
         }
+        index = this->allocBlock();
     }
-    void* ptr = 0;
-    times[writeIndex] = replayTimer->getMicroseconds();
-    if (type == 0)
-    {
-        // nodes
-        ptr = (void *)(nodes + (writeIndex * m_actor->ar_num_nodes));
-    }
-    else if (type == 1)
-    {
-        // beams
-        ptr = (void *)(beams + (writeIndex * m_actor->ar_num_beams));
-    }
+
+    m_write_block = index;
+    return true;
+}
+
+char* Replay::reserveBlockSpace(size_t size)
+{
+    Block& block = m_blocks[m_write_block];
+    char* ptr = block.rb_data + block.rb_used;
+    block.rb_used += AlignReplayRecord(size);
     return ptr;
 }
 
-void Replay::writeDone()
+bool Replay::recordBeamStates()
 {
-    if (outOfMemory)
-        return;
-    writeIndex++;
-    if (writeIndex == numFrames)
+    bool changed = false;
+    for (int i = 0; i < m_actor->ar_num_beams; i++)
     {
-        firstRun = 0;
-        writeIndex = 0;
+        const uint8_t state = (m_actor->ar_beams[i].bm_broken ? 1 : 0) | (m_actor->ar_beams[i].bm_disabled ? 2 : 0);
+        if (state != m_beam_states[i])
+        {
+            m_beam_states[i] = state;
+            changed = true;
+            if (!m_beam_touched[i])
+            {
+                m_beam_touched[i] = 1;
+                m_touched_beams.push_back(static_cast<uint32_t>(i));
+            }
+        }
     }
+    return changed;
 }
 
-//we take negative offsets only
-void* Replay::getReadBuffer(int offset, int type, unsigned long& time)
+void Replay::recordFrame()
 {
-    if (offset >= 0)
-        offset = -1;
-    if (offset <= -numFrames)
-        offset = -numFrames + 1;
-
-    int delta = writeIndex + offset;
-    if (delta < 0)
-        if (firstRun && type == 0)
-            return (void *)(nodes);
-        else if (firstRun && type == 1)
-            return (void *)(beams);
+    if (outOfMemory || numFrames == 0)
+        return;
+
+    const size_t key_nodes_size = m_actor->ar_num_nodes * sizeof(ReplayKeyNode);
+    const size_t key_beams_size = m_actor->ar_num_beams;
+    const size_t delta_nodes_size = m_actor->ar_num_nodes * sizeof(ReplayDeltaNode);
+
+    Frame prev;
+    if (m_frames_written > 0)
+        prev = m_frames[(m_frames_written - 1) % numFrames];
+    if (m_frames_written - m_first_frame >= numFrames)
+        this->dropOldestFrame();
+
+    // A sleeping actor doesn't move; repeat the previous frame without looking at the nodes.
+    const bool sleeping = (m_actor->ar_state == ActorState::LOCAL_SLEEPING);
+    const bool beams_changed = !sleeping && this->recordBeamStates();
+    const bool have_key = (m_write_block != -1 && prev.rf_block == m_write_block);
+
+    Frame frame;
+    frame.rf_time = replayTimer->getMicroseconds();
+    bool is_key = !have_key || (!sleeping && m_frames_since_key >= REPLAY_KEYFRAME_INTERVAL);
+
+    if (!is_key && sleeping)
+    {
+        frame.rf_nodes            = prev.rf_nodes;
+        frame.rf_key_nodes        = prev.rf_key_nodes;
+        frame.rf_key_beams        = prev.rf_key_beams;
+        frame.rf_beam_changes     = prev.rf_beam_changes;
+        frame.rf_num_beam_changes = prev.rf_num_beam_changes;
+    }
+    else if (!is_key)
+    {
+        Block& block = m_blocks[m_write_block];
+        const size_t beam_changes_size = (beams_changed) ? m_touched_beams.size() * sizeof(uint32_t) : 0;
+        const size_t used = block.rb_used;
+        if (used + AlignReplayRecord(delta_nodes_size) + AlignReplayRecord(beam_changes_size) > m_block_size)
+        {
+            is_key = true; // Start a new block
+        }
         else
-            delta += numFrames;
+        {
+            // Quantize against the keyframe; fall back to a keyframe if any node strayed too far.
+            const ReplayKeyNode* key_nodes = reinterpret_cast<const ReplayKeyNode*>(prev.rf_key_nodes);
+            ReplayDeltaNode* delta_nodes = reinterpret_cast<ReplayDeltaNode*>(this->reserveBlockSpace(delta_nodes_size));
+            bool ok = true;
+            for (int i = 0; ok && i < m_actor->ar_num_nodes; i++)
+            {
+                const Vector3 pos = m_actor->ar_nodes[i].AbsPosition - key_nodes[i].position;
+                const Vector3 vel = m_actor->ar_nodes[i].Velocity - key_nodes[i].velocity;
+                ok = QuantizeReplayDelta(pos.x, REPLAY_POSITION_UNITS, delta_nodes[i].position[0]) &&
+                     QuantizeReplayDelta(pos.y, REPLAY_POSITION_UNITS, delta_nodes[i].position[1]) &&
+                     QuantizeReplayDelta(pos.z, REPLAY_POSITION_UNITS, delta_nodes[i].position[2]) &&
+                     QuantizeReplayDelta(vel.x, REPLAY_VELOCITY_UNITS, delta_nodes[i].velocity[0]) &&
+                     QuantizeReplayDelta(vel.y, REPLAY_VELOCITY_UNITS, delta_nodes[i].velocity[1]) &&
+                     QuantizeReplayDelta(vel.z, REPLAY_VELOCITY_UNITS, delta_nodes[i].velocity[2]);
+            }
 
-    // set the time
-    time = times[delta];
-    curFrameTime = time;
+            if (!ok)
+            {
+                block.rb_used = used;
+                is_key = true;
+            }
+            else
+            {
+                frame.rf_nodes = reinterpret_cast<const char*>(delta_nodes);
+                // Actor at rest: share the previous frame's nodes
+                if (prev.rf_nodes != prev.rf_key_nodes && memcmp(prev.rf_nodes, delta_nodes, delta_nodes_size) == 0)
+                {
+                    block.rb_used = used;
+                    frame.rf_nodes = prev.rf_nodes;
+                }
+                frame.rf_key_nodes = prev.rf_key_nodes;
+                frame.rf_key_beams = prev.rf_key_beams;
+
+                if (beams_changed)
+                {
+                    uint32_t* changes = reinterpret_cast<uint32_t*>(this->reserveBlockSpace(beam_changes_size));
+                    for (size_t i = 0; i < m_touched_beams.size(); i++)
+                    {
+                        changes[i] = (m_touched_beams[i] << 2) | m_beam_states[m_touched_beams[i]];
+                    }
+                    frame.rf_beam_changes = changes;
+                    frame.rf_num_beam_changes = static_cast<int>(m_touched_beams.size());
+                }
+                else
+                {
+                    frame.rf_beam_changes = prev.rf_beam_changes;
+                    frame.rf_num_beam_changes = prev.rf_num_beam_changes;
+                }
+            }
+        }
+    }
+
+    if (is_key)
+    {
+        const size_t key_size = AlignReplayRecord(key_nodes_size) + AlignReplayRecord(key_beams_size);
+        if (m_write_block == -1 || m_blocks[m_write_block].rb_used + key_size > m_block_size)
+        {
+            if (!this->startNewBlock())
+            {
+                LOG("replay: out of memory, recording stopped");
+                return;
+            }
+        }
+
+        ReplayKeyNode* key_nodes = reinterpret_cast<ReplayKeyNode*>(this->reserveBlockSpace(key_nodes_size));
+        for (int i = 0; i < m_actor->ar_num_nodes; i++)
+        {
+            key_nodes[i].position = m_actor->ar_nodes[i].AbsPosition;
+            key_nodes[i].velocity = m_actor->ar_nodes[i].Velocity;
+        }
+        uint8_t* key_beams = reinterpret_cast<uint8_t*>(this->reserveBlockSpace(key_beams_size));
+        std::copy(m_beam_states.begin(), m_beam_states.end(), key_beams);
+
+        for (uint32_t i: m_touched_beams)
+        {
+            m_beam_touched[i] = 0;
+        }
+        m_touched_beams.clear();
 
-    if (outOfMemory)
-        return 0;
+        frame.rf_nodes = reinterpret_cast<const char*>(key_nodes);
+        frame.rf_key_nodes = frame.rf_nodes;
+        frame.rf_key_beams = key_beams;
+        m_frames_since_key = 0;
+    }
 
-    // return buffer pointer
-    if (type == 0)
-        return (void *)(nodes + delta * m_actor->ar_num_nodes);
-    else if (type == 1)
-        return (void *)(beams + delta * m_actor->ar_num_beams);
-    return 0;
+    m_frames_since_key++;
+    frame.rf_block = m_write_block;
+    m_blocks[m_write_block].rb_num_frames++;
+    m_frames[m_frames_written % numFrames] = frame;
+    m_frames_written++;
 }
 
 unsigned long Replay::getLastReadTime()
@@ -183,65 +360,69 @@ void Replay::onPhysicsStep()
     m_replay_timer += PHYSICS_DT;
     if (m_replay_timer >= ar_replay_precision)
     {
-        // store nodes
-        node_simple_t* nbuff = (node_simple_t *)this->getWriteBuffer(0);
-        if (nbuff)
-        {
-            for (int i = 0; i < m_actor->ar_num_nodes; i++)
-            {
-                nbuff[i].position = m_actor->ar_nodes[i].AbsPosition;
-                nbuff[i].velocity = m_actor->ar_nodes[i].Velocity;
-            }
-        }
-
-        // store beams
-        beam_simple_t* bbuff = (beam_simple_t *)this->getWriteBuffer(1);
-        if (bbuff)
-        {
-            for (int i = 0; i < m_actor->ar_num_beams; i++)
-            {
-                bbuff[i].broken = m_actor->ar_beams[i].bm_broken;
-                bbuff[i].disabled = m_actor->ar_beams[i].bm_disabled;
-            }
-        }
-
-        this->writeDone();
+        this->recordFrame();
         m_replay_timer = 0.0f;
     }
 }
 
+//we take negative offsets only
 void Replay::replayStepActor()
 {
-    if (ar_replay_pos != m_replay_pos_prev)
+    if (ar_replay_pos != m_replay_pos_prev && m_frames_written > m_first_frame)
     {
-        unsigned long time = 0;
+        int offset = ar_replay_pos;
+        if (offset >= 0)
+            offset = -1;
+        if (offset <= -numFrames)
+            offset = -numFrames + 1;
+
+        const Frame& frame = m_frames[std::max(m_frames_written + offset, m_first_frame) % numFrames];
+        curFrameTime = frame.rf_time;
 
-        node_simple_t* nbuff = (node_simple_t *)this->getReadBuffer(ar_replay_pos, 0, time);
-        if (nbuff)
+        const ReplayKeyNode* key_nodes = reinterpret_cast<const ReplayKeyNode*>(frame.rf_key_nodes);
+        if (frame.rf_nodes == frame.rf_key_nodes)
         {
             for (int i = 0; i < m_actor->ar_num_nodes; i++)
             {
-                m_actor->ar_nodes[i].AbsPosition = nbuff[i].position;
-                m_actor->ar_nodes[i].RelPosition = nbuff[i].position - m_actor->ar_origin;
-
-                m_actor->ar_nodes[i].Velocity = nbuff[i].velocity;
-                m_actor->ar_nodes[i].Forces = Vector3::ZERO;
+                m_actor->ar_nodes[i].AbsPosition = key_nodes[i].position;
+                m_actor->ar_nodes[i].Velocity = key_nodes[i].velocity;
             }
-
-            m_actor->updateSlideNodePositions();
-            m_actor->UpdateBoundingBoxes();
-            m_actor->calculateAveragePosition();
         }
-
-        beam_simple_t* bbuff = (beam_simple_t *)this->getReadBuffer(ar_replay_pos, 1, time);
-        if (bbuff)
+        else
         {
-            for (int i = 0; i < m_actor->ar_num_beams; i++)
+            const ReplayDeltaNode* delta_nodes = reinterpret_cast<const ReplayDeltaNode*>(frame.rf_nodes);
+            for (int i = 0; i < m_actor->ar_num_nodes; i++)
             {
-                m_actor->ar_beams[i].bm_broken = bbuff[i].broken;
-                m_actor->ar_beams[i].bm_disabled = bbuff[i].disabled;
+                const ReplayDeltaNode& d = delta_nodes[i];
+                m_actor->ar_nodes[i].AbsPosition = key_nodes[i].position
+                    + Vector3(d.position[0], d.position[1], d.position[2]) / REPLAY_POSITION_UNITS;
+                m_actor->ar_nodes[i].Velocity = key_nodes[i].velocity
+                    + Vector3(d.velocity[0], d.velocity[1], d.velocity[2]) / REPLAY_VELOCITY_UNITS;
             }
         }
+
+        for (int i = 0; i < m_actor->ar_num_nodes; i++)
+        {
+            m_actor->ar_nodes[i].RelPosition = m_actor->ar_nodes[i].AbsPosition - m_actor->ar_origin;
+            m_actor->ar_nodes[i].Forces = Vector3::ZERO;
+        }
+
+        m_actor->updateSlideNodePositions();
+        m_actor->UpdateBoundingBoxes();
+        m_actor->calculateAveragePosition();
+
+        for (int i = 0; i < m_actor->ar_num_beams; i++)
+        {
+            m_actor->ar_beams[i].bm_broken = (frame.rf_key_beams[i] & 1) != 0;
+            m_actor->ar_beams[i].bm_disabled = (frame.rf_key_beams[i] & 2) != 0;
+        }
+        for (int i = 0; i < frame.rf_num_beam_changes; i++)
+        {
+            const uint32_t change = frame.rf_beam_changes[i];
+            m_actor->ar_beams[change >> 2].bm_broken = (change & 1) != 0;
+            m_actor->ar_beams[change >> 2].bm_disabled = (change & 2) != 0;
+        }
+
         m_replay_pos_prev = ar_replay_pos;
     }
 }
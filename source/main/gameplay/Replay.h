@@ -21,31 +21,37 @@
 #pragma once
 
 #include "Application.h"
+#include "PlatformUtils.h"
+
+#include <cstdint>
+#include <vector>
 
 namespace RoR {
 
-struct node_simple_t
+/// Node state in a keyframe (exact)
+struct ReplayKeyNode
 {
     Ogre::Vector3 position;
     Ogre::Vector3 velocity;
 };
 
-struct beam_simple_t
+/// Node state in a delta frame; quantized difference to the keyframe
+struct ReplayDeltaNode
 {
-    bool broken:1;
-    bool disabled:1;
+    int16_t position[3]; //!< Millimeters
+    int16_t velocity[3]; //!< Centimeters per second
 };
 
+/// Replay recorder/player. Frames are stored in blocks: periodic keyframes with full node+beam state,
+/// followed by delta frames which only reference their keyframe, so any frame decodes in one step.
+/// Blocks are allocated as needed and recycled; above `sim_replay_memory` they're placed in a memory-mapped scratch file.
 class Replay : public ZeroedMemoryAllocator
 {
 public:
     Replay(Actor* b, int nframes);
     ~Replay();
 
-    void*               getWriteBuffer(int type);
-    void*               getReadBuffer(int offset, int type, unsigned long& time);
     unsigned long       getLastReadTime();
-    void                writeDone();
     void                onPhysicsStep();
     void                replayStepActor();
     float               getPrecision() const { return ar_replay_precision; }
@@ -56,6 +62,33 @@ public:
     void                UpdateInputEvents();
 
 protected:
+    struct Frame
+    {
+        const char*      rf_nodes = nullptr;          //!< `ReplayKeyNode[]` if equal to `rf_key_nodes`, otherwise `ReplayDeltaNode[]`
+        const char*      rf_key_nodes = nullptr;      //!< `ReplayKeyNode[]`
+        const uint8_t*   rf_key_beams = nullptr;      //!< Beam states at the keyframe
+        const uint32_t*  rf_beam_changes = nullptr;   //!< Beams changed since the keyframe: (index << 2) | state
+        int              rf_num_beam_changes = 0;
+        int              rf_block = -1;
+        unsigned long    rf_time = 0;
+    };
+
+    struct Block
+    {
+        char*            rb_data = nullptr;
+        size_t           rb_used = 0;
+        int              rb_num_frames = 0;          //!< Frames stored in this block (all references stay within a block)
+        bool             rb_mapped = false;          //!< Lives in `m_spill_file`
+    };
+
+    void                recordFrame();
+    bool                recordBeamStates();             //!< Returns true if any beam changed
+    char*               reserveBlockSpace(size_t size);
+    bool                startNewBlock();
+    int                 allocBlock();
+    void                dropOldestFrame();
+    void                releaseBlockFrame(int block);
+
     Actor*              m_actor = nullptr;
     float               m_replay_timer = 0.f;
     float               ar_replay_precision = 1.f;
@@ -64,14 +97,28 @@ protected:
     Ogre::Timer*        replayTimer;
     int                 numFrames;
     bool                outOfMemory;
-    int                 writeIndex;
-    int                 firstRun;
     unsigned long       curFrameTime;
 
-    // malloc'ed
-    node_simple_t*      nodes;
-    beam_simple_t*      beams;
-    unsigned long*      times;
+    // Frames (ring buffer indexed by absolute frame number)
+    std::vector<Frame>  m_frames;
+    int64_t             m_frames_written = 0;
+    int64_t             m_first_frame = 0;           //!< Oldest frame still stored
+    int                 m_frames_since_key = 0;
+
+    // Blocks
+    std::vector<Block>  m_blocks;
+    std::vector<int>    m_free_blocks;
+    int                 m_write_block = -1;
+    size_t              m_block_size = 0;
+    size_t              m_ram_size = 0;              //!< Total size of blocks in RAM
+    size_t              m_ram_limit = 0;
+    MappedScratchFile   m_spill_file;
+    bool                m_spill_failed = false;
+
+    // Recorder state
+    std::vector<uint8_t>  m_beam_states;             //!< Last recorded: broken | (disabled << 1)
+    std::vector<uint8_t>  m_beam_touched;            //!< Changed since keyframe
+    std::vector<uint32_t> m_touched_beams;           //!< Indices of beams changed since keyframe
 };
 
 } // namespace RoR
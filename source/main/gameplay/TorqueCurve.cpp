@@ -30,7 +30,9 @@ using namespace RoR;
 
 const String TorqueCurve::customModel = "CustomModel";
 
-TorqueCurve::TorqueCurve() : usedSpline(0), usedModel("")
+static const size_t TORQUE_CURVE_RESOLUTION = 512; //!< Samples of the baked curve
+
+TorqueCurve::TorqueCurve() : usedSpline(0), usedModel(""), bakedCurveDirty(true)
 {
     loadDefaultTorqueModels();
     setTorqueModel("default");
@@ -43,16 +45,33 @@ TorqueCurve::~TorqueCurve()
 
 Real TorqueCurve::getEngineTorque(Real rpm)
 {
-    if (!usedSpline)
-        return 0.0f;
-    if (usedSpline->getNumPoints() == 1)
-        return usedSpline->getPoint(0).y;
+    if (bakedCurveDirty)
+        bakeUsedSpline();
+    return bakedCurve.Evaluate(rpm);
+}
+
+void TorqueCurve::bakeUsedSpline()
+{
+    bakedCurveDirty = false;
+    if (!usedSpline || usedSpline->getNumPoints() == 0)
+    {
+        bakedCurve.BakeConstant(0.0f);
+        return;
+    }
     float minRPM = usedSpline->getPoint(0).x;
     float maxRPM = usedSpline->getPoint(usedSpline->getNumPoints() - 1).x;
-    if (minRPM == maxRPM)
-        return usedSpline->getPoint(0).y;
-    float t = Math::Clamp((rpm - minRPM) / (maxRPM - minRPM), 0.0f, 1.0f);
-    return usedSpline->interpolate(t).y;
+    if (usedSpline->getNumPoints() == 1 || minRPM == maxRPM)
+    {
+        bakedCurve.BakeConstant(usedSpline->getPoint(0).y);
+        return;
+    }
+    // The spline is parametrized 0-1 over the whole RPM range, see `spaceCurveEvenly()`
+    Ogre::SimpleSpline* spline = usedSpline;
+    bakedCurve.Bake(minRPM, maxRPM, TORQUE_CURVE_RESOLUTION, [spline, minRPM, maxRPM](float rpm)
+        {
+            float t = Math::Clamp((rpm - minRPM) / (maxRPM - minRPM), 0.0f, 1.0f);
+            return spline->interpolate(t).y;
+        });
 }
 
 int TorqueCurve::loadDefaultTorqueModels()
@@ -123,6 +142,7 @@ int TorqueCurve::processLine(Ogre::StringVector args, String model)
     // attach the points to the spline
     // LOG("curve "+model+" : " + TOSTRING(point));
     splines[model].addPoint(point);
+    bakedCurveDirty = true;
 
     // special case for custom model:
     // we set it as active curve as well!
@@ -152,6 +172,7 @@ void TorqueCurve::AddCurveSample(float rpm, float progress, Ogre::String const&
 {
     /* attach the points to the spline */
     splines[model].addPoint(Ogre::Vector3(rpm, progress, 0));
+    bakedCurveDirty = true;
 }
 
 int TorqueCurve::setTorqueModel(String name)
@@ -166,6 +187,7 @@ int TorqueCurve::setTorqueModel(String name)
     // use the model
     usedSpline = &splines.find(name)->second;
     usedModel = name;
+    bakedCurveDirty = true;
     return 0;
 }
 
@@ -174,6 +196,7 @@ int TorqueCurve::spaceCurveEvenly(Ogre::SimpleSpline* spline)
     if (!spline)
         return 2;
 
+    bakedCurveDirty = true;
     SimpleSpline tmpSpline = *spline;
     Real points = tmpSpline.getNumPoints();
 
@@ -21,6 +21,7 @@
 #pragma once
 
 #include "Application.h"
+#include "BakedCurve.h"
 
 /// @file
 /// @version 1
@@ -42,7 +43,8 @@ public:
     ~TorqueCurve(); //!< Destructor
 
     /**
-     * Returns the calculated engine torque based on the given RPM, interpolating the torque curve spline.
+     * Returns the calculated engine torque based on the given RPM.
+     * Reads a lookup table baked from the torque curve spline; it's rebuilt on first use after the curve changed.
      * @param The current engine RPM.
      * @return Calculated engine torque.
      */
@@ -104,9 +106,16 @@ protected:
      */
     int processLine(Ogre::StringVector args, Ogre::String model);
 
+    /**
+     * Samples the used spline into `bakedCurve`.
+     */
+    void bakeUsedSpline();
+
     Ogre::SimpleSpline* usedSpline; //!< spline which is used for calculating the torque, set by setTorqueModel().
     Ogre::String usedModel; //!< name of the torque model used by the truck.
     std::map<Ogre::String, Ogre::SimpleSpline> splines; //!< container were all torque curve splines are stored in.
+    BakedCurve bakedCurve; //!< torque ratio by RPM, sampled from `usedSpline`
+    bool bakedCurveDirty; //!< set whenever `usedSpline` may have changed
 };
 
 } // namespace RoR
@@ -79,7 +79,10 @@ RoR::GfxActor::GfxActor(Actor* actor, ActorSpawner* spawner, std::string ogre_re
     m_particles_sparks = App::GetGfxScene()->GetDustPool("sparks");
     m_particles_clump  = App::GetGfxScene()->GetDustPool("clump");
 
-    m_simbuf.simbuf_nodes.reset(new SimBuffer::NodeSB[actor->ar_num_nodes]);
+    // Double-buffered: the sim thread writes the back half, `UpdateSimDataBuffer()` swaps.
+    m_simbuf_nodes_block.reset(new SimBuffer::NodeSB[actor->ar_num_nodes * 2]());
+    m_simbuf.simbuf_nodes = m_simbuf_nodes_block.get();
+    m_simbuf_nodes_back = m_simbuf_nodes_block.get() + actor->ar_num_nodes;
     m_simbuf.simbuf_aeroengines.resize(actor->ar_num_aeroengines);
     m_simbuf.simbuf_commandkey.resize(MAX_COMMANDS + 10);
     m_simbuf.simbuf_airbrakes.resize(spawner->GetMemoryRequirements().num_airbrakes);
@@ -435,7 +438,7 @@ void RoR::GfxActor::UpdateVideoCameras(float dt_sec)
             vidcam.vcam_render_window->update();
 
         // get the normal of the camera plane now
-        GfxActor::SimBuffer::NodeSB* node_buf = m_simbuf.simbuf_nodes.get();
+        GfxActor::SimBuffer::NodeSB* node_buf = m_simbuf.simbuf_nodes;
         const Ogre::Vector3 abs_pos_center = node_buf[vidcam.vcam_node_center].AbsPosition;
         const Ogre::Vector3 abs_pos_z = node_buf[vidcam.vcam_node_dir_z].AbsPosition;
         const Ogre::Vector3 abs_pos_y = node_buf[vidcam.vcam_node_dir_y].AbsPosition;
@@ -1749,17 +1752,26 @@ void RoR::GfxActor::UpdateSimDataBuffer()
     m_simbuf.simbuf_physics_paused = m_actor->ar_physics_paused;
 
     // nodes
-    const int num_nodes = m_actor->ar_num_nodes;
-    for (int i = 0; i < num_nodes; ++i)
+    if (m_simbuf_nodes_ready && !m_actor->m_ongoing_reset)
     {
-        auto node = m_actor->ar_nodes[i];
-        m_simbuf.simbuf_nodes.get()[i].AbsPosition = node.AbsPosition;
-        m_simbuf.simbuf_nodes.get()[i].nd_has_contact = node.nd_has_ground_contact || node.nd_has_mesh_contact;
+        std::swap(m_simbuf.simbuf_nodes, m_simbuf_nodes_back);
+        m_simbuf_nodes_ready = false;
+    }
+    else
+    {
+        // Not simulated by us (networked, paused, resetting) or first fill - copy directly.
+        const int num_nodes = m_actor->ar_num_nodes;
+        for (int i = 0; i < num_nodes; ++i)
+        {
+            const node_t& node = m_actor->ar_nodes[i];
+            m_simbuf.simbuf_nodes[i].AbsPosition = node.AbsPosition;
+            m_simbuf.simbuf_nodes[i].nd_has_contact = node.nd_has_ground_contact || node.nd_has_mesh_contact;
+        }
     }
 
     for (NodeGfx& nx: m_gfx_nodes)
     {
-        m_simbuf.simbuf_nodes.get()[nx.nx_node_idx].nd_is_wet = (nx.nx_wet_time_sec != -1.f);
+        m_simbuf.simbuf_nodes[nx.nx_node_idx].nd_is_wet = (nx.nx_wet_time_sec != -1.f);
     }
 
     // beams
@@ -1870,6 +1882,24 @@ void RoR::GfxActor::UpdateSimDataBuffer()
     }
 }
 
+void RoR::GfxActor::WriteSimNodeSnapshot()
+{
+    SimBuffer::NodeSB* nodes = m_simbuf_nodes_back;
+    const int num_nodes = m_actor->ar_num_nodes;
+    for (int i = 0; i < num_nodes; ++i)
+    {
+        const node_t& node = m_actor->ar_nodes[i];
+        nodes[i].AbsPosition = node.AbsPosition;
+        nodes[i].nd_has_contact = node.nd_has_ground_contact || node.nd_has_mesh_contact;
+    }
+    m_simbuf_nodes_ready = true;
+}
+
+void RoR::GfxActor::DiscardSimNodeSnapshot()
+{
+    m_simbuf_nodes_ready = false;
+}
+
 bool RoR::GfxActor::IsActorLive() const
 {
     return (m_actor->ar_state < ActorState::LOCAL_SLEEPING);
@@ -1993,7 +2023,7 @@ void RoR::GfxActor::RegisterProps(std::vector<Prop> const& props, int driverseat
 void RoR::GfxActor::UpdateAirbrakes()
 {
     const size_t num_airbrakes = m_gfx_airbrakes.size();
-    SimBuffer::NodeSB* nodes = m_simbuf.simbuf_nodes.get();
+    SimBuffer::NodeSB* nodes = m_simbuf.simbuf_nodes;
     for (size_t i=0; i<num_airbrakes; ++i)
     {
         AirbrakeGfx abx = m_gfx_airbrakes[i];
@@ -2023,7 +2053,7 @@ void RoR::GfxActor::UpdateAirbrakes()
 void RoR::GfxActor::UpdateCParticles()
 {
     //update custom particle systems
-    SimBuffer::NodeSB* nodes = m_simbuf.simbuf_nodes.get();
+    SimBuffer::NodeSB* nodes = m_simbuf.simbuf_nodes;
     for (int i = 0; i < m_actor->ar_num_custom_particles; i++)
     {
         Ogre::Vector3 pos = nodes[m_actor->ar_custom_particles[i].emitterNode].AbsPosition;
@@ -32,7 +32,7 @@
 #include "ForwardDeclarations.h"
 #include "GfxData.h"
 #include "RigDef_Prerequisites.h"
-#include "ThreadPool.h" // class Task
+#include "ThreadPool.h" // class TaskHandle
 
 #include <OgreAxisAlignedBox.h>
 #include <OgreColourValue.h>
@@ -112,7 +112,7 @@ public:
             float simbuf_ab_ratio;
         };
 
-        std::unique_ptr<NodeSB>     simbuf_nodes;
+        NodeSB*                     simbuf_nodes              = nullptr; //!< Front half of `GfxActor::m_simbuf_nodes_block`
         Ogre::Vector3               simbuf_pos                = Ogre::Vector3::ZERO;
         Ogre::Vector3               simbuf_node0_velo         = Ogre::Vector3::ZERO;
         float                       simbuf_rotation           = 0;
@@ -250,6 +250,8 @@ public:
     // Internal updates
 
     void                 UpdateSimDataBuffer(); //!< Copies sim. data from `Actor` to `GfxActor` for later update
+    void                 WriteSimNodeSnapshot(); //!< Sim thread: fills the back node buffer, see `UpdateSimDataBuffer()`
+    void                 DiscardSimNodeSnapshot(); //!< Sim thread: actor wasn't simulated, back node buffer is stale
     void                 FinishWheelUpdates();
     void                 FinishFlexbodyTasks();
 
@@ -268,7 +270,7 @@ public:
     VideoCamState        GetVideoCamState() const { return m_vidcam_state; }
     DebugViewType        GetDebugView() const { return m_debug_view; }
     SimBuffer &          GetSimDataBuffer() { return m_simbuf; }
-    SimBuffer::NodeSB*   GetSimNodeBuffer() { return m_simbuf.simbuf_nodes.get(); }
+    SimBuffer::NodeSB*   GetSimNodeBuffer() { return m_simbuf.simbuf_nodes; }
     std::set<GfxActor*>  GetLinkedGfxActors() { return m_linked_gfx_actors; }
     Ogre::String         GetResourceGroup() { return m_custom_resource_group; }
     Actor*               GetActor() { return m_actor; } // Watch out for multithreading with this!
@@ -307,8 +309,8 @@ private:
     std::vector<WheelGfx>       m_wheels;
     Ogre::SceneNode*            m_rods_parent_scenenode;
     RoR::Renderdash*            m_renderdash;
-    std::vector<std::shared_ptr<Task>> m_flexwheel_tasks;
-    std::vector<std::shared_ptr<Task>> m_flexbody_tasks;
+    std::vector<TaskHandle>     m_flexwheel_tasks;
+    std::vector<TaskHandle>     m_flexbody_tasks;
     bool                        m_beaconlight_active;
     float                       m_prop_anim_crankfactor_prev;
     float                       m_prop_anim_shift_timer;
@@ -318,6 +320,9 @@ private:
     bool                        m_initialized;
 
     SimBuffer                   m_simbuf;
+    std::unique_ptr<SimBuffer::NodeSB[]> m_simbuf_nodes_block; //!< Both node buffers, one allocation
+    SimBuffer::NodeSB*          m_simbuf_nodes_back = nullptr;  //!< Written by the sim thread, swapped with `m_simbuf.simbuf_nodes`
+    bool                        m_simbuf_nodes_ready = false;   //!< Back buffer holds the last physics run; guarded by `ActorManager::SyncWithSimThread()`
 
     // Old cab mesh
     FlexObj*                    m_cab_mesh;
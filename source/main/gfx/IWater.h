@@ -47,6 +47,17 @@ public:
     virtual void           WaterSetSunPosition(Ogre::Vector3) {}
     virtual bool           IsUnderWater(Ogre::Vector3 pos) = 0;
     virtual void           FrameStepWater(float dt) = 0;
+    virtual void           StepWaves() {}              //!< Advances the wave clock by one PHYSICS_DT; called by the sim thread once per physics step
+
+    /// Batched `IsUnderWater()` for the physics step; sets `out_under_water[i]` to 1 or 0.
+    virtual void           IsUnderWaterBatch(const float* pos_x, const float* pos_y, const float* pos_z, size_t count, uint8_t* out_under_water)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            out_under_water[i] = this->IsUnderWater(Ogre::Vector3(pos_x[i], pos_y[i], pos_z[i])) ? 1 : 0;
+        }
+    }
+
     virtual void           SetReflectionPlaneHeight(float centerheight) {}
     virtual void           UpdateReflectionPlane(float h) {}
     virtual void           WaterPrepareShutdown() {}
@@ -21,6 +21,7 @@
 
 #include "Water.h"
 
+#include "ActorManager.h" // PHYSICS_DT
 #include "AppContext.h"
 #include "CameraManager.h"
 #include "GfxScene.h"
@@ -33,6 +34,30 @@ using namespace Ogre;
 using namespace RoR;
 
 static const int WAVEREZ = 100;
+static const size_t WAVE_BATCH_SIZE = 64; //!< Positions per batch in `IsUnderWaterBatch()`, heights stay on stack
+
+/// sin(2*pi*u) for `u` given in wave cycles.
+/// A fixed polynomial rather than libm, so that every platform computes the same waves;
+/// branchless, so that the compiler can vectorize the loops which call it. Abs. error < 4e-6.
+static inline float WaveSinCycles(float u)
+{
+    // Reduce to [-0.5, 0.5] cycles
+    u -= (float)(int)(u + ((u < 0.f) ? -0.5f : 0.5f));
+    // Fold onto [-0.25, 0.25] using sin(pi - x) = sin(x)
+    u = std::min(u, 0.5f - u);
+    u = std::max(u, -0.5f - u);
+    // Taylor series up to x^9
+    const float x = u * Math::TWO_PI;
+    const float x2 = x * x;
+    return x * (1.f + x2 * (-1.f / 6.f + x2 * (1.f / 120.f + x2 * (-1.f / 5040.f + x2 * (1.f / 362880.f)))));
+}
+
+/// Time term of a wave train in cycles, [0, 1); computed in double so the waves don't get jerky during long sessions
+static inline float WavePhaseCycles(double time_sec, float wavespeed, float wavelength)
+{
+    const double cycles = time_sec * wavespeed / wavelength;
+    return (float)(cycles - std::floor(cycles));
+}
 
 Water::Water(Ogre::Vector3 terrn_size) :
     m_map_size(terrn_size),
@@ -49,7 +74,8 @@ Water::Water(Ogre::Vector3 terrn_size) :
     m_refract_rtt_target(0),
     m_reflect_rtt_target(0),
     m_reflect_cam(0),
-    m_refract_cam(0)
+    m_refract_cam(0),
+    m_wave_steps(0)
 {
     //Ugh.. Why so ugly and hard to read
     m_reflect_listener.scene_mgr = App::GetGfxScene()->GetSceneManager();
@@ -88,6 +114,8 @@ Water::Water(Ogre::Vector3 terrn_size) :
     for (size_t i = 0; i < m_wavetrain_defs.size(); i++)
     {
         m_wavetrain_defs[i].wavespeed = 1.25 * sqrt(m_wavetrain_defs[i].wavelength);
+        m_wavetrain_defs[i].cycles_x = m_wavetrain_defs[i].dir_sin / m_wavetrain_defs[i].wavelength;
+        m_wavetrain_defs[i].cycles_z = m_wavetrain_defs[i].dir_cos / m_wavetrain_defs[i].wavelength;
         m_max_ampl += m_wavetrain_defs[i].maxheight;
     }
 
@@ -372,11 +400,25 @@ void Water::ShowWave(Vector3 refpos)
     float xScaled = m_map_size.x * m_waterplane_mesh_scale;
     float zScaled = m_map_size.z * m_waterplane_mesh_scale;
 
+    // One batch per row of the grid
+    float row_x[WAVEREZ + 1];
+    float row_y[WAVEREZ + 1];
+    float row_z[WAVEREZ + 1];
+    float row_height[WAVEREZ + 1];
+    for (int px = 0; px < WAVEREZ + 1; px++)
+    {
+        row_x[px] = refpos.x + xScaled * 0.5 - (float)px * xScaled / WAVEREZ;
+        row_y[px] = refpos.y;
+    }
+
     for (int pz = 0; pz < WAVEREZ + 1; pz++)
     {
+        const float z = refpos.z + (float)pz * zScaled / WAVEREZ - zScaled * 0.5;
+        std::fill(row_z, row_z + WAVEREZ + 1, z);
+        this->CalcWavesHeightBatch(row_x, row_y, row_z, WAVEREZ + 1, row_height);
         for (int px = 0; px < WAVEREZ + 1; px++)
         {
-            m_waterplane_vert_buf_local[(pz * (WAVEREZ + 1) + px) * 8 + 1] = CalcWavesHeight(refpos + Vector3(xScaled * 0.5 - (float)px * xScaled / WAVEREZ, 0, (float)pz * zScaled / WAVEREZ - zScaled * 0.5)) - m_water_height;
+            m_waterplane_vert_buf_local[(pz * (WAVEREZ + 1) + px) * 8 + 1] = row_height[px] - m_water_height;
         }
     }
 
@@ -441,7 +483,7 @@ void Water::UpdateWater()
             m_waterplane_node->setPosition(Vector3(waterPos.x, m_water_height, waterPos.z));
             m_bottomplane_node->setPosition(bottomPos);
         }
-        if (RoR::App::gfx_water_waves->getBool() && RoR::App::mp_state->getEnum<MpState>() == RoR::MpState::DISABLED)
+        if (this->AreWavesEnabled())
             this->ShowWave(m_waterplane_node->getPosition());
     }
 
@@ -524,44 +566,81 @@ float Water::CalcWavesHeight(Vector3 pos)
         return m_water_height;
     }
 
-    const float time_sec = (float)(App::GetAppContext()->GetOgreRoot()->getTimer()->getMilliseconds() * 0.001);
-
     // uh, some upper limit?!
     if (pos.y > m_water_height + m_max_ampl)
         return m_water_height;
 
-    float waveheight = GetWaveHeight(pos);
+    float result;
+    this->CalcWavesHeightBatch(&pos.x, &pos.y, &pos.z, 1, &result);
+    return result;
+}
+
+void Water::CalcWavesHeightBatch(const float* pos_x, const float* pos_y, const float* pos_z, size_t count, float* out_height)
+{
+    // Waves are driven by simulation time, so that the physics sees the same sea every run
+    const double time_sec = this->GetWaveTime();
+    const Vector3 center((m_map_size.x * m_waterplane_mesh_scale) * 0.5, m_water_height, (m_map_size.z * m_waterplane_mesh_scale) * 0.5);
+
     // we will store the result in this variable, init it with the default height
-    float result = m_water_height;
+    for (size_t i = 0; i < count; i++)
+    {
+        out_height[i] = m_water_height;
+    }
+
     // now walk through all the wave trains. One 'train' is one sin/cos set that will generate once wave. All the trains together will sum up, so that they generate a 'rough' sea
-    for (size_t i = 0; i < m_wavetrain_defs.size(); i++)
+    // The time term is the same for all positions - the inner loop is plain arithmetic, see `WaveSinCycles()`
+    for (const WaveTrain& train: m_wavetrain_defs)
     {
-        // calculate the amplitude that this wave will have. wavetrains[i].amplitude is read from the config
-        // upper limit: prevent too big waves by setting an upper limit
-        float amp = std::min(m_wavetrain_defs[i].amplitude * waveheight, m_wavetrain_defs[i].maxheight);
-        // now the main thing:
-        // calculate the sinus with the values of the config file and add it to the result
-        result += amp * sin(Math::TWO_PI * ((time_sec * m_wavetrain_defs[i].wavespeed + m_wavetrain_defs[i].dir_sin * pos.x + m_wavetrain_defs[i].dir_cos * pos.z) / m_wavetrain_defs[i].wavelength));
+        const float phase = WavePhaseCycles(time_sec, train.wavespeed, train.wavelength);
+        for (size_t i = 0; i < count; i++)
+        {
+            // How high the waves should be at this point, see `GetWaveHeight()`
+            const float dx = pos_x[i] - center.x;
+            const float dy = pos_y[i] - center.y;
+            const float dz = pos_z[i] - center.z;
+            const float waveheight = (dx * dx + dy * dy + dz * dz) / 3000000.f + m_waves_height;
+            // calculate the amplitude that this wave will have. wavetrains[i].amplitude is read from the config
+            // upper limit: prevent too big waves by setting an upper limit
+            const float amp = std::min(train.amplitude * waveheight, train.maxheight);
+            out_height[i] += amp * WaveSinCycles(phase + train.cycles_x * pos_x[i] + train.cycles_z * pos_z[i]);
+        }
     }
-    // return the summed up waves
-    return result;
 }
 
 bool Water::IsUnderWater(Vector3 pos)
 {
-    float waterheight = m_water_height;
+    uint8_t result;
+    this->IsUnderWaterBatch(&pos.x, &pos.y, &pos.z, 1, &result);
+    return result != 0;
+}
 
-    if (RoR::App::gfx_water_waves->getBool() && RoR::App::mp_state->getEnum<MpState>() == RoR::MpState::DISABLED)
+void Water::IsUnderWaterBatch(const float* pos_x, const float* pos_y, const float* pos_z, size_t count, uint8_t* out_under_water)
+{
+    if (!this->AreWavesEnabled())
     {
-        float waveheight = GetWaveHeight(pos);
-
-        if (pos.y > m_water_height + m_max_ampl * waveheight || pos.y > m_water_height + m_max_ampl)
-            return false;
-
-        waterheight = CalcWavesHeight(pos);
+        for (size_t i = 0; i < count; i++)
+        {
+            out_under_water[i] = (pos_y[i] < m_water_height) ? 1 : 0;
+        }
+        return;
     }
 
-    return pos.y < waterheight;
+    const Vector3 center((m_map_size.x * m_waterplane_mesh_scale) * 0.5, m_water_height, (m_map_size.z * m_waterplane_mesh_scale) * 0.5);
+    float heights[WAVE_BATCH_SIZE];
+    for (size_t start = 0; start < count; start += WAVE_BATCH_SIZE)
+    {
+        const size_t num = std::min(WAVE_BATCH_SIZE, count - start);
+        this->CalcWavesHeightBatch(pos_x + start, pos_y + start, pos_z + start, num, heights);
+        for (size_t i = 0; i < num; i++)
+        {
+            const float x = pos_x[start + i];
+            const float y = pos_y[start + i];
+            const float z = pos_z[start + i];
+            const float waveheight = ((x - center.x) * (x - center.x) + (y - center.y) * (y - center.y) + (z - center.z) * (z - center.z)) / 3000000.f + m_waves_height;
+            const bool above_waves = (y > m_water_height + m_max_ampl * waveheight) || (y > m_water_height + m_max_ampl);
+            out_under_water[start + i] = (!above_waves && y < heights[i]) ? 1 : 0;
+        }
+    }
 }
 
 Vector3 Water::CalcWavesVelocity(Vector3 pos)
@@ -576,20 +655,35 @@ Vector3 Water::CalcWavesVelocity(Vector3 pos)
 
     Vector3 result(Vector3::ZERO);
 
-    const float time_sec = (float)(App::GetAppContext()->GetOgreRoot()->getTimer()->getMilliseconds() * 0.001);
+    const double time_sec = this->GetWaveTime();
 
-    for (size_t i = 0; i < m_wavetrain_defs.size(); i++)
+    for (const WaveTrain& train: m_wavetrain_defs)
     {
-        float amp = std::min(m_wavetrain_defs[i].amplitude * waveheight, m_wavetrain_defs[i].maxheight);
-        float speed = Math::TWO_PI * amp / (m_wavetrain_defs[i].wavelength / m_wavetrain_defs[i].wavespeed);
-        float coeff = Math::TWO_PI * (time_sec * m_wavetrain_defs[i].wavespeed + m_wavetrain_defs[i].dir_sin * pos.x + m_wavetrain_defs[i].dir_cos * pos.z) / m_wavetrain_defs[i].wavelength;
-        result.y += speed * cos(coeff);
-        result += Vector3(m_wavetrain_defs[i].dir_sin, 0, m_wavetrain_defs[i].dir_cos) * speed * sin(coeff);
+        float amp = std::min(train.amplitude * waveheight, train.maxheight);
+        float speed = Math::TWO_PI * amp / (train.wavelength / train.wavespeed);
+        float cycles = WavePhaseCycles(time_sec, train.wavespeed, train.wavelength) + train.cycles_x * pos.x + train.cycles_z * pos.z;
+        result.y += speed * WaveSinCycles(cycles + 0.25f); // cos
+        result += Vector3(train.dir_sin, 0, train.dir_cos) * speed * WaveSinCycles(cycles);
     }
 
     return result;
 }
 
+void Water::StepWaves()
+{
+    m_wave_steps.store(m_wave_steps.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+double Water::GetWaveTime() const
+{
+    return m_wave_steps.load(std::memory_order_relaxed) * (double)PHYSICS_DT;
+}
+
+bool Water::AreWavesEnabled() const
+{
+    return RoR::App::gfx_water_waves->getBool() && RoR::App::mp_state->getEnum<MpState>() == RoR::MpState::DISABLED;
+}
+
 void Water::UpdateReflectionPlane(float h)
 {
     if (this->IsCameraUnderWater())
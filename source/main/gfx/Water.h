@@ -30,6 +30,7 @@
 #include <OgreRenderTargetListener.h>
 #include <OgreTexture.h>
 #include <OgreVector3.h>
+#include <atomic>
 #include <vector>
 
 namespace RoR {
@@ -50,6 +51,8 @@ public:
     Ogre::Vector3  CalcWavesVelocity(Ogre::Vector3 pos) override;
     void           SetWaterVisible(bool value) override;
     bool           IsUnderWater(Ogre::Vector3 pos) override;
+    void           IsUnderWaterBatch(const float* pos_x, const float* pos_y, const float* pos_z, size_t count, uint8_t* out_under_water) override;
+    void           StepWaves() override;
     void           SetReflectionPlaneHeight(float centerheight) override;
     void           UpdateReflectionPlane(float h) override;
     void           WaterPrepareShutdown() override;
@@ -69,6 +72,8 @@ private:
         float direction;
         float dir_sin;
         float dir_cos;
+        float cycles_x;   //!< dir_sin / wavelength
+        float cycles_z;   //!< dir_cos / wavelength
     };
 
     struct ReflectionListener: Ogre::RenderTargetListener
@@ -94,6 +99,9 @@ private:
     };
 
     float          GetWaveHeight(Ogre::Vector3 pos);
+    bool           AreWavesEnabled() const; //!< Waves for the physics (`IsUnderWater*()`) and the water mesh; off in multiplayer
+    double         GetWaveTime() const;
+    void           CalcWavesHeightBatch(const float* pos_x, const float* pos_y, const float* pos_z, size_t count, float* out_height);
     void           ShowWave(Ogre::Vector3 refpos);
     bool           IsCameraUnderWater();
     void           PrepareWater();
@@ -128,6 +136,7 @@ private:
     Ogre::SceneNode*      m_bottomplane_node;
     Ogre::Plane           m_bottom_plane;
     std::vector<WaveTrain>  m_wavetrain_defs;
+    std::atomic<uint64_t>   m_wave_steps;   //!< Wave clock in physics steps; written by the sim thread, read by both sim and main thread
 
     // Forced camera transforms, used by UpdateWater()
     bool                  m_cam_forced;
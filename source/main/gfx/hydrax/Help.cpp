@@ -24,6 +24,8 @@ http://www.gnu.org/copyleft/lesser.txt.
 
 #include <Help.h>
 
+#include "ThreadPool.h"
+
 namespace Hydrax
 {
 	Ogre::Vector2 Math::intersectionOfTwoLines(const Ogre::Vector2 &a, const Ogre::Vector2 &b,
@@ -71,4 +73,31 @@ namespace Hydrax
 		return Ogre::Vector2((a.x + (r * (b.x - a.x))),
 		                   	 (a.y + (r * (b.y - a.y))));
 	}
+
+	void Parallel::forEachRowRange(const int &RowBegin, const int &RowEnd, const int &MinRowsPerRange,
+		                           const std::function<void(const int&, const int&)> &Func)
+	{
+		const int Rows = RowEnd - RowBegin;
+
+		// Two ranges per thread (workers + the calling one) so an unlucky slow range doesn't stall the join
+		const int MaxRanges    = 2*(static_cast<int>(RoR::App::GetThreadPool()->GetNumWorkers()) + 1),
+		          RowsPerRange = std::max(MinRowsPerRange, (Rows + MaxRanges - 1)/MaxRanges);
+
+		if (Rows <= RowsPerRange)
+		{
+			if (Rows > 0)
+			{
+				Func(RowBegin, RowEnd);
+			}
+			return;
+		}
+
+		std::vector<std::function<void()>> Tasks;
+		for (int Begin = RowBegin; Begin < RowEnd; Begin += RowsPerRange)
+		{
+			const int End = std::min(Begin + RowsPerRange, RowEnd);
+			Tasks.push_back([&Func, Begin, End]() { Func(Begin, End); });
+		}
+		RoR::App::GetThreadPool()->Parallelize(Tasks);
+	}
 }
@@ -27,6 +27,8 @@ http://www.gnu.org/copyleft/lesser.txt.
 
 #include "Prerequisites.h"
 
+#include <functional>
+
 namespace Hydrax
 {
     /** Struct wich contains an especific width and height value
@@ -113,6 +115,22 @@ namespace Hydrax
 		static Ogre::Vector2 intersectionOfTwoLines(const Ogre::Vector2 &a, const Ogre::Vector2 &b,
 			                                        const Ogre::Vector2 &c, const Ogre::Vector2 &d);
 	};
+
+	/** Parallel class with some help funtions
+	 */
+	class Parallel
+	{
+	public:
+		/** Split a range of rows (grid or texture rows) in row ranges and process them on the global thread pool
+		    @param RowBegin First row
+			@param RowEnd One past the last row
+			@param MinRowsPerRange Smaller ranges aren't worth a task; a range this size or smaller runs on the calling thread
+			@param Func Called once per row range with (RowBegin, RowEnd), from several threads at once
+			@remarks Returns when all row ranges are done
+		 */
+		static void forEachRowRange(const int &RowBegin, const int &RowEnd, const int &MinRowsPerRange,
+			                        const std::function<void(const int&, const int&)> &Func);
+	};
 }
 
 #endif
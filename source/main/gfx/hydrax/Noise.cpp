@@ -78,6 +78,14 @@ namespace Hydrax{namespace Noise
 		}
 	}
 
+	void Noise::getValues(const float *x, const float *y, const int &Count, float *Values)
+	{
+		for (int k = 0; k < Count; k++)
+		{
+			Values[k] = getValue(x[k], y[k]);
+		}
+	}
+
 	void Noise::saveCfg(Ogre::String &Data)
 	{
 		Data += "#Noise options\n";
@@ -120,6 +120,16 @@ namespace Hydrax{ namespace Noise
 		 */
 		virtual float getValue(const float &x, const float &y) = 0;
 
+		/** Get the especified x/y noise values (i.e. one grid row)
+		    @param x X Coords
+			@param y Y Coords
+			@param Count Number of coords
+			@param Values Output, one noise value per coord
+			@remarks Called from several threads at once (one per row range), between two update() calls,
+			         so neither getValue() nor getValues() may modify the noise
+		 */
+		virtual void getValues(const float *x, const float *y, const int &Count, float *Values);
+
 	protected:
 		/// Module name
 		Ogre::String mName;
@@ -32,12 +32,14 @@ http://graphics.cs.lth.se/theses/projects/projgrid/
 
 #define _def_PackedNoise true
 
+// Coords per getValues() batch
+#define _def_ValuesBatch 64
+
 namespace Hydrax{namespace Noise
 {
 	Perlin::Perlin()
 		: Noise("Perlin", true)
 		, time(0)
-		, r_noise(0)
 		, magnitude(n_dec_magn * 0.085f)
 		, mGPUNormalMapManager(0)
 	{
@@ -47,7 +49,6 @@ namespace Hydrax{namespace Noise
 		: Noise("Perlin", true)
 		, mOptions(Options)
 		, time(0)
-		, r_noise(0)
 		, magnitude(n_dec_magn * Options.Scale)
 		, mGPUNormalMapManager(0)
 	{
@@ -405,6 +406,45 @@ namespace Hydrax{namespace Noise
 		return _getHeigthDual(x, y);
 	}
 
+	void Perlin::getValues(const float *x, const float *y, const int &Count, float *Values)
+	{
+		int ui[_def_ValuesBatch],
+		    vi[_def_ValuesBatch],
+			value[_def_ValuesBatch],
+			hoct = mOptions.Octaves / n_packsize;
+
+		for (int Start = 0; Start < Count; Start += _def_ValuesBatch)
+		{
+			const int Num = std::min(_def_ValuesBatch, Count - Start);
+
+			for (int k = 0; k < Num; k++)
+			{
+				ui[k] = x[Start + k]*magnitude;
+				vi[k] = y[Start + k]*magnitude;
+				value[k] = 0;
+			}
+
+			// Same sums as _getHeigthDual(), octave pack by octave pack for the whole batch
+			const int *r_noise = p_noise;
+
+			for (int i = 0; i < hoct; i++)
+			{
+				for (int k = 0; k < Num; k++)
+				{
+					value[k] += _readTexelLinearDual(r_noise, ui[k], vi[k]);
+					ui[k] = ui[k] << n_packsize;
+					vi[k] = vi[k] << n_packsize;
+				}
+				r_noise += np_size_sq;
+			}
+
+			for (int k = 0; k < Num; k++)
+			{
+				Values[Start + k] = static_cast<float>(value[k])/noise_magnitude;
+			}
+		}
+	}
+
 	void Perlin::_initNoise()
 	{
 		// Create noise (uniform)
@@ -446,7 +486,7 @@ namespace Hydrax{namespace Noise
 
 	void Perlin::_calculeNoise()
 	{
-		int i, o, v, u,
+		int i, o,
 			multitable[max_octaves],
 			amount[3],
 			iImage;
@@ -504,26 +544,35 @@ namespace Hydrax{namespace Noise
 
 		if(_def_PackedNoise)
 		{
-			int octavepack = 0;
-			for(o=0; o<mOptions.Octaves; o+=n_packsize)
+			const int Octaves = mOptions.Octaves;
+
+			// Packed noise rows are independent, each row range fills its rows of every octave pack
+			Parallel::forEachRowRange(0, np_size, 16, [this, Octaves](const int &RowBegin, const int &RowEnd)
 			{
-				for(v=0; v<np_size; v++)
+				int octavepack = 0;
+				for(int o=0; o<Octaves; o+=n_packsize)
 				{
-					for(u=0; u<np_size; u++)
+					for(int v=RowBegin; v<RowEnd; v++)
 					{
-						p_noise[v*np_size+u+octavepack*np_size_sq]  = o_noise[(o+3)*n_size_sq + (v&n_size_m1)*n_size + (u&n_size_m1)];
-						p_noise[v*np_size+u+octavepack*np_size_sq] += _mapSample( u, v, 3, o);
-						p_noise[v*np_size+u+octavepack*np_size_sq] += _mapSample( u, v, 2, o+1);
-						p_noise[v*np_size+u+octavepack*np_size_sq] += _mapSample( u, v, 1, o+2);
+						int *p_row = p_noise + octavepack*np_size_sq + v*np_size;
+						const int *o_row = o_noise + (o+3)*n_size_sq + (v&n_size_m1)*n_size;
+
+						for(int u=0; u<np_size; u++)
+						{
+							p_row[u] = o_row[u&n_size_m1] +
+								_mapSample( u, v, 3, o) +
+								_mapSample( u, v, 2, o+1) +
+								_mapSample( u, v, 1, o+2);
+						}
 					}
-				}
 
-				octavepack++;
-			}
+					octavepack++;
+				}
+			});
 		}
 	}
 
-	int Perlin::_readTexelLinearDual(const int &u, const int &v,const int &o)
+	int Perlin::_readTexelLinearDual(const int *r_noise, const int &u, const int &v) const
 	{
 		int iu, iup, iv, ivp, fu, fv,
 			ut01, ut23, ut;
@@ -544,10 +593,10 @@ namespace Hydrax{namespace Noise
 		return ut;
 	}
 
-	float Perlin::_getHeigthDual(float u, float v)
+	float Perlin::_getHeigthDual(float u, float v) const
 	{
-		// Pointer to the current noise source octave
-		r_noise = p_noise;
+		// Pointer to the current noise source octave; local, so concurrent getValue() calls don't interfere
+		const int *r_noise = p_noise;
 
 		int ui = u*magnitude,
 		    vi = v*magnitude,
@@ -557,7 +606,7 @@ namespace Hydrax{namespace Noise
 
 		for(i=0; i<hoct; i++)
 		{
-			value += _readTexelLinearDual(ui,vi,0);
+			value += _readTexelLinearDual(r_noise,ui,vi);
 			ui = ui << n_packsize;
 			vi = vi << n_packsize;
 			r_noise += np_size_sq;
@@ -566,7 +615,7 @@ namespace Hydrax{namespace Noise
 		return static_cast<float>(value)/noise_magnitude;
 	}
 
-	int Perlin::_mapSample(const int &u, const int &v, const int &upsamplepower, const int &octave)
+	int Perlin::_mapSample(const int &u, const int &v, const int &upsamplepower, const int &octave) const
 	{
 		int magnitude = 1<<upsamplepower,
 
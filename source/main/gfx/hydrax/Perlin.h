@@ -209,6 +209,15 @@ namespace Hydrax{ namespace Noise
 		 */
 		float getValue(const float &x, const float &y);
 
+		/** Get the especified x/y noise values
+		    @param x X Coords
+			@param y Y Coords
+			@param Count Number of coords
+			@param Values Output, one noise value per coord
+			@remarks Same results as getValue(), octave by octave for all coords
+		 */
+		void getValues(const float *x, const float *y, const int &Count, float *Values);
+
 		/** Set/Update perlin noise options
 		    @param Options Perlin noise options
 			@remarks If create() have been already called, Octaves option doesn't be updated.
@@ -237,19 +246,19 @@ namespace Hydrax{ namespace Noise
 		void _updateGPUNormalMapResources();
 
 		/** Read texel linear dual
+		    @param r_noise Packed noise octave to read from (p_noise + n*np_size_sq)
 		    @param u u
 			@param v v
-			@param o Octave
 			@return int
 		 */
-	    int _readTexelLinearDual(const int &u, const int &v, const int &o);
+	    int _readTexelLinearDual(const int *r_noise, const int &u, const int &v) const;
 
 		/** Read texel linear
 		    @param u u
 			@param v v
 			@return Heigth
 		 */
-		float _getHeigthDual(float u, float v);
+		float _getHeigthDual(float u, float v) const;
 
 		/** Map sample
 		    @param u u
@@ -258,13 +267,12 @@ namespace Hydrax{ namespace Noise
 			@param octave Octave
 			@return Map sample
 		 */
-		int _mapSample(const int &u, const int &v, const int &upsamplepower, const int &octave);
+		int _mapSample(const int &u, const int &v, const int &upsamplepower, const int &octave) const;
 
 		/// Perlin noise variables
 		int noise[n_size_sq*noise_frames];
 		int o_noise[n_size_sq*max_octaves];
 		int p_noise[np_size_sq*(max_octaves>>(n_packsize-1))];
-		int *r_noise;
 		float magnitude;
 
 		/// Elapsed time
@@ -55,6 +55,86 @@ namespace Hydrax{namespace Module
 		return "Rtt";
 	}
 
+	/** Project the grid rows [RowBegin, RowEnd) onto the base plane (x/z only)
+	 */
+	template <class VertexType>
+	void _PG_projectRows(VertexType* Vertices, const int &Complexity, const int &RowBegin, const int &RowEnd,
+		                 const Ogre::Vector4 &c0, const Ogre::Vector4 &c1, const Ogre::Vector4 &c2, const Ogre::Vector4 &c3)
+	{
+		const float d = 1.0f/(Complexity-1);
+
+		for(int iv = RowBegin; iv < RowEnd; iv++)
+		{
+			// Interpolate the corners along v once per row, then along u per vertex
+			const float v    = iv*d,
+			            _1_v = 1.0f-v,
+			            Lx = _1_v*c0.x + v*c2.x, Lz = _1_v*c0.z + v*c2.z, Lw = _1_v*c0.w + v*c2.w,
+			            Rx = _1_v*c1.x + v*c3.x, Rz = _1_v*c1.z + v*c3.z, Rw = _1_v*c1.w + v*c3.w;
+
+			VertexType* Row = Vertices + iv*Complexity;
+
+			for(int iu = 0; iu < Complexity; iu++)
+			{
+				const float u      = iu*d,
+				            _1_u   = 1.0f-u,
+				            divide = 1.0f/(_1_u*Lw + u*Rw);
+
+				Row[iu].x = (_1_u*Lx + u*Rx)*divide;
+				Row[iu].z = (_1_u*Lz + u*Rz)*divide;
+			}
+		}
+	}
+
+	/** Set the heights of the grid rows [RowBegin, RowEnd) from the noise at their x/z position
+	 */
+	template <class VertexType>
+	void _PG_calculeHeights(VertexType* Vertices, Noise::Noise *n, const int &Complexity, const int &RowBegin, const int &RowEnd,
+		                    const Ogre::Vector3 &WorldPos, const float &Height, const float &Strength)
+	{
+		// One row of coords/values side by side, so the loops vectorize and the noise is sampled in batches
+		std::vector<float> X(Complexity), Z(Complexity), Y(Complexity);
+
+		for(int v = RowBegin; v < RowEnd; v++)
+		{
+			VertexType* Row = Vertices + v*Complexity;
+
+			for(int u = 0; u < Complexity; u++)
+			{
+				X[u] = WorldPos.x + Row[u].x;
+				Z[u] = WorldPos.z + Row[u].z;
+			}
+
+			n->getValues(&X[0], &Z[0], Complexity, &Y[0]);
+
+			for(int u = 0; u < Complexity; u++)
+			{
+				Row[u].y = Height + Y[u]*Strength;
+			}
+		}
+	}
+
+	/** Smooth the heights of the inner grid vertices
+	    @remarks In place, each vertex reads its already smoothed left and upper neighbours,
+	             so this pass stays on one thread (it's cheap compared to the noise)
+	 */
+	template <class VertexType>
+	void _PG_smoothHeights(VertexType* Vertices, const int &Complexity)
+	{
+		for(int v=1; v<(Complexity-1); v++)
+		{
+			for(int u=1; u<(Complexity-1); u++)
+			{
+				Vertices[v*Complexity + u].y =
+					 0.2f *
+					(Vertices[v    *Complexity + u    ].y +
+					 Vertices[v    *Complexity + (u+1)].y +
+					 Vertices[v    *Complexity + (u-1)].y +
+					 Vertices[(v+1)*Complexity + u    ].y +
+					 Vertices[(v-1)*Complexity + u    ].y);
+			}
+		}
+	}
+
 	ProjectedGrid::ProjectedGrid(Hydrax *h, Noise::Noise *n, const Ogre::Plane &BasePlane, const MaterialManager::NormalMode& NormalMode)
 		: Module("ProjectedGrid" + _PG_getNormalModeString(NormalMode),
 		         n, Mesh::Options(256, Size(0), _PG_getVertexTypeFromNormalMode(NormalMode)), NormalMode)
@@ -287,81 +367,39 @@ namespace Hydrax{namespace Module
 		}
 		else if (mLastMinMax)
 		{
-			if (getNormalMode() == MaterialManager::NM_VERTEX)
-			{
-				Mesh::POS_NORM_VERTEX* Vertices = static_cast<Mesh::POS_NORM_VERTEX*>(mVertices);
+			const float Height = -mBasePlane.d;
 
-				if (mOptions.ChoppyWaves)
-				{
-					for(int i = 0; i < mOptions.Complexity*mOptions.Complexity; i++)
-		            {
-			            Vertices[i] = mVerticesChoppyBuffer[i];
-						Vertices[i].y = -mBasePlane.d + mNoise->getValue(RenderingCameraPos.x + Vertices[i].x, RenderingCameraPos.z + Vertices[i].z)*mOptions.Strength;
-		            }
-				}
-				else
-				{
-					for(int i = 0; i < mOptions.Complexity*mOptions.Complexity; i++)
-		            {
-						Vertices[i].y = -mBasePlane.d + mNoise->getValue(RenderingCameraPos.x + Vertices[i].x, RenderingCameraPos.z + Vertices[i].z)*mOptions.Strength;
-		            }
-				}
-			}
-			else if (getNormalMode() == MaterialManager::NM_RTT)
+			Parallel::forEachRowRange(0, mOptions.Complexity, 8, [this, &RenderingCameraPos, Height](const int &RowBegin, const int &RowEnd)
 			{
-				Mesh::POS_VERTEX* Vertices = static_cast<Mesh::POS_VERTEX*>(mVertices);
-
-				for(int i = 0; i < mOptions.Complexity*mOptions.Complexity; i++)
-		        {
-				    Vertices[i].y = -mBasePlane.d + mNoise->getValue(RenderingCameraPos.x + Vertices[i].x, RenderingCameraPos.z + Vertices[i].z)*mOptions.Strength;
-		        }
-			}
-
-			// Smooth the heightdata
-		    if (mOptions.Smooth)
-		    {
 				if (getNormalMode() == MaterialManager::NM_VERTEX)
 				{
 					Mesh::POS_NORM_VERTEX* Vertices = static_cast<Mesh::POS_NORM_VERTEX*>(mVertices);
 
-					for(int v=1; v<(mOptions.Complexity-1); v++)
+					if (mOptions.ChoppyWaves)
 					{
-						for(int u=1; u<(mOptions.Complexity-1); u++)
+						for(int i = RowBegin*mOptions.Complexity; i < RowEnd*mOptions.Complexity; i++)
 						{
-							Vertices[v*mOptions.Complexity + u].y =
-								 0.2f *
-								(Vertices[v    *mOptions.Complexity + u    ].y +
-								 Vertices[v    *mOptions.Complexity + (u+1)].y +
-								 Vertices[v    *mOptions.Complexity + (u-1)].y +
-								 Vertices[(v+1)*mOptions.Complexity + u    ].y +
-								 Vertices[(v-1)*mOptions.Complexity + u    ].y);
+							Vertices[i] = mVerticesChoppyBuffer[i];
 						}
 					}
+
+					_PG_calculeHeights(Vertices, mNoise, mOptions.Complexity, RowBegin, RowEnd, RenderingCameraPos, Height, mOptions.Strength);
 				}
-				else if(getNormalMode() == MaterialManager::NM_RTT)
+				else if (getNormalMode() == MaterialManager::NM_RTT)
 				{
 					Mesh::POS_VERTEX* Vertices = static_cast<Mesh::POS_VERTEX*>(mVertices);
 
-					for(int v=1; v<(mOptions.Complexity-1); v++)
-					{
-						for(int u=1; u<(mOptions.Complexity-1); u++)
-						{
-							Vertices[v*mOptions.Complexity + u].y =
-								 0.2f *
-								(Vertices[v    *mOptions.Complexity + u    ].y +
-								 Vertices[v    *mOptions.Complexity + (u+1)].y +
-								 Vertices[v    *mOptions.Complexity + (u-1)].y +
-								 Vertices[(v+1)*mOptions.Complexity + u    ].y +
-								 Vertices[(v-1)*mOptions.Complexity + u    ].y);
-						}
-					}
+					_PG_calculeHeights(Vertices, mNoise, mOptions.Complexity, RowBegin, RowEnd, RenderingCameraPos, Height, mOptions.Strength);
 				}
-		    }
+			});
+
+			_smoothHeights();
 
 			_calculeNormals();
 
 			_performChoppyWaves();
 
+			// All row ranges have joined, upload the whole grid at once
 			mHydrax->getMesh()->updateGeometry(mOptions.Complexity*mOptions.Complexity, mVertices);
 		}
 
@@ -376,104 +414,22 @@ namespace Hydrax{namespace Module
 		t_corners2 = _calculeWorldPosition(Ogre::Vector2( 0.0f,+1.0f),m,_viewMat);
 		t_corners3 = _calculeWorldPosition(Ogre::Vector2(+1.0f,+1.0f),m,_viewMat);
 
-		float du  = 1.0f/(mOptions.Complexity-1),
-			  dv  = 1.0f/(mOptions.Complexity-1),
-			  u,v = 0.0f,
-			  // _1_u = (1.0f-u)
-			  _1_u, _1_v = 1.0f,
-			  divide;
-
-		Ogre::Vector4 result;
-
-		int i = 0, iv, iu;
-
-		if (getNormalMode() == MaterialManager::NM_VERTEX)
-		{
-			Mesh::POS_NORM_VERTEX* Vertices = static_cast<Mesh::POS_NORM_VERTEX*>(mVertices);
-
-			for(iv=0; iv<mOptions.Complexity; iv++)
-			{
-				u = 0.0f;
-				_1_u = 1.0f;
-				for(iu=0; iu<mOptions.Complexity; iu++)
-				{
-					result.x = _1_v*(_1_u*t_corners0.x + u*t_corners1.x) + v*(_1_u*t_corners2.x + u*t_corners3.x);
-					result.z = _1_v*(_1_u*t_corners0.z + u*t_corners1.z) + v*(_1_u*t_corners2.z + u*t_corners3.z);
-					result.w = _1_v*(_1_u*t_corners0.w + u*t_corners1.w) + v*(_1_u*t_corners2.w + u*t_corners3.w);
-
-					divide = 1.0f/result.w;
-					result.x *= divide;
-					result.z *= divide;
+		const float Height = -mBasePlane.d;
 
-					Vertices[i].x = result.x;
-					Vertices[i].z = result.z;
-					Vertices[i].y = -mBasePlane.d + mNoise->getValue(WorldPos.x + result.x, WorldPos.z + result.z)*mOptions.Strength;
-
-					i++;
-					u += du;
-					_1_u = 1.0f-u;
-				}
-				v += dv;
-				_1_v = 1.0f-v;
-			}
-
-			if (mOptions.ChoppyWaves)
-			{
-				for(int i = 0; i < mOptions.Complexity*mOptions.Complexity; i++)
-		        {
-			        mVerticesChoppyBuffer[i] = Vertices[i];
-		        }
-			}
-		}
-		else if(getNormalMode() == MaterialManager::NM_RTT)
-		{
-			Mesh::POS_VERTEX* Vertices = static_cast<Mesh::POS_VERTEX*>(mVertices);
-
-			for(iv=0; iv<mOptions.Complexity; iv++)
-			{
-				u = 0.0f;
-				_1_u = 1.0f;
-				for(iu=0; iu<mOptions.Complexity; iu++)
-				{
-					result.x = _1_v*(_1_u*t_corners0.x + u*t_corners1.x) + v*(_1_u*t_corners2.x + u*t_corners3.x);
-					result.z = _1_v*(_1_u*t_corners0.z + u*t_corners1.z) + v*(_1_u*t_corners2.z + u*t_corners3.z);
-					result.w = _1_v*(_1_u*t_corners0.w + u*t_corners1.w) + v*(_1_u*t_corners2.w + u*t_corners3.w);
-
-					divide = 1.0f/result.w;
-					result.x *= divide;
-					result.z *= divide;
-
-					Vertices[i].x = result.x;
-					Vertices[i].z = result.z;
-					Vertices[i].y = -mBasePlane.d + mNoise->getValue(WorldPos.x + result.x, WorldPos.z + result.z)*mOptions.Strength;
-
-					i++;
-					u += du;
-					_1_u = 1.0f-u;
-				}
-				v += dv;
-				_1_v = 1.0f-v;
-			}
-		}
-
-		// Smooth the heightdata
-		if (mOptions.Smooth)
+		Parallel::forEachRowRange(0, mOptions.Complexity, 8, [this, &WorldPos, Height](const int &RowBegin, const int &RowEnd)
 		{
 			if (getNormalMode() == MaterialManager::NM_VERTEX)
 			{
 				Mesh::POS_NORM_VERTEX* Vertices = static_cast<Mesh::POS_NORM_VERTEX*>(mVertices);
 
-				for(iv=1; iv<(mOptions.Complexity-1); iv++)
+				_PG_projectRows(Vertices, mOptions.Complexity, RowBegin, RowEnd, t_corners0, t_corners1, t_corners2, t_corners3);
+				_PG_calculeHeights(Vertices, mNoise, mOptions.Complexity, RowBegin, RowEnd, WorldPos, Height, mOptions.Strength);
+
+				if (mOptions.ChoppyWaves)
 				{
-					for(iu=1; iu<(mOptions.Complexity-1); iu++)
+					for(int i = RowBegin*mOptions.Complexity; i < RowEnd*mOptions.Complexity; i++)
 					{
-						Vertices[iv*mOptions.Complexity + iu].y =
-							 0.2f *
-							(Vertices[iv    *mOptions.Complexity + iu    ].y +
-							 Vertices[iv    *mOptions.Complexity + (iu+1)].y +
-							 Vertices[iv    *mOptions.Complexity + (iu-1)].y +
-							 Vertices[(iv+1)*mOptions.Complexity + iu    ].y +
-							 Vertices[(iv-1)*mOptions.Complexity + iu    ].y);
+						mVerticesChoppyBuffer[i] = Vertices[i];
 					}
 				}
 			}
@@ -481,21 +437,12 @@ namespace Hydrax{namespace Module
 			{
 				Mesh::POS_VERTEX* Vertices = static_cast<Mesh::POS_VERTEX*>(mVertices);
 
-				for(iv=1; iv<(mOptions.Complexity-1); iv++)
-				{
-					for(iu=1; iu<(mOptions.Complexity-1); iu++)
-					{
-						Vertices[iv*mOptions.Complexity + iu].y =
-							 0.2f *
-							(Vertices[iv    *mOptions.Complexity + iu    ].y +
-							 Vertices[iv    *mOptions.Complexity + (iu+1)].y +
-							 Vertices[iv    *mOptions.Complexity + (iu-1)].y +
-							 Vertices[(iv+1)*mOptions.Complexity + iu    ].y +
-							 Vertices[(iv-1)*mOptions.Complexity + iu    ].y);
-					}
-				}
+				_PG_projectRows(Vertices, mOptions.Complexity, RowBegin, RowEnd, t_corners0, t_corners1, t_corners2, t_corners3);
+				_PG_calculeHeights(Vertices, mNoise, mOptions.Complexity, RowBegin, RowEnd, WorldPos, Height, mOptions.Strength);
 			}
-		}
+		});
+
+		_smoothHeights();
 
 		_calculeNormals();
 
@@ -504,6 +451,23 @@ namespace Hydrax{namespace Module
 		return true;
 	}
 
+	void ProjectedGrid::_smoothHeights()
+	{
+		if (!mOptions.Smooth)
+		{
+			return;
+		}
+
+		if (getNormalMode() == MaterialManager::NM_VERTEX)
+		{
+			_PG_smoothHeights(static_cast<Mesh::POS_NORM_VERTEX*>(mVertices), mOptions.Complexity);
+		}
+		else if(getNormalMode() == MaterialManager::NM_RTT)
+		{
+			_PG_smoothHeights(static_cast<Mesh::POS_VERTEX*>(mVertices), mOptions.Complexity);
+		}
+	}
+
 	void ProjectedGrid::_calculeNormals()
 	{
 		if (getNormalMode() != MaterialManager::NM_VERTEX)
@@ -511,32 +475,35 @@ namespace Hydrax{namespace Module
 			return;
 		}
 
-		int v, u;
-		Ogre::Vector3 vec1, vec2, normal;
-
 		Mesh::POS_NORM_VERTEX* Vertices = static_cast<Mesh::POS_NORM_VERTEX*>(mVertices);
 
-		for(v=1; v<(mOptions.Complexity-1); v++)
+		// Each normal only reads positions, rows are independent
+		Parallel::forEachRowRange(1, mOptions.Complexity-1, 8, [this, Vertices](const int &RowBegin, const int &RowEnd)
 		{
-			for(u=1; u<(mOptions.Complexity-1); u++)
+			Ogre::Vector3 vec1, vec2, normal;
+
+			for(int v=RowBegin; v<RowEnd; v++)
 			{
-				vec1 = Ogre::Vector3(
-					Vertices[v*mOptions.Complexity + u + 1].x-Vertices[v*mOptions.Complexity + u - 1].x,
-					Vertices[v*mOptions.Complexity + u + 1].y-Vertices[v*mOptions.Complexity + u - 1].y,
-					Vertices[v*mOptions.Complexity + u + 1].z-Vertices[v*mOptions.Complexity + u - 1].z);
+				for(int u=1; u<(mOptions.Complexity-1); u++)
+				{
+					vec1 = Ogre::Vector3(
+						Vertices[v*mOptions.Complexity + u + 1].x-Vertices[v*mOptions.Complexity + u - 1].x,
+						Vertices[v*mOptions.Complexity + u + 1].y-Vertices[v*mOptions.Complexity + u - 1].y,
+						Vertices[v*mOptions.Complexity + u + 1].z-Vertices[v*mOptions.Complexity + u - 1].z);
 
-				vec2 = Ogre::Vector3(
-					Vertices[(v+1)*mOptions.Complexity + u].x - Vertices[(v-1)*mOptions.Complexity + u].x,
-					Vertices[(v+1)*mOptions.Complexity + u].y - Vertices[(v-1)*mOptions.Complexity + u].y,
-					Vertices[(v+1)*mOptions.Complexity + u].z - Vertices[(v-1)*mOptions.Complexity + u].z);
+					vec2 = Ogre::Vector3(
+						Vertices[(v+1)*mOptions.Complexity + u].x - Vertices[(v-1)*mOptions.Complexity + u].x,
+						Vertices[(v+1)*mOptions.Complexity + u].y - Vertices[(v-1)*mOptions.Complexity + u].y,
+						Vertices[(v+1)*mOptions.Complexity + u].z - Vertices[(v-1)*mOptions.Complexity + u].z);
 
-				normal = vec2.crossProduct(vec1);
+					normal = vec2.crossProduct(vec1);
 
-				Vertices[v*mOptions.Complexity + u].nx = normal.x;
-				Vertices[v*mOptions.Complexity + u].ny = normal.y;
-				Vertices[v*mOptions.Complexity + u].nz = normal.z;
+					Vertices[v*mOptions.Complexity + u].nx = normal.x;
+					Vertices[v*mOptions.Complexity + u].ny = normal.y;
+					Vertices[v*mOptions.Complexity + u].nz = normal.z;
+				}
 			}
-		}
+		});
 	}
 
 	void ProjectedGrid::_performChoppyWaves()
@@ -546,19 +513,15 @@ namespace Hydrax{namespace Module
 			return;
 		}
 
-		int v, u,
-		    Underwater = 1;
+		int Underwater = 1;
 
 		if (mHydrax->_isCurrentFrameUnderwater())
 		{
 			Underwater = -1;
 		}
 
-		float Dis1,  Dis2;//,
-		   // Dis1_, Dis2_;
-
-		Ogre::Vector3 CameraDir, Norm;
-		Ogre::Vector2 Dir, Perp, Norm2;
+		Ogre::Vector3 CameraDir;
+		Ogre::Vector2 Dir, Perp;
 
 		CameraDir = mRenderingCamera->getDerivedDirection();
 		Dir       = Ogre::Vector2(CameraDir.x, CameraDir.z).normalisedCopy();
@@ -572,48 +535,58 @@ namespace Hydrax{namespace Module
 
 		Mesh::POS_NORM_VERTEX* Vertices = static_cast<Mesh::POS_NORM_VERTEX*>(mVertices);
 
-		for(v=1; v<(mOptions.Complexity-1); v++)
+		// Reads the choppy buffer and the normals only, rows are independent
+		Parallel::forEachRowRange(1, mOptions.Complexity-1, 8, [this, Vertices, Dir, Perp, Underwater](const int &RowBegin, const int &RowEnd)
 		{
-			Dis1 =  (Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + 1].x,
-					               mVerticesChoppyBuffer[v*mOptions.Complexity + 1].z) -
-					 Ogre::Vector2(mVerticesChoppyBuffer[(v+1)*mOptions.Complexity + 1].x,
-				                   mVerticesChoppyBuffer[(v+1)*mOptions.Complexity + 1].z)).length();
-
-			/*Dis1_ = (Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + 1].x,
-                                   mVerticesChoppyBuffer[v*mOptions.Complexity + 1].z) -
-				   	 Ogre::Vector2(mVerticesChoppyBuffer[(v-1)*mOptions.Complexity + 1].x,
-					               mVerticesChoppyBuffer[(v-1)*mOptions.Complexity + 1].z)).length();
+			float Dis1,  Dis2;//,
+			   // Dis1_, Dis2_;
 
-			Dis1 = (Dis1+Dis1_)/2;*/
+			Ogre::Vector3 Norm;
+			Ogre::Vector2 Norm2;
 
-			for(u=1; u<(mOptions.Complexity-1); u++)
+			for(int v=RowBegin; v<RowEnd; v++)
 			{
-				Dis2 = (Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + u].x,
-					                  mVerticesChoppyBuffer[v*mOptions.Complexity + u].z) -
-					    Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + u+1].x,
-					                  mVerticesChoppyBuffer[v*mOptions.Complexity + u+1].z)).length();
-/*
-				Dis2_ = (Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + u].x,
-					                   mVerticesChoppyBuffer[v*mOptions.Complexity + u].z) -
-					     Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + u-1].x,
-				                       mVerticesChoppyBuffer[v*mOptions.Complexity + u-1].z)).length();
-
-				Dis2 = (Dis2+Dis2_)/2;*/
+				Dis1 =  (Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + 1].x,
+						               mVerticesChoppyBuffer[v*mOptions.Complexity + 1].z) -
+						 Ogre::Vector2(mVerticesChoppyBuffer[(v+1)*mOptions.Complexity + 1].x,
+					                   mVerticesChoppyBuffer[(v+1)*mOptions.Complexity + 1].z)).length();
 
-				Norm = Ogre::Vector3(Vertices[v*mOptions.Complexity + u].nx,
-					                 Vertices[v*mOptions.Complexity + u].ny,
-								     Vertices[v*mOptions.Complexity + u].nz).
-					   			     normalisedCopy();
+				/*Dis1_ = (Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + 1].x,
+	                                   mVerticesChoppyBuffer[v*mOptions.Complexity + 1].z) -
+					   	 Ogre::Vector2(mVerticesChoppyBuffer[(v-1)*mOptions.Complexity + 1].x,
+						               mVerticesChoppyBuffer[(v-1)*mOptions.Complexity + 1].z)).length();
 
-				Norm2 = Ogre::Vector2(Norm.x, Norm.z)  *
-					                 ( (Dir  * Dis1)   +
-					                   (Perp * Dis2))  *
-				 				      mOptions.ChoppyStrength;
+				Dis1 = (Dis1+Dis1_)/2;*/
 
-				Vertices[v*mOptions.Complexity + u].x = mVerticesChoppyBuffer[v*mOptions.Complexity + u].x + Norm2.x * Underwater;
-				Vertices[v*mOptions.Complexity + u].z = mVerticesChoppyBuffer[v*mOptions.Complexity + u].z + Norm2.y * Underwater;
+				for(int u=1; u<(mOptions.Complexity-1); u++)
+				{
+					Dis2 = (Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + u].x,
+						                  mVerticesChoppyBuffer[v*mOptions.Complexity + u].z) -
+						    Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + u+1].x,
+						                  mVerticesChoppyBuffer[v*mOptions.Complexity + u+1].z)).length();
+	/*
+					Dis2_ = (Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + u].x,
+						                   mVerticesChoppyBuffer[v*mOptions.Complexity + u].z) -
+						     Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + u-1].x,
+					                       mVerticesChoppyBuffer[v*mOptions.Complexity + u-1].z)).length();
+
+					Dis2 = (Dis2+Dis2_)/2;*/
+
+					Norm = Ogre::Vector3(Vertices[v*mOptions.Complexity + u].nx,
+						                 Vertices[v*mOptions.Complexity + u].ny,
+									     Vertices[v*mOptions.Complexity + u].nz).
+						   			     normalisedCopy();
+
+					Norm2 = Ogre::Vector2(Norm.x, Norm.z)  *
+						                 ( (Dir  * Dis1)   +
+						                   (Perp * Dis2))  *
+					 				      mOptions.ChoppyStrength;
+
+					Vertices[v*mOptions.Complexity + u].x = mVerticesChoppyBuffer[v*mOptions.Complexity + u].x + Norm2.x * Underwater;
+					Vertices[v*mOptions.Complexity + u].z = mVerticesChoppyBuffer[v*mOptions.Complexity + u].z + Norm2.y * Underwater;
+				}
 			}
-		}
+		});
 	}
 
 	// Check the point of intersection with the plane (0,1,0,0) and return the position in homogenous coordinates
@@ -202,6 +202,10 @@ namespace Hydrax{ namespace Module
 		}
 
 	private:
+		/** Smooth the heightdata, if enabled
+		 */
+		void _smoothHeights();
+
 		/** Calcule current normals
 		 */
 		void _calculeNormals();
@@ -256,6 +256,7 @@ void GameSettings::DrawGameplaySettings()
     {
         DrawGIntBox(App::sim_replay_length, _LC("GameSettings", "Replay length"));
         DrawGIntBox(App::sim_replay_stepping, _LC("GameSettings", "Replay stepping"));
+        DrawGIntBox(App::sim_replay_memory, _LC("GameSettings", "Replay memory (MB)"));
     }
 
     DrawGCheckbox(App::sim_realistic_commands, _LC("GameSettings", "Realistic forward commands"));
@@ -281,6 +281,9 @@ int main(int argc, char *argv[])
         // --------------------------------------------------------------
 
         auto start_time = std::chrono::high_resolution_clock::now();
+#ifdef USE_SOCKETW
+        std::vector<RoR::NetRecvPacket*> net_packets;
+#endif // USE_SOCKETW
 
         while (App::app_state->getEnum<AppState>() != AppState::SHUTDOWN)
         {
@@ -292,9 +295,22 @@ int main(int argc, char *argv[])
                 App::GetGameContext()->GetActorManager()->SyncWithSimThread();
             }
 
+            // Spawn actors whose truckfiles finished parsing in background
+            if (App::app_state->getEnum<AppState>() == AppState::SIMULATION)
+            {
+                App::GetGameContext()->UpdateActorSpawns();
+            }
+
             // Game events
             while (App::GetGameContext()->HasMessages())
             {
+                // Messages after a spawn request may depend on the actor (savegames, bundle reloads...) - wait for pending spawns.
+                if (App::GetGameContext()->HasPendingActorSpawns() &&
+                    App::GetGameContext()->PeekMessageType() != MSG_SIM_SPAWN_ACTOR_REQUESTED)
+                {
+                    break;
+                }
+
                 Message m = App::GetGameContext()->PopMessage();
                 bool failed_m = false;
                 switch (m.type)
@@ -306,6 +322,7 @@ int main(int argc, char *argv[])
                     if (App::app_state->getEnum<AppState>() == AppState::SIMULATION)
                     {
                         App::GetGameContext()->SaveScene("autosave.sav");
+                        App::GetGameContext()->GetActorManager()->WaitForSavegameWrite(); // Pending tasks are dropped on exit
                     }
                     App::GetConsole()->saveConfig(); // RoR.cfg
                     App::GetDiscordRpc()->Shutdown();
@@ -591,9 +608,7 @@ int main(int argc, char *argv[])
                 case MSG_SIM_SPAWN_ACTOR_REQUESTED:
                     if (App::app_state->getEnum<AppState>() == AppState::SIMULATION)
                     {
-                        ActorSpawnRequest* rq = (ActorSpawnRequest*)m.payload;
-                        App::GetGameContext()->SpawnActor(*rq);
-                        delete rq;
+                        App::GetGameContext()->QueueActorSpawn((ActorSpawnRequest*)m.payload);
                     }
                     break;
 
@@ -781,16 +796,17 @@ int main(int argc, char *argv[])
             // Process incoming network traffic
             if (App::mp_state->getEnum<MpState>() == MpState::CONNECTED)
             {
-                std::vector<RoR::NetRecvPacket> packets = App::GetNetwork()->GetIncomingStreamData();
-                if (!packets.empty())
+                App::GetNetwork()->GetIncomingStreamData(net_packets);
+                if (!net_packets.empty())
                 {
-                    RoR::ChatSystem::HandleStreamData(packets);
+                    RoR::ChatSystem::HandleStreamData(net_packets);
                     if (App::app_state->getEnum<AppState>() == AppState::SIMULATION)
                     {
-                        App::GetGameContext()->GetActorManager()->HandleActorStreamData(packets);
-                        App::GetGameContext()->GetCharacterFactory()->handleStreamData(packets); // Update characters last (or else beam coupling might fail)
+                        App::GetGameContext()->GetActorManager()->HandleActorStreamData(net_packets);
+                        App::GetGameContext()->GetCharacterFactory()->handleStreamData(net_packets); // Update characters last (or else beam coupling might fail)
                     }
                 }
+                App::GetNetwork()->ReleaseIncomingStreamData();
             }
 #endif // USE_SOCKETW
 
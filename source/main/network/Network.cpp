@@ -80,6 +80,10 @@ static Ogre::ColourValue MP_COLORS[] = // Classic RoR multiplayer colors
 using namespace RoRnet;
 
 static const unsigned int m_packet_buffer_size = 20;
+static const size_t NET_SEND_RING_SIZE  = 256;       // Packets; the main thread waits when it's full
+static const int    NET_SEND_WAIT_MS    = 100;       // Longest the main thread waits for room in the send ring before giving up on the connection
+static const size_t NET_RECV_RING_SIZE  = 1024;      // Packets; RecvThread stops reading the socket when it's full
+static const size_t NET_SEND_BATCH_SIZE = 64 * 1024; // Bytes written by SendThread in one go
 
 #define LOG_THREAD(_MSG_) { std::stringstream s; s << _MSG_ << " (Thread ID: " << std::this_thread::get_id() << ")"; LOG(s.str()); }
 #define LOGSTREAM         Ogre::LogManager().getSingleton().stream()
@@ -160,16 +164,6 @@ bool Network::SendNetMessage(int type, unsigned int streamid, int len, char* con
     return SendMessageRaw(buffer, msgsize);
 }
 
-void Network::QueueStreamData(RoRnet::Header &header, char *buffer, size_t buffer_len)
-{
-    NetRecvPacket packet;
-    packet.header = header;
-    memcpy(packet.buffer, buffer, std::min(buffer_len, size_t(RORNET_MAX_MESSAGE_LENGTH)));
-
-    std::lock_guard<std::mutex> lock(m_recv_packetqueue_mutex);
-    m_recv_packet_buffer.push_back(packet);
-}
-
 int Network::ReceiveMessage(RoRnet::Header *head, char* content, int bufferlen)
 {
     SWBaseSocket::SWBaseError error;
@@ -196,13 +190,13 @@ int Network::ReceiveMessage(RoRnet::Header *head, char* content, int bufferlen)
     if (head->size > 0)
     {
         // Read the packet content
-        std::memset(content, 0, bufferlen);
         if (m_socket.frecv(content, head->size, &error) < static_cast<int>(head->size))
         {
             LOG_THREAD("NET receive error 2: "+ error.get_error());
             return -1;
         }
     }
+    std::memset(content + head->size, 0, bufferlen - head->size);
 
 #ifdef DEBUG
     LOG_THREAD("[RoR|Networking] ReceiveMessage() body received");
@@ -214,23 +208,57 @@ int Network::ReceiveMessage(RoRnet::Header *head, char* content, int bufferlen)
 void Network::SendThread()
 {
     LOG("[RoR|Networking] SendThread started");
+    m_send_batch.reserve(NET_SEND_BATCH_SIZE);
     while (!m_shutdown)
     {
-        NetSendPacket packet;
         {
-            std::unique_lock<std::mutex> queue_lock(m_send_packetqueue_mutex);
-            while (m_send_packet_buffer.empty() && !m_shutdown)
+            std::unique_lock<std::mutex> lock(m_send_packet_available_mutex);
+            m_send_thread_waiting = true;
+            std::atomic_thread_fence(std::memory_order_seq_cst); // Pairs with the fence in AddPacket()
+            while (m_send_packet_ring.GetNumAvailable() == 0 && !m_shutdown)
             {
-                m_send_packet_available_cv.wait(queue_lock);
+                m_send_packet_available_cv.wait(lock);
             }
+            m_send_thread_waiting = false;
             if (m_shutdown)
             {
                 break;
             }
-            packet = m_send_packet_buffer.front();
-            m_send_packet_buffer.pop_front();
         }
-        SendMessageRaw(packet.buffer, packet.size);
+
+        // Coalesce everything that's pending into as few writes as possible
+        const size_t num_packets = m_send_packet_ring.GetNumAvailable();
+        for (size_t i = 0; i < num_packets; i++)
+        {
+            const NetSendPacket& packet = m_send_packet_ring.Peek(i);
+            const RoRnet::Header* head = (const RoRnet::Header*)packet.buffer;
+            if (head->command == MSG2_STREAM_DATA_DISCARDABLE)
+            {
+                // Skip outdated discardable streamdata if a newer one is already queued
+                bool outdated = false;
+                for (size_t j = i + 1; j < num_packets && !outdated; j++)
+                {
+                    outdated = !memcmp(packet.buffer, m_send_packet_ring.Peek(j).buffer, sizeof(RoRnet::Header));
+                }
+                if (outdated)
+                {
+                    continue;
+                }
+            }
+            if (m_send_batch.size() + packet.size > NET_SEND_BATCH_SIZE)
+            {
+                SendMessageRaw(m_send_batch.data(), (int)m_send_batch.size());
+                m_send_batch.clear();
+            }
+            m_send_batch.insert(m_send_batch.end(), packet.buffer, packet.buffer + packet.size);
+        }
+        m_send_packet_ring.Pop(num_packets);
+
+        if (!m_send_batch.empty())
+        {
+            SendMessageRaw(m_send_batch.data(), (int)m_send_batch.size());
+            m_send_batch.clear();
+        }
     }
     LOG("[RoR|Networking] SendThread stopped");
 }
@@ -239,12 +267,19 @@ void Network::RecvThread()
 {
     LOG_THREAD("[RoR|Networking] RecvThread starting...");
 
-    RoRnet::Header header;
-
-    char buffer[RORNET_MAX_MESSAGE_LENGTH] = {0};
-
     while (!m_shutdown)
     {
+        // Receive straight into the queue slot; it's only published if the packet is meant for the main thread
+        NetRecvPacket* packet = m_recv_packet_ring.BeginPush();
+        if (packet == nullptr)
+        {
+            // Main thread is lagging behind; let the data wait in the socket
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        RoRnet::Header& header = packet->header;
+        char* buffer = packet->buffer;
+
         int err = ReceiveMessage(&header, buffer, RORNET_MAX_MESSAGE_LENGTH);
         //LOG("Received data: " + TOSTRING(header.command) + ", source: " + TOSTRING(header.source) + ":" + TOSTRING(header.streamid) + ", size: " + TOSTRING(header.size));
         if (err != 0)
@@ -366,7 +401,7 @@ void Network::RecvThread()
         }
         //DebugPacket("recv", &header, buffer);
 
-        QueueStreamData(header, buffer, RORNET_MAX_MESSAGE_LENGTH);
+        m_recv_packet_ring.EndPush();
     }
 
     LOG_THREAD("[RoR|Networking] RecvThread stopped");
@@ -394,6 +429,11 @@ bool Network::StartConnecting()
     m_net_port = App::mp_server_port->getInt();
     m_password = App::mp_server_password->getStr();
 
+    // Packet queues; must be set up before the threads start
+    m_send_packet_ring.Reset(NET_SEND_RING_SIZE);
+    m_recv_packet_ring.Reset(NET_RECV_RING_SIZE);
+    m_recv_num_peeked = 0;
+
     try
     {
         m_connect_thread = std::thread(&Network::ConnectThread, this);
@@ -566,7 +606,10 @@ void Network::Disconnect()
 
     m_shutdown = true; // Instruct Send/Recv threads to shut down.
 
-    m_send_packet_available_cv.notify_one();
+    {
+        std::lock_guard<std::mutex> lock(m_send_packet_available_mutex);
+        m_send_packet_available_cv.notify_one();
+    }
 
     m_send_thread.join();
     LOG("[RoR|Networking] Disconnect() sender thread cleaned up");
@@ -592,8 +635,10 @@ void Network::Disconnect()
 
     m_users.clear();
     m_disconnected_users.clear();
-    m_recv_packet_buffer.clear();
-    m_send_packet_buffer.clear();
+    m_recv_packet_ring.Reset(0);
+    m_send_packet_ring.Reset(0);
+    m_send_stalled = false;
+    m_recv_num_peeked = 0;
     App::GetConsole()->doCommand("clear net");
 
     m_shutdown = false;
@@ -612,12 +657,41 @@ void Network::AddPacket(int streamid, int type, int len, const char *content)
         return;
     }
 
-    NetSendPacket packet;
-    memset(&packet, 0, sizeof(NetSendPacket));
+    if (type == MSG2_STREAM_DATA_DISCARDABLE && m_send_packet_ring.GetNumAvailable() > m_packet_buffer_size)
+    {
+        // buffer full, discard unimportant data packets
+        return;
+    }
+
+    // Write straight into the queue slot
+    NetSendPacket* packet = m_send_packet_ring.BeginPush();
+    if (packet == nullptr && !m_send_stalled && !m_shutdown && App::mp_state->getEnum<MpState>() == MpState::CONNECTED)
+    {
+        // SendThread is busy on the socket; give it a moment rather than dropping important data
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(NET_SEND_WAIT_MS);
+        while (packet == nullptr && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            packet = m_send_packet_ring.BeginPush();
+        }
+        if (packet == nullptr)
+        {
+            // The socket is stalled - don't freeze the game on every further packet, drop the connection
+            m_send_stalled = true;
+            PushNetMessage(MSG_NET_RECV_ERROR, _LC("Network", "Error sending data to network, connection stalled"));
+        }
+    }
+    if (packet == nullptr)
+    {
+        LOGSTREAM << "[RoR|Networking] Discarding network packet (StreamID: "
+            <<streamid<<", Type: "<<type<<"), send queue is full";
+        return;
+    }
 
-    char *buffer = (char*)(packet.buffer);
+    char *buffer = (char*)(packet->buffer);
 
     RoRnet::Header *head = (RoRnet::Header *)buffer;
+    memset(head, 0, sizeof(RoRnet::Header));
     head->command     = type;
     head->source      = m_uid;
     head->size        = len;
@@ -628,32 +702,17 @@ void Network::AddPacket(int streamid, int type, int len, const char *content)
     memcpy(bufferContent, content, len);
 
     // record the packet size
-    packet.size = len + sizeof(RoRnet::Header);
+    packet->size = len + sizeof(RoRnet::Header);
 
-    { // Lock scope
-        std::lock_guard<std::mutex> lock(m_send_packetqueue_mutex);
-        if (type == MSG2_STREAM_DATA_DISCARDABLE)
-        {
-            if (m_send_packet_buffer.size() > m_packet_buffer_size)
-            {
-                // buffer full, discard unimportant data packets
-                return;
-            }
-            auto search = std::find_if(m_send_packet_buffer.begin(), m_send_packet_buffer.end(),
-                    [&](const NetSendPacket& p) { return !memcmp(packet.buffer, p.buffer, sizeof(RoRnet::Header)); });
-            if (search != m_send_packet_buffer.end())
-            {
-                // Found outdated discardable streamdata -> replace it
-                (*search) = packet;
-                m_send_packet_available_cv.notify_one();
-                return;
-            }
-        }
-        //DebugPacket("send", head, buffer);
-        m_send_packet_buffer.push_back(packet);
-    }
+    //DebugPacket("send", head, buffer);
+    m_send_packet_ring.EndPush(); // Outdated discardable packets are skipped by SendThread
 
-    m_send_packet_available_cv.notify_one();
+    std::atomic_thread_fence(std::memory_order_seq_cst); // Pairs with the fence in SendThread()
+    if (m_send_thread_waiting)
+    {
+        std::lock_guard<std::mutex> lock(m_send_packet_available_mutex);
+        m_send_packet_available_cv.notify_one();
+    }
 }
 
 void Network::AddLocalStream(RoRnet::StreamRegister *reg, int size)
@@ -668,12 +727,20 @@ void Network::AddLocalStream(RoRnet::StreamRegister *reg, int size)
     m_stream_id++;
 }
 
-std::vector<NetRecvPacket> Network::GetIncomingStreamData()
+void Network::GetIncomingStreamData(std::vector<NetRecvPacket*>& packets)
+{
+    packets.clear();
+    m_recv_num_peeked = m_recv_packet_ring.GetNumAvailable();
+    for (size_t i = 0; i < m_recv_num_peeked; i++)
+    {
+        packets.push_back(&m_recv_packet_ring.Peek(i));
+    }
+}
+
+void Network::ReleaseIncomingStreamData()
 {
-    std::lock_guard<std::mutex> lock(m_recv_packetqueue_mutex);
-    std::vector<NetRecvPacket> buf_copy = m_recv_packet_buffer;
-    m_recv_packet_buffer.clear();
-    return buf_copy;
+    m_recv_packet_ring.Pop(m_recv_num_peeked);
+    m_recv_num_peeked = 0;
 }
 
 Ogre::String Network::GetTerrainName()
@@ -25,12 +25,12 @@
 
 #include "Application.h"
 #include "RoRnet.h"
+#include "SpscRing.h"
 
 #include <SocketW.h>
 
 #include <atomic>
 #include <condition_variable>
-#include <deque>
 #include <list>
 #include <mutex>
 #include <queue>
@@ -98,10 +98,11 @@ public:
     void                 StopConnecting();
     void                 Disconnect();
 
-    void                 AddPacket(int streamid, int type, int len, const char *content);
+    void                 AddPacket(int streamid, int type, int len, const char *content); //!< Main thread only
     void                 AddLocalStream(RoRnet::StreamRegister *reg, int size);
 
-    std::vector<NetRecvPacket> GetIncomingStreamData();
+    void                 GetIncomingStreamData(std::vector<NetRecvPacket*>& packets); //!< Main thread; packets stay valid until `ReleaseIncomingStreamData()`
+    void                 ReleaseIncomingStreamData();
 
     int                  GetUID();
     int                  GetNetQuality();
@@ -129,7 +130,6 @@ private:
     void                 SetNetQuality(int quality);
     bool                 SendMessageRaw(char *buffer, int msgsize);
     bool                 SendNetMessage(int type, unsigned int streamid, int len, char* content);
-    void                 QueueStreamData(RoRnet::Header &header, char *buffer, size_t buffer_len);
     int                  ReceiveMessage(RoRnet::Header *head, char* content, int bufferlen);
     void                 CouldNotConnect(std::string const & msg, bool close_socket = true);
 
@@ -165,13 +165,16 @@ private:
 
     std::mutex           m_users_mutex;
     std::mutex           m_userdata_mutex;
-    std::mutex           m_recv_packetqueue_mutex;
-    std::mutex           m_send_packetqueue_mutex;
+    std::mutex           m_send_packet_available_mutex; // Only for putting SendThread to sleep, the queues are lock-free
 
     std::condition_variable m_send_packet_available_cv;
+    std::atomic<bool>    m_send_thread_waiting{false};
 
-    std::vector<NetRecvPacket> m_recv_packet_buffer;
-    std::deque <NetSendPacket> m_send_packet_buffer;
+    SpscRing<NetRecvPacket> m_recv_packet_ring;     // RecvThread -> main thread
+    SpscRing<NetSendPacket> m_send_packet_ring;     // main thread -> SendThread
+    size_t               m_recv_num_peeked = 0;     // Packets handed out by `GetIncomingStreamData()`
+    bool                 m_send_stalled = false;    // Main thread; send ring stayed full for NET_SEND_WAIT_MS, disconnect is pending
+    std::vector<char>    m_send_batch;              // SendThread; pending packets coalesced into one write
 };
 
 } // namespace RoR
@@ -0,0 +1,345 @@
+/*
+    This source file is part of Rigs of Rods
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief Encoder/decoder for the bit-packed, keyframe-relative actor node stream (see `RoRnet::NodeStreamHeader`).
+
+#include "NodeStreamCodec.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace RoR;
+
+namespace {
+
+const int WIDTH_BITS = 5; // Per axis and block; widths never exceed 31, see `QUANT_LIMIT`
+
+inline uint32_t ZigZag(int32_t v)
+{
+    return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+inline int32_t UnZigZag(uint32_t u)
+{
+    return static_cast<int32_t>((u >> 1) ^ (0u - (u & 1u)));
+}
+
+inline int BitWidth(uint32_t v)
+{
+    int width = 0;
+    while (v != 0)
+    {
+        ++width;
+        v >>= 1;
+    }
+    return width;
+}
+
+struct BitWriter
+{
+    explicit BitWriter(std::vector<uint8_t>& out): bw_out(out) {}
+
+    void Write(uint32_t value, int num_bits)
+    {
+        bw_acc |= static_cast<uint64_t>(value) << bw_bits;
+        bw_bits += num_bits;
+        while (bw_bits >= 8)
+        {
+            bw_out.push_back(static_cast<uint8_t>(bw_acc));
+            bw_acc >>= 8;
+            bw_bits -= 8;
+        }
+    }
+
+    void Align()
+    {
+        if (bw_bits > 0)
+        {
+            bw_out.push_back(static_cast<uint8_t>(bw_acc));
+        }
+        bw_acc = 0;
+        bw_bits = 0;
+    }
+
+    std::vector<uint8_t>& bw_out;
+    uint64_t              bw_acc = 0;
+    int                   bw_bits = 0;
+};
+
+struct BitReader
+{
+    BitReader(const uint8_t* data, size_t size): br_data(data), br_size(size) {}
+
+    uint32_t Read(int num_bits)
+    {
+        while (br_bits < num_bits)
+        {
+            if (br_pos == br_size)
+            {
+                br_overrun = true;
+                return 0;
+            }
+            br_acc |= static_cast<uint64_t>(br_data[br_pos++]) << br_bits;
+            br_bits += 8;
+        }
+        const uint32_t value = static_cast<uint32_t>(br_acc & ((uint64_t(1) << num_bits) - 1));
+        br_acc >>= num_bits;
+        br_bits -= num_bits;
+        return value;
+    }
+
+    void Align()
+    {
+        br_acc = 0;
+        br_bits = 0;
+    }
+
+    const uint8_t* br_data;
+    size_t         br_size;
+    size_t         br_pos = 0;
+    uint64_t       br_acc = 0;
+    int            br_bits = 0;
+    bool           br_overrun = false;
+};
+
+} // namespace
+
+int32_t NodeStreamCodec::Quantize(float value, float scale)
+{
+    const float q = std::max(-float(QUANT_LIMIT), std::min(float(QUANT_LIMIT), value * scale));
+    return static_cast<int32_t>(q + ((q >= 0.f) ? 0.5f : -0.5f));
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Encoder
+
+void NodeStreamEncoder::Resize(int num_nodes)
+{
+    m_num_nodes = num_nodes;
+    m_input.assign(num_nodes * 3, 0);
+    m_keyframe.assign(num_nodes * 3, 0);
+    m_payload.clear();
+    m_payload.reserve(num_nodes * 3 * sizeof(int32_t) + num_nodes); // Worst case incl. block headers
+    m_chunks.clear();
+    m_has_keyframe = false;
+    m_updates_since_keyframe = 0;
+}
+
+void NodeStreamEncoder::Encode(size_t max_chunk_bytes)
+{
+    m_is_keyframe = !m_has_keyframe || m_updates_since_keyframe >= NodeStreamCodec::KEYFRAME_INTERVAL;
+    if (!m_is_keyframe)
+    {
+        this->Pack(m_keyframe.data(), max_chunk_bytes);
+        m_is_keyframe = (m_payload.size() >= m_keyframe_size); // Moved too far from the keyframe
+    }
+
+    if (m_is_keyframe)
+    {
+        this->Pack(nullptr, max_chunk_bytes);
+        std::copy(m_input.begin(), m_input.end(), m_keyframe.begin());
+        m_keyframe_size = m_payload.size();
+        m_keyframe_id++;
+        m_has_keyframe = true;
+        m_updates_since_keyframe = 0;
+    }
+    else
+    {
+        m_updates_since_keyframe++;
+    }
+}
+
+void NodeStreamEncoder::Pack(const int32_t* reference, size_t max_chunk_bytes)
+{
+    const int B = NodeStreamCodec::BLOCK_NODES;
+
+    m_payload.clear();
+    m_chunks.clear();
+
+    BitWriter writer(m_payload);
+    int32_t prev[3] = {0, 0, 0};
+    uint32_t residuals[3][B];
+    for (int block_first = 0; block_first < m_num_nodes; block_first += B)
+    {
+        const int count = std::min(B, m_num_nodes - block_first);
+        uint32_t combined[3] = {0, 0, 0};
+        for (int i = 0; i < count; ++i)
+        {
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                const int idx = (block_first + i) * 3 + axis;
+                const int32_t value = (reference != nullptr) ? (m_input[idx] - reference[idx]) : m_input[idx];
+                residuals[axis][i] = ZigZag(value - prev[axis]);
+                combined[axis] |= residuals[axis][i];
+                prev[axis] = value;
+            }
+        }
+
+        int width[3];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            width[axis] = BitWidth(combined[axis]);
+        }
+
+        const size_t block_bytes = (WIDTH_BITS * 3 + count * (width[0] + width[1] + width[2]) + 7) / 8;
+        if (m_chunks.empty() || m_chunks.back().size + block_bytes > max_chunk_bytes)
+        {
+            ChunkRange chunk;
+            chunk.first_node = block_first;
+            chunk.num_nodes = 0;
+            chunk.offset = m_payload.size();
+            chunk.size = 0;
+            m_chunks.push_back(chunk);
+        }
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            writer.Write(static_cast<uint32_t>(width[axis]), WIDTH_BITS);
+        }
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (width[axis] == 0)
+                continue;
+            for (int i = 0; i < count; ++i)
+            {
+                writer.Write(residuals[axis][i], width[axis]);
+            }
+        }
+        writer.Align();
+
+        m_chunks.back().num_nodes += count;
+        m_chunks.back().size += block_bytes;
+    }
+}
+
+NodeStreamEncoder::Chunk NodeStreamEncoder::GetChunk(size_t i) const
+{
+    Chunk chunk;
+    chunk.first_node = m_chunks[i].first_node;
+    chunk.num_nodes  = m_chunks[i].num_nodes;
+    chunk.data       = m_payload.data() + m_chunks[i].offset;
+    chunk.size       = m_chunks[i].size;
+    return chunk;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Decoder
+
+void NodeStreamDecoder::Resize(int num_nodes)
+{
+    m_num_nodes = num_nodes;
+    m_output.assign(num_nodes * 3, 0);
+    m_keyframe.assign(num_nodes * 3, 0);
+    m_has_keyframe = false;
+    m_asm_next_node = -1;
+}
+
+NodeStreamDecoder::Result NodeStreamDecoder::DecodeChunk(int32_t time, const RoRnet::NodeStreamHeader& header, const uint8_t* data, size_t size)
+{
+    const int B = NodeStreamCodec::BLOCK_NODES;
+    const int first = header.first_node;
+    const int count = header.num_nodes;
+    const bool is_keyframe = (header.flags & RoRnet::NODESTREAM_KEYFRAME) != 0;
+    const bool is_last = (header.flags & RoRnet::NODESTREAM_LAST_CHUNK) != 0;
+
+    if (header.magic != RORNET_NODESTREAM_MAGIC || count <= 0 || (first % B) != 0 ||
+        first + count > m_num_nodes || (is_last != (first + count == m_num_nodes)) || (!is_last && (count % B) != 0))
+    {
+        m_asm_next_node = -1;
+        return Result::MISMATCH;
+    }
+
+    if (first == 0)
+    {
+        m_asm_time = time;
+        m_asm_keyframe = is_keyframe;
+        m_asm_prev[0] = m_asm_prev[1] = m_asm_prev[2] = 0;
+    }
+    else if (first != m_asm_next_node || time != m_asm_time || is_keyframe != m_asm_keyframe)
+    {
+        m_asm_next_node = -1; // Lost a chunk - wait for the next update
+        return Result::PENDING;
+    }
+
+    if (!is_keyframe && (!m_has_keyframe || header.keyframe_id != m_keyframe_id))
+    {
+        m_asm_next_node = -1; // Missed the keyframe - wait for the next one
+        return Result::PENDING;
+    }
+
+    const int32_t* reference = (is_keyframe) ? nullptr : m_keyframe.data();
+    BitReader reader(data, size);
+    for (int block_first = first; block_first < first + count; block_first += B)
+    {
+        const int block_count = std::min(B, first + count - block_first);
+        int width[3];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            width[axis] = static_cast<int>(reader.Read(WIDTH_BITS));
+        }
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            int32_t value = m_asm_prev[axis];
+            for (int i = 0; i < block_count; ++i)
+            {
+                const int idx = (block_first + i) * 3 + axis;
+                if (width[axis] != 0)
+                {
+                    value += UnZigZag(reader.Read(width[axis]));
+                }
+                m_output[idx] = (reference != nullptr) ? (value + reference[idx]) : value;
+            }
+            m_asm_prev[axis] = value;
+        }
+        reader.Align();
+    }
+
+    if (reader.br_overrun)
+    {
+        m_asm_next_node = -1;
+        return Result::MISMATCH;
+    }
+
+    if (!is_last)
+    {
+        m_asm_next_node = first + count;
+        return Result::PENDING;
+    }
+
+    m_asm_next_node = -1;
+    if (is_keyframe)
+    {
+        std::copy(m_output.begin(), m_output.end(), m_keyframe.begin());
+        m_keyframe_id = header.keyframe_id;
+        m_has_keyframe = true;
+    }
+    return Result::COMPLETE;
+}
+
+bool RoR::IsDiscardableStreamData(const char* data, size_t size)
+{
+    if (size < sizeof(RoRnet::VehicleState) + sizeof(RoRnet::NodeStreamHeader))
+        return true;
+
+    RoRnet::NodeStreamHeader header;
+    std::memcpy(&header, data + sizeof(RoRnet::VehicleState), sizeof(RoRnet::NodeStreamHeader));
+    if (header.magic != RORNET_NODESTREAM_MAGIC)
+        return true;
+
+    return !(header.flags & RoRnet::NODESTREAM_KEYFRAME) && (header.first_node == 0) && (header.flags & RoRnet::NODESTREAM_LAST_CHUNK);
+}
@@ -0,0 +1,121 @@
+/*
+    This source file is part of Rigs of Rods
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief Bit-packed, keyframe-relative encoding of actor node positions for network streams.
+
+#pragma once
+
+#include "RoRnet.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace RoR {
+
+/// Node positions travel as integers: offset from node 0, multiplied by `Actor::m_net_node_compression`.
+///
+/// Nodes are packed in blocks of `BLOCK_NODES`. Each value is predicted from the previous node
+/// (and, for delta updates, from the keyframe), zigzag-encoded and stored with the smallest bit width
+/// which fits the whole block. A resting actor costs 2 bytes per block, a rigidly moving one a few bits per node.
+/// Updates larger than one packet are split into chunks at block boundaries, see `RoRnet::NodeStreamHeader`.
+struct NodeStreamCodec
+{
+    static const int     BLOCK_NODES = 16;
+    static const int     KEYFRAME_INTERVAL = 10;        //!< Updates; a late joiner waits at most this long
+    static const int32_t QUANT_LIMIT = (1 << 28) - 1;   //!< Keeps the residuals within 31 bits
+
+    static int32_t Quantize(float value, float scale);
+};
+
+class NodeStreamEncoder
+{
+public:
+    struct Chunk
+    {
+        int            first_node;
+        int            num_nodes;
+        const uint8_t* data;
+        size_t         size;
+    };
+
+    void     Resize(int num_nodes);
+    int32_t* GetInput() { return m_input.data(); }   //!< Fill with 3 quantized values (x,y,z) per node, then call `Encode()`
+
+    /// Encodes `GetInput()`; switches to a keyframe periodically or when a delta would not be smaller.
+    void     Encode(size_t max_chunk_bytes);
+
+    bool     IsKeyframe() const                      { return m_is_keyframe; }
+    uint8_t  GetKeyframeId() const                   { return m_keyframe_id; }
+    size_t   GetNumChunks() const                    { return m_chunks.size(); }
+    Chunk    GetChunk(size_t i) const;
+    size_t   GetPayloadSize() const                  { return m_payload.size(); }
+
+private:
+    void     Pack(const int32_t* reference, size_t max_chunk_bytes);
+
+    struct ChunkRange { int first_node; int num_nodes; size_t offset; size_t size; };
+
+    int                     m_num_nodes = 0;
+    std::vector<int32_t>    m_input;
+    std::vector<int32_t>    m_keyframe;           //!< Quantized positions of the last keyframe
+    std::vector<uint8_t>    m_payload;
+    std::vector<ChunkRange> m_chunks;
+    size_t                  m_keyframe_size = 0;  //!< Payload bytes of the last keyframe
+    int                     m_updates_since_keyframe = 0;
+    uint8_t                 m_keyframe_id = 0;
+    bool                    m_has_keyframe = false;
+    bool                    m_is_keyframe = false;
+};
+
+class NodeStreamDecoder
+{
+public:
+    enum class Result
+    {
+        PENDING,   //!< Chunk accepted (or skipped) but no complete update yet
+        COMPLETE,  //!< `GetOutput()` holds a complete update
+        MISMATCH   //!< Stream doesn't fit this actor
+    };
+
+    void           Resize(int num_nodes);
+
+    /// @param time  `VehicleState::time` of the packet; chunks of one update share it.
+    Result         DecodeChunk(int32_t time, const RoRnet::NodeStreamHeader& header, const uint8_t* data, size_t size);
+
+    const int32_t* GetOutput() const { return m_output.data(); } //!< 3 quantized values (x,y,z) per node
+
+private:
+    int                     m_num_nodes = 0;
+    std::vector<int32_t>    m_output;
+    std::vector<int32_t>    m_keyframe;
+    uint8_t                 m_keyframe_id = 0;
+    bool                    m_has_keyframe = false;
+
+    // Update being assembled
+    int32_t                 m_asm_time = 0;
+    int                     m_asm_next_node = -1;  //!< -1 = no update in progress
+    int32_t                 m_asm_prev[3] = {};    //!< Predictor carried across chunks
+    bool                    m_asm_keyframe = false;
+};
+
+/// False for node stream chunks the receiver must not drop (keyframes and parts of multi-packet updates);
+/// true for single-packet deltas and anything which isn't node stream data.
+bool IsDiscardableStreamData(const char* data, size_t size);
+
+} // namespace RoR
@@ -28,7 +28,12 @@ namespace RoRnet {
 #define RORNET_LAN_BROADCAST_PORT   13000  //!< port used to send the broadcast announcement in LAN mode
 #define RORNET_MAX_USERNAME_LEN     40     //!< port used to send the broadcast announcement in LAN mode
 
-#define RORNET_VERSION              "RoRnet_2.43"
+// 2.44: actor stream data uses the RORNET_NODESTREAM_VERSION layout, the legacy layout (node 0 as floats, then 3 shorts
+//       per node) is gone. Servers relay stream data as-is, they only need to be rebuilt with the new version string.
+#define RORNET_VERSION              "RoRnet_2.44"
+
+#define RORNET_NODESTREAM_VERSION   1      //!< Actor stream data layout, announced in `ActorStreamRegister::bufferSize`
+#define RORNET_NODESTREAM_MAGIC     0xB7   //!< First byte of `NodeStreamHeader`
 
 enum MessageType
 {
@@ -111,6 +116,12 @@ enum Netmask
     NETMASK_ENGINE_MODE_MANUAL_RANGES = BITMASK(30)  //!< engine mode
 };
 
+enum NodeStreamFlags
+{
+    NODESTREAM_KEYFRAME   = BITMASK(1), //!< Positions relative to node 0 only; otherwise relative to keyframe `keyframe_id`
+    NODESTREAM_LAST_CHUNK = BITMASK(2)  //!< Completes the update; wheel data follows the node data
+};
+
 // -------------------------------- structs -----------------------------------
 // Only use datatypes with defined binary sizes (avoid bool, int, wchar_t...)
 // Prefer alignment to 4 or 2 bytes (put int32/float/etc. fields on top)
@@ -142,7 +153,7 @@ struct ActorStreamRegister
     int32_t origin_sourceid;       //!< origin sourceid
     int32_t origin_streamid;       //!< origin streamid
     char    name[128];             //!< filename
-    int32_t bufferSize;            //!< initial stream status
+    int32_t bufferSize;            //!< stream data layout: RORNET_NODESTREAM_VERSION
     int32_t time;                  //!< initial time stamp
     char    skin[60];              //!< skin
     char    sectionconfig[60];     //!< section configuration
@@ -184,6 +195,17 @@ struct VehicleState                  //!< Formerly `oob_t`
     uint32_t flagmask;             //!< flagmask: NETMASK_*
 };
 
+struct NodeStreamHeader              //!< Follows `VehicleState` in actor stream data (RORNET_NODESTREAM_VERSION)
+{
+    float    refpos[3];            //!< absolute position of node 0
+    uint16_t first_node;           //!< first node in this chunk, multiple of the codec block size
+    uint16_t num_nodes;            //!< number of nodes in this chunk
+    uint8_t  magic;                //!< RORNET_NODESTREAM_MAGIC
+    uint8_t  flags;                //!< NODESTREAM_*
+    uint8_t  keyframe_id;          //!< keyframe this chunk belongs or refers to
+    uint8_t  reserved;
+};
+
 struct ServerInfo
 {
     char    protocolversion[20];   //!< protocol version being used
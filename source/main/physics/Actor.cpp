@@ -29,6 +29,7 @@
 #include "ActorManager.h"
 #include "Buoyance.h"
 #include "CacheSystem.h"
+#include "CameraManager.h"
 #include "ChatSystem.h"
 #include "CmdKeyInertia.h"
 #include "Collisions.h"
@@ -337,35 +338,56 @@ Vector3 Actor::getPosition()
 
 void Actor::pushNetwork(char* data, int size)
 {
-    NetUpdate update;
+    if (m_net_updates.empty())
+        return; // Not a remote actor
 
-    update.veh_state.resize(sizeof(RoRnet::VehicleState));
-    update.node_data.resize(m_net_node_buf_size);
-    update.wheel_data.resize(ar_num_wheels * sizeof(float));
+    // Decode straight into the next ring slot; it only becomes visible once complete.
+    NetUpdate& update = this->GetNetUpdate(m_net_updates_count); // The oldest one if full
+    bool valid = false;
 
-    // check if the size of the data matches to what we expected
-    if ((unsigned int)size == (m_net_buffer_size + sizeof(RoRnet::VehicleState)))
+    if ((size_t)size >= sizeof(RoRnet::VehicleState) + sizeof(RoRnet::NodeStreamHeader))
     {
-        // we walk through the incoming data and separate it a bit
-        char* ptr = data;
+        RoRnet::NodeStreamHeader header;
+        memcpy(&header, data + sizeof(RoRnet::VehicleState), sizeof(RoRnet::NodeStreamHeader));
+        const bool is_last = (header.flags & RoRnet::NODESTREAM_LAST_CHUNK) != 0;
+        const size_t wheel_bytes = (is_last) ? (ar_num_wheels * sizeof(float)) : 0;
+        const size_t header_bytes = sizeof(RoRnet::VehicleState) + sizeof(RoRnet::NodeStreamHeader);
+        if ((size_t)size >= header_bytes + wheel_bytes)
+        {
+            RoRnet::VehicleState veh_state;
+            memcpy(&veh_state, data, sizeof(RoRnet::VehicleState));
+            const uint8_t* payload = (const uint8_t*)(data + header_bytes);
+            const size_t payload_size = size - header_bytes - wheel_bytes;
 
-        // put the RoRnet::VehicleState in front, describes actor basics, engine state, flares, etc
-        memcpy(update.veh_state.data(), ptr, sizeof(RoRnet::VehicleState));
-        ptr += sizeof(RoRnet::VehicleState);
+            switch (m_net_node_decoder.DecodeChunk(veh_state.time, header, payload, payload_size))
+            {
+            case NodeStreamDecoder::Result::PENDING:
+                return; // Wait for the remaining chunks or the next keyframe
 
-        // then copy the node data
-        memcpy(update.node_data.data(), ptr, m_net_node_buf_size);
-        ptr += m_net_node_buf_size;
+            case NodeStreamDecoder::Result::COMPLETE:
+            {
+                update.veh_state = veh_state;
+                const Vector3 refpos(header.refpos[0], header.refpos[1], header.refpos[2]);
+                const int32_t* quantized = m_net_node_decoder.GetOutput();
+                const float inv_compression = 1.f / m_net_node_compression;
+                for (int i = 0; i < m_net_first_wheel_node; i++)
+                {
+                    update.node_pos[i].x = refpos.x + quantized[i * 3 + 0] * inv_compression;
+                    update.node_pos[i].y = refpos.y + quantized[i * 3 + 1] * inv_compression;
+                    update.node_pos[i].z = refpos.z + quantized[i * 3 + 2] * inv_compression;
+                }
+                memcpy(update.wheel_data.data(), payload + payload_size, wheel_bytes);
+                valid = true;
+                break;
+            }
 
-        // then take care of the wheel speeds
-        for (int i = 0; i < ar_num_wheels; i++)
-        {
-            float wspeed = *(float*)(ptr);
-            update.wheel_data[i] = wspeed;
-            ptr += sizeof(float);
+            case NodeStreamDecoder::Result::MISMATCH:
+                break;
+            }
         }
     }
-    else
+
+    if (!valid)
     {
         if (!m_net_initialized)
         {
@@ -399,7 +421,7 @@ void Actor::pushNetwork(char* data, int size)
     // Required to catch up when joining late (since the StreamRegister time stamp is received delayed)
     if (!m_net_initialized)
     {
-        RoRnet::VehicleState* oob = (RoRnet::VehicleState*)update.veh_state.data();
+        const RoRnet::VehicleState* oob = &update.veh_state;
         int tnow = App::GetGameContext()->GetActorManager()->GetNetTime();
         int rnow = std::max(0, tnow + App::GetGameContext()->GetActorManager()->GetNetTimeOffset(ar_net_source_id));
         if (oob->time > rnow + 100)
@@ -408,129 +430,101 @@ void Actor::pushNetwork(char* data, int size)
         }
     }
 
-    m_net_updates.push_back(update);
+    if (m_net_updates_count == NET_UPDATE_RING_SIZE)
+    {
+        m_net_updates_begin = (m_net_updates_begin + 1) % NET_UPDATE_RING_SIZE; // Overwrote the oldest
+    }
+    else
+    {
+        m_net_updates_count++;
+    }
 }
 
 void Actor::calcNetwork()
 {
     using namespace RoRnet;
 
-    if (m_net_updates.size() < 2)
+    if (m_net_updates_count < 2)
         return;
 
     int tnow = App::GetGameContext()->GetActorManager()->GetNetTime();
     int rnow = std::max(0, tnow + App::GetGameContext()->GetActorManager()->GetNetTimeOffset(ar_net_source_id));
 
-    // Find index offset into the stream data for the current time
-    int index_offset = 0;
-    for (int i = 0; i < m_net_updates.size() - 1; i++)
+    // Find index offset into the stream data for the current time:
+    // the last update not newer than `rnow`, excluding the newest one (updates arrive in time order)
+    int lo = 0;
+    int hi = (int)m_net_updates_count - 1;
+    while (lo < hi)
     {
-        VehicleState* oob = (VehicleState*)m_net_updates[i].veh_state.data();
-        if (oob->time > rnow)
-            break;
-        index_offset = i;
+        int mid = (lo + hi) / 2;
+        if (this->GetNetUpdate(mid).veh_state.time > rnow)
+            hi = mid;
+        else
+            lo = mid + 1;
     }
+    int index_offset = std::max(0, lo - 1);
 
-    VehicleState* oob1 = (VehicleState*)m_net_updates[index_offset    ].veh_state.data();
-    VehicleState* oob2 = (VehicleState*)m_net_updates[index_offset + 1].veh_state.data();
-    char*        netb1 = (char*)        m_net_updates[index_offset    ].node_data.data();
-    char*        netb2 = (char*)        m_net_updates[index_offset + 1].node_data.data();
-    float*     net_rp1 = (float*)       m_net_updates[index_offset    ].wheel_data.data();
-    float*     net_rp2 = (float*)       m_net_updates[index_offset + 1].wheel_data.data();
+    NetUpdate&      update1 = this->GetNetUpdate(index_offset);
+    NetUpdate&      update2 = this->GetNetUpdate(index_offset + 1);
+    VehicleState*      oob1 = &update1.veh_state;
+    VehicleState*      oob2 = &update2.veh_state;
+    const float*    net_rp1 = update1.wheel_data.data();
+    const float*    net_rp2 = update2.wheel_data.data();
 
     float tratio = (float)(rnow - oob1->time) / (float)(oob2->time - oob1->time);
 
     if (tratio > 4.0f)
     {
-        m_net_updates.clear();
+        m_net_updates_count = 0;
         return; // Wait for new data
     }
     else if (tratio > 1.0f)
     {
         App::GetGameContext()->GetActorManager()->UpdateNetTimeOffset(ar_net_source_id, -std::pow(2, tratio));
     }
-    else if (index_offset == 0 && (m_net_updates.size() > 5 || (tratio < 0.125f && m_net_updates.size() > 2)))
+    else if (index_offset == 0 && (m_net_updates_count > 5 || (tratio < 0.125f && m_net_updates_count > 2)))
     {
         App::GetGameContext()->GetActorManager()->UpdateNetTimeOffset(ar_net_source_id, +1);
     }
 
-    short* sp1 = (short*)(netb1 + sizeof(float) * 3);
-    short* sp2 = (short*)(netb2 + sizeof(float) * 3);
-    Vector3 p1ref = Vector3::ZERO;
-    Vector3 p2ref = Vector3::ZERO;
-    Vector3 p1 = Vector3::ZERO;
-    Vector3 p2 = Vector3::ZERO;
-
-    for (int i = 0; i < m_net_first_wheel_node; i++)
+    // Wheels the player can't make out are not rebuilt, they just follow their axle
+    const bool rebuild_wheels = this->IsNetworkWheelDetailVisible();
+    if (!rebuild_wheels)
     {
-        if (i == 0)
-        {
-            // first node is uncompressed
-            p1.x = ((float*)netb1)[0];
-            p1.y = ((float*)netb1)[1];
-            p1.z = ((float*)netb1)[2];
-            p1ref = p1;
-
-            p2.x = ((float*)netb2)[0];
-            p2.y = ((float*)netb2)[1];
-            p2.z = ((float*)netb2)[2];
-            p2ref = p2;
-        }
-        else
+        for (int i = 0; i < ar_num_wheels; i++)
         {
-            // all other nodes are compressed:
-            // short int compared to previous node
-            p1.x = (float)(sp1[(i - 1) * 3 + 0]) / m_net_node_compression;
-            p1.y = (float)(sp1[(i - 1) * 3 + 1]) / m_net_node_compression;
-            p1.z = (float)(sp1[(i - 1) * 3 + 2]) / m_net_node_compression;
-            p1 = p1 + p1ref;
-
-            p2.x = (float)(sp2[(i - 1) * 3 + 0]) / m_net_node_compression;
-            p2.y = (float)(sp2[(i - 1) * 3 + 1]) / m_net_node_compression;
-            p2.z = (float)(sp2[(i - 1) * 3 + 2]) / m_net_node_compression;
-            p2 = p2 + p2ref;
+            const int axle = ar_wheels[i].wh_axis_node_0->pos;
+            const Vector3& p1 = update1.node_pos[axle];
+            const Vector3& p2 = update2.node_pos[axle];
+            const Vector3 delta = p1 + tratio * (p2 - p1) - ar_wheels[i].wh_axis_node_0->AbsPosition;
+            for (int j = 0; j < ar_wheels[i].wh_num_nodes; j++)
+            {
+                ar_wheels[i].wh_nodes[j]->AbsPosition += delta;
+                ar_wheels[i].wh_nodes[j]->RelPosition = ar_wheels[i].wh_nodes[j]->AbsPosition - ar_origin;
+            }
+            for (int j = 0; j < ar_wheels[i].wh_num_rim_nodes; j++)
+            {
+                ar_wheels[i].wh_rim_nodes[j]->AbsPosition += delta;
+                ar_wheels[i].wh_rim_nodes[j]->RelPosition = ar_wheels[i].wh_rim_nodes[j]->AbsPosition - ar_origin;
+            }
         }
+    }
+
+    const float inv_dt = 1000.0f / (float)(oob2->time - oob1->time);
+    for (int i = 0; i < m_net_first_wheel_node; i++)
+    {
+        const Vector3& p1 = update1.node_pos[i];
+        const Vector3& p2 = update2.node_pos[i];
 
         // linear interpolation
         ar_nodes[i].AbsPosition = p1 + tratio * (p2 - p1);
         ar_nodes[i].RelPosition = ar_nodes[i].AbsPosition - ar_origin;
-        ar_nodes[i].Velocity    = (p2 - p1) * 1000.0f / (float)(oob2->time - oob1->time);
+        ar_nodes[i].Velocity    = (p2 - p1) * inv_dt;
     }
 
-    for (int i = 0; i < ar_num_wheels; i++)
+    if (rebuild_wheels)
     {
-        float rp = net_rp1[i] + tratio * (net_rp2[i] - net_rp1[i]);
-        //compute ideal positions
-        Vector3 axis = ar_wheels[i].wh_axis_node_1->RelPosition - ar_wheels[i].wh_axis_node_0->RelPosition;
-        axis.normalise();
-        Plane pplan = Plane(axis, ar_wheels[i].wh_axis_node_0->AbsPosition);
-        Vector3 ortho = -pplan.projectVector(ar_wheels[i].wh_near_attach_node->AbsPosition) - ar_wheels[i].wh_axis_node_0->AbsPosition;
-        Vector3 ray = ortho.crossProduct(axis);
-        ray.normalise();
-        ray *= ar_wheels[i].wh_radius;
-        float drp = Math::TWO_PI / (ar_wheels[i].wh_num_nodes / 2);
-        for (int j = 0; j < ar_wheels[i].wh_num_nodes / 2; j++)
-        {
-            Vector3 uray = Quaternion(Radian(rp - drp * j), axis) * ray;
-
-            ar_wheels[i].wh_nodes[j * 2 + 0]->AbsPosition = ar_wheels[i].wh_axis_node_0->AbsPosition + uray;
-            ar_wheels[i].wh_nodes[j * 2 + 0]->RelPosition = ar_wheels[i].wh_nodes[j * 2]->AbsPosition - ar_origin;
-
-            ar_wheels[i].wh_nodes[j * 2 + 1]->AbsPosition = ar_wheels[i].wh_axis_node_1->AbsPosition + uray;
-            ar_wheels[i].wh_nodes[j * 2 + 1]->RelPosition = ar_wheels[i].wh_nodes[j * 2 + 1]->AbsPosition - ar_origin;
-        }
-        ray.normalise();
-        ray *= ar_wheels[i].wh_rim_radius;
-        for (int j = 0; j < ar_wheels[i].wh_num_rim_nodes / 2; j++)
-        {
-            Vector3 uray = Quaternion(Radian(rp - drp * j), axis) * ray;
-
-            ar_wheels[i].wh_rim_nodes[j * 2 + 0]->AbsPosition = ar_wheels[i].wh_axis_node_0->AbsPosition + uray;
-            ar_wheels[i].wh_rim_nodes[j * 2 + 0]->RelPosition = ar_wheels[i].wh_rim_nodes[j * 2]->AbsPosition - ar_origin;
-
-            ar_wheels[i].wh_rim_nodes[j * 2 + 1]->AbsPosition = ar_wheels[i].wh_axis_node_1->AbsPosition + uray;
-            ar_wheels[i].wh_rim_nodes[j * 2 + 1]->RelPosition = ar_wheels[i].wh_rim_nodes[j * 2 + 1]->AbsPosition - ar_origin;
-        }
+        this->CalcNetworkWheels(tratio, net_rp1, net_rp2);
     }
     this->UpdateBoundingBoxes();
     this->calculateAveragePosition();
@@ -624,14 +618,80 @@ void Actor::calcNetwork()
     else
         SOUND_STOP(ar_instance_id, SS_TRIG_REVERSE_GEAR);
 
-    for (int i = 0; i < index_offset; i++)
-    {
-        m_net_updates.pop_front();
-    }
+    m_net_updates_begin = (m_net_updates_begin + index_offset) % NET_UPDATE_RING_SIZE;
+    m_net_updates_count -= index_offset;
 
     m_net_initialized = true;
 }
 
+bool Actor::IsNetworkWheelDetailVisible()
+{
+    const int range = App::mp_wheel_update_range->getInt();
+    if (range <= 0)
+        return true;
+
+    Ogre::Camera* camera = App::GetCameraManager()->GetCamera();
+    if (!camera->isVisible(ar_bounding_box))
+        return false;
+
+    return m_avg_node_position.squaredDistance(camera->getDerivedPosition()) < (float)(range * range);
+}
+
+void Actor::CalcNetworkWheels(float tratio, const float* rp1, const float* rp2)
+{
+    for (int i = 0; i < ar_num_wheels; i++)
+    {
+        wheel_t& wheel = ar_wheels[i];
+        const Vector3& axis_pos_0 = wheel.wh_axis_node_0->AbsPosition;
+        const Vector3& axis_pos_1 = wheel.wh_axis_node_1->AbsPosition;
+
+        //compute ideal positions
+        Vector3 axis = wheel.wh_axis_node_1->RelPosition - wheel.wh_axis_node_0->RelPosition;
+        axis.normalise();
+        Plane pplan = Plane(axis, axis_pos_0);
+        Vector3 ortho = -pplan.projectVector(wheel.wh_near_attach_node->AbsPosition) - axis_pos_0;
+        Vector3 ray = ortho.crossProduct(axis);
+        ray.normalise();
+
+        // `ray` is perpendicular to `axis`, so rotating it by `a` around the axis is `ray*cos(a) + (axis x ray)*sin(a)`.
+        // The angle steps by a constant `-drp` per node pair, so sin/cos advance by a 2D rotation instead of a Quaternion per node.
+        const Vector3 bitangent = axis.crossProduct(ray);
+        const float rp = rp1[i] + tratio * (rp2[i] - rp1[i]);
+        const int num_pairs = std::max(wheel.wh_num_nodes, wheel.wh_num_rim_nodes) / 2;
+        const float drp = Math::TWO_PI / (wheel.wh_num_nodes / 2);
+        const float step_cos = std::cos(drp);
+        const float step_sin = std::sin(drp);
+        float cos_a = std::cos(rp);
+        float sin_a = std::sin(rp);
+        for (int j = 0; j < num_pairs; j++)
+        {
+            const Vector3 dir = ray * cos_a + bitangent * sin_a;
+
+            if (j < wheel.wh_num_nodes / 2)
+            {
+                const Vector3 uray = dir * wheel.wh_radius;
+                wheel.wh_nodes[j * 2 + 0]->AbsPosition = axis_pos_0 + uray;
+                wheel.wh_nodes[j * 2 + 0]->RelPosition = wheel.wh_nodes[j * 2 + 0]->AbsPosition - ar_origin;
+                wheel.wh_nodes[j * 2 + 1]->AbsPosition = axis_pos_1 + uray;
+                wheel.wh_nodes[j * 2 + 1]->RelPosition = wheel.wh_nodes[j * 2 + 1]->AbsPosition - ar_origin;
+            }
+            if (j < wheel.wh_num_rim_nodes / 2)
+            {
+                const Vector3 uray = dir * wheel.wh_rim_radius;
+                wheel.wh_rim_nodes[j * 2 + 0]->AbsPosition = axis_pos_0 + uray;
+                wheel.wh_rim_nodes[j * 2 + 0]->RelPosition = wheel.wh_rim_nodes[j * 2 + 0]->AbsPosition - ar_origin;
+                wheel.wh_rim_nodes[j * 2 + 1]->AbsPosition = axis_pos_1 + uray;
+                wheel.wh_rim_nodes[j * 2 + 1]->RelPosition = wheel.wh_rim_nodes[j * 2 + 1]->AbsPosition - ar_origin;
+            }
+
+            // Advance the angle by -drp
+            const float next_cos = cos_a * step_cos + sin_a * step_sin;
+            sin_a = sin_a * step_cos - cos_a * step_sin;
+            cos_a = next_cos;
+        }
+    }
+}
+
 void Actor::RecalculateNodeMasses(Real total)
 {
     //reset
@@ -1875,6 +1935,7 @@ void Actor::sendStreamSetup()
         strncpy(reg.skin, m_used_skin_entry->dname.c_str(), 60);
     }
     strncpy(reg.sectionconfig, m_section_config.c_str(), 60);
+    reg.bufferSize = RORNET_NODESTREAM_VERSION;
 
 #ifdef USE_SOCKETW
     App::GetNetwork()->AddLocalStream((RoRnet::StreamRegister *)&reg, sizeof(RoRnet::ActorStreamRegister));
@@ -1893,21 +1954,11 @@ void Actor::sendStreamData()
 
     ar_net_last_update_time = ar_net_timer.getMilliseconds();
 
-    //look if the packet is too big first
-    if (m_net_buffer_size + sizeof(RoRnet::VehicleState) > 8192)
-    {
-        ErrorUtils::ShowError(_L("Actor is too big to be sent over the net."), _L("Network error!"));
-        exit(126);
-    }
-
-    char send_buffer[8192] = {0};
-
-    unsigned int packet_len = 0;
+    char send_buffer[RORNET_MAX_MESSAGE_LENGTH - sizeof(RoRnet::Header)] = {0};
 
     // RoRnet::VehicleState is at the beginning of the buffer
     {
         RoRnet::VehicleState* send_oob = (RoRnet::VehicleState *)send_buffer;
-        packet_len += sizeof(RoRnet::VehicleState);
 
         send_oob->flagmask = 0;
 
@@ -1999,44 +2050,61 @@ void Actor::sendStreamData()
             send_oob->flagmask += NETMASK_HORN;
     }
 
-    // then process the contents
+    // then the node positions, relative to node 0
+    const Vector3 refpos = ar_nodes[0].AbsPosition;
+    int32_t* quantized = m_net_node_encoder.GetInput();
+    for (int i = 0; i < m_net_first_wheel_node; i++)
     {
-        char* ptr = send_buffer + sizeof(RoRnet::VehicleState);
-        float* send_nodes = (float *)ptr;
-        packet_len += m_net_buffer_size;
-
-        // copy data into the buffer
-        int i;
-
-        // reference node first
-        Vector3& refpos = ar_nodes[0].AbsPosition;
-        send_nodes[0] = refpos.x;
-        send_nodes[1] = refpos.y;
-        send_nodes[2] = refpos.z;
+        const Vector3 relpos = ar_nodes[i].AbsPosition - refpos;
+        quantized[i * 3 + 0] = NodeStreamCodec::Quantize(relpos.x, m_net_node_compression);
+        quantized[i * 3 + 1] = NodeStreamCodec::Quantize(relpos.y, m_net_node_compression);
+        quantized[i * 3 + 2] = NodeStreamCodec::Quantize(relpos.z, m_net_node_compression);
+    }
+
+    const size_t wheel_bytes = ar_num_wheels * sizeof(float);
+    const size_t header_bytes = sizeof(RoRnet::VehicleState) + sizeof(NodeStreamHeader);
+    m_net_node_encoder.Encode(sizeof(send_buffer) - header_bytes - wheel_bytes);
+
+    // Big actors are split into several packets; the receiver re-assembles them by time stamp
+    const size_t num_chunks = m_net_node_encoder.GetNumChunks();
+    for (size_t c = 0; c < num_chunks; c++)
+    {
+        const NodeStreamEncoder::Chunk chunk = m_net_node_encoder.GetChunk(c);
+        const bool is_last = (c + 1 == num_chunks);
+
+        NodeStreamHeader header;
+        memset(&header, 0, sizeof(NodeStreamHeader));
+        header.refpos[0]   = refpos.x;
+        header.refpos[1]   = refpos.y;
+        header.refpos[2]   = refpos.z;
+        header.first_node  = static_cast<uint16_t>(chunk.first_node);
+        header.num_nodes   = static_cast<uint16_t>(chunk.num_nodes);
+        header.magic       = RORNET_NODESTREAM_MAGIC;
+        header.keyframe_id = m_net_node_encoder.GetKeyframeId();
+        if (m_net_node_encoder.IsKeyframe())
+            header.flags |= NODESTREAM_KEYFRAME;
+        if (is_last)
+            header.flags |= NODESTREAM_LAST_CHUNK;
 
-        ptr += sizeof(float) * 3;// plus 3 floats from above
-
-        // then copy the other nodes into a compressed short format
-        short* sbuf = (short*)ptr;
-        for (i = 1; i < m_net_first_wheel_node; i++)
+        char* ptr = send_buffer + sizeof(RoRnet::VehicleState);
+        memcpy(ptr, &header, sizeof(NodeStreamHeader));
+        ptr += sizeof(NodeStreamHeader);
+        memcpy(ptr, chunk.data, chunk.size);
+        ptr += chunk.size;
+        if (is_last)
         {
-            Vector3 relpos = ar_nodes[i].AbsPosition - refpos;
-            sbuf[(i - 1) * 3 + 0] = (short int)(relpos.x * m_net_node_compression);
-            sbuf[(i - 1) * 3 + 1] = (short int)(relpos.y * m_net_node_compression);
-            sbuf[(i - 1) * 3 + 2] = (short int)(relpos.z * m_net_node_compression);
-
-            ptr += sizeof(short int) * 3; // increase pointer
+            // then the wheels
+            for (int i = 0; i < ar_num_wheels; i++)
+            {
+                memcpy(ptr, &ar_wheels[i].wh_net_rp, sizeof(float));
+                ptr += sizeof(float);
+            }
         }
 
-        // then to the wheels
-        float* wfbuf = (float*)ptr;
-        for (i = 0; i < ar_num_wheels; i++)
-        {
-            wfbuf[i] = ar_wheels[i].wh_net_rp;
-        }
+        // Keyframes and split updates must arrive complete, only a standalone delta may be superseded in the queue
+        const int type = (m_net_node_encoder.IsKeyframe() || num_chunks > 1) ? MSG2_STREAM_DATA : MSG2_STREAM_DATA_DISCARDABLE;
+        App::GetNetwork()->AddPacket(ar_net_stream_id, type, (int)(ptr - send_buffer), send_buffer);
     }
-
-    App::GetNetwork()->AddPacket(ar_net_stream_id, MSG2_STREAM_DATA_DISCARDABLE, packet_len, send_buffer);
 #endif //SOCKETW
 }
 
@@ -4438,6 +4506,8 @@ Actor::Actor(
     , ar_driveable(NOT_DRIVEABLE)
     , m_skid_trails{} // Init array to nullptr
     , ar_collision_range(DEFAULT_COLLISION_RANGE)
+    , ar_physics_rng(static_cast<uint32_t>(actor_id))
+    , ar_props_rng(static_cast<uint32_t>(actor_id) ^ 0x9E3779B9u)
     , ar_instance_id(actor_id)
     , ar_vector_index(vector_index)
     , ar_rescuer_flag(false)
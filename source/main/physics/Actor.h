@@ -22,9 +22,12 @@
 #pragma once
 
 #include "Application.h"
+#include "ApproxMath.h"
 #include "CmdKeyInertia.h"
+#include "Collisions.h"
 #include "Differentials.h"
 #include "GfxActor.h"
+#include "NodeStreamCodec.h"
 #include "PerVehicleCameraContext.h"
 #include "RigDef_Prerequisites.h"
 #include "SimData.h"
@@ -357,6 +360,8 @@ public:
     float             ar_collision_range;             //!< Physics attr
     float             ar_top_speed;                   //!< Sim state
     ground_model_t*   ar_last_fuzzy_ground_model;     //!< GUI state
+    RandomStream      ar_physics_rng;                 //!< Physics state; per-actor random numbers (turbulent drag, engine anti-lag, ...), seeded by instance ID
+    RandomStream      ar_props_rng;                   //!< Gfx state; random numbers for prop setup (beacon phases), kept apart so props don't shift `ar_physics_rng`
 
     // Gameplay state
     ActorState        ar_state;
@@ -411,6 +416,7 @@ private:
     void              CalcHydros();                        
     void              CalcMouse();                         
     void              CalcNodes();                         
+    void              CalcNodesWater(IWater* water);       //!< CalcNodes() helper; one batched wave evaluation for all nodes
     void              CalcReplay();                        
     void              CalcRopes();                         
     void              CalcShocks(bool doUpdate, int num_steps); 
@@ -420,6 +426,8 @@ private:
     void              CalcTies();                          
     void              CalcTruckEngine(bool doUpdate);      
     void              CalcWheels(bool doUpdate, int num_steps); 
+    void              CalcNetworkWheels(float tratio, const float* rp1, const float* rp2); //!< calcNetwork() helper; rebuilds wheel nodes around the axles
+    bool              IsNetworkWheelDetailVisible();       //!< calcNetwork() helper; false if the actor is out of view or beyond 'mp_wheel_update_range'
 
     void              DetermineLinkedActors();
     void              RecalculateNodeMasses(Ogre::Real total); //!< Previously 'calc_masses2()'
@@ -441,7 +449,7 @@ private:
 
     // -------------------- data -------------------- //
 
-    std::vector<std::shared_ptr<Task>> m_flexbody_tasks;   //!< Gfx state
+    std::vector<TaskHandle>            m_flexbody_tasks;   //!< Gfx state
     std::shared_ptr<RigDef::File>      m_definition;
     std::unique_ptr<GfxActor>          m_gfx_actor;
     PerVehicleCameraContext            m_camera_context;
@@ -488,8 +496,8 @@ private:
     TransferCase*     m_transfer_case;            //!< Physics
     float             m_net_node_compression;  //!< Sim attr;
     int               m_net_first_wheel_node;  //!< Network attr; Determines data buffer layout
-    int               m_net_node_buf_size;     //!< Network attr; buffer size
-    int               m_net_buffer_size;       //!< Network attr; buffer size
+    NodeStreamEncoder m_net_node_encoder;      //!< Network state; local actors
+    NodeStreamDecoder m_net_node_decoder;      //!< Network state; remote actors
     int               m_wheel_node_count;      //!< Static attr; filled at spawn
     int               m_previous_gear;         //!< Sim state; land vehicle shifting
     float             m_handbrake_force;       //!< Physics attr; defined in truckfile
@@ -504,6 +512,11 @@ private:
     int               m_masscount;             //!< Physics attr; Number of nodes loaded with l option
     float             m_dry_mass;              //!< Physics attr;
     std::unique_ptr<Buoyance> m_buoyance;      //!< Physics
+    Collisions::CellWindow m_collision_cells;  //!< Physics; static collision cells around the actor, resolved once per step in CalcNodes()
+    Collisions::GroundSamples m_ground_samples; //!< Physics; terrain height + normal under each node, sampled once per step in CalcNodes()
+    std::vector<float> m_water_positions;      //!< Physics; absolute node positions as x|y|z streams, input of IWater::IsUnderWaterBatch()
+    std::vector<uint8_t> m_water_contacts;     //!< Physics; output of IWater::IsUnderWaterBatch()
+    std::vector<float> m_wing_params;          //!< Physics; Airfoil::getparamsBatch() arguments and results of all wings, see CalcAircraftForces()
     CacheEntry*       m_used_skin_entry;       //!< Graphics
     Skidmark*         m_skid_trails[MAX_WHEELS*2];
     bool              m_antilockbrake;         //!< GUI state
@@ -556,12 +569,17 @@ private:
 
     struct NetUpdate
     {
-        std::vector<char> veh_state;   //!< Actor properties (engine, brakes, lights, ...)
-        std::vector<char> node_data;   //!< Compressed node positions
-        std::vector<float> wheel_data; //!< Wheel rotations
+        RoRnet::VehicleState       veh_state;  //!< Actor properties (engine, brakes, lights, ...)
+        std::vector<Ogre::Vector3> node_pos;   //!< Decoded node positions, `m_net_first_wheel_node` entries
+        std::vector<float>         wheel_data; //!< Wheel rotations
     };
 
-    std::deque<NetUpdate> m_net_updates; //!< Incoming stream of NetUpdates
+    static const size_t    NET_UPDATE_RING_SIZE = 16;
+    std::vector<NetUpdate> m_net_updates;           //!< Ring buffer of incoming updates, preallocated at spawn
+    size_t                 m_net_updates_begin = 0; //!< Index of the oldest update
+    size_t                 m_net_updates_count = 0;
+
+    NetUpdate&             GetNetUpdate(size_t i) { return m_net_updates[(m_net_updates_begin + i) % NET_UPDATE_RING_SIZE]; }
 };
 
 } // namespace RoR
@@ -113,10 +113,43 @@ void Actor::CalcAircraftForces(bool doUpdate)
         if (ar_screwprops[i])
             ar_screwprops[i]->updateForces(doUpdate);
 
-    //wing forces
+    //wing forces - the airfoil coefficients of each run of wings sharing an airfoil are looked up in one batch
+    m_wing_params.resize(ar_num_wings * 6);
+    float* const alpha  = m_wing_params.data();
+    float* const cratio = alpha + ar_num_wings;
+    float* const cdef   = cratio + ar_num_wings;
+    float* const cz     = cdef + ar_num_wings;
+    float* const cx     = cz + ar_num_wings;
+    float* const cm     = cx + ar_num_wings;
+    for (int i = 0; i < ar_num_wings; i++)
+    {
+        if (!ar_wings[i].fa || !ar_wings[i].fa->calcAngleOfAttack(&alpha[i], &cratio[i], &cdef[i]))
+        {
+            alpha[i] = 0.f;
+            cratio[i] = 1.f;
+            cdef[i] = 0.f;
+        }
+    }
+    for (int start = 0; start < ar_num_wings; )
+    {
+        if (!ar_wings[start].fa || !ar_wings[start].fa->getAirfoil())
+        {
+            start++;
+            continue;
+        }
+        Airfoil* airfoil = ar_wings[start].fa->getAirfoil();
+        int end = start + 1;
+        while (end < ar_num_wings && ar_wings[end].fa && ar_wings[end].fa->getAirfoil() &&
+               airfoil->isSameAirfoil(ar_wings[end].fa->getAirfoil()))
+        {
+            end++;
+        }
+        airfoil->getparamsBatch(alpha + start, cratio + start, cdef + start, end - start, cz + start, cx + start, cm + start);
+        start = end;
+    }
     for (int i = 0; i < ar_num_wings; i++)
         if (ar_wings[i].fa)
-            ar_wings[i].fa->updateForces();
+            ar_wings[i].fa->applyForces(cz[i], cx[i], cm[i]);
 }
 
 void Actor::CalcFuseDrag()
@@ -134,11 +167,7 @@ void Actor::CalcFuseDrag()
             aoa = 2.0 * acos(v); //quaternion fun
         m_fusealge_airfoil->getparams(aoa, 1.0, 0.0, &cz, &cx, &cm);
 
-        //tropospheric model valid up to 11.000m (33.000ft)
-        float altitude = m_fusealge_front->AbsPosition.y;
-        float sea_level_pressure = 101325; //in Pa
-        float airpressure = sea_level_pressure * approx_pow(1.0 - 0.0065 * altitude / 288.1, 5.24947); //in Pa
-        float airdensity = airpressure * 0.0000120896f;//1.225 at sea level
+        float airdensity = Airfoil::getAirDensity(m_fusealge_front->AbsPosition.y);
 
         //fuselage as an airfoil + parasitic drag (half fuselage front surface almost as a flat plane!)
         ar_fusedrag = ((cx * s + m_fusealge_width * m_fusealge_width * 0.5) * 0.5 * airdensity * wspeed / ar_num_nodes) * wind; 
@@ -1518,20 +1547,67 @@ void Actor::CalcBeamsInterActor()
     }
 }
 
+void Actor::CalcNodesWater(IWater* water)
+{
+    const size_t num_nodes = ar_num_nodes;
+    m_water_positions.resize(num_nodes * 3);
+    m_water_contacts.resize(num_nodes);
+    float* const pos_x = m_water_positions.data();
+    float* const pos_y = pos_x + num_nodes;
+    float* const pos_z = pos_y + num_nodes;
+    for (size_t i = 0; i < num_nodes; i++)
+    {
+        pos_x[i] = ar_nodes[i].AbsPosition.x;
+        pos_y[i] = ar_nodes[i].AbsPosition.y;
+        pos_z[i] = ar_nodes[i].AbsPosition.z;
+    }
+
+    water->IsUnderWaterBatch(pos_x, pos_y, pos_z, num_nodes, m_water_contacts.data());
+
+    for (NodeNum_t i = 0; i < ar_num_nodes; i++)
+    {
+        const bool is_under_water = m_water_contacts[i] != 0;
+        if (is_under_water)
+        {
+            m_water_contact = true;
+            if (ar_num_buoycabs == 0)
+            {
+                // water drag (turbulent)
+                const Real approx_speed = approx_sqrt(ar_nodes[i].Velocity.squaredLength());
+                ar_nodes[i].Forces -= (DEFAULT_WATERDRAG * approx_speed) * ar_nodes[i].Velocity;
+                // basic buoyance
+                ar_nodes[i].Forces += ar_nodes[i].buoyancy * Vector3::UNIT_Y;
+            }
+            // engine stall
+            if (i == ar_cinecam_node[0] && ar_engine)
+            {
+                ar_engine->StopEngine();
+            }
+        }
+        ar_nodes[i].nd_under_water = is_under_water;
+    }
+}
+
 void Actor::CalcNodes()
 {
     const auto water = App::GetSimTerrain()->getWater();
     const float gravity = App::GetSimTerrain()->getGravity();
     m_water_contact = false;
 
+    // Nodes barely move within a step; resolve the static collision cells around the actor once
+    App::GetSimTerrain()->GetCollisions()->prepareCellWindow(ar_bounding_box, m_collision_cells);
+    // Likewise the terrain under all nodes, in one batch; a node's position doesn't change before its collision pass
+    App::GetSimTerrain()->GetCollisions()->prepareGroundSamples(ar_nodes, ar_num_nodes, m_ground_samples);
+
     for (NodeNum_t i = 0; i < ar_num_nodes; i++)
     {
         // COLLISION
         if (!ar_nodes[i].nd_no_ground_contact)
         {
             Vector3 oripos = ar_nodes[i].AbsPosition;
-            bool contacted = App::GetSimTerrain()->GetCollisions()->groundCollision(&ar_nodes[i], PHYSICS_DT);
-            contacted = contacted | App::GetSimTerrain()->GetCollisions()->nodeCollision(&ar_nodes[i], PHYSICS_DT, false);
+            bool contacted = App::GetSimTerrain()->GetCollisions()->groundCollision(&ar_nodes[i], PHYSICS_DT,
+                m_ground_samples.height[i], m_ground_samples.normal[i]);
+            contacted = contacted | App::GetSimTerrain()->GetCollisions()->nodeCollision(&ar_nodes[i], PHYSICS_DT, m_collision_cells);
             ar_nodes[i].nd_has_ground_contact = contacted;
             if (ar_nodes[i].nd_has_ground_contact || ar_nodes[i].nd_has_mesh_contact)
             {
@@ -1589,31 +1665,16 @@ void Actor::CalcNodes()
             Vector3 drag = -defdragxspeed * ar_nodes[i].Velocity;
             // plus: turbulences
             Real maxtur = defdragxspeed * approx_speed * 0.005f;
-            drag += maxtur * Vector3(frand_11(), frand_11(), frand_11());
+            const uint64_t rng_index = ar_physics_rng.GetCounter();
+            drag += maxtur * Vector3(ar_physics_rng.At11(rng_index), ar_physics_rng.At11(rng_index + 1), ar_physics_rng.At11(rng_index + 2));
+            ar_physics_rng.Skip(3);
             ar_nodes[i].Forces += drag;
         }
+    }
 
-        if (water)
-        {
-            const bool is_under_water = water->IsUnderWater(ar_nodes[i].AbsPosition);
-            if (is_under_water)
-            {
-                m_water_contact = true;
-                if (ar_num_buoycabs == 0)
-                {
-                    // water drag (turbulent)
-                    ar_nodes[i].Forces -= (DEFAULT_WATERDRAG * approx_speed) * ar_nodes[i].Velocity;
-                    // basic buoyance
-                    ar_nodes[i].Forces += ar_nodes[i].buoyancy * Vector3::UNIT_Y;
-                }
-                // engine stall
-                if (i == ar_cinecam_node[0] && ar_engine)
-                {
-                    ar_engine->StopEngine();
-                }
-            }
-            ar_nodes[i].nd_under_water = is_under_water;
-        }
+    if (water)
+    {
+        this->CalcNodesWater(water);
     }
 
     this->UpdateBoundingBoxes();
@@ -40,6 +40,7 @@
 #include "Console.h"
 #include "GUI_TopMenubar.h"
 #include "InputEngine.h"
+#include "IWater.h"
 #include "Language.h"
 #include "MovableText.h"
 #include "Network.h"
@@ -54,6 +55,8 @@
 #include "Utils.h"
 #include "VehicleAI.h"
 
+#include <fmt/format.h>
+
 using namespace Ogre;
 using namespace RoR;
 
@@ -72,6 +75,7 @@ ActorManager::ActorManager()
 ActorManager::~ActorManager()
 {
     this->SyncWithSimThread(); // Wait for sim task to finish
+    this->WaitForSavegameWrite();
 }
 
 void ActorManager::SetupActor(Actor* actor, ActorSpawnRequest rq, std::shared_ptr<RigDef::File> def)
@@ -295,23 +299,29 @@ void ActorManager::SetupActor(Actor* actor, ActorSpawnRequest rq, std::shared_pt
 
     if (App::mp_state->getEnum<MpState>() == RoR::MpState::CONNECTED)
     {
-        // network buffer layout (without RoRnet::VehicleState):
-        //
-        //  - 3 floats (x,y,z) for the reference node 0
-        //  - ar_num_nodes - 1 times 3 short ints (compressed position info)
-        //  - ar_num_wheels times a float for the wheel rotation
-        //
-        actor->m_net_node_buf_size = sizeof(float) * 3 + (actor->m_net_first_wheel_node - 1) * sizeof(short int) * 3;
-        actor->m_net_buffer_size = actor->m_net_node_buf_size + actor->ar_num_wheels * sizeof(float);
+        // network buffer layout: RoRnet::VehicleState, then the RORNET_NODESTREAM_VERSION node data
+        // (see `RoRnet::NodeStreamHeader` and `NodeStreamCodec`), then ar_num_wheels times a float for the wheel rotation.
 
         if (rq.asr_origin == ActorSpawnRequest::Origin::NETWORK)
         {
+            actor->m_net_node_decoder.Resize(actor->m_net_first_wheel_node);
+            actor->m_net_updates.resize(Actor::NET_UPDATE_RING_SIZE);
+            for (Actor::NetUpdate& update : actor->m_net_updates)
+            {
+                update.node_pos.resize(actor->m_net_first_wheel_node);
+                update.wheel_data.resize(actor->ar_num_wheels);
+            }
+
             actor->ar_state = ActorState::NETWORKED_OK;
             if (actor->ar_engine)
             {
                 actor->ar_engine->StartEngine();
             }
         }
+        else
+        {
+            actor->m_net_node_encoder.Resize(actor->m_net_first_wheel_node);
+        }
 
         actor->m_net_username = rq.asr_net_username;
         actor->m_net_color_num = rq.asr_net_color;
@@ -328,6 +338,9 @@ Actor* ActorManager::CreateActorInstance(ActorSpawnRequest rq, std::shared_ptr<R
 {
     Actor* actor = new Actor(m_actor_counter++, static_cast<int>(m_actors.size()), def, rq);
     actor->setUsedSkin(rq.asr_skin_entry);
+#ifdef USE_OPENAL
+    App::GetSoundScriptManager()->registerOwner(actor->ar_instance_id); // Trigger states must exist even without sound instances (i.e. horn is networked)
+#endif // USE_OPENAL
 
     if (App::mp_state->getEnum<MpState>() == MpState::CONNECTED && rq.asr_origin != ActorSpawnRequest::Origin::NETWORK)
     {
@@ -358,23 +371,26 @@ void ActorManager::RemoveStreamSource(int sourceid)
 }
 
 #ifdef USE_SOCKETW
-void ActorManager::HandleActorStreamData(std::vector<RoR::NetRecvPacket> packet_buffer)
+void ActorManager::HandleActorStreamData(std::vector<RoR::NetRecvPacket*> const& packet_buffer)
 {
+    // Sorting and compressing only shuffles pointers, the packets stay in the network queue
+    m_net_packets.assign(packet_buffer.begin(), packet_buffer.end());
     // Sort by stream source
-    std::stable_sort(packet_buffer.begin(), packet_buffer.end(),
-            [](const RoR::NetRecvPacket& a, const RoR::NetRecvPacket& b)
-            { return a.header.source > b.header.source; });
+    std::stable_sort(m_net_packets.begin(), m_net_packets.end(),
+            [](const RoR::NetRecvPacket* a, const RoR::NetRecvPacket* b)
+            { return a->header.source > b->header.source; });
     // Compress data stream by eliminating all but the last update from every consecutive group of stream data updates
-    auto it = std::unique(packet_buffer.rbegin(), packet_buffer.rend(),
-            [](const RoR::NetRecvPacket& a, const RoR::NetRecvPacket& b)
-            { return !memcmp(&a.header, &b.header, sizeof(RoRnet::Header)) &&
-            a.header.command == RoRnet::MSG2_STREAM_DATA; });
-    packet_buffer.erase(packet_buffer.begin(), it.base());
-    for (auto& packet : packet_buffer)
-    {
-        if (packet.header.command == RoRnet::MSG2_STREAM_REGISTER)
+    auto it = std::unique(m_net_packets.rbegin(), m_net_packets.rend(),
+            [](const RoR::NetRecvPacket* a, const RoR::NetRecvPacket* b)
+            { return !memcmp(&a->header, &b->header, sizeof(RoRnet::Header)) &&
+            a->header.command == RoRnet::MSG2_STREAM_DATA &&
+            IsDiscardableStreamData(b->buffer, b->header.size); });
+    m_net_packets.erase(m_net_packets.begin(), it.base());
+    for (RoR::NetRecvPacket* packet : m_net_packets)
+    {
+        if (packet->header.command == RoRnet::MSG2_STREAM_REGISTER)
         {
-            RoRnet::StreamRegister* reg = (RoRnet::StreamRegister *)packet.buffer;
+            RoRnet::StreamRegister* reg = (RoRnet::StreamRegister *)packet->buffer;
             if (reg->type == 0)
             {
                 reg->name[127] = 0;
@@ -409,6 +425,13 @@ void ActorManager::HandleActorStreamData(std::vector<RoR::NetRecvPacket> packet_
                         AddStreamMismatch(reg->origin_sourceid, reg->origin_streamid);
                         reg->status = -1;
                     }
+                    else if (reinterpret_cast<RoRnet::ActorStreamRegister*>(reg)->bufferSize != RORNET_NODESTREAM_VERSION)
+                    {
+                        RoR::LogFormat("[RoR] Cannot create remote actor (unknown stream data layout %d), filename: '%s'",
+                            reinterpret_cast<RoRnet::ActorStreamRegister*>(reg)->bufferSize, filename.c_str());
+                        AddStreamMismatch(reg->origin_sourceid, reg->origin_streamid);
+                        reg->status = -1;
+                    }
                     else
                     {
                         auto actor_reg = reinterpret_cast<RoRnet::ActorStreamRegister*>(reg);
@@ -444,14 +467,14 @@ void ActorManager::HandleActorStreamData(std::vector<RoR::NetRecvPacket> packet_
                 App::GetNetwork()->AddPacket(reg->origin_streamid, RoRnet::MSG2_STREAM_REGISTER_RESULT, sizeof(RoRnet::StreamRegister), (char *)reg);
             }
         }
-        else if (packet.header.command == RoRnet::MSG2_STREAM_REGISTER_RESULT)
+        else if (packet->header.command == RoRnet::MSG2_STREAM_REGISTER_RESULT)
         {
-            RoRnet::StreamRegister* reg = (RoRnet::StreamRegister *)packet.buffer;
+            RoRnet::StreamRegister* reg = (RoRnet::StreamRegister *)packet->buffer;
             for (auto actor : m_actors)
             {
                 if (actor->ar_net_source_id == reg->origin_sourceid && actor->ar_net_stream_id == reg->origin_streamid)
                 {
-                    int sourceid = packet.header.source;
+                    int sourceid = packet->header.source;
                     actor->ar_net_stream_results[sourceid] = reg->status;
 
                     String message = "";
@@ -467,9 +490,9 @@ void ActorManager::HandleActorStreamData(std::vector<RoR::NetRecvPacket> packet_
                 }
             }
         }
-        else if (packet.header.command == RoRnet::MSG2_STREAM_UNREGISTER)
+        else if (packet->header.command == RoRnet::MSG2_STREAM_UNREGISTER)
         {
-            Actor* b = this->GetActorByNetworkLinks(packet.header.source, packet.header.streamid);
+            Actor* b = this->GetActorByNetworkLinks(packet->header.source, packet->header.streamid);
             if (b)
             {
                 if (b->ar_state == ActorState::NETWORKED_OK || b->ar_state == ActorState::NETWORKED_HIDDEN)
@@ -477,21 +500,21 @@ void ActorManager::HandleActorStreamData(std::vector<RoR::NetRecvPacket> packet_
                     App::GetGameContext()->PushMessage(Message(MSG_SIM_DELETE_ACTOR_REQUESTED, (void*)b));
                 }
             }
-            m_stream_mismatches[packet.header.source].erase(packet.header.streamid);
+            m_stream_mismatches[packet->header.source].erase(packet->header.streamid);
         }
-        else if (packet.header.command == RoRnet::MSG2_USER_LEAVE)
+        else if (packet->header.command == RoRnet::MSG2_USER_LEAVE)
         {
-            this->RemoveStreamSource(packet.header.source);
+            this->RemoveStreamSource(packet->header.source);
         }
-        else if (packet.header.command == RoRnet::MSG2_STREAM_DATA)
+        else if (packet->header.command == RoRnet::MSG2_STREAM_DATA)
         {
             for (auto actor : m_actors)
             {
                 if (actor->ar_state != ActorState::NETWORKED_OK)
                     continue;
-                if (packet.header.source == actor->ar_net_source_id && packet.header.streamid == actor->ar_net_stream_id)
+                if (packet->header.source == actor->ar_net_source_id && packet->header.streamid == actor->ar_net_stream_id)
                 {
-                    actor->pushNetwork(packet.buffer, packet.header.size);
+                    actor->pushNetwork(packet->buffer, packet->header.size);
                     break;
                 }
             }
@@ -1059,6 +1082,9 @@ void ActorManager::UpdateActors(Actor* player_actor)
         }
     }
 
+    // Also objects spawned by the actor updates above; the index must not change under a running sim task
+    App::GetSimTerrain()->GetCollisions()->updateCellIndex();
+
     auto func = std::function<void()>([this]()
         {
             this->UpdatePhysicsSimulation();
@@ -1089,8 +1115,13 @@ void ActorManager::UpdatePhysicsSimulation()
     {
         actor->UpdatePhysicsOrigin();
     }
+    IWater* water = App::GetSimTerrain()->getWater();
     for (int i = 0; i < m_physics_steps; i++)
     {
+        if (water)
+        {
+            water->StepWaves();
+        }
         {
             std::vector<std::function<void()>> tasks;
             for (auto actor : m_actors)
@@ -1113,6 +1144,7 @@ void ActorManager::UpdatePhysicsSimulation()
                 }
             }
         }
+        m_broadphase.Update(m_actors);
         {
             std::vector<std::function<void()>> tasks;
             for (auto actor : m_actors)
@@ -1122,7 +1154,7 @@ void ActorManager::UpdatePhysicsSimulation()
                 {
                     auto func = std::function<void()>([this, actor]()
                         {
-                            actor->m_inter_point_col_detector->UpdateInterPoint();
+                            actor->m_inter_point_col_detector->UpdateInterPoint(m_broadphase.GetPartners(actor));
                             if (actor->ar_collision_relevant)
                             {
                                 ResolveInterActorCollisions(PHYSICS_DT,
@@ -1156,6 +1188,11 @@ void ActorManager::UpdatePhysicsSimulation()
             actor->m_avg_node_velocity /= (m_physics_steps * PHYSICS_DT);
             actor->m_avg_node_position_prev = actor->m_avg_node_position;
             actor->ar_top_speed = std::max(actor->ar_top_speed, actor->ar_nodes[0].Velocity.length());
+            actor->GetGfxActor()->WriteSimNodeSnapshot();
+        }
+        else
+        {
+            actor->GetGfxActor()->DiscardSimNodeSnapshot();
         }
     }
 }
@@ -1164,6 +1201,11 @@ void ActorManager::SyncWithSimThread()
 {
     if (m_sim_task)
         m_sim_task->join();
+
+    // No sim task runs now - collision objects spawned meanwhile become visible to all lookups,
+    // also while the simulation is paused or doesn't advance this frame.
+    if (App::GetSimTerrain())
+        App::GetSimTerrain()->GetCollisions()->updateCellIndex();
 }
 
 void HandleErrorLoadingFile(std::string type, std::string filename, std::string exception_msg)
@@ -1195,28 +1237,106 @@ std::shared_ptr<RigDef::File> ActorManager::FetchActorDef(std::string filename,
         return cache_entry->actor_def;
     }
 
+    // If being parsed in the background, wait for it
+    auto search = m_actor_def_loads.find(cache_entry);
+    if (search != m_actor_def_loads.end())
+    {
+        std::shared_ptr<ActorDefLoad> load = search->second;
+        load->adl_task->join();
+        return this->FinishActorDef(*load);
+    }
+
     // Load the 'truckfile'
+    ActorDefLoad load;
+    load.adl_cache_entry = cache_entry;
+    load.adl_filename = filename;
+    load.adl_predefined_on_terrain = predefined_on_terrain;
+    if (!this->OpenActorDef(load))
+    {
+        return nullptr; // Error already reported
+    }
+    ParseActorDef(load);
+    return this->FinishActorDef(load);
+}
+
+std::shared_ptr<ActorDefLoad> ActorManager::FetchActorDefAsync(std::string filename, bool predefined_on_terrain)
+{
+    CacheEntry* cache_entry = App::GetCacheSystem()->FindEntryByFilename(LT_AllBeam, /*partial=*/false, filename);
+    if (cache_entry == nullptr)
+    {
+        HandleErrorLoadingTruckfile(filename, "Truckfile not found in ModCache (probably not installed)");
+        return nullptr;
+    }
+
+    auto search = m_actor_def_loads.find(cache_entry);
+    if (search != m_actor_def_loads.end())
+    {
+        return search->second;
+    }
+
+    std::shared_ptr<ActorDefLoad> load = std::make_shared<ActorDefLoad>();
+    load->adl_cache_entry = cache_entry;
+    load->adl_filename = filename;
+    load->adl_predefined_on_terrain = predefined_on_terrain;
+    if (cache_entry->actor_def != nullptr)
+    {
+        load->adl_def = cache_entry->actor_def; // Already parsed, nothing to do
+        load->adl_finished = true;
+        return load;
+    }
+
+    if (!this->OpenActorDef(*load))
+    {
+        return nullptr; // Error already reported
+    }
+    load->adl_task = App::GetThreadPool()->RunTask([load]() { ActorManager::ParseActorDef(*load); });
+    m_actor_def_loads.insert(std::make_pair(cache_entry, load));
+    return load;
+}
+
+bool ActorManager::OpenActorDef(ActorDefLoad& load)
+{
+    // The resource system is only usable on the main thread, read the whole file here.
     try
     {
-        Ogre::String resource_filename = filename;
-        Ogre::String resource_groupname;
-        if (!App::GetCacheSystem()->CheckResourceLoaded(resource_filename, resource_groupname)) // Validates the filename and finds resource group
+        load.adl_resource_group = "";
+        Ogre::String resource_filename = load.adl_filename;
+        if (!App::GetCacheSystem()->CheckResourceLoaded(resource_filename, load.adl_resource_group)) // Validates the filename and finds resource group
         {
-            HandleErrorLoadingTruckfile(filename, "Truckfile not found");
-            return nullptr;
+            HandleErrorLoadingTruckfile(load.adl_filename, "Truckfile not found");
+            return false;
         }
-        Ogre::DataStreamPtr stream = Ogre::ResourceGroupManager::getSingleton().openResource(resource_filename, resource_groupname);
+        Ogre::DataStreamPtr stream = Ogre::ResourceGroupManager::getSingleton().openResource(resource_filename, load.adl_resource_group);
 
         if (stream.isNull() || !stream->isReadable())
         {
-            HandleErrorLoadingTruckfile(filename, "Unable to open/read truckfile");
-            return nullptr;
+            HandleErrorLoadingTruckfile(load.adl_filename, "Unable to open/read truckfile");
+            return false;
         }
 
-        RoR::LogFormat("[RoR] Parsing truckfile '%s'", resource_filename.c_str());
+        load.adl_filename = resource_filename;
+        load.adl_contents = stream->getAsString();
+        return true;
+    }
+    catch (Ogre::Exception& oex)
+    {
+        HandleErrorLoadingTruckfile(load.adl_filename, oex.getFullDescription().c_str());
+        return false;
+    }
+}
+
+void ActorManager::ParseActorDef(ActorDefLoad& load)
+{
+    try
+    {
+        RoR::LogFormat("[RoR] Parsing truckfile '%s'", load.adl_filename.c_str());
+        Ogre::DataStreamPtr stream(OGRE_NEW Ogre::MemoryDataStream(
+            load.adl_filename, (void*)load.adl_contents.data(), load.adl_contents.size(), /*freeOnClose=*/false, /*readOnly=*/true));
+
+        // No resource group = don't touch the resource system; textures are checked by FinishActorDef()
         RigDef::Parser parser;
         parser.Prepare();
-        parser.ProcessOgreStream(stream.getPointer(), resource_groupname);
+        parser.ProcessOgreStream(stream.getPointer(), "");
         parser.Finalize();
 
         auto def = parser.GetFile();
@@ -1227,13 +1347,13 @@ std::shared_ptr<RigDef::File> ActorManager::FetchActorDef(std::string filename,
         RigDef::Validator validator;
         validator.Setup(def);
 
-        if (predefined_on_terrain)
+        if (load.adl_predefined_on_terrain)
         {
             // Workaround: Some terrains pre-load truckfiles with special purpose:
             //     "soundloads" = play sound effect at certain spot
             //     "fixes"      = structures of N/B fixed to the ground
             // These files can have no beams. Possible extensions: .load or .fixed
-            std::string file_extension = filename.substr(filename.find_last_of('.'));
+            std::string file_extension = load.adl_filename.substr(load.adl_filename.find_last_of('.'));
             Ogre::StringUtil::toLowerCase(file_extension);
             if ((file_extension == ".load") | (file_extension == ".fixed"))
             {
@@ -1243,26 +1363,77 @@ std::shared_ptr<RigDef::File> ActorManager::FetchActorDef(std::string filename,
 
         validator.Validate(); // Sends messages to console
 
-        def->hash = Utils::Sha1Hash(stream->getAsString());
+        def->hash = Utils::Sha1Hash(load.adl_contents);
 
-        cache_entry->actor_def = def;
-        return def;
+        load.adl_def = def;
     }
     catch (Ogre::Exception& oex)
     {
-        HandleErrorLoadingTruckfile(filename, oex.getFullDescription().c_str());
-        return nullptr;
+        load.adl_error = oex.getFullDescription();
     }
     catch (std::exception& stex)
     {
-        HandleErrorLoadingTruckfile(filename, stex.what());
-        return nullptr;
+        load.adl_error = stex.what();
     }
     catch (...)
     {
-        HandleErrorLoadingTruckfile(filename, "<Unknown exception occurred>");
+        load.adl_error = "<Unknown exception occurred>";
+    }
+}
+
+std::shared_ptr<RigDef::File> ActorManager::FinishActorDef(ActorDefLoad& load)
+{
+    if (load.adl_finished)
+    {
+        return load.adl_def;
+    }
+    load.adl_finished = true;
+    m_actor_def_loads.erase(load.adl_cache_entry);
+    load.adl_contents.clear();
+
+    if (load.adl_def == nullptr)
+    {
+        HandleErrorLoadingTruckfile(load.adl_filename, load.adl_error);
         return nullptr;
     }
+
+    // Drop managed materials with missing textures (the parser does this when given a resource group)
+    Ogre::ResourceGroupManager& rgm = Ogre::ResourceGroupManager::getSingleton();
+    auto check_managed_materials = [&](std::shared_ptr<RigDef::File::Module> module)
+    {
+        auto itor = module->managed_materials.begin();
+        while (itor != module->managed_materials.end())
+        {
+            if (!rgm.resourceExists(load.adl_resource_group, itor->diffuse_map))
+            {
+                App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_ACTOR, Console::CONSOLE_SYSTEM_WARNING,
+                    fmt::format("{}: managed material '{}': Missing texture file: {}", load.adl_filename, itor->name, itor->diffuse_map));
+                itor = module->managed_materials.erase(itor);
+                continue;
+            }
+            if (itor->HasDamagedDiffuseMap() && !rgm.resourceExists(load.adl_resource_group, itor->damaged_diffuse_map))
+            {
+                App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_ACTOR, Console::CONSOLE_SYSTEM_WARNING,
+                    fmt::format("{}: managed material '{}': Missing texture file: {}", load.adl_filename, itor->name, itor->damaged_diffuse_map));
+                itor->damaged_diffuse_map = "-";
+            }
+            if (itor->HasSpecularMap() && !rgm.resourceExists(load.adl_resource_group, itor->specular_map))
+            {
+                App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_ACTOR, Console::CONSOLE_SYSTEM_WARNING,
+                    fmt::format("{}: managed material '{}': Missing texture file: {}", load.adl_filename, itor->name, itor->specular_map));
+                itor->specular_map = "-";
+            }
+            ++itor;
+        }
+    };
+    check_managed_materials(load.adl_def->root_module);
+    for (auto& entry : load.adl_def->user_modules)
+    {
+        check_managed_materials(entry.second);
+    }
+
+    load.adl_cache_entry->actor_def = load.adl_def;
+    return load.adl_def;
 }
 
 std::vector<Actor*> ActorManager::GetLocalActors()
@@ -26,12 +26,15 @@
 
 #include "Application.h"
 
+#include "ActorBroadphase.h"
 #include "SimData.h"
 #include "CmdKeyInertia.h"
 #include "Network.h"
 #include "RigDef_Prerequisites.h"
 #include "ThreadPool.h"
 
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -39,6 +42,20 @@
 
 namespace RoR {
 
+/// A truckfile being loaded; read on the main thread, parsed+validated on the ThreadPool.
+struct ActorDefLoad
+{
+    CacheEntry*                     adl_cache_entry = nullptr;
+    std::string                     adl_filename;
+    std::string                     adl_resource_group;
+    std::string                     adl_contents;             //!< Raw truckfile text
+    bool                            adl_predefined_on_terrain = false;
+    TaskHandle                      adl_task;                 //!< Empty if parsed on the spot
+    std::shared_ptr<RigDef::File>   adl_def;                  //!< Output; null on error
+    std::string                     adl_error;                //!< Output; reported by `FinishActorDef()`
+    bool                            adl_finished = false;     //!< Main thread has processed the output
+};
+
 /// Builds and manages softbody actors (physics on background thread, networking)
 class ActorManager
 {
@@ -81,9 +98,11 @@ public:
     Actor*         FindActorInsideBox(Collisions* collisions, const Ogre::String& inst, const Ogre::String& box);
     void           UpdateInputEvents(float dt);
     std::shared_ptr<RigDef::File>   FetchActorDef(std::string filename, bool predefined_on_terrain = false);
+    std::shared_ptr<ActorDefLoad>   FetchActorDefAsync(std::string filename, bool predefined_on_terrain = false); //!< Null if the file can't be opened (error already reported)
+    std::shared_ptr<RigDef::File>   FinishActorDef(ActorDefLoad& load); //!< Call when `adl_task` is finished
 
 #ifdef USE_SOCKETW
-    void           HandleActorStreamData(std::vector<RoR::NetRecvPacket> packet);
+    void           HandleActorStreamData(std::vector<RoR::NetRecvPacket*> const& packet_buffer);
 #endif
 
 #ifdef USE_ANGELSCRIPT
@@ -94,8 +113,11 @@ public:
     // Savegames (defined in Savegame.cpp)
 
     bool           LoadScene(Ogre::String filename);
-    bool           SaveScene(Ogre::String filename);
-    void           RestoreSavedState(Actor* actor, rapidjson::Value const& j_entry);
+    bool           SaveScene(Ogre::String filename); //!< Binary savegames are written in background, '.json' exports immediately
+    void           WaitForSavegameWrite();
+    void           RestoreSavedState(Actor* actor, rapidjson::Value const& j_entry, SavedBeam const* beams); //!< `beams` (inter-actor links) may be null
+    static bool    RestoreSavedNodesAndBeams(Actor* actor, SavedNode const* nodes, size_t num_nodes,
+                                             SavedBeam const* beams, size_t num_beams); //!< Threadsafe for distinct actors; false if counts don't match
 
     std::vector<Actor*> GetActors() const                  { return m_actors; };
     std::vector<Actor*> GetLocalActors();
@@ -114,12 +136,20 @@ private:
     void           RecursiveActivation(int j, std::vector<bool>& visited);
     void           ForwardCommands(Actor* source_actor); //!< Fowards things to trailers
     void           UpdateTruckFeatures(Actor* vehicle, float dt);
+    bool           OpenActorDef(ActorDefLoad& load);
+    static void    ParseActorDef(ActorDefLoad& load);   //!< Thread safe
 
     // Networking
     std::map<int, std::set<int>> m_stream_mismatches; //!< Networking: A set of streams without a corresponding actor in the actor-array for each stream source
     std::map<int, int>  m_stream_time_offsets;       //!< Networking: A network time offset for each stream source
     Ogre::Timer         m_net_timer;
 
+    // Truckfiles being parsed on the ThreadPool, so that simultaneous spawns of the same file share the work
+    std::map<CacheEntry*, std::shared_ptr<ActorDefLoad>> m_actor_def_loads;
+#ifdef USE_SOCKETW
+    std::vector<RoR::NetRecvPacket*> m_net_packets; //!< Networking: Scratch list for HandleActorStreamData()
+#endif // USE_SOCKETW
+
     // Physics
     std::vector<Actor*> m_actors;
     bool                m_forced_awake           = false; //!< disables sleep counters
@@ -130,10 +160,12 @@ private:
     float               m_simulation_time        = 0.f;   //!< Amount of time the physics simulation is going to be advanced
     bool                m_simulation_paused      = false;
     float               m_total_sim_time         = 0.f;
+    ActorBroadphase     m_broadphase;                     //!< Inter-actor collision partners, updated every physics step
 
     // Utils
     std::unique_ptr<ThreadPool> m_sim_thread_pool;
-    std::shared_ptr<Task>       m_sim_task;
+    TaskHandle                  m_sim_task;
+    TaskHandle                  m_savegame_task;          //!< Writes the last binary savegame
     RoR::CmdKeyInertiaConfig    m_inertia_config;
 };
 
@@ -1616,8 +1616,8 @@ void ActorSpawner::ProcessProp(RigDef::Prop & def)
         if(def.special == RigDef::Prop::SPECIAL_BEACON)
         {
             prop.pp_beacon_type = 'b';
-            prop.pp_beacon_rot_angle[0] = 2.0 * 3.14 * frand();
-            prop.pp_beacon_rot_rate[0] = 4.0 * 3.14 + frand() - 0.5;
+            prop.pp_beacon_rot_angle[0] = 2.0 * 3.14 * m_actor->ar_props_rng.Next01();
+            prop.pp_beacon_rot_rate[0] = 4.0 * 3.14 + m_actor->ar_props_rng.Next01() - 0.5;
             /* the light */
             auto pp_beacon_light = App::GetGfxScene()->GetSceneManager()->createLight();
             pp_beacon_light->setType(Ogre::Light::LT_SPOTLIGHT);
@@ -1682,8 +1682,8 @@ void ActorSpawner::ProcessProp(RigDef::Prop & def)
             prop.pp_beacon_type='p';
             for (int k=0; k<4; k++)
             {
-                prop.pp_beacon_rot_angle[k] = 2.0 * 3.14 * frand();
-                prop.pp_beacon_rot_rate[k] = 4.0 * 3.14 + frand() - 0.5;
+                prop.pp_beacon_rot_angle[k] = 2.0 * 3.14 * m_actor->ar_props_rng.Next01();
+                prop.pp_beacon_rot_rate[k] = 4.0 * 3.14 + m_actor->ar_props_rng.Next01() - 0.5;
                 prop.pp_beacon_bbs[k] = nullptr;
                 //the light
                 prop.pp_beacon_light[k]=App::GetGfxScene()->GetSceneManager()->createLight();
@@ -25,6 +25,9 @@
 
 #include "Application.h"
 
+#include <cstdint>
+#include <cstring>
+
 static int mirand = 1;
 
 // Returns a random number in the range [0, 1]
@@ -63,6 +66,63 @@ inline float frand_11()
     return( *((float*)&a) - 3.0f );
 }
 
+/// Counter-based random number stream for the simulation.
+///
+/// Unlike `frand*()` above (one shared, unsynchronized state per translation unit),
+/// each actor owns its own stream, so physics workers never share state and a stream
+/// seeded with the same value replays bit-exactly. The n-th number is a pure function
+/// of (seed, n) - a 32-bit integer hash - so batches can be generated out of order
+/// and the loops vectorize (see `At11()`).
+class RandomStream
+{
+public:
+    explicit RandomStream(uint32_t seed = 0)  { this->Seed(seed); }
+
+    void     Seed(uint32_t seed)              { m_key = Hash(seed ^ 0x9e3779b9u); m_counter = 0; }
+    uint64_t GetCounter() const               { return m_counter; }
+    void     SetCounter(uint64_t counter)     { m_counter = counter; } //!< Rewind/fast-forward, i.e. for replays
+    void     Skip(uint64_t count)             { m_counter += count; }
+
+    /// Returns a random number in the range [0, 1)
+    float Next01()                            { return At01(m_counter++); }
+    /// Returns a random number in the range [-1, 1)
+    float Next11()                            { return At11(m_counter++); }
+
+    /// Random number in the range [0, 1) at absolute position `index` - doesn't advance the stream.
+    float At01(uint64_t index) const          { return ToUnitFloat(this->Bits(index)) - 1.f; }
+    /// Random number in the range [-1, 1) at absolute position `index` - doesn't advance the stream.
+    float At11(uint64_t index) const          { return ToUnitFloat(this->Bits(index)) * 2.f - 3.f; }
+
+private:
+    uint32_t Bits(uint64_t index) const
+    {
+        return Hash(static_cast<uint32_t>(index) ^ Hash(m_key + static_cast<uint32_t>(index >> 32)));
+    }
+
+    /// 'lowbias32' integer hash by Chris Wellons - full avalanche, only shifts/xors/muls.
+    static uint32_t Hash(uint32_t x)
+    {
+        x ^= x >> 16;
+        x *= 0x7feb352du;
+        x ^= x >> 15;
+        x *= 0x846ca68bu;
+        x ^= x >> 16;
+        return x;
+    }
+
+    /// Maps 23 random bits to [1, 2)
+    static float ToUnitFloat(uint32_t bits)
+    {
+        const uint32_t a = (bits >> 9) | 0x3f800000u;
+        float f;
+        std::memcpy(&f, &a, sizeof(f));
+        return f;
+    }
+
+    uint32_t m_key;
+    uint64_t m_counter;
+};
+
 // Calculates approximate e^x.
 // Use it in code not requiring precision
 inline float approx_exp(const float x)
@@ -41,13 +41,297 @@
 #include "TerrainManager.h"
 
 #include <rapidjson/rapidjson.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 
-#define SAVEGAME_FILE_FORMAT 3
+#ifdef _WIN32
+#   include <windows.h> // MoveFileExA()
+#endif
+
+#define SAVEGAME_FILE_FORMAT 3   //!< Scene description (JSON), also used standalone for import/export
+#define SAVEGAME_BINARY_FORMAT 1
 
 using namespace Ogre;
 using namespace RoR;
 
+// --------------------------------
+// Savegame files
+
+namespace {
+
+// Binary savegame layout: header | actor index | node+beam arrays (8-byte aligned) | scene description (JSON).
+// The scene description is the same as a JSON savegame, minus the node/beam arrays.
+
+const char SAVEGAME_SIGNATURE[8] = { 'R', 'o', 'R', 'S', 'c', 'e', 'n', 'e' };
+
+struct SavegameHeader
+{
+    char            signature[8];
+    int32_t         format_version;
+    uint32_t        node_record_size;   //!< Detects layout differences between builds
+    uint32_t        beam_record_size;
+    uint32_t        num_actors;
+    uint64_t        json_offset;
+    uint64_t        json_size;
+};
+
+struct SavegameActorIndex
+{
+    uint64_t        nodes_offset;
+    uint64_t        beams_offset;
+    uint32_t        num_nodes;
+    uint32_t        num_beams;
+};
+
+struct SavegameActorArrays
+{
+    SavedNode const* nodes = nullptr;
+    size_t           num_nodes = 0;
+    SavedBeam const* beams = nullptr;
+    size_t           num_beams = 0;
+};
+
+/// Scene description + node/beam arrays of each actor, from either savegame format
+struct SavegameData
+{
+    rapidjson::Document               j_doc;
+    std::vector<SavegameActorArrays>  actors;
+    MappedFile                        file;        //!< Binary savegame; arrays point into the mapping
+    std::vector<SavedNode>            json_nodes;  //!< JSON savegame; arrays point here
+    std::vector<SavedBeam>            json_beams;
+};
+
+template<typename T> void AppendRecord(std::string& buf, T const& record)
+{
+    buf.append(reinterpret_cast<const char*>(&record), sizeof(T));
+}
+
+template<typename T> T ReadRecord(const char* src, size_t index)
+{
+    T record;
+    std::memcpy(&record, src + (index * sizeof(T)), sizeof(T));
+    return record;
+}
+
+void AlignSavegameBuffer(std::string& buf)
+{
+    buf.resize((buf.size() + 7) & ~size_t(7), '\0');
+}
+
+bool LoadBinarySavegame(std::string const& filename, SavegameData& data)
+{
+    const char* src = data.file.GetData();
+    const uint64_t size = data.file.GetSize();
+    const SavegameHeader header = ReadRecord<SavegameHeader>(src, 0);
+    if (header.format_version != SAVEGAME_BINARY_FORMAT ||
+        header.node_record_size != sizeof(SavedNode) ||
+        header.beam_record_size != sizeof(SavedBeam))
+    {
+        RoR::LogFormat("[RoR|Savegame] Unsupported format of savegame '%s'", filename.c_str());
+        return false;
+    }
+
+    const uint64_t index_end = sizeof(SavegameHeader) + (uint64_t(header.num_actors) * sizeof(SavegameActorIndex));
+    if (index_end > header.json_offset || header.json_offset + header.json_size != size)
+    {
+        RoR::LogFormat("[RoR|Savegame] Damaged savegame '%s'", filename.c_str());
+        return false;
+    }
+
+    data.j_doc.Parse<rapidjson::kParseNanAndInfFlag>(src + header.json_offset, static_cast<size_t>(header.json_size));
+    if (data.j_doc.HasParseError())
+    {
+        RoR::LogFormat("[RoR|Savegame] Error parsing scene description in savegame '%s'", filename.c_str());
+        return false;
+    }
+
+    // The arrays are used in place; the mapping is page-aligned and so are the records within.
+    data.actors.resize(header.num_actors);
+    for (uint32_t i = 0; i < header.num_actors; i++)
+    {
+        const SavegameActorIndex rec = ReadRecord<SavegameActorIndex>(src + sizeof(SavegameHeader), i);
+        const uint64_t nodes_end = rec.nodes_offset + (uint64_t(rec.num_nodes) * sizeof(SavedNode));
+        const uint64_t beams_end = rec.beams_offset + (uint64_t(rec.num_beams) * sizeof(SavedBeam));
+        if (rec.nodes_offset < index_end || nodes_end > header.json_offset ||
+            rec.beams_offset < index_end || beams_end > header.json_offset ||
+            (rec.nodes_offset % alignof(SavedNode)) != 0 || (rec.beams_offset % alignof(SavedBeam)) != 0)
+        {
+            RoR::LogFormat("[RoR|Savegame] Damaged savegame '%s'", filename.c_str());
+            return false;
+        }
+        data.actors[i].nodes     = reinterpret_cast<SavedNode const*>(src + rec.nodes_offset);
+        data.actors[i].num_nodes = rec.num_nodes;
+        data.actors[i].beams     = reinterpret_cast<SavedBeam const*>(src + rec.beams_offset);
+        data.actors[i].num_beams = rec.num_beams;
+    }
+
+    return true;
+}
+
+bool LoadJsonSavegame(std::string const& filename, SavegameData& data)
+{
+    if (!App::GetContentManager()->LoadAndParseJson(filename, RGN_SAVEGAMES, data.j_doc)) // Logs errors
+    {
+        return false;
+    }
+    if (!data.j_doc.IsObject() || !data.j_doc.HasMember("actors") || !data.j_doc["actors"].IsArray())
+    {
+        return true; // Scene description is validated by caller
+    }
+
+    // Convert node/beam arrays to the binary layout
+    std::vector<size_t> node_starts;
+    std::vector<size_t> beam_starts;
+    for (rapidjson::Value& j_entry: data.j_doc["actors"].GetArray())
+    {
+        node_starts.push_back(data.json_nodes.size());
+        if (j_entry.HasMember("nodes"))
+        {
+            for (rapidjson::Value const& j_node: j_entry["nodes"].GetArray())
+            {
+                SavedNode node;
+                for (int i = 0; i < 3; i++)
+                {
+                    node.sn_position[i]         = j_node[i].GetFloat();
+                    node.sn_velocity[i]         = j_node[i + 3].GetFloat();
+                    node.sn_initial_position[i] = j_node[i + 6].GetFloat();
+                }
+                data.json_nodes.push_back(node);
+            }
+            j_entry.RemoveMember("nodes");
+        }
+
+        beam_starts.push_back(data.json_beams.size());
+        if (j_entry.HasMember("beams"))
+        {
+            for (rapidjson::Value const& j_beam: j_entry["beams"].GetArray())
+            {
+                SavedBeam beam;
+                std::memset(&beam, 0, sizeof(beam));
+                beam.sb_maxposstress       = j_beam[0].GetFloat();
+                beam.sb_maxnegstress       = j_beam[1].GetFloat();
+                beam.sb_minmaxposnegstress = j_beam[2].GetFloat();
+                beam.sb_strength           = j_beam[3].GetFloat();
+                beam.sb_L                  = j_beam[4].GetFloat();
+                beam.sb_broken             = j_beam[5].GetBool();
+                beam.sb_disabled           = j_beam[6].GetBool();
+                beam.sb_inter_actor        = j_beam[7].GetBool();
+                beam.sb_locked_actor       = j_beam[8].GetInt();
+                data.json_beams.push_back(beam);
+            }
+            j_entry.RemoveMember("beams");
+        }
+    }
+    node_starts.push_back(data.json_nodes.size());
+    beam_starts.push_back(data.json_beams.size());
+
+    data.actors.resize(node_starts.size() - 1);
+    for (size_t i = 0; i < data.actors.size(); i++)
+    {
+        data.actors[i].nodes     = data.json_nodes.data() + node_starts[i];
+        data.actors[i].num_nodes = node_starts[i + 1] - node_starts[i];
+        data.actors[i].beams     = data.json_beams.data() + beam_starts[i];
+        data.actors[i].num_beams = beam_starts[i + 1] - beam_starts[i];
+    }
+
+    return true;
+}
+
+/// Opens binary or JSON savegame
+bool LoadSavegame(std::string const& filename, SavegameData& data)
+{
+    const std::string path = PathCombine(App::sys_savegames_dir->getStr(), filename);
+    if (data.file.Open(path.c_str()) &&
+        data.file.GetSize() >= sizeof(SavegameHeader) &&
+        std::memcmp(data.file.GetData(), SAVEGAME_SIGNATURE, sizeof(SAVEGAME_SIGNATURE)) == 0)
+    {
+        return LoadBinarySavegame(filename, data);
+    }
+
+    data.file.Close();
+    return LoadJsonSavegame(filename, data);
+}
+
+void ExportNodesAndBeamsToJson(rapidjson::Value& j_entry, SavegameActorArrays const& arrays, rapidjson::Document::AllocatorType& j_alloc)
+{
+    rapidjson::Value j_nodes(rapidjson::kArrayType);
+    for (size_t i = 0; i < arrays.num_nodes; i++)
+    {
+        rapidjson::Value j_node(rapidjson::kArrayType);
+        SavedNode const& node = arrays.nodes[i];
+
+        // Position, velocity, initial position
+        for (int k = 0; k < 3; k++)
+            j_node.PushBack(node.sn_position[k], j_alloc);
+        for (int k = 0; k < 3; k++)
+            j_node.PushBack(node.sn_velocity[k], j_alloc);
+        for (int k = 0; k < 3; k++)
+            j_node.PushBack(node.sn_initial_position[k], j_alloc);
+
+        j_nodes.PushBack(j_node, j_alloc);
+    }
+    j_entry.AddMember("nodes", j_nodes, j_alloc);
+
+    rapidjson::Value j_beams(rapidjson::kArrayType);
+    for (size_t i = 0; i < arrays.num_beams; i++)
+    {
+        rapidjson::Value j_beam(rapidjson::kArrayType);
+        SavedBeam const& beam = arrays.beams[i];
+
+        j_beam.PushBack(beam.sb_maxposstress, j_alloc);
+        j_beam.PushBack(beam.sb_maxnegstress, j_alloc);
+        j_beam.PushBack(beam.sb_minmaxposnegstress, j_alloc);
+        j_beam.PushBack(beam.sb_strength, j_alloc);
+        j_beam.PushBack(beam.sb_L, j_alloc);
+        j_beam.PushBack(beam.sb_broken != 0, j_alloc);
+        j_beam.PushBack(beam.sb_disabled != 0, j_alloc);
+        j_beam.PushBack(beam.sb_inter_actor != 0, j_alloc);
+        j_beam.PushBack(beam.sb_locked_actor, j_alloc);
+
+        j_beams.PushBack(j_beam, j_alloc);
+    }
+    j_entry.AddMember("beams", j_beams, j_alloc);
+}
+
+/// Runs on a worker thread; writes a temporary file first so a failed write doesn't destroy the previous savegame.
+bool WriteSavegameFile(std::string const& path, std::string const& buf)
+{
+    const std::string tmp_path = path + ".tmp";
+    FILE* file = fopen(tmp_path.c_str(), "wb");
+    if (!file)
+    {
+        RoR::LogFormat("[RoR|Savegame] Cannot open file '%s' for writing", tmp_path.c_str());
+        return false;
+    }
+
+    const size_t written = fwrite(buf.data(), 1, buf.size(), file);
+    const bool closed = (fclose(file) == 0);
+    if (written < buf.size() || !closed)
+    {
+        RoR::LogFormat("[RoR|Savegame] Error writing file '%s', only written %u out of %u bytes!",
+                       tmp_path.c_str(), static_cast<unsigned>(written), static_cast<unsigned>(buf.size()));
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+
+    // Replace the old savegame in one step, so it's never lost half-way
+#ifdef _WIN32
+    if (!MoveFileExA(tmp_path.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) // `rename()` doesn't overwrite on Windows
+#else
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0)
+#endif
+    {
+        RoR::LogFormat("[RoR|Savegame] Cannot rename file '%s' to '%s'", tmp_path.c_str(), path.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
 // --------------------------------
 // GameContext functions
 
@@ -73,8 +357,10 @@ void GameContext::SaveScene(std::string const& filename)
 std::string GameContext::ExtractSceneName(std::string const& filename)
 {
     // Read from disk
-    rapidjson::Document j_doc;
-    if (!App::GetContentManager()->LoadAndParseJson(filename, RGN_SAVEGAMES, j_doc) ||
+    m_actor_manager.WaitForSavegameWrite();
+    SavegameData data;
+    rapidjson::Document& j_doc = data.j_doc;
+    if (!LoadSavegame(filename, data) ||
         !j_doc.IsObject() || !j_doc.HasMember("format_version") || !j_doc["format_version"].IsNumber() ||
         !j_doc.HasMember("scene_name") || !j_doc["scene_name"].IsString())
         return "";
@@ -85,8 +371,10 @@ std::string GameContext::ExtractSceneName(std::string const& filename)
 std::string GameContext::ExtractSceneTerrain(std::string const& filename)
 {
     // Read from disk
-    rapidjson::Document j_doc;
-    if (!App::GetContentManager()->LoadAndParseJson(filename, RGN_SAVEGAMES, j_doc) ||
+    m_actor_manager.WaitForSavegameWrite();
+    SavegameData data;
+    rapidjson::Document& j_doc = data.j_doc;
+    if (!LoadSavegame(filename, data) ||
         !j_doc.IsObject() || !j_doc.HasMember("format_version") || !j_doc["format_version"].IsNumber() ||
         !j_doc.HasMember("terrain_name") || !j_doc["terrain_name"].IsString())
         return "";
@@ -237,16 +525,19 @@ void GameContext::HandleSavegameHotkeys()
 
 bool ActorManager::LoadScene(Ogre::String filename)
 {
-    // Read from disk
-    rapidjson::Document j_doc;
-    if (!App::GetContentManager()->LoadAndParseJson(filename, RGN_SAVEGAMES, j_doc) ||
+    // Read from disk (binary savegames are mapped, node/beam arrays are restored in place)
+    this->WaitForSavegameWrite();
+    SavegameData data;
+    rapidjson::Document& j_doc = data.j_doc;
+    if (!LoadSavegame(filename, data) ||
         !j_doc.IsObject() || !j_doc.HasMember("format_version") || !j_doc["format_version"].IsNumber())
     {
         App::GetConsole()->putMessage(
             Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_ERROR, _L("Error while loading scene: File invalid or missing"));
         return false;
     }
-    if (j_doc["format_version"].GetInt() != SAVEGAME_FILE_FORMAT)
+    if (j_doc["format_version"].GetInt() != SAVEGAME_FILE_FORMAT ||
+        data.actors.size() != j_doc["actors"].Size())
     {
         App::GetConsole()->putMessage(
             Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_ERROR, _L("Error while loading scene: File format mismatch"));
@@ -360,8 +651,11 @@ bool ActorManager::LoadScene(Ogre::String filename)
             rq->asr_origin        = preloaded ? ActorSpawnRequest::Origin::TERRN_DEF : ActorSpawnRequest::Origin::SAVEGAME;
             rq->asr_free_position = preloaded;
             // Copy saved state
-            rq->asr_saved_state = std::shared_ptr<rapidjson::Document>(new rapidjson::Document());
-            rq->asr_saved_state->CopyFrom(j_entry, rq->asr_saved_state->GetAllocator());
+            SavegameActorArrays const& arrays = data.actors[index];
+            rq->asr_saved_state = std::make_shared<SavedActorState>();
+            rq->asr_saved_state->sas_entry.CopyFrom(j_entry, rq->asr_saved_state->sas_entry.GetAllocator());
+            rq->asr_saved_state->sas_nodes.assign(arrays.nodes, arrays.nodes + arrays.num_nodes);
+            rq->asr_saved_state->sas_beams.assign(arrays.beams, arrays.beams + arrays.num_beams);
 
             App::GetGameContext()->PushMessage(Message(MSG_SIM_SPAWN_ACTOR_REQUESTED, (void*)rq));
             actors_changed = true;
@@ -384,7 +678,24 @@ bool ActorManager::LoadScene(Ogre::String filename)
         actors_changed = true;
     }
 
+    // Node and beam arrays of existing actors are independent, restore them in parallel
     const int num_actors = static_cast<int>(j_doc["actors"].Size());
+    std::vector<char> arrays_ok(num_actors, 0);
+    std::vector<std::function<void()>> tasks;
+    for (int index = 0; index < num_actors; index++)
+    {
+        if (actors[index] == nullptr)
+            continue;
+
+        tasks.push_back([&actors, &data, &arrays_ok, index]()
+        {
+            SavegameActorArrays const& arrays = data.actors[index];
+            arrays_ok[index] = ActorManager::RestoreSavedNodesAndBeams(actors[index],
+                arrays.nodes, arrays.num_nodes, arrays.beams, arrays.num_beams);
+        });
+    }
+    App::GetThreadPool()->Parallelize(tasks);
+
     for (int index = 0; index < num_actors; index++)
     {
         if (actors[index] == nullptr)
@@ -393,7 +704,7 @@ bool ActorManager::LoadScene(Ogre::String filename)
         Actor* actor = actors[index];
         rapidjson::Value& j_entry = j_doc["actors"][index];
 
-        this->RestoreSavedState(actor, j_entry);
+        this->RestoreSavedState(actor, j_entry, (arrays_ok[index]) ? data.actors[index].beams : nullptr);
     }
 
     if (filename != "autosave.sav")
@@ -407,6 +718,9 @@ bool ActorManager::LoadScene(Ogre::String filename)
 
 bool ActorManager::SaveScene(Ogre::String filename)
 {
+    this->SyncWithSimThread(); // Snapshot at physics step boundary
+    this->WaitForSavegameWrite();
+
     std::vector<Actor*> x_actors = GetLocalActors();
 
     if (App::mp_state->getEnum<MpState>() == RoR::MpState::CONNECTED)
@@ -464,6 +778,17 @@ bool ActorManager::SaveScene(Ogre::String filename)
         }
     }
 
+    // Binary savegame buffer - node/beam arrays are copied right in
+    size_t buf_size = sizeof(SavegameHeader) + (x_actors.size() * sizeof(SavegameActorIndex));
+    for (auto actor : x_actors)
+    {
+        buf_size += (actor->ar_num_nodes * sizeof(SavedNode)) + (actor->ar_num_beams * sizeof(SavedBeam)) + 16;
+    }
+    std::shared_ptr<std::string> buf = std::make_shared<std::string>();
+    buf->reserve(buf_size + 64 * 1024); // Scene description is appended last
+    buf->resize(sizeof(SavegameHeader) + (x_actors.size() * sizeof(SavegameActorIndex)));
+    std::vector<SavegameActorIndex> index;
+
     // Actors
     rapidjson::Value j_actors(rapidjson::kArrayType);
     for (auto actor : x_actors)
@@ -681,75 +1006,160 @@ bool ActorManager::SaveScene(Ogre::String filename)
 
         j_entry.AddMember("slidenodes_locked", actor->m_slidenodes_locked, j_doc.GetAllocator());
 
-        // Nodes
-        rapidjson::Value j_nodes(rapidjson::kArrayType);
+        // Nodes and beams
+        SavegameActorIndex index_rec;
+        std::memset(&index_rec, 0, sizeof(index_rec));
+        index_rec.num_nodes = static_cast<uint32_t>(actor->ar_num_nodes);
+        index_rec.num_beams = static_cast<uint32_t>(actor->ar_num_beams);
+
+        AlignSavegameBuffer(*buf);
+        index_rec.nodes_offset = buf->size();
         for (int i = 0; i < actor->ar_num_nodes; i++)
         {
-            rapidjson::Value j_node(rapidjson::kArrayType);
-
-            // Position
-            j_node.PushBack(actor->ar_nodes[i].AbsPosition.x, j_doc.GetAllocator());
-            j_node.PushBack(actor->ar_nodes[i].AbsPosition.y, j_doc.GetAllocator());
-            j_node.PushBack(actor->ar_nodes[i].AbsPosition.z, j_doc.GetAllocator());
-
-            // Velocity
-            j_node.PushBack(actor->ar_nodes[i].Velocity.x, j_doc.GetAllocator());
-            j_node.PushBack(actor->ar_nodes[i].Velocity.y, j_doc.GetAllocator());
-            j_node.PushBack(actor->ar_nodes[i].Velocity.z, j_doc.GetAllocator());
-
-            // Initial Position
-            j_node.PushBack(actor->ar_initial_node_positions[i].x, j_doc.GetAllocator());
-            j_node.PushBack(actor->ar_initial_node_positions[i].y, j_doc.GetAllocator());
-            j_node.PushBack(actor->ar_initial_node_positions[i].z, j_doc.GetAllocator());
-
-            j_nodes.PushBack(j_node, j_doc.GetAllocator());
+            SavedNode node;
+            for (int k = 0; k < 3; k++)
+            {
+                node.sn_position[k]         = actor->ar_nodes[i].AbsPosition[k];
+                node.sn_velocity[k]         = actor->ar_nodes[i].Velocity[k];
+                node.sn_initial_position[k] = actor->ar_initial_node_positions[i][k];
+            }
+            AppendRecord(*buf, node);
         }
-        j_entry.AddMember("nodes", j_nodes, j_doc.GetAllocator());
 
-        // Beams
-        rapidjson::Value j_beams(rapidjson::kArrayType);
+        AlignSavegameBuffer(*buf);
+        index_rec.beams_offset = buf->size();
         for (int i = 0; i < actor->ar_num_beams; i++)
         {
-            rapidjson::Value j_beam(rapidjson::kArrayType);
-
-            j_beam.PushBack(actor->ar_beams[i].maxposstress, j_doc.GetAllocator());
-            j_beam.PushBack(actor->ar_beams[i].maxnegstress, j_doc.GetAllocator());
-            j_beam.PushBack(actor->ar_beams[i].minmaxposnegstress, j_doc.GetAllocator());
-            j_beam.PushBack(actor->ar_beams[i].strength, j_doc.GetAllocator());
-            j_beam.PushBack(actor->ar_beams[i].L, j_doc.GetAllocator());
-            j_beam.PushBack(actor->ar_beams[i].bm_broken, j_doc.GetAllocator());
-            j_beam.PushBack(actor->ar_beams[i].bm_disabled, j_doc.GetAllocator());
-            j_beam.PushBack(actor->ar_beams[i].bm_inter_actor, j_doc.GetAllocator());
+            SavedBeam beam;
+            std::memset(&beam, 0, sizeof(beam)); // Deterministic padding
+            beam.sb_maxposstress       = actor->ar_beams[i].maxposstress;
+            beam.sb_maxnegstress       = actor->ar_beams[i].maxnegstress;
+            beam.sb_minmaxposnegstress = actor->ar_beams[i].minmaxposnegstress;
+            beam.sb_strength           = actor->ar_beams[i].strength;
+            beam.sb_L                  = actor->ar_beams[i].L;
+            beam.sb_broken             = actor->ar_beams[i].bm_broken;
+            beam.sb_disabled           = actor->ar_beams[i].bm_disabled;
+            beam.sb_inter_actor        = actor->ar_beams[i].bm_inter_actor;
             Actor* locked_actor = actor->ar_beams[i].bm_locked_actor;
-            j_beam.PushBack(locked_actor ? vector_index_lookup[locked_actor->ar_vector_index] : -1, j_doc.GetAllocator());
-
-            j_beams.PushBack(j_beam, j_doc.GetAllocator());
+            beam.sb_locked_actor       = locked_actor ? vector_index_lookup[locked_actor->ar_vector_index] : -1;
+            AppendRecord(*buf, beam);
         }
-        j_entry.AddMember("beams", j_beams, j_doc.GetAllocator());
+        index.push_back(index_rec);
 
         j_actors.PushBack(j_entry, j_doc.GetAllocator());
     }
     j_doc.AddMember("actors", j_actors, j_doc.GetAllocator());
 
-    // Write to disk
-    if (!App::GetContentManager()->SerializeAndWriteJson(filename, RGN_SAVEGAMES, j_doc))
+    // JSON export, for tooling: everything in one document, written right away
+    if (StringUtil::endsWith(filename, ".json"))
     {
-        // Error already logged
+        for (size_t i = 0; i < index.size(); i++)
+        {
+            SavegameActorArrays arrays;
+            arrays.nodes     = reinterpret_cast<SavedNode const*>(buf->data() + index[i].nodes_offset);
+            arrays.num_nodes = index[i].num_nodes;
+            arrays.beams     = reinterpret_cast<SavedBeam const*>(buf->data() + index[i].beams_offset);
+            arrays.num_beams = index[i].num_beams;
+            ExportNodesAndBeamsToJson(j_doc["actors"][static_cast<rapidjson::SizeType>(i)], arrays, j_doc.GetAllocator());
+        }
+
+        if (!App::GetContentManager()->SerializeAndWriteJson(filename, RGN_SAVEGAMES, j_doc))
+        {
+            // Error already logged
+            App::GetConsole()->putMessage(
+                Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_ERROR, _L("Error while saving scene"));
+            return false;
+        }
+
         App::GetConsole()->putMessage(
-            Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_ERROR, _L("Error while saving scene"));
+            Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_NOTICE, _L("Scene saved"));
+        return true;
+    }
+
+    // Scene description
+    rapidjson::StringBuffer j_buffer;
+    rapidjson::Writer<rapidjson::StringBuffer, rapidjson::UTF8<>, rapidjson::UTF8<>,
+                      rapidjson::CrtAllocator, rapidjson::kWriteNanAndInfFlag>
+                      j_writer(j_buffer);
+    j_doc.Accept(j_writer);
+
+    SavegameHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.signature, SAVEGAME_SIGNATURE, sizeof(header.signature));
+    header.format_version   = SAVEGAME_BINARY_FORMAT;
+    header.node_record_size = sizeof(SavedNode);
+    header.beam_record_size = sizeof(SavedBeam);
+    header.num_actors       = static_cast<uint32_t>(index.size());
+    header.json_offset      = buf->size();
+    header.json_size        = j_buffer.GetSize();
+    buf->append(j_buffer.GetString(), j_buffer.GetSize());
+
+    std::memcpy(&(*buf)[0], &header, sizeof(header));
+    if (!index.empty())
+    {
+        std::memcpy(&(*buf)[sizeof(header)], index.data(), index.size() * sizeof(SavegameActorIndex));
+    }
+
+    // Write to disk in background
+    const std::string path = PathCombine(App::sys_savegames_dir->getStr(), filename);
+    const std::string error_msg = _L("Error while saving scene");
+    const std::string notice_msg = (filename != "autosave.sav") ? _L("Scene saved") : "";
+    m_savegame_task = App::GetThreadPool()->RunTask([buf, path, error_msg, notice_msg]()
+    {
+        if (!WriteSavegameFile(path, *buf)) // Logs errors
+        {
+            App::GetConsole()->putMessage(
+                Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_ERROR, error_msg);
+        }
+        else if (notice_msg != "")
+        {
+            App::GetConsole()->putMessage(
+                Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_NOTICE, notice_msg);
+        }
+    });
+
+    return true;
+}
+
+void ActorManager::WaitForSavegameWrite()
+{
+    if (m_savegame_task)
+        m_savegame_task->join();
+}
+
+bool ActorManager::RestoreSavedNodesAndBeams(Actor* actor, SavedNode const* nodes, size_t num_nodes,
+                                             SavedBeam const* beams, size_t num_beams)
+{
+    if (num_nodes != static_cast<size_t>(actor->ar_num_nodes) || num_beams != static_cast<size_t>(actor->ar_num_beams))
+    {
+        RoR::LogFormat("[RoR|Savegame] Node/beam count mismatch for actor '%s', keeping current state", actor->ar_filename.c_str());
         return false;
     }
 
-    if (filename != "autosave.sav")
+    for (size_t i = 0; i < num_nodes; i++)
     {
-        App::GetConsole()->putMessage(
-            Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_NOTICE, _L("Scene saved"));
+        actor->ar_nodes[i].AbsPosition      = Vector3(nodes[i].sn_position);
+        actor->ar_nodes[i].RelPosition      = actor->ar_nodes[i].AbsPosition - actor->ar_origin;
+        actor->ar_nodes[i].Velocity         = Vector3(nodes[i].sn_velocity);
+        actor->ar_initial_node_positions[i] = Vector3(nodes[i].sn_initial_position);
+    }
+
+    for (size_t i = 0; i < num_beams; i++)
+    {
+        actor->ar_beams[i].maxposstress       = beams[i].sb_maxposstress;
+        actor->ar_beams[i].maxnegstress       = beams[i].sb_maxnegstress;
+        actor->ar_beams[i].minmaxposnegstress = beams[i].sb_minmaxposnegstress;
+        actor->ar_beams[i].strength           = beams[i].sb_strength;
+        actor->ar_beams[i].L                  = beams[i].sb_L;
+        actor->ar_beams[i].bm_broken          = beams[i].sb_broken != 0;
+        actor->ar_beams[i].bm_disabled        = beams[i].sb_disabled != 0;
+        actor->ar_beams[i].bm_inter_actor     = beams[i].sb_inter_actor != 0;
     }
 
     return true;
 }
 
-void ActorManager::RestoreSavedState(Actor* actor, rapidjson::Value const& j_entry)
+void ActorManager::RestoreSavedState(Actor* actor, rapidjson::Value const& j_entry, SavedBeam const* beams)
 {
     actor->m_spawn_rotation = j_entry["spawn_rotation"].GetFloat();
     actor->ar_state = static_cast<ActorState>(j_entry["sim_state"].GetInt());
@@ -895,31 +1305,12 @@ void ActorManager::RestoreSavedState(Actor* actor, rapidjson::Value const& j_ent
         }
     }
 
-    auto nodes = j_entry["nodes"].GetArray();
-    for (rapidjson::SizeType i = 0; i < nodes.Size(); i++)
-    {
-        auto data = nodes[i].GetArray();
-        actor->ar_nodes[i].AbsPosition      = Vector3(data[0].GetFloat(), data[1].GetFloat(), data[2].GetFloat());
-        actor->ar_nodes[i].RelPosition      = actor->ar_nodes[i].AbsPosition - actor->ar_origin;
-        actor->ar_nodes[i].Velocity         = Vector3(data[3].GetFloat(), data[4].GetFloat(), data[5].GetFloat());
-        actor->ar_initial_node_positions[i] = Vector3(data[6].GetFloat(), data[7].GetFloat(), data[8].GetFloat());
-    }
-
     std::vector<Actor*> actors = this->GetLocalActors();
 
-    auto beams = j_entry["beams"].GetArray();
-    for (rapidjson::SizeType i = 0; i < beams.Size(); i++)
-    {
-        auto data = beams[i].GetArray();
-        actor->ar_beams[i].maxposstress       = data[0].GetFloat();
-        actor->ar_beams[i].maxnegstress       = data[1].GetFloat();
-        actor->ar_beams[i].minmaxposnegstress = data[2].GetFloat();
-        actor->ar_beams[i].strength           = data[3].GetFloat();
-        actor->ar_beams[i].L                  = data[4].GetFloat();
-        actor->ar_beams[i].bm_broken          = data[5].GetBool();
-        actor->ar_beams[i].bm_disabled        = data[6].GetBool();
-        actor->ar_beams[i].bm_inter_actor     = data[7].GetBool();
-        int locked_actor                      = data[8].GetInt();
+    // Inter-actor beams; the rest of node/beam state is done by `RestoreSavedNodesAndBeams()`
+    for (int i = 0; beams != nullptr && i < actor->ar_num_beams; i++)
+    {
+        int locked_actor = beams[i].sb_locked_actor;
         if (locked_actor != -1 &&
             locked_actor < (int)actors.size() &&
             actors[locked_actor] != nullptr)
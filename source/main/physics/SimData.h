@@ -652,6 +652,37 @@ struct authorinfo_t
     Ogre::String email;
 };
 
+/// Savegame: node state, stored as-is in binary savegames
+struct SavedNode
+{
+    float               sn_position[3];
+    float               sn_velocity[3];
+    float               sn_initial_position[3];
+};
+
+/// Savegame: beam state, stored as-is in binary savegames
+struct SavedBeam
+{
+    float               sb_maxposstress;
+    float               sb_maxnegstress;
+    float               sb_minmaxposnegstress;
+    float               sb_strength;
+    float               sb_L;
+    int32_t             sb_locked_actor;             //!< Index into the savegame's actor list, -1 if none
+    uint8_t             sb_broken;
+    uint8_t             sb_disabled;
+    uint8_t             sb_inter_actor;
+    uint8_t             sb_padding;
+};
+
+/// Savegame: everything needed to restore an actor after it's spawned
+struct SavedActorState
+{
+    rapidjson::Document     sas_entry;               //!< Actor entry in the JSON scene description, without node/beam arrays
+    std::vector<SavedNode>  sas_nodes;
+    std::vector<SavedBeam>  sas_beams;
+};
+
 struct ActorSpawnRequest
 {
     enum class Origin //!< Enables special processing
@@ -679,7 +710,7 @@ struct ActorSpawnRequest
     int                 net_stream_id = 0;
     bool                asr_free_position = false;   //!< Disables the automatic spawn position adjustment
     bool                asr_terrn_machine = false;   //!< This is a fixed machinery
-    std::shared_ptr<rapidjson::Document>
+    std::shared_ptr<SavedActorState>
                         asr_saved_state;             //!< Pushes msg MODIFY_ACTOR (type RESTORE_SAVED) after spawn.
 };
 
@@ -698,7 +729,7 @@ struct ActorModifyRequest
 
     Actor*              amr_actor;
     Type                amr_type;
-    std::shared_ptr<rapidjson::Document>
+    std::shared_ptr<SavedActorState>
                         amr_saved_state;
 };
 
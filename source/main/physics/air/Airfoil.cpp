@@ -23,18 +23,44 @@
 #include "Application.h"
 
 #include <Ogre.h>
+#include <cmath>
+#include <map>
+#include <mutex>
 
 using namespace Ogre;
 using namespace RoR;
 
+static const float AIR_DENSITY_MIN_ALTITUDE = -1000.f;    //!< Meters
+static const float AIR_DENSITY_MAX_ALTITUDE = 40000.f;    //!< Meters; the model has no air left at ~44km
+static const size_t AIR_DENSITY_RESOLUTION = 4096;
+
 Airfoil::Airfoil(Ogre::String const& fname)
 {
-    for (int i = 0; i < 3601; i++) //init in case of bad things
+    m_tables = Airfoil::LoadTables(fname);
+}
+
+Airfoil::~Airfoil()
+{
+}
+
+std::shared_ptr<Airfoil::Tables> Airfoil::LoadTables(Ogre::String const& fname)
+{
+    // Wings of one plane mostly use the same airfoil - parse it once and share the tables
+    static std::mutex registry_mutex;
+    static std::map<Ogre::String, std::weak_ptr<Tables>> registry;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    std::shared_ptr<Tables> tables = registry[fname].lock();
+    if (tables)
     {
-        cl[i] = 0;
-        cd[i] = 0;
-        cm[i] = 0;
+        return tables;
     }
+    tables = std::make_shared<Tables>();
+    registry[fname] = tables;
+
+    std::vector<float> cl(3601, 0.f); //init in case of bad things
+    std::vector<float> cd(3601, 0.f);
+    std::vector<float> cm(3601, 0.f);
     char line[1024];
     //we load directly X-Plane AFL file format!!!
     bool process = false;
@@ -53,76 +79,90 @@ Airfoil::Airfoil(Ogre::String const& fname)
     if (group == "")
     {
         LOG(String("Airfoil error: could not load airfoil ")+fname);
-        return;
     }
-
-    DataStreamPtr ds = rgm.openResource(fname, group);
-    while (!ds->eof())
+    else
     {
-        size_t ll = ds->readLine(line, 1023);
-        if (ll == 0)
-            continue;
-        //		fscanf(fd," %[^\n\r]",line);
-        if (!strncmp("alpha", line, 5))
-        {
-            process = true;
-            continue;
-        };
-        if (process)
+        DataStreamPtr ds = rgm.openResource(fname, group);
+        while (!ds->eof())
         {
-            float l, d, m;
-            int a, b;
-            sscanf(line, "%i.%i %f %f %f", &a, &b, &l, &d, &m);
-            if (neg)
-                b = -b;
-            if (a == 0 && b == 0)
-                neg = false;
-            int ia = (a * 10 + b) + 1800;
-            if (ia == 3600) { process = false; };
-            cl[ia] = l;
-            cd[ia] = d;
-            cm[ia] = m;
-            if (lastia != -1 && ia - lastia > 1)
+            size_t ll = ds->readLine(line, 1023);
+            if (ll == 0)
+                continue;
+            //		fscanf(fd," %[^\n\r]",line);
+            if (!strncmp("alpha", line, 5))
             {
-                //we have to interpolate previous elements (linear interpolation)
-                int i;
-                for (i = 0; i < ia - lastia - 1; i++)
+                process = true;
+                continue;
+            };
+            if (process)
+            {
+                float l, d, m;
+                int a, b;
+                sscanf(line, "%i.%i %f %f %f", &a, &b, &l, &d, &m);
+                if (neg)
+                    b = -b;
+                if (a == 0 && b == 0)
+                    neg = false;
+                int ia = (a * 10 + b) + 1800;
+                if (ia == 3600) { process = false; };
+                cl[ia] = l;
+                cd[ia] = d;
+                cm[ia] = m;
+                if (lastia != -1 && ia - lastia > 1)
                 {
-                    cl[lastia + 1 + i] = cl[lastia] + (float)(i + 1) * (cl[ia] - cl[lastia]) / (float)(ia - lastia);
-                    cd[lastia + 1 + i] = cd[lastia] + (float)(i + 1) * (cd[ia] - cd[lastia]) / (float)(ia - lastia);
-                    cm[lastia + 1 + i] = cm[lastia] + (float)(i + 1) * (cm[ia] - cm[lastia]) / (float)(ia - lastia);
+                    //we have to interpolate previous elements (linear interpolation)
+                    int i;
+                    for (i = 0; i < ia - lastia - 1; i++)
+                    {
+                        cl[lastia + 1 + i] = cl[lastia] + (float)(i + 1) * (cl[ia] - cl[lastia]) / (float)(ia - lastia);
+                        cd[lastia + 1 + i] = cd[lastia] + (float)(i + 1) * (cd[ia] - cd[lastia]) / (float)(ia - lastia);
+                        cm[lastia + 1 + i] = cm[lastia] + (float)(i + 1) * (cm[ia] - cm[lastia]) / (float)(ia - lastia);
+                    }
                 }
+                lastia = ia;
             }
-            lastia = ia;
         }
     }
+
+    // One sample per 0.1 degree
+    tables->cl.Assign(-180.f, 180.f, cl.data(), cl.size());
+    tables->cd.Assign(-180.f, 180.f, cd.data(), cd.size());
+    tables->cm.Assign(-180.f, 180.f, cm.data(), cm.size());
+    return tables;
 }
 
-Airfoil::~Airfoil()
+void Airfoil::getparams(float a, float cratio, float cdef, float* ocl, float* ocd, float* ocm)
 {
+    this->getparamsBatch(&a, &cratio, &cdef, 1, ocl, ocd, ocm);
 }
 
-void Airfoil::getparams(float a, float cratio, float cdef, float* ocl, float* ocd, float* ocm)
+void Airfoil::getparamsBatch(const float* a, const float* cratio, const float* cdef, size_t count, float* ocl, float* ocd, float* ocm)
+{
+    const Tables& tables = *m_tables;
+    for (size_t i = 0; i < count; i++)
+    {
+        //drag shift
+        const float dva = a[i] + 1.15f * (1.0f - cratio[i]) * cdef[i];
+        const float sign = (cdef[i] < 0) ? -1.0f : 1.0f;
+        const float flap = sign * (1.0f - cratio[i]) * std::sqrt(std::abs(cdef[i]));
+        ocl[i] = tables.cl.EvaluatePeriodic(a[i]) - 0.66f * flap;
+        ocd[i] = tables.cd.EvaluatePeriodic(dva) + 0.00015f * (1.0f - cratio[i]) * cdef[i] * cdef[i];
+        ocm[i] = tables.cm.EvaluatePeriodic(a[i]) + 0.20f * flap;
+    }
+}
+
+float Airfoil::getAirDensity(float altitude)
 {
-    int ta = (int)(a / 360.0);
-    //		float va=360.0f*fmod(a, 360.0f); FMOD IS TOTALLY UNRELIABLE HERE : fmod(-180.0f, 360.0f)=-180.0f!!!!!
-    float va = a - (float)(ta * 360);
-    if (va > 180.0f)
-        va -= 360.0f;
-    if (va < -180.0f)
-        va += 360.0f;
-    int ia = (int)((va + 180.0f) * 10.0f);
-    //drag shift
-    float dva = va + 1.15 * (1.0 - cratio) * cdef;
-    if (dva > 180.0f)
-        dva -= 360.0f;
-    if (dva < -180.0f)
-        dva += 360.0f;
-    int dia = (int)((dva + 180.0f) * 10.0f);
-    float sign = 1.0;
-    if (cdef < 0)
-        sign = -1.0;
-    *ocl = cl[ia] - 0.66 * sign * (1.0 - cratio) * sqrt(fabs(cdef));
-    *ocd = cd[dia] + 0.00015 * (1.0 - cratio) * cdef * cdef;
-    *ocm = cm[ia] + 0.20 * sign * (1.0 - cratio) * sqrt(fabs(cdef));
+    static const BakedCurve curve = []()
+        {
+            BakedCurve baked;
+            baked.Bake(AIR_DENSITY_MIN_ALTITUDE, AIR_DENSITY_MAX_ALTITUDE, AIR_DENSITY_RESOLUTION, [](float alt)
+                {
+                    float sea_level_pressure = 101325; //in Pa
+                    float airpressure = sea_level_pressure * pow(1.0 - 0.0065 * alt / 288.15, 5.24947); //in Pa
+                    return (float)(airpressure * 0.0000120896); //1.225 at sea level
+                });
+            return baked;
+        }();
+    return curve.Evaluate(altitude);
 }
@@ -21,6 +21,9 @@
 #pragma once
 
 #include "Application.h"
+#include "BakedCurve.h"
+
+#include <memory>
 
 namespace RoR {
 
@@ -29,18 +32,36 @@ class Airfoil : public ZeroedMemoryAllocator
 {
 public:
 
-    /// Parses the airfoil from file.
+    /// Parses the airfoil from file; the coefficient tables are shared by all airfoils loaded from the same file.
     /// @param fname File name (X-Plane's .AFL file format)
     Airfoil(Ogre::String const& fname);
     ~Airfoil();
 
+    /// @param a Angle of attack in degrees, any range
+    /// @param cratio Chord ratio of the control surface
+    /// @param cdef Control surface deflection in degrees
     void getparams(float a, float cratio, float cdef, float* ocl, float* ocd, float* ocm);
 
+    /// Batched `getparams()`, for all wings of an actor which share this airfoil.
+    void getparamsBatch(const float* a, const float* cratio, const float* cdef, size_t count, float* ocl, float* ocd, float* ocm);
+    bool isSameAirfoil(Airfoil const* other) const { return m_tables == other->m_tables; } //!< True if both were loaded from the same file
+
+    /// Air density in kg/m3 at the given altitude; tropospheric model valid up to 11.000m (33.000ft).
+    static float getAirDensity(float altitude);
+
 private:
 
-    float cl[3601];
-    float cd[3601];
-    float cm[3601];
+    /// Lift, drag and moment coefficients by angle of attack, -180 to 180 degrees.
+    struct Tables
+    {
+        BakedCurve cl;
+        BakedCurve cd;
+        BakedCurve cm;
+    };
+
+    static std::shared_ptr<Tables> LoadTables(Ogre::String const& fname);
+
+    std::shared_ptr<Tables> m_tables;
 };
 
 } // namespace RoR
@@ -220,13 +220,7 @@ void Turboprop::updateForces(float dt, int doUpdate)
 {
     if (doUpdate)
     {
-        //tropospheric model valid up to 11.000m (33.000ft)
-        float altitude = m_actor->ar_nodes[noderef].AbsPosition.y;
-        //float sea_level_temperature=273.15+15.0; //in Kelvin
-        float sea_level_pressure = 101325; //in Pa
-        //float airtemperature=sea_level_temperature-altitude*0.0065; //in Kelvin
-        float airpressure = sea_level_pressure * pow(1.0 - 0.0065 * altitude / 288.15, 5.24947); //in Pa
-        airdensity = airpressure * 0.0000120896;//1.225 at sea level
+        airdensity = Airfoil::getAirDensity(m_actor->ar_nodes[noderef].AbsPosition.y);
         SOUND_MODULATE(m_actor->ar_instance_id, mod_id, rpm);
     }
 
@@ -349,13 +343,16 @@ void Turboprop::updateForces(float dt, int doUpdate)
             Vector3 tipf = -refchordv;
             totaltipforce += (tipforce - rpm / 10.0) * tipf; //add a bit of mechanical friction
             //for each blade segment (there are 6 elements)
-            for (int j = 0; j < 5; j++) //outer to inner, the 6th blade element is ignored
+            const int NUM_SEGMENTS = 5; //outer to inner, the 6th blade element is ignored
+            Vector3 winds[NUM_SEGMENTS];
+            Vector3 liftvs[NUM_SEGMENTS];
+            float aoas[NUM_SEGMENTS];
+            for (int j = 0; j < NUM_SEGMENTS; j++)
             {
                 //proportion
                 float proport = ((float)j + 0.5) / 6.0;
                 //evaluate wind direction
                 Vector3 wind = -(m_actor->ar_nodes[nodep[i]].Velocity * (1.0 - proport) + m_actor->ar_nodes[noderef].Velocity * proport);
-                float wspeed = wind.length();
 
                 Vector3 liftv = spanv.crossProduct(-wind);
                 liftv.normalise();
@@ -375,9 +372,23 @@ void Turboprop::updateForces(float dt, int doUpdate)
                     aoa = -aoa;
                     raoa = -raoa;
                 };
-                //get airfoil data
-                float cz, cx, cm;
-                airfoil->getparams(aoa, 1.0, 0.0, &cz, &cx, &cm);
+                winds[j] = wind;
+                liftvs[j] = liftv;
+                aoas[j] = aoa;
+            }
+            //get airfoil data, all segments at once
+            const float cratios[NUM_SEGMENTS] = { 1.0, 1.0, 1.0, 1.0, 1.0 };
+            const float cdefs[NUM_SEGMENTS] = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+            float czs[NUM_SEGMENTS], cxs[NUM_SEGMENTS], cms[NUM_SEGMENTS];
+            airfoil->getparamsBatch(aoas, cratios, cdefs, NUM_SEGMENTS, czs, cxs, cms);
+            for (int j = 0; j < NUM_SEGMENTS; j++)
+            {
+                float proport = ((float)j + 0.5) / 6.0;
+                const Vector3 wind = winds[j];
+                const Vector3 liftv = liftvs[j];
+                float wspeed = wind.length();
+                float cz = czs[j];
+                float cx = cxs[j];
                 //surface computation
                 float s = radius * bladewidth / 6.0;
 
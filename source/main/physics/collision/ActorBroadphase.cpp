@@ -0,0 +1,111 @@
+/*
+    This source file is part of Rigs of Rods
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ActorBroadphase.h"
+
+#include "Actor.h"
+#include "Application.h"
+
+#include <algorithm>
+#include <cfloat>
+
+using namespace RoR;
+
+void ActorBroadphase::Update(std::vector<Actor*> const& actors)
+{
+    const unsigned int num_actors = static_cast<unsigned int>(actors.size());
+
+    if (actors != m_actors)
+    {
+        // Spawn or removal - start over with a fresh order
+        m_actors = actors;
+        m_order.resize(num_actors);
+        for (unsigned int i = 0; i < num_actors; i++)
+        {
+            m_order[i] = i;
+        }
+        m_min_x.resize(num_actors);
+        m_max_x.resize(num_actors);
+        m_partners.resize(num_actors);
+    }
+
+    for (unsigned int i = 0; i < num_actors; i++)
+    {
+        const Ogre::AxisAlignedBox& box = m_actors[i]->ar_bounding_box;
+        if (box.isNull())
+        {
+            m_min_x[i] = FLT_MAX; // Sorts to the end and never overlaps
+            m_max_x[i] = -FLT_MAX;
+        }
+        else if (box.isInfinite())
+        {
+            m_min_x[i] = -FLT_MAX;
+            m_max_x[i] = FLT_MAX;
+        }
+        else
+        {
+            m_min_x[i] = box.getMinimum().x;
+            m_max_x[i] = box.getMaximum().x;
+        }
+        m_partners[i].clear();
+    }
+
+    // Insertion sort; the order from the previous step is almost sorted already
+    for (unsigned int i = 1; i < num_actors; i++)
+    {
+        const unsigned int index = m_order[i];
+        const float min_x = m_min_x[index];
+        unsigned int j = i;
+        while (j > 0 && m_min_x[m_order[j - 1]] > min_x)
+        {
+            m_order[j] = m_order[j - 1];
+            j--;
+        }
+        m_order[j] = index;
+    }
+
+    // Sweep along X, test the remaining axes on overlap
+    for (unsigned int i = 0; i < num_actors; i++)
+    {
+        const unsigned int a = m_order[i];
+        for (unsigned int j = i + 1; j < num_actors; j++)
+        {
+            const unsigned int b = m_order[j];
+            if (m_min_x[b] > m_max_x[a])
+            {
+                break;
+            }
+            if (m_actors[a]->ar_bounding_box.intersects(m_actors[b]->ar_bounding_box))
+            {
+                m_partners[a].push_back(m_actors[b]);
+                m_partners[b].push_back(m_actors[a]);
+            }
+        }
+    }
+
+    // Keep the brute-force ordering, `PointColDetector` compares partner lists between steps
+    for (auto& partners : m_partners)
+    {
+        std::sort(partners.begin(), partners.end(), [](Actor* a, Actor* b) { return a->ar_vector_index < b->ar_vector_index; });
+    }
+}
+
+std::vector<Actor*> const& ActorBroadphase::GetPartners(Actor* actor) const
+{
+    ROR_ASSERT(actor->ar_vector_index < m_partners.size() && m_actors[actor->ar_vector_index] == actor);
+    return m_partners[actor->ar_vector_index];
+}
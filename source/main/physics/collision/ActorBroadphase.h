@@ -0,0 +1,52 @@
+/*
+    This source file is part of Rigs of Rods
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief Sweep-and-prune pair finding over actor bounding boxes.
+
+#pragma once
+
+#include "ForwardDeclarations.h"
+
+#include <vector>
+
+namespace RoR {
+
+/// Finds all pairs of actors with intersecting `ar_bounding_box`, once per physics step.
+///
+/// Boxes are sorted along X and swept; the sort order is kept between steps, so with
+/// coherent motion the insertion sort runs in near-linear time. Owned by `ActorManager`,
+/// consumed by `PointColDetector::UpdateInterPoint()` from the parallel collision phase.
+class ActorBroadphase
+{
+public:
+    /// Recomputes the partner lists; call from the sim thread before resolving inter-actor collisions.
+    void Update(std::vector<Actor*> const& actors);
+
+    /// Actors whose bounding box intersects the given one, in `ActorManager` order.
+    /// Valid until the next `Update()`; the actor must have been part of it.
+    std::vector<Actor*> const& GetPartners(Actor* actor) const;
+
+private:
+    std::vector<Actor*>              m_actors;   //!< Actor list of the last update, to detect spawns/removals
+    std::vector<unsigned int>        m_order;    //!< Indices into `m_actors`, sorted by `m_min_x`
+    std::vector<float>               m_min_x;
+    std::vector<float>               m_max_x;
+    std::vector<std::vector<Actor*>> m_partners; //!< Indexed by `Actor::ar_vector_index`
+};
+
+} // namespace RoR
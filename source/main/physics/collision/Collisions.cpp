@@ -33,8 +33,13 @@
 #include "MovableText.h"
 #include "PlatformUtils.h"
 #include "ScriptEngine.h"
+#include "TerrainGeometryManager.h"
 #include "TerrainManager.h"
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
 using namespace RoR;
 
 // some gcc fixes
@@ -122,6 +127,7 @@ Collisions::Collisions(Ogre::Vector3 terrn_size):
     , free_eventsource(0)
     , hashmask(0)
     , landuse(0)
+    , m_cell_index_version(0)
     , m_terrain_size(terrn_size)
 {
     debugMode = App::diag_collisions->getBool(); // TODO: make interactive - do not copy the value, use GVar directly
@@ -131,6 +137,11 @@ Collisions::Collisions(Ogre::Vector3 terrn_size):
         hashmask++;
     }
 
+    if (App::sim_legacy_collision_hash->getBool())
+    {
+        m_legacy_hashtable = std::unique_ptr<legacy_hashtable_t>(new legacy_hashtable_t());
+    }
+
     loadDefaultModels();
     defaultgm = getGroundModelByString("concrete");
     defaultgroundgm = getGroundModelByString("gravel");
@@ -389,18 +400,100 @@ unsigned int Collisions::hashfunc(unsigned int cellid)
 void Collisions::hash_add(int cell_x, int cell_z, int value, float h)
 {
     unsigned int cell_id = (cell_x << 16) + cell_z;
-    unsigned int pos    = hashfunc(cell_id);
 
-    hashtable[pos].emplace_back(cell_id, value);
-    hashtable_height[pos] = std::max(hashtable_height[pos], h);
+    if (m_legacy_hashtable)
+    {
+        unsigned int pos = hashfunc(cell_id);
+        m_legacy_hashtable->elements[pos].emplace_back(cell_id, value);
+        m_legacy_hashtable->height[pos] = std::max(m_legacy_hashtable->height[pos], h);
+    }
+    else
+    {
+        m_pending_elements.push_back(pending_element_t{hash_coll_element_t(cell_id, value), h});
+    }
+}
+
+Collisions::hash_cell_t Collisions::hash_find(int cell_x, int cell_z)
+{
+    unsigned int cell_id = (cell_x << 16) + cell_z;
+    hash_cell_t cell;
+
+    if (m_legacy_hashtable)
+    {
+        unsigned int pos = hashfunc(cell_id);
+        std::vector<hash_coll_element_t> const& bucket = m_legacy_hashtable->elements[pos];
+        cell.begin  = bucket.data();
+        cell.end    = bucket.data() + bucket.size();
+        cell.height = m_legacy_hashtable->height[pos];
+        return cell;
+    }
+
+    auto itor = std::lower_bound(m_cell_ids.begin(), m_cell_ids.end(), cell_id);
+    if (itor == m_cell_ids.end() || *itor != cell_id)
+    {
+        cell.begin  = nullptr;
+        cell.end    = nullptr;
+        cell.height = -std::numeric_limits<float>::max();
+        return cell;
+    }
+
+    const size_t index = std::distance(m_cell_ids.begin(), itor);
+    cell.begin  = m_cell_elements.data() + m_cell_offsets[index];
+    cell.end    = m_cell_elements.data() + m_cell_offsets[index + 1];
+    cell.height = m_cell_heights[index];
+    return cell;
 }
 
-int Collisions::hash_find(int cell_x, int cell_z)
+void Collisions::updateCellIndex()
 {
-    unsigned int cellid = (cell_x << 16) + cell_z;
-    unsigned int pos    = hashfunc(cellid);
+    if (m_pending_elements.empty())
+        return;
+
+    // Merge the new elements behind the existing ones of the same cell, so the order of addition is kept
+    std::stable_sort(m_pending_elements.begin(), m_pending_elements.end(),
+        [](pending_element_t const& a, pending_element_t const& b) { return a.element.cell_id < b.element.cell_id; });
+
+    std::vector<hash_coll_element_t> elements;
+    std::vector<unsigned int> cell_ids;
+    std::vector<unsigned int> cell_offsets;
+    std::vector<float> cell_heights;
+    elements.reserve(m_cell_elements.size() + m_pending_elements.size());
+    size_t old_cell = 0;
+    size_t pending = 0;
+    while (old_cell < m_cell_ids.size() || pending < m_pending_elements.size())
+    {
+        unsigned int cell_id = (pending < m_pending_elements.size()) ? m_pending_elements[pending].element.cell_id : m_cell_ids[old_cell];
+        if (old_cell < m_cell_ids.size())
+        {
+            cell_id = std::min(cell_id, m_cell_ids[old_cell]);
+        }
+        cell_ids.push_back(cell_id);
+        cell_offsets.push_back(static_cast<unsigned int>(elements.size()));
+        float height = -std::numeric_limits<float>::max();
 
-    return static_cast<int>(pos);
+        if (old_cell < m_cell_ids.size() && m_cell_ids[old_cell] == cell_id)
+        {
+            elements.insert(elements.end(),
+                m_cell_elements.begin() + m_cell_offsets[old_cell], m_cell_elements.begin() + m_cell_offsets[old_cell + 1]);
+            height = m_cell_heights[old_cell];
+            old_cell++;
+        }
+        for (; pending < m_pending_elements.size() && m_pending_elements[pending].element.cell_id == cell_id; pending++)
+        {
+            elements.push_back(m_pending_elements[pending].element);
+            height = std::max(height, m_pending_elements[pending].height);
+        }
+        cell_heights.push_back(height);
+    }
+    cell_offsets.push_back(static_cast<unsigned int>(elements.size()));
+
+    m_cell_ids.swap(cell_ids);
+    m_cell_offsets.swap(cell_offsets);
+    m_cell_heights.swap(cell_heights);
+    m_cell_elements.swap(elements);
+    m_cell_index_version++;
+    m_pending_elements.clear();
+    m_pending_elements.shrink_to_fit();
 }
 
 int Collisions::addCollisionBox(SceneNode *tenode, bool rotating, bool virt, Vector3 pos, Ogre::Vector3 rot, Ogre::Vector3 l, Ogre::Vector3 h, Ogre::Vector3 sr, const Ogre::String &eventname, const Ogre::String &instancename, bool forcecam, Ogre::Vector3 campos, Ogre::Vector3 sc /* = Vector3::UNIT_SCALE */, Ogre::Vector3 dr /* = Vector3::ZERO */, CollisionEventFilter event_filter /* = EVENT_ALL */, int scripthandler /* = -1 */)
@@ -743,7 +836,7 @@ std::pair<bool, Ogre::Real> Collisions::intersectsTris(Ogre::Ray ray)
 {
     int steps = ray.getDirection().length() / (float)CELL_SIZE;
 
-    int lhash = -1;
+    const hash_coll_element_t* lcell = nullptr;
 
     for (int i = 0; i <= steps; i++)
     {
@@ -752,19 +845,18 @@ std::pair<bool, Ogre::Real> Collisions::intersectsTris(Ogre::Ray ray)
         // find the correct cell
         int refx = (int)(pos.x / (float)CELL_SIZE);
         int refz = (int)(pos.z / (float)CELL_SIZE);
-        int hash = hash_find(refx, refz);
+        const hash_cell_t cell = hash_find(refx, refz);
 
-        if (hash == lhash)
+        if (cell.begin == lcell)
             continue;
 
-        lhash = hash;
+        lcell = cell.begin;
 
-        size_t num_elements = hashtable[hash].size();
-        for (size_t k = 0; k < num_elements; k++)
+        for (const hash_coll_element_t* element = cell.begin; element != cell.end; element++)
         {
-            if (hashtable[hash][k].IsCollisionTri())
+            if (element->IsCollisionTri())
             {
-                const int ctri_index = hashtable[hash][k].element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
+                const int ctri_index = element->element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
                 collision_tri_t *ctri = &m_collision_tris[ctri_index];
 
                 if (!ctri->enabled)
@@ -794,17 +886,16 @@ float Collisions::getSurfaceHeightBelow(float x, float z, float height)
     // find the correct cell
     int refx = (int)(x / (float)CELL_SIZE);
     int refz = (int)(z / (float)CELL_SIZE);
-    int hash = hash_find(refx, refz);
+    const hash_cell_t cell = hash_find(refx, refz);
 
-    Vector3 origin = Vector3(x, hashtable_height[hash], z);
+    Vector3 origin = Vector3(x, cell.height, z);
     Ray ray(origin, -Vector3::UNIT_Y);
 
-    size_t num_elements = hashtable[hash].size();
-    for (size_t k = 0; k < num_elements; k++)
+    for (const hash_coll_element_t* element = cell.begin; element != cell.end; element++)
     {
-        if (hashtable[hash][k].IsCollisionBox())
+        if (element->IsCollisionBox())
         {
-            collision_box_t* cbox = &m_collision_boxes[hashtable[hash][k].element_index];
+            collision_box_t* cbox = &m_collision_boxes[element->element_index];
 
             if (!cbox->enabled)
                 continue;
@@ -850,7 +941,7 @@ float Collisions::getSurfaceHeightBelow(float x, float z, float height)
         }
         else // The element is a triangle
         {
-            const int ctri_index = hashtable[hash][k].element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
+            const int ctri_index = element->element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
             collision_tri_t *ctri = &m_collision_tris[ctri_index];
 
             if (!ctri->enabled)
@@ -882,9 +973,9 @@ bool Collisions::collisionCorrect(Vector3 *refpos, bool envokeScriptCallbacks)
     // find the correct cell
     int refx = (int)(refpos->x / (float)CELL_SIZE);
     int refz = (int)(refpos->z / (float)CELL_SIZE);
-    int hash = hash_find(refx, refz);
+    const hash_cell_t cell = hash_find(refx, refz);
 
-    if (refpos->y > hashtable_height[hash])
+    if (refpos->y > cell.height)
         return false;
 
     collision_tri_t *minctri = 0;
@@ -894,12 +985,11 @@ bool Collisions::collisionCorrect(Vector3 *refpos, bool envokeScriptCallbacks)
     bool contacted = false;
     bool isScriptCallbackEnvoked = false;
 
-    size_t num_elements = hashtable[hash].size();
-    for (size_t k = 0; k < num_elements; k++)
+    for (const hash_coll_element_t* element = cell.begin; element != cell.end; element++)
     {
-        if (hashtable[hash][k].IsCollisionBox())
+        if (element->IsCollisionBox())
         {
-            collision_box_t* cbox = &m_collision_boxes[hashtable[hash][k].element_index];
+            collision_box_t* cbox = &m_collision_boxes[element->element_index];
 
             if (!cbox->enabled)
                 continue;
@@ -979,7 +1069,7 @@ bool Collisions::collisionCorrect(Vector3 *refpos, bool envokeScriptCallbacks)
         }
         else // The element is a triangle
         {
-            const int ctri_index = hashtable[hash][k].element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
+            const int ctri_index = element->element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
             collision_tri_t *ctri = &m_collision_tris[ctri_index];
             if (!ctri->enabled)
                 continue;
@@ -1040,15 +1130,68 @@ bool Collisions::permitEvent(CollisionEventFilter filter)
     }
 }
 
+void Collisions::prepareCellWindow(AxisAlignedBox const& aabb, CellWindow& window)
+{
+    window.size_x = 0;
+    window.size_z = 0;
+    window.cells.clear();
+
+    if (!aabb.isFinite())
+        return;
+
+    // Same rounding as the lookup in nodeCollision(); one extra cell of margin as the nodes move on
+    const int x0 = (int)(aabb.getMinimum().x / CELL_SIZE) - 1;
+    const int z0 = (int)(aabb.getMinimum().z / CELL_SIZE) - 1;
+    const int x1 = (int)(aabb.getMaximum().x / CELL_SIZE) + 1;
+    const int z1 = (int)(aabb.getMaximum().z / CELL_SIZE) + 1;
+    if ((x1 - x0 + 1) * (z1 - z0 + 1) > MAX_WINDOW_CELLS)
+        return;
+
+    window.cell_x = x0;
+    window.cell_z = z0;
+    window.index_version = m_cell_index_version;
+    window.size_x = x1 - x0 + 1;
+    window.size_z = z1 - z0 + 1;
+    window.cells.reserve(window.size_x * window.size_z);
+    for (int x = x0; x <= x1; x++)
+    {
+        for (int z = z0; z <= z1; z++)
+        {
+            window.cells.push_back(hash_find(x, z));
+        }
+    }
+}
+
+bool Collisions::nodeCollision(node_t *node, float dt, CellWindow const& window)
+{
+    // find the correct cell
+    int refx = (int)(node->AbsPosition.x / CELL_SIZE);
+    int refz = (int)(node->AbsPosition.z / CELL_SIZE);
+    unsigned int cell_id = (refx << 16) + refz;
+
+    const int wx = refx - window.cell_x;
+    const int wz = refz - window.cell_z;
+    if (wx >= 0 && wx < window.size_x && wz >= 0 && wz < window.size_z &&
+        window.index_version == m_cell_index_version)
+    {
+        return nodeCollisionInCell(node, dt, window.cells[wx * window.size_z + wz], cell_id, false);
+    }
+    return nodeCollisionInCell(node, dt, hash_find(refx, refz), cell_id, false);
+}
+
 bool Collisions::nodeCollision(node_t *node, float dt, bool envokeScriptCallbacks)
 {
     // find the correct cell
     int refx = (int)(node->AbsPosition.x / CELL_SIZE);
     int refz = (int)(node->AbsPosition.z / CELL_SIZE);
-    int hash = hash_find(refx, refz);
     unsigned int cell_id = (refx << 16) + refz;
 
-    if (node->AbsPosition.y > hashtable_height[hash])
+    return nodeCollisionInCell(node, dt, hash_find(refx, refz), cell_id, envokeScriptCallbacks);
+}
+
+bool Collisions::nodeCollisionInCell(node_t *node, float dt, hash_cell_t const& cell, unsigned int cell_id, bool envokeScriptCallbacks)
+{
+    if (node->AbsPosition.y > cell.height)
         return false;
 
     collision_tri_t *minctri = 0;
@@ -1058,16 +1201,15 @@ bool Collisions::nodeCollision(node_t *node, float dt, bool envokeScriptCallback
     bool contacted = false;
     bool isScriptCallbackEnvoked = false;
 
-    size_t num_elements = hashtable[hash].size();
-    for (size_t k=0; k < num_elements; k++)
+    for (const hash_coll_element_t* element = cell.begin; element != cell.end; element++)
     {
-        if (hashtable[hash][k].cell_id != cell_id)
+        if (element->cell_id != cell_id)
         {
             continue;
         }
-        else if (hashtable[hash][k].IsCollisionBox())
+        else if (element->IsCollisionBox())
         {
-            collision_box_t *cbox = &m_collision_boxes[hashtable[hash][k].element_index];
+            collision_box_t *cbox = &m_collision_boxes[element->element_index];
 
             if (!cbox->enabled)
                 continue;
@@ -1173,7 +1315,7 @@ bool Collisions::nodeCollision(node_t *node, float dt, bool envokeScriptCallback
         else
         {
             // tri collision
-            const int ctri_index = hashtable[hash][k].element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
+            const int ctri_index = element->element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
             collision_tri_t *ctri = &m_collision_tris[ctri_index];
             if (!ctri->enabled)
                 continue;
@@ -1297,20 +1439,40 @@ bool Collisions::isInside(Vector3 pos, collision_box_t *cbox, float border)
 
 bool Collisions::groundCollision(node_t *node, float dt)
 {
-    Real v = App::GetSimTerrain()->GetHeightAt(node->AbsPosition.x, node->AbsPosition.z);
-    if (v > node->AbsPosition.y)
+    float v;
+    Ogre::Vector3 normal;
+    App::GetSimTerrain()->getGeometryManager()->getHeightAndNormalAt(node->AbsPosition.x, node->AbsPosition.z, v, normal);
+    return this->groundCollision(node, dt, v, normal);
+}
+
+bool Collisions::groundCollision(node_t *node, float dt, float ground_height, Ogre::Vector3 const& ground_normal)
+{
+    if (ground_height > node->AbsPosition.y)
     {
         ground_model_t* ogm = landuse ? landuse->getGroundModelAt(node->AbsPosition.x, node->AbsPosition.z) : nullptr;
         // when landuse fails or we don't have it, use the default value
         if (!ogm) ogm = defaultgroundgm;
-        Ogre::Vector3 normal = App::GetSimTerrain()->GetNormalAt(node->AbsPosition.x, v, node->AbsPosition.z);
-        node->Forces += primitiveCollision(node, node->Velocity, node->mass, normal, dt, ogm, v - node->AbsPosition.y);
+        node->Forces += primitiveCollision(node, node->Velocity, node->mass, ground_normal, dt, ogm, ground_height - node->AbsPosition.y);
         node->nd_last_collision_gm = ogm;
         return true;
     }
     return false;
 }
 
+void Collisions::prepareGroundSamples(node_t* nodes, int num_nodes, GroundSamples& samples)
+{
+    samples.pos_x.resize(num_nodes);
+    samples.pos_z.resize(num_nodes);
+    samples.height.resize(num_nodes);
+    samples.normal.resize(num_nodes);
+    for (int i = 0; i < num_nodes; i++)
+    {
+        samples.pos_x[i] = nodes[i].AbsPosition.x;
+        samples.pos_z[i] = nodes[i].AbsPosition.z;
+    }
+    App::GetSimTerrain()->GetHeightsAndNormalsAt(num_nodes, samples.pos_x.data(), samples.pos_z.data(), samples.height.data(), samples.normal.data());
+}
+
 Vector3 RoR::primitiveCollision(node_t *node, Vector3 velocity, float mass, Vector3 normal, float dt, ground_model_t* gm, float penetration)
 {
     Vector3 force = Vector3::ZERO;
@@ -1443,11 +1605,11 @@ int Collisions::createCollisionDebugVisualization()
         {
             int cellx = (int)(x/(float)CELL_SIZE);
             int cellz = (int)(z/(float)CELL_SIZE);
-            const int hash = hash_find(cellx, cellz);
+            const hash_cell_t cell = hash_find(cellx, cellz);
 
-            bool used = std::find_if(hashtable[hash].begin(), hashtable[hash].end(), [&](hash_coll_element_t const &c) {
+            bool used = std::find_if(cell.begin, cell.end, [&](hash_coll_element_t const &c) {
                     return c.cell_id == (cellx << 16) + cellz;
-            }) != hashtable[hash].end();
+            }) != cell.end;
 
             if (used)
             {
@@ -1462,7 +1624,7 @@ int Collisions::createCollisionDebugVisualization()
                 groundheight = std::max(groundheight, App::GetSimTerrain()->GetHeightAt(x2, z2));
                 groundheight += 0.1; // 10 cm hover
 
-                float percentd = static_cast<float>(hashtable[hash].size()) / static_cast<float>(CELL_BLOCKSIZE);
+                float percentd = static_cast<float>(std::distance(cell.begin, cell.end)) / static_cast<float>(CELL_BLOCKSIZE);
 
                 if (percentd > 1) percentd = 1;
                 String matName = "mat-coll-dbg-"+TOSTRING((int)(percentd*100));
@@ -1693,6 +1855,8 @@ void Collisions::getMeshInformation(Mesh* mesh,size_t &vertex_count,Vector3* &ve
 
 void Collisions::finishLoadingTerrain()
 {
+    this->updateCellIndex();
+
     if (debugMode)
     {
         SceneNode *debugsn = App::GetGfxScene()->GetSceneManager()->getRootSceneNode()->createChildSceneNode();
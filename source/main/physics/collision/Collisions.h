@@ -25,6 +25,7 @@
 #include "Application.h"
 #include "SimData.h" // for collision_box_t
 
+#include <memory>
 #include <mutex>
 #include <Ogre.h>
 
@@ -62,7 +63,9 @@ private:
     /// Static collision object lookup system
     /// -------------------------------------
     /// Terrain is split into equal-size 'cells' of dimension CELL_SIZE, identified by CellID
-    /// A hash table aggregates elements from multiple cells in one entry
+    /// The cell index stores elements of all cells in one array sorted by CellID,
+    /// with a sorted array of used CellIDs and offsets into it (CSR layout).
+    /// The legacy hash table (cvar 'sim_legacy_collision_hash') aggregates elements from multiple cells in one entry
     struct hash_coll_element_t
     {
         static const int ELEMENT_TRI_BASE_INDEX = 1000000; // Effectively a maximum number of collision boxes
@@ -79,6 +82,21 @@ private:
         int element_index;
     };
 
+    /// Element waiting for `updateCellIndex()`
+    struct pending_element_t
+    {
+        hash_coll_element_t element;
+        float height; //!< Top of the element
+    };
+
+    /// Elements found by `hash_find()`; with the legacy hash table, this includes elements of other cells
+    struct hash_cell_t
+    {
+        const hash_coll_element_t* begin;
+        const hash_coll_element_t* end;
+        float height; //!< Top of the highest element
+    };
+
     struct collision_tri_t
     {
         Ogre::Vector3 a;
@@ -98,6 +116,12 @@ private:
     static const int HASH_POWER = 20;
     static const int HASH_SIZE = 1 << HASH_POWER;
 
+    struct legacy_hashtable_t
+    {
+        Ogre::Real height[HASH_SIZE];
+        std::vector<hash_coll_element_t> elements[HASH_SIZE];
+    };
+
     // how many elements per cell? power of 2 minus 2 is better
     static const int CELL_BLOCKSIZE = 126;
 
@@ -114,9 +138,14 @@ private:
 
     Ogre::AxisAlignedBox m_collision_aab; // Tight bounding box around all collision meshes
 
-    // collision hashtable
-    Ogre::Real hashtable_height[HASH_SIZE];
-    std::vector<hash_coll_element_t> hashtable[HASH_SIZE];
+    // collision cell index
+    std::vector<unsigned int>           m_cell_ids;          //!< Sorted, unique
+    std::vector<unsigned int>           m_cell_offsets;      //!< Elements of `m_cell_ids[i]` are [m_cell_offsets[i], m_cell_offsets[i+1])
+    std::vector<float>                  m_cell_heights;
+    std::vector<hash_coll_element_t>    m_cell_elements;     //!< Sorted by cell, in order of addition within a cell
+    std::vector<pending_element_t>      m_pending_elements;  //!< Added since the last `updateCellIndex()`, not visible to lookups yet
+    unsigned int                        m_cell_index_version; //!< Incremented whenever `m_cell_elements` is reallocated, see `CellWindow`
+    std::unique_ptr<legacy_hashtable_t> m_legacy_hashtable;  //!< Only allocated with cvar 'sim_legacy_collision_hash'
 
     // ground models
     std::map<Ogre::String, ground_model_t> ground_models;
@@ -139,14 +168,39 @@ private:
     const Ogre::Vector3 m_terrain_size;
 
     void hash_add(int cell_x, int cell_z, int value, float h);
-    int hash_find(int cell_x, int cell_z); /// Returns index to 'hashtable'
+    hash_cell_t hash_find(int cell_x, int cell_z);
     unsigned int hashfunc(unsigned int cellid);
     void parseGroundConfig(Ogre::ConfigFile* cfg, Ogre::String groundModel = "");
 
     Ogre::Vector3 calcCollidedSide(const Ogre::Vector3& pos, const Ogre::Vector3& lo, const Ogre::Vector3& hi);
+    bool nodeCollisionInCell(node_t* node, float dt, hash_cell_t const& cell, unsigned int cell_id, bool envokeScriptCallbacks);
 
 public:
 
+    /// Static collision cells covering an area, resolved once by `prepareCellWindow()` and reused
+    /// by `nodeCollision()` for many nodes. Owned by the caller, so actors can be processed in parallel.
+    /// The cells point into the cell index; a window resolved before `updateCellIndex()` is ignored.
+    struct CellWindow
+    {
+        int cell_x = 0;                 //!< First cell of the window
+        int cell_z = 0;
+        int size_x = 0;                 //!< 0 = empty window, all lookups use the cell index
+        int size_z = 0;
+        unsigned int index_version = 0; //!< `m_cell_index_version` the cells were resolved against
+        std::vector<hash_cell_t> cells; //!< [x * size_z + z]
+    };
+
+    static const int MAX_WINDOW_CELLS = 4096; //!< Bigger areas are not worth resolving up front
+
+    /// Terrain height + normal under a set of nodes, sampled in one batch by `prepareGroundSamples()`.
+    struct GroundSamples
+    {
+        std::vector<float>         pos_x;
+        std::vector<float>         pos_z;
+        std::vector<float>         height;
+        std::vector<Ogre::Vector3> normal;
+    };
+
     std::mutex m_scriptcallback_mutex;
 
     bool forcecam;
@@ -163,11 +217,18 @@ public:
     float getSurfaceHeightBelow(float x, float z, float height);
     bool collisionCorrect(Ogre::Vector3* refpos, bool envokeScriptCallbacks = true);
     bool groundCollision(node_t* node, float dt);
+    bool groundCollision(node_t* node, float dt, float ground_height, Ogre::Vector3 const& ground_normal); //!< Terrain already sampled, see `prepareGroundSamples()`
+    void prepareGroundSamples(node_t* nodes, int num_nodes, GroundSamples& samples);
     bool isInside(Ogre::Vector3 pos, const Ogre::String& inst, const Ogre::String& box, float border = 0);
     bool isInside(Ogre::Vector3 pos, collision_box_t* cbox, float border = 0);
     bool nodeCollision(node_t* node, float dt, bool envokeScriptCallbacks = true);
+    bool nodeCollision(node_t* node, float dt, CellWindow const& window); //!< Same as `nodeCollision(node, dt, false)`, cells inside the window need no lookup
+    void prepareCellWindow(Ogre::AxisAlignedBox const& aabb, CellWindow& window);
 
     void finishLoadingTerrain();
+    /// Merges the elements added since the last call into the cell index. The sim task reads the index
+    /// without locking, so this must only run while no sim task does - see `ActorManager::SyncWithSimThread()`.
+    void updateCellIndex();
 
     int addCollisionBox(Ogre::SceneNode* tenode, bool rotating, bool virt, Ogre::Vector3 pos, Ogre::Vector3 rot, Ogre::Vector3 l, Ogre::Vector3 h, Ogre::Vector3 sr, const Ogre::String& eventname, const Ogre::String& instancename, bool forcecam, Ogre::Vector3 campos, Ogre::Vector3 sc = Ogre::Vector3::UNIT_SCALE, Ogre::Vector3 dr = Ogre::Vector3::ZERO, CollisionEventFilter event_filter = EVENT_ALL, int scripthandler = -1);
     int addCollisionMesh(Ogre::String meshname, Ogre::Vector3 pos, Ogre::Quaternion q, Ogre::Vector3 scale, ground_model_t* gm = 0, std::vector<int>* collTris = 0);
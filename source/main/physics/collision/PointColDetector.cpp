@@ -24,6 +24,8 @@
 #include "ActorManager.h"
 #include "GameContext.h"
 
+#include <cfloat>
+
 using namespace Ogre;
 using namespace RoR;
 
@@ -36,23 +38,36 @@ void PointColDetector::UpdateIntraPoint(bool contactables)
         m_collision_partners = {m_actor};
         m_object_list_size = contacters_size;
         update_structures_for_contacters(contactables);
+        update_kdtree(true);
+    }
+    else
+    {
+        update_kdtree(false);
     }
-
-    m_kdtree[0].ref = NULL;
-    m_kdtree[0].begin = 0;
-    m_kdtree[0].end = -m_object_list_size;
 }
 
 void PointColDetector::UpdateInterPoint(bool ignorestate)
+{
+    std::vector<Actor*> candidates;
+    for (auto actor : App::GetGameContext()->GetActorManager()->GetActors())
+    {
+        if (actor != m_actor && m_actor->ar_bounding_box.intersects(actor->ar_bounding_box))
+        {
+            candidates.push_back(actor);
+        }
+    }
+    this->UpdateInterPoint(candidates, ignorestate);
+}
+
+void PointColDetector::UpdateInterPoint(std::vector<Actor*> const& candidates, bool ignorestate)
 {
     m_linked_actors = m_actor->getAllLinkedActors();
 
     int contacters_size = 0;
     std::vector<Actor*> collision_partners;
-    for (auto actor : App::GetGameContext()->GetActorManager()->GetActors())
+    for (auto actor : candidates)
     {
-        if (actor != m_actor && (ignorestate || actor->ar_update_physics) &&
-                m_actor->ar_bounding_box.intersects(actor->ar_bounding_box))
+        if (ignorestate || actor->ar_update_physics)
         {
             collision_partners.push_back(actor);
             bool is_linked = std::find(m_linked_actors.begin(), m_linked_actors.end(), actor) != m_linked_actors.end();
@@ -80,11 +95,93 @@ void PointColDetector::UpdateInterPoint(bool ignorestate)
         m_collision_partners = collision_partners;
         m_object_list_size = contacters_size;
         update_structures_for_contacters(false);
+        update_kdtree(true);
+    }
+    else
+    {
+        update_kdtree(false);
+    }
+}
+
+void PointColDetector::update_kdtree(bool structure_changed)
+{
+    // Same points as last step: keep the tree topology and only refresh the bounds.
+    // The tree degrades as nodes move, so it's rebuilt from scratch now and then.
+    if (!structure_changed && m_object_list_size > 0 && m_kdtree[0].end >= 0 &&
+            m_kdtree_refits < KDTREE_MAX_REFITS)
+    {
+        float bbmin[3], bbmax[3];
+        refit_kdtree(0, 0, bbmin, bbmax);
+        m_kdtree_refits++;
+        return;
     }
 
+    // Reset; the tree is built lazily by queries
     m_kdtree[0].ref = NULL;
     m_kdtree[0].begin = 0;
     m_kdtree[0].end = -m_object_list_size;
+    m_kdtree_refits = 0;
+}
+
+void PointColDetector::refit_kdtree(int index, int axis, float* bbmin, float* bbmax)
+{
+    kdnode_t& node = m_kdtree[index];
+
+    if (node.end < 0)
+    {
+        // Not built yet - bound the slice, the query which builds it will set up the node
+        for (int i = 0; i < 3; i++)
+        {
+            bbmin[i] = FLT_MAX;
+            bbmax[i] = -FLT_MAX;
+        }
+        for (int r = node.begin; r < -node.end; r++)
+        {
+            const float* point = m_ref_list[r].point;
+            for (int i = 0; i < 3; i++)
+            {
+                bbmin[i] = std::min(bbmin[i], point[i]);
+                bbmax[i] = std::max(bbmax[i], point[i]);
+            }
+        }
+        return;
+    }
+
+    if (node.ref != NULL)
+    {
+        const float* point = node.ref->point;
+        for (int i = 0; i < 3; i++)
+        {
+            bbmin[i] = point[i];
+            bbmax[i] = point[i];
+        }
+        node.middle = point[axis];
+        node.min = node.middle;
+        node.max = node.middle;
+        node.leftmax = node.middle;
+        node.rightmin = node.middle;
+        return;
+    }
+
+    int newaxis = axis + 1;
+    if (newaxis >= 3)
+    {
+        newaxis = 0;
+    }
+
+    float rightbbmin[3], rightbbmax[3];
+    refit_kdtree(index + index + 1, newaxis, bbmin, bbmax);
+    refit_kdtree(index + index + 2, newaxis, rightbbmin, rightbbmax);
+
+    node.leftmax = bbmax[axis];
+    node.rightmin = rightbbmin[axis];
+    for (int i = 0; i < 3; i++)
+    {
+        bbmin[i] = std::min(bbmin[i], rightbbmin[i]);
+        bbmax[i] = std::max(bbmax[i], rightbbmax[i]);
+    }
+    node.min = bbmin[axis];
+    node.max = bbmax[axis];
 }
 
 void PointColDetector::update_structures_for_contacters(bool ignoreinternal)
@@ -167,45 +264,43 @@ void PointColDetector::queryrec(int kdindex, int axis)
             return;
         }
 
-        if (m_bbmax[axis] >= m_kdtree[kdindex].middle)
+        if (m_bbmin[axis] > m_kdtree[kdindex].max || m_bbmax[axis] < m_kdtree[kdindex].min)
         {
-            if (m_bbmin[axis] > m_kdtree[kdindex].max)
-            {
-                return;
-            }
+            return;
+        }
 
-            int newaxis = axis + 1;
+        // Children may overlap on this axis after a refit, test both bounds
+        const bool visit_left = m_bbmin[axis] <= m_kdtree[kdindex].leftmax;
+        const bool visit_right = m_bbmax[axis] >= m_kdtree[kdindex].rightmin;
 
-            if (newaxis >= 3)
-            {
-                newaxis = 0;
-            }
+        int newaxis = axis + 1;
 
-            int newindex = kdindex + kdindex + 1;
+        if (newaxis >= 3)
+        {
+            newaxis = 0;
+        }
 
-            if (m_bbmin[axis] <= m_kdtree[kdindex].middle)
-            {
-                queryrec(newindex, newaxis);
-            }
+        int newindex = kdindex + kdindex + 1;
 
+        if (visit_left && visit_right)
+        {
+            queryrec(newindex, newaxis);
+            kdindex = newindex + 1;
+        }
+        else if (visit_left)
+        {
+            kdindex = newindex;
+        }
+        else if (visit_right)
+        {
             kdindex = newindex + 1;
-            axis = newaxis;
         }
         else
         {
-            if (m_bbmax[axis] < m_kdtree[kdindex].min)
-            {
-                return;
-            }
-
-            kdindex = 2 * kdindex + 1;
-            axis++;
-
-            if (axis >= 3)
-            {
-                axis = 0;
-            }
+            return;
         }
+
+        axis = newaxis;
     }
 }
 
@@ -230,6 +325,8 @@ void PointColDetector::build_kdtree_incr(int axis, int index)
             m_kdtree[index].min = m_ref_list[begin].point[axis];
             m_kdtree[index].max = m_ref_list[median].point[axis];
             m_kdtree[index].middle = m_kdtree[index].max;
+            m_kdtree[index].leftmax = m_kdtree[index].min;
+            m_kdtree[index].rightmin = m_kdtree[index].max;
             m_kdtree[index].ref = NULL;
 
             axis++;
@@ -242,6 +339,8 @@ void PointColDetector::build_kdtree_incr(int axis, int index)
             m_kdtree[newindex].middle = m_kdtree[newindex].ref->point[axis];
             m_kdtree[newindex].min = m_kdtree[newindex].middle;
             m_kdtree[newindex].max = m_kdtree[newindex].middle;
+            m_kdtree[newindex].leftmax = m_kdtree[newindex].middle;
+            m_kdtree[newindex].rightmin = m_kdtree[newindex].middle;
             m_kdtree[newindex].end = median;
             newindex++;
 
@@ -249,6 +348,8 @@ void PointColDetector::build_kdtree_incr(int axis, int index)
             m_kdtree[newindex].middle = m_kdtree[newindex].ref->point[axis];
             m_kdtree[newindex].min = m_kdtree[newindex].middle;
             m_kdtree[newindex].max = m_kdtree[newindex].middle;
+            m_kdtree[newindex].leftmax = m_kdtree[newindex].middle;
+            m_kdtree[newindex].rightmin = m_kdtree[newindex].middle;
             m_kdtree[newindex].end = end;
             return;
         }
@@ -259,6 +360,8 @@ void PointColDetector::build_kdtree_incr(int axis, int index)
         }
 
         m_kdtree[index].middle = m_ref_list[median].point[axis];
+        m_kdtree[index].leftmax = m_kdtree[index].middle;
+        m_kdtree[index].rightmin = m_kdtree[index].middle;
         m_kdtree[index].ref = NULL;
 
         m_kdtree[newindex].begin = begin;
@@ -275,6 +378,8 @@ void PointColDetector::build_kdtree_incr(int axis, int index)
         m_kdtree[index].middle = m_kdtree[index].ref->point[axis];
         m_kdtree[index].min = m_kdtree[index].middle;
         m_kdtree[index].max = m_kdtree[index].middle;
+        m_kdtree[index].leftmax = m_kdtree[index].middle;
+        m_kdtree[index].rightmin = m_kdtree[index].middle;
     }
 }
 
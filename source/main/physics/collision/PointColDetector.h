@@ -35,10 +35,11 @@ public:
 
     std::vector<pointid_t*> hit_list;
 
-    PointColDetector(Actor* actor): m_actor(actor), m_object_list_size(-1) {};
+    PointColDetector(Actor* actor): m_actor(actor), m_object_list_size(-1), m_kdtree_refits(0) {};
 
     void UpdateIntraPoint(bool contactables = false);
-    void UpdateInterPoint(bool ignorestate = false);
+    void UpdateInterPoint(bool ignorestate = false); //!< Scans all actors for collision partners
+    void UpdateInterPoint(std::vector<Actor*> const& candidates, bool ignorestate = false); //!< Candidates must have intersecting bounding boxes, see `ActorBroadphase`
     void query(const Ogre::Vector3& vec1, const Ogre::Vector3& vec2, const Ogre::Vector3& vec3, const float enlargeBB);
 
 private:
@@ -57,8 +58,12 @@ private:
         refelem_t* ref;
         float middle;
         int begin;
+        float leftmax;  //!< Upper bound of the left subtree on this node's axis
+        float rightmin; //!< Lower bound of the right subtree on this node's axis
     };
 
+    static const int KDTREE_MAX_REFITS = 20; //!< Physics steps to keep a tree topology before rebuilding it
+
     Actor*                 m_actor;
     std::vector<Actor*>    m_linked_actors;
     std::vector<Actor*>    m_collision_partners;
@@ -68,8 +73,11 @@ private:
     Ogre::Vector3          m_bbmin;
     Ogre::Vector3          m_bbmax;
     int                    m_object_list_size;
+    int                    m_kdtree_refits;
 
     void queryrec(int kdindex, int axis);
+    void update_kdtree(bool structure_changed);
+    void refit_kdtree(int index, int axis, float* bbmin, float* bbmax);
     void build_kdtree_incr(int axis, int index);
     void partintwo(const int start, const int median, const int end, const int axis, float& minex, float& maxex);
     void update_structures_for_contacters(bool ignoreinternal);
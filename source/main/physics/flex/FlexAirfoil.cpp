@@ -587,10 +587,10 @@ void FlexAirfoil::addwash(int propid, float ratio)
     free_wash++;
 }
 
-void FlexAirfoil::updateForces()
+bool FlexAirfoil::calcAngleOfAttack(float* oa, float* ocratio, float* ocdef)
 {
-    if (!airfoil) return;
-    if (broken) return;
+    if (!airfoil) return false;
+    if (broken) return false;
 
     //evaluate wind direction
     Vector3 wind=-(nodes[nfld].Velocity+nodes[nfrd].Velocity)/2.0;
@@ -622,19 +622,33 @@ void FlexAirfoil::updateForces()
     float raoa=daoa.valueRadians();
     if (dumb.dotProduct(spanv)>0) {aoa=-aoa; raoa=-raoa;};
 
-    //get airfoil data
-    float cz, cx, cm;
-    if (isstabilator)
-        airfoil->getparams(aoa-deflection, chordratio, 0, &cz, &cx, &cm);
-    else
-        airfoil->getparams(aoa, chordratio, deflection, &cz, &cx, &cm);
+    //airfoil data arguments
+    *oa=(isstabilator) ? aoa-deflection : aoa;
+    *ocratio=chordratio;
+    *ocdef=(isstabilator) ? 0 : deflection;
+
+    cur_wind=wind;
+    cur_liftv=liftv;
+    cur_normv=normv;
+    cur_wspeed=wspeed;
+    cur_chord=chord;
+    cur_surface=s;
+    return true;
+}
+
+void FlexAirfoil::applyForces(float cz, float cx, float cm)
+{
+    if (!airfoil) return;
+    if (broken) return;
 
+    const Vector3 wind=cur_wind;
+    const Vector3 liftv=cur_liftv;
+    const Vector3 normv=cur_normv;
+    const float wspeed=cur_wspeed;
+    const float chord=cur_chord;
+    const float s=cur_surface;
 
-    //tropospheric model valid up to 11.000m (33.000ft)
-    float altitude=nodes[nfld].AbsPosition.y;
-    float sea_level_pressure=101325; //in Pa
-    float airpressure=sea_level_pressure*approx_pow(1.0-0.0065*altitude/288.15, 5.24947); //in Pa
-    float airdensity=airpressure*0.0000120896;//1.225 at sea level
+    float airdensity=Airfoil::getAirDensity(nodes[nfld].AbsPosition.y);
 
     Vector3 wforce=Vector3::ZERO;
     //drag
@@ -49,7 +49,10 @@ public:
 
     void addwash(int propid, float ratio);
 
-    void updateForces();
+    // Force update in two halves, so that the actor can look up the airfoil coefficients of all wings in one batch (see `Actor::CalcAircraftForces()`):
+    bool calcAngleOfAttack(float* oa, float* ocratio, float* ocdef); //!< Outputs the `Airfoil::getparams()` arguments; false if the wing makes no forces
+    void applyForces(float cz, float cx, float cm); //!< Takes the `Airfoil::getparams()` results
+    Airfoil* getAirfoil() { return airfoil; }
 
     float aoa;
     char type;
@@ -124,6 +127,14 @@ private:
     float idArea;
     bool idLeft;
 
+    // State of the current physics step, between `calcAngleOfAttack()` and `applyForces()`
+    Ogre::Vector3 cur_wind;
+    Ogre::Vector3 cur_liftv;
+    Ogre::Vector3 cur_normv;
+    float cur_wspeed;
+    float cur_chord;
+    float cur_surface;
+
     Airfoil* airfoil;
     AeroEngine** aeroengines;
     int free_wash;
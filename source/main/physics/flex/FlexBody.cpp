@@ -28,6 +28,7 @@
 #include "GfxActor.h"
 #include "GfxScene.h"
 #include "RigDef_File.h"
+#include "ThreadPool.h"
 
 #include <Ogre.h>
 
@@ -378,7 +379,7 @@ FlexBody::FlexBody(
         }
 
         m_locators = new Locator_t[m_vertex_count];
-        for (int i=0; i<(int)m_vertex_count; i++)
+        auto find_locator = [this, vertices, nodes, &node_indices, def](int i)
         {
             //search nearest node as the local origin
             float closest_node_distance = std::numeric_limits<float>::max();
@@ -466,7 +467,23 @@ FlexBody::FlexBody(
             m_locators[i].coords = mat * (vertices[i] - nodes[m_locators[i].ref].AbsPosition);
 
             // that's it!
+        };
+
+        // Each vertex searches all nodes - split into chunks and run on the thread pool
+        const int LOCATOR_CHUNK_SIZE = 256;
+        std::vector<std::function<void()>> tasks;
+        for (int chunk_start = 0; chunk_start < (int)m_vertex_count; chunk_start += LOCATOR_CHUNK_SIZE)
+        {
+            const int chunk_end = std::min(chunk_start + LOCATOR_CHUNK_SIZE, (int)m_vertex_count);
+            tasks.push_back([&find_locator, chunk_start, chunk_end]()
+                {
+                    for (int i = chunk_start; i < chunk_end; i++)
+                    {
+                        find_locator(i);
+                    }
+                });
         }
+        App::GetThreadPool()->Parallelize(tasks);
 
     } // if (preloaded_from_cache == nullptr)
 
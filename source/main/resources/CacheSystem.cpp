@@ -42,14 +42,19 @@
 #include "SkinFileFormat.h"
 #include "TerrainManager.h"
 #include "Terrn2FileFormat.h"
+#include "ThreadPool.h"
 #include "Utils.h"
 
 #include <OgreFileSystem.h>
+#include <OgreZip.h>
 #include <rapidjson/document.h>
 #include <rapidjson/istreamwrapper.h>
 #include <rapidjson/ostreamwrapper.h>
 #include <rapidjson/writer.h>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <unordered_map>
 
 using namespace Ogre;
 using namespace RoR;
@@ -118,6 +123,10 @@ void CacheSystem::LoadModCache(CacheValidity validity)
     m_resource_paths.clear();
     m_update_time = getTimeStamp();
 
+    // Reuse the entries loaded by the validity check rather than reading and parsing the file again
+    const bool cache_file_loaded = m_cache_file_loaded;
+    m_cache_file_loaded = false;
+
     if (validity != CacheValidity::VALID)
     {
         if (validity == CacheValidity::NEEDS_REBUILD)
@@ -128,6 +137,10 @@ void CacheSystem::LoadModCache(CacheValidity validity)
         else
         {
             RoR::Log("[RoR|ModCache] Performing update ...");
+            if (!cache_file_loaded)
+            {
+                this->LoadCacheFileBinary();
+            }
             this->PruneCache();
         }
         const bool orig_echo = App::diag_log_console_echo->getBool();
@@ -136,63 +149,134 @@ void CacheSystem::LoadModCache(CacheValidity validity)
         this->ParseKnownFiles(RGN_CONTENT);
         App::diag_log_console_echo->setVal(orig_echo);
         this->DetectDuplicates();
+        this->WriteCacheFileBinary();
         this->WriteCacheFileJson();
     }
 
-    this->LoadCacheFileJson();
+    if (validity != CacheValidity::VALID || !cache_file_loaded)
+    {
+        if (!this->LoadCacheFileBinary() && !this->LoadCacheFileJson())
+        {
+            RoR::Log("[RoR|ModCache] Error, cache file still invalid after check/update, content selector will be empty.");
+            return;
+        }
+    }
 
     RoR::Log("[RoR|ModCache] Cache loaded");
 }
 
 CacheEntry* CacheSystem::FindEntryByFilename(LoaderType type, bool partial, std::string filename)
 {
+    this->UpdateFilenameIndex();
+
     StringUtil::toLowerCase(filename);
+    const int kind = (type == LT_Terrain) ? 1 : 0;
+
+    auto found = m_fname_index[kind].find(filename);
+    if (found != m_fname_index[kind].end())
+        return &m_entries[found->second];
+
+    if (!partial)
+        return nullptr;
+
+    // Candidates: entries containing the rarest trigram of the query, or all entries of the kind for very short queries
+    const std::vector<size_t>* candidates = nullptr;
+    for (size_t i = 0; i + 3 <= filename.length(); i++)
+    {
+        auto posting = m_fname_trigrams[kind].find(MakeTrigram(filename.c_str() + i));
+        if (posting == m_fname_trigrams[kind].end())
+            return nullptr; // Some trigram doesn't occur anywhere
+        if (candidates == nullptr || posting->second.size() < candidates->size())
+            candidates = &posting->second;
+    }
+    if (candidates == nullptr)
+        candidates = &m_fname_kind_entries[kind];
+
     size_t partial_match_length = std::numeric_limits<size_t>::max();
     CacheEntry* partial_match = nullptr;
-    for (CacheEntry& entry : m_entries)
+    for (size_t index : *candidates) // Ascending, so ties go to the first entry as before
     {
-        if ((type == LT_Terrain) != (entry.fext == "terrn2"))
-            continue;
+        const std::string& fname = m_fname_lower[index];
+        if (fname.length() < partial_match_length &&
+            fname.find(filename) != std::string::npos)
+        {
+            partial_match = &m_entries[index];
+            partial_match_length = fname.length();
+        }
+    }
+
+    return partial_match;
+}
+
+uint32_t CacheSystem::MakeTrigram(const char* str)
+{
+    return (uint32_t(uint8_t(str[0])) << 16) | (uint32_t(uint8_t(str[1])) << 8) | uint32_t(uint8_t(str[2]));
+}
+
+void CacheSystem::ResetFilenameIndex()
+{
+    for (int kind = 0; kind < 2; kind++)
+    {
+        m_fname_index[kind].clear();
+        m_fname_trigrams[kind].clear();
+        m_fname_kind_entries[kind].clear();
+    }
+    m_fname_lower.clear();
+}
+
+void CacheSystem::UpdateFilenameIndex()
+{
+    if (m_fname_lower.size() > m_entries.size())
+    {
+        this->ResetFilenameIndex(); // Entries were replaced behind our back
+    }
+
+    // Entries are only ever appended (or all cleared), index the new ones
+    for (size_t index = m_fname_lower.size(); index < m_entries.size(); index++)
+    {
+        const CacheEntry& entry = m_entries[index];
+        const int kind = (entry.fext == "terrn2") ? 1 : 0;
 
         String fname = entry.fname;
         String fname_without_uid = entry.fname_without_uid;
         StringUtil::toLowerCase(fname);
         StringUtil::toLowerCase(fname_without_uid);
-        if (fname == filename || fname_without_uid == filename)
-            return &entry;
 
-        if (partial &&
-            fname.length() < partial_match_length &&
-            fname.find(filename) != std::string::npos)
+        // `emplace()` keeps the existing value, so the first entry in order wins like with the linear search
+        m_fname_index[kind].emplace(fname, index);
+        m_fname_index[kind].emplace(fname_without_uid, index);
+
+        for (size_t i = 0; i + 3 <= fname.length(); i++)
         {
-            partial_match = &entry;
-            partial_match_length = fname.length();
+            std::vector<size_t>& posting = m_fname_trigrams[kind][MakeTrigram(fname.c_str() + i)];
+            if (posting.empty() || posting.back() != index) // Trigram may repeat within the name
+                posting.push_back(index);
         }
-    }
 
-    return (partial) ? partial_match : nullptr;
+        m_fname_kind_entries[kind].push_back(index);
+        m_fname_lower.push_back(fname);
+    }
 }
 
 CacheValidity CacheSystem::EvaluateCacheValidity()
 {
     this->GenerateHashFromFilenames();
-    this->LoadCacheFileJson();
+    m_cache_file_loaded = false;
 
     // First, open cache file and get hash for quick update check
-    rapidjson::Document j_doc;
-    if (!App::GetContentManager()->LoadAndParseJson(CACHE_FILE, RGN_CACHE, j_doc))
+    if (!this->LoadCacheFileBinary())
     {
-        RoR::Log("[RoR|ModCache] Invalid or missing cache file");
-        return CacheValidity::NEEDS_REBUILD;
-    }
-
-    if (j_doc["format_version"].GetInt() != CACHE_FILE_FORMAT)
-    {
-        RoR::Log("[RoR|ModCache] Invalid cache file format");
-        return CacheValidity::NEEDS_REBUILD;
+        // No binary cache yet (i.e. first start after update) - import the JSON one if usable
+        if (!this->LoadCacheFileJson())
+        {
+            RoR::Log("[RoR|ModCache] Invalid or missing cache file");
+            return CacheValidity::NEEDS_REBUILD;
+        }
+        this->WriteCacheFileBinary();
     }
+    m_cache_file_loaded = true;
 
-    if (j_doc["global_hash"].GetString() != m_filenames_hash)
+    if (m_cache_file_hash != m_filenames_hash)
     {
         RoR::Log("[RoR|ModCache] Cache file out of date");
         return CacheValidity::NEEDS_UPDATE;
@@ -237,14 +321,7 @@ void CacheSystem::ImportEntryFromJson(rapidjson::Value& j_entry, CacheEntry & ou
     Ogre::StringUtil::trim(out_entry.guid);
 
     // Category
-    int category_id = j_entry["categoryid"].GetInt();
-    auto category_itor = m_categories.find(category_id);
-    if (category_itor == m_categories.end() || category_id >= CID_Max)
-    {
-        category_itor = m_categories.find(CID_Unsorted);
-    }
-    out_entry.categoryname = category_itor->second;
-    out_entry.categoryid = category_itor->first;
+    this->ImportCategory(j_entry["categoryid"].GetInt(), out_entry);
 
      // Common - Authors
     for (rapidjson::Value& j_author: j_entry["authors"].GetArray())
@@ -302,19 +379,39 @@ void CacheSystem::ImportEntryFromJson(rapidjson::Value& j_entry, CacheEntry & ou
     }
 }
 
-void CacheSystem::LoadCacheFileJson()
+void CacheSystem::ImportCategory(int category_id, CacheEntry & out_entry)
+{
+    auto category_itor = m_categories.find(category_id);
+    if (category_itor == m_categories.end() || category_id >= CID_Max)
+    {
+        category_itor = m_categories.find(CID_Unsorted);
+    }
+    out_entry.categoryname = category_itor->second;
+    out_entry.categoryid = category_itor->first;
+}
+
+bool CacheSystem::LoadCacheFileJson()
 {
     // Clear existing entries
     m_entries.clear();
+    this->ResetFilenameIndex();
 
     rapidjson::Document j_doc;
     if (!App::GetContentManager()->LoadAndParseJson(CACHE_FILE, RGN_CACHE, j_doc) ||
-        !j_doc.IsObject() || !j_doc.HasMember("entries") || !j_doc["entries"].IsArray())
+        !j_doc.IsObject() || !j_doc.HasMember("entries") || !j_doc["entries"].IsArray() ||
+        !j_doc.HasMember("format_version") || !j_doc.HasMember("global_hash"))
     {
-        RoR::Log("[RoR|ModCache] Error, cache file still invalid after check/update, content selector will be empty.");
-        return;
+        return false;
     }
 
+    if (j_doc["format_version"].GetInt() != CACHE_FILE_FORMAT)
+    {
+        RoR::Log("[RoR|ModCache] Invalid cache file format");
+        return false;
+    }
+
+    m_cache_file_hash = j_doc["global_hash"].GetString();
+
     for (rapidjson::Value& j_entry: j_doc["entries"].GetArray())
     {
         CacheEntry entry;
@@ -322,12 +419,11 @@ void CacheSystem::LoadCacheFileJson()
         entry.number = static_cast<int>(m_entries.size() + 1); // Let's number mods from 1
         m_entries.push_back(entry);
     }
+    return true;
 }
 
 void CacheSystem::PruneCache()
 {
-    this->LoadCacheFileJson();
-
     std::vector<String> paths;
     for (auto& entry : m_entries)
     {
@@ -569,9 +665,449 @@ void CacheSystem::WriteCacheFileJson()
     }
 }
 
+// -------------------------- Binary cache file --------------------------
+
+namespace {
+
+const char CACHE_FILE_SIGNATURE[8] = { 'R', 'o', 'R', 'C', 'a', 'c', 'h', 'e' };
+
+struct CacheFileString //!< Ref into the string table
+{
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct CacheFileHeader
+{
+    char            signature[8];
+    int32_t         format_version;
+    uint32_t        entry_record_size;  //!< Detects layout differences between builds (i.e. 32/64 bit)
+    uint32_t        author_record_size;
+    uint32_t        num_entries;
+    uint32_t        num_authors;
+    uint32_t        num_sectionconfigs;
+    uint32_t        strings_size;
+    CacheFileString global_hash;
+};
+
+struct CacheFileAuthor
+{
+    int32_t         id;
+    CacheFileString type;
+    CacheFileString name;
+    CacheFileString email;
+};
+
+struct CacheFileEntry
+{
+    enum Flags
+    {
+        HAS_SUBMESHS     = 1 << 0,
+        CUSTOMTACH       = 1 << 1,
+        CUSTOM_PARTICLES = 1 << 2,
+        FORWARDCOMMANDS  = 1 << 3,
+        IMPORTCOMMANDS   = 1 << 4,
+        RESCUER          = 1 << 5,
+    };
+
+    // Common details
+    int64_t         addtimestamp;
+    int64_t         filetime;
+    CacheFileString resource_bundle_type;
+    CacheFileString resource_bundle_path;
+    CacheFileString fpath;
+    CacheFileString fname;
+    CacheFileString fname_without_uid;
+    CacheFileString fext;
+    CacheFileString dname;
+    CacheFileString uniqueid;
+    CacheFileString guid;
+    CacheFileString filecachename;
+    int32_t         usagecounter;
+    int32_t         categoryid;
+    int32_t         version;
+    uint32_t        first_author;        //!< Index to author records
+    uint32_t        num_authors;
+
+    // Vehicle details
+    CacheFileString description;
+    CacheFileString tags;
+    int32_t         fileformatversion;
+    int32_t         nodecount;
+    int32_t         beamcount;
+    int32_t         shockcount;
+    int32_t         fixescount;
+    int32_t         hydroscount;
+    int32_t         wheelcount;
+    int32_t         propwheelcount;
+    int32_t         commandscount;
+    int32_t         flarescount;
+    int32_t         propscount;
+    int32_t         wingscount;
+    int32_t         turbopropscount;
+    int32_t         turbojetcount;
+    int32_t         rotatorscount;
+    int32_t         exhaustscount;
+    int32_t         flexbodiescount;
+    int32_t         soundsourcescount;
+    float           truckmass;
+    float           loadmass;
+    float           minrpm;
+    float           maxrpm;
+    float           torque;
+    int32_t         driveable;
+    int32_t         numgears;
+    int32_t         enginetype;
+    uint32_t        flags;
+    uint32_t        first_sectionconfig; //!< Index to section-config string refs
+    uint32_t        num_sectionconfigs;
+};
+
+/// Builds the string table, storing each distinct string once (bundle paths, extensions and author names repeat a lot)
+class CacheFileStringTable
+{
+public:
+    CacheFileString Add(std::string const& str)
+    {
+        auto itor = m_lookup.find(str);
+        if (itor != m_lookup.end())
+        {
+            return itor->second;
+        }
+        CacheFileString ref;
+        ref.offset = static_cast<uint32_t>(m_data.size());
+        ref.length = static_cast<uint32_t>(str.size());
+        m_data.append(str);
+        m_lookup.insert(std::make_pair(str, ref));
+        return ref;
+    }
+
+    std::string const& GetData() const { return m_data; }
+
+private:
+    std::string                                      m_data;
+    std::unordered_map<std::string, CacheFileString> m_lookup;
+};
+
+/// Resolves string refs of a mapped file; remembers if any was out of range.
+class CacheFileStringReader
+{
+public:
+    CacheFileStringReader(const char* data, uint32_t size): m_data(data), m_size(size), m_ok(true) {}
+
+    std::string Get(CacheFileString const& ref)
+    {
+        if (ref.offset > m_size || ref.length > m_size - ref.offset)
+        {
+            m_ok = false;
+            return std::string();
+        }
+        return std::string(m_data + ref.offset, ref.length);
+    }
+
+    bool IsOk() const { return m_ok; }
+
+private:
+    const char* m_data;
+    uint32_t    m_size;
+    bool        m_ok;
+};
+
+template<typename T> void AppendRecord(std::string& buf, T const& record)
+{
+    buf.append(reinterpret_cast<const char*>(&record), sizeof(T));
+}
+
+template<typename T> T ReadRecord(const char* src, size_t index)
+{
+    T record;
+    std::memcpy(&record, src + (index * sizeof(T)), sizeof(T)); // Mapped data has no alignment guarantee
+    return record;
+}
+
+} // namespace
+
+void CacheSystem::WriteCacheFileBinary()
+{
+    CacheFileStringTable strings;
+    std::vector<CacheFileEntry> entries;
+    std::vector<CacheFileAuthor> authors;
+    std::vector<CacheFileString> sectionconfigs;
+
+    for (CacheEntry const& entry : m_entries)
+    {
+        if (entry.deleted)
+            continue;
+
+        CacheFileEntry rec;
+        std::memset(&rec, 0, sizeof(rec)); // Deterministic padding
+
+        // Common details
+        rec.addtimestamp         = static_cast<int64_t>(entry.addtimestamp);
+        rec.filetime             = static_cast<int64_t>(entry.filetime);
+        rec.resource_bundle_type = strings.Add(entry.resource_bundle_type);
+        rec.resource_bundle_path = strings.Add(entry.resource_bundle_path);
+        rec.fpath                = strings.Add(entry.fpath);
+        rec.fname                = strings.Add(entry.fname);
+        rec.fname_without_uid    = strings.Add(entry.fname_without_uid);
+        rec.fext                 = strings.Add(entry.fext);
+        rec.dname                = strings.Add(entry.dname);
+        rec.uniqueid             = strings.Add(entry.uniqueid);
+        rec.guid                 = strings.Add(entry.guid);
+        rec.filecachename        = strings.Add(entry.filecachename);
+        rec.usagecounter         = entry.usagecounter;
+        rec.categoryid           = entry.categoryid;
+        rec.version              = entry.version;
+
+        // Common - Authors
+        rec.first_author = static_cast<uint32_t>(authors.size());
+        rec.num_authors  = static_cast<uint32_t>(entry.authors.size());
+        for (AuthorInfo const& author: entry.authors)
+        {
+            CacheFileAuthor author_rec;
+            std::memset(&author_rec, 0, sizeof(author_rec));
+            author_rec.id    = author.id;
+            author_rec.type  = strings.Add(author.type);
+            author_rec.name  = strings.Add(author.name);
+            author_rec.email = strings.Add(author.email);
+            authors.push_back(author_rec);
+        }
+
+        // Vehicle details
+        rec.description       = strings.Add(entry.description);
+        rec.tags              = strings.Add(entry.tags);
+        rec.fileformatversion = entry.fileformatversion;
+        rec.nodecount         = entry.nodecount;
+        rec.beamcount         = entry.beamcount;
+        rec.shockcount        = entry.shockcount;
+        rec.fixescount        = entry.fixescount;
+        rec.hydroscount       = entry.hydroscount;
+        rec.wheelcount        = entry.wheelcount;
+        rec.propwheelcount    = entry.propwheelcount;
+        rec.commandscount     = entry.commandscount;
+        rec.flarescount       = entry.flarescount;
+        rec.propscount        = entry.propscount;
+        rec.wingscount        = entry.wingscount;
+        rec.turbopropscount   = entry.turbopropscount;
+        rec.turbojetcount     = entry.turbojetcount;
+        rec.rotatorscount     = entry.rotatorscount;
+        rec.exhaustscount     = entry.exhaustscount;
+        rec.flexbodiescount   = entry.flexbodiescount;
+        rec.soundsourcescount = entry.soundsourcescount;
+        rec.truckmass         = entry.truckmass;
+        rec.loadmass          = entry.loadmass;
+        rec.minrpm            = entry.minrpm;
+        rec.maxrpm            = entry.maxrpm;
+        rec.torque            = entry.torque;
+        rec.driveable         = static_cast<int32_t>(entry.driveable);
+        rec.numgears          = entry.numgears;
+        rec.enginetype        = static_cast<int32_t>(entry.enginetype);
+        rec.flags             = (entry.hasSubmeshs      ? CacheFileEntry::HAS_SUBMESHS     : 0) |
+                                (entry.customtach       ? CacheFileEntry::CUSTOMTACH       : 0) |
+                                (entry.custom_particles ? CacheFileEntry::CUSTOM_PARTICLES : 0) |
+                                (entry.forwardcommands  ? CacheFileEntry::FORWARDCOMMANDS  : 0) |
+                                (entry.importcommands   ? CacheFileEntry::IMPORTCOMMANDS   : 0) |
+                                (entry.rescuer          ? CacheFileEntry::RESCUER          : 0);
+
+        // Vehicle 'section-configs' (aka Modules in RigDef namespace)
+        rec.first_sectionconfig = static_cast<uint32_t>(sectionconfigs.size());
+        rec.num_sectionconfigs  = static_cast<uint32_t>(entry.sectionconfigs.size());
+        for (std::string const & module_name: entry.sectionconfigs)
+        {
+            sectionconfigs.push_back(strings.Add(module_name));
+        }
+
+        entries.push_back(rec);
+    }
+
+    CacheFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.signature, CACHE_FILE_SIGNATURE, sizeof(header.signature));
+    header.format_version     = CACHE_FILE_FORMAT;
+    header.entry_record_size  = sizeof(CacheFileEntry);
+    header.author_record_size = sizeof(CacheFileAuthor);
+    header.num_entries        = static_cast<uint32_t>(entries.size());
+    header.num_authors        = static_cast<uint32_t>(authors.size());
+    header.num_sectionconfigs = static_cast<uint32_t>(sectionconfigs.size());
+    header.global_hash        = strings.Add(m_filenames_hash);
+    header.strings_size       = static_cast<uint32_t>(strings.GetData().size());
+
+    // Assemble and write in one go
+    std::string buf;
+    buf.reserve(sizeof(CacheFileHeader) + (entries.size() * sizeof(CacheFileEntry)) +
+        (authors.size() * sizeof(CacheFileAuthor)) + (sectionconfigs.size() * sizeof(CacheFileString)) +
+        strings.GetData().size());
+    AppendRecord(buf, header);
+    for (CacheFileEntry const& rec: entries)
+        AppendRecord(buf, rec);
+    for (CacheFileAuthor const& rec: authors)
+        AppendRecord(buf, rec);
+    for (CacheFileString const& rec: sectionconfigs)
+        AppendRecord(buf, rec);
+    buf.append(strings.GetData());
+
+    try
+    {
+        Ogre::DataStreamPtr stream
+            = Ogre::ResourceGroupManager::getSingleton().createResource(
+                CACHE_FILE_BINARY, RGN_CACHE, /*overwrite=*/true);
+        size_t written = stream->write(buf.data(), buf.size());
+        if (written < buf.size())
+        {
+            RoR::LogFormat("[RoR|ModCache] Error writing file '%s', only written %u out of %u bytes!",
+                           CACHE_FILE_BINARY, static_cast<unsigned>(written), static_cast<unsigned>(buf.size()));
+            return;
+        }
+        RoR::LogFormat("[RoR|ModCache] File '%s' written OK", CACHE_FILE_BINARY);
+    }
+    catch (std::exception& e)
+    {
+        RoR::LogFormat("[RoR|ModCache] Error writing file '%s', message: '%s'", CACHE_FILE_BINARY, e.what());
+    }
+}
+
+bool CacheSystem::LoadCacheFileBinary()
+{
+    // Clear existing entries
+    m_entries.clear();
+    this->ResetFilenameIndex();
+
+    MappedFile file;
+    if (!file.Open(PathCombine(App::sys_cache_dir->getStr(), CACHE_FILE_BINARY).c_str()) ||
+        file.GetSize() < sizeof(CacheFileHeader))
+    {
+        return false;
+    }
+
+    const CacheFileHeader header = ReadRecord<CacheFileHeader>(file.GetData(), 0);
+    if (std::memcmp(header.signature, CACHE_FILE_SIGNATURE, sizeof(header.signature)) != 0 ||
+        header.format_version != CACHE_FILE_FORMAT ||
+        header.entry_record_size != sizeof(CacheFileEntry) ||
+        header.author_record_size != sizeof(CacheFileAuthor))
+    {
+        RoR::Log("[RoR|ModCache] Invalid cache file format");
+        return false;
+    }
+
+    const uint64_t entries_offset        = sizeof(CacheFileHeader);
+    const uint64_t authors_offset        = entries_offset + (uint64_t(header.num_entries) * sizeof(CacheFileEntry));
+    const uint64_t sectionconfigs_offset = authors_offset + (uint64_t(header.num_authors) * sizeof(CacheFileAuthor));
+    const uint64_t strings_offset        = sectionconfigs_offset + (uint64_t(header.num_sectionconfigs) * sizeof(CacheFileString));
+    if (strings_offset + header.strings_size != file.GetSize())
+    {
+        RoR::Log("[RoR|ModCache] Damaged cache file");
+        return false;
+    }
+
+    const char* entries_data        = file.GetData() + entries_offset;
+    const char* authors_data        = file.GetData() + authors_offset;
+    const char* sectionconfigs_data = file.GetData() + sectionconfigs_offset;
+    CacheFileStringReader strings(file.GetData() + strings_offset, header.strings_size);
+
+    m_cache_file_hash = strings.Get(header.global_hash);
+
+    bool damaged = false;
+    m_entries.resize(header.num_entries);
+    for (uint32_t i = 0; i < header.num_entries; i++)
+    {
+        const CacheFileEntry rec = ReadRecord<CacheFileEntry>(entries_data, i);
+        CacheEntry& entry = m_entries[i];
+
+        if (uint64_t(rec.first_author) + rec.num_authors > header.num_authors ||
+            uint64_t(rec.first_sectionconfig) + rec.num_sectionconfigs > header.num_sectionconfigs)
+        {
+            damaged = true;
+            break;
+        }
+
+        // Common details
+        entry.addtimestamp         = static_cast<std::time_t>(rec.addtimestamp);
+        entry.filetime             = static_cast<std::time_t>(rec.filetime);
+        entry.resource_bundle_type = strings.Get(rec.resource_bundle_type);
+        entry.resource_bundle_path = strings.Get(rec.resource_bundle_path);
+        entry.fpath                = strings.Get(rec.fpath);
+        entry.fname                = strings.Get(rec.fname);
+        entry.fname_without_uid    = strings.Get(rec.fname_without_uid);
+        entry.fext                 = strings.Get(rec.fext);
+        entry.dname                = strings.Get(rec.dname);
+        entry.uniqueid             = strings.Get(rec.uniqueid);
+        entry.guid                 = strings.Get(rec.guid);
+        entry.filecachename        = strings.Get(rec.filecachename);
+        entry.usagecounter         = rec.usagecounter;
+        entry.version              = rec.version;
+        this->ImportCategory(rec.categoryid, entry);
+
+        // Common - Authors
+        entry.authors.resize(rec.num_authors);
+        for (uint32_t j = 0; j < rec.num_authors; j++)
+        {
+            const CacheFileAuthor author_rec = ReadRecord<CacheFileAuthor>(authors_data, rec.first_author + j);
+            entry.authors[j].id    = author_rec.id;
+            entry.authors[j].type  = strings.Get(author_rec.type);
+            entry.authors[j].name  = strings.Get(author_rec.name);
+            entry.authors[j].email = strings.Get(author_rec.email);
+        }
+
+        // Vehicle details
+        entry.description       = strings.Get(rec.description);
+        entry.tags              = strings.Get(rec.tags);
+        entry.fileformatversion = rec.fileformatversion;
+        entry.nodecount         = rec.nodecount;
+        entry.beamcount         = rec.beamcount;
+        entry.shockcount        = rec.shockcount;
+        entry.fixescount        = rec.fixescount;
+        entry.hydroscount       = rec.hydroscount;
+        entry.wheelcount        = rec.wheelcount;
+        entry.propwheelcount    = rec.propwheelcount;
+        entry.commandscount     = rec.commandscount;
+        entry.flarescount       = rec.flarescount;
+        entry.propscount        = rec.propscount;
+        entry.wingscount        = rec.wingscount;
+        entry.turbopropscount   = rec.turbopropscount;
+        entry.turbojetcount     = rec.turbojetcount;
+        entry.rotatorscount     = rec.rotatorscount;
+        entry.exhaustscount     = rec.exhaustscount;
+        entry.flexbodiescount   = rec.flexbodiescount;
+        entry.soundsourcescount = rec.soundsourcescount;
+        entry.truckmass         = rec.truckmass;
+        entry.loadmass          = rec.loadmass;
+        entry.minrpm            = rec.minrpm;
+        entry.maxrpm            = rec.maxrpm;
+        entry.torque            = rec.torque;
+        entry.driveable         = ActorType(rec.driveable);
+        entry.numgears          = rec.numgears;
+        entry.enginetype        = static_cast<char>(rec.enginetype);
+        entry.hasSubmeshs       = (rec.flags & CacheFileEntry::HAS_SUBMESHS) != 0;
+        entry.customtach        = (rec.flags & CacheFileEntry::CUSTOMTACH) != 0;
+        entry.custom_particles  = (rec.flags & CacheFileEntry::CUSTOM_PARTICLES) != 0;
+        entry.forwardcommands   = (rec.flags & CacheFileEntry::FORWARDCOMMANDS) != 0;
+        entry.importcommands    = (rec.flags & CacheFileEntry::IMPORTCOMMANDS) != 0;
+        entry.rescuer           = (rec.flags & CacheFileEntry::RESCUER) != 0;
+
+        // Vehicle 'section-configs' (aka Modules in RigDef namespace)
+        entry.sectionconfigs.resize(rec.num_sectionconfigs);
+        for (uint32_t j = 0; j < rec.num_sectionconfigs; j++)
+        {
+            entry.sectionconfigs[j] = strings.Get(ReadRecord<CacheFileString>(sectionconfigs_data, rec.first_sectionconfig + j));
+        }
+
+        entry.number = static_cast<int>(i + 1); // Let's number mods from 1
+    }
+
+    if (damaged || !strings.IsOk())
+    {
+        RoR::Log("[RoR|ModCache] Damaged cache file");
+        m_entries.clear();
+        return false;
+    }
+
+    return true;
+}
+
 void CacheSystem::ClearCache()
 {
     App::GetContentManager()->DeleteDiskFile(CACHE_FILE, RGN_CACHE);
+    App::GetContentManager()->DeleteDiskFile(CACHE_FILE_BINARY, RGN_CACHE);
     for (auto& entry : m_entries)
     {
         String group = entry.resource_group;
@@ -583,6 +1119,7 @@ void CacheSystem::ClearCache()
         this->RemoveFileCache(entry);
     }
     m_entries.clear();
+    this->ResetFilenameIndex();
 }
 
 Ogre::String CacheSystem::StripUIDfromString(Ogre::String uidstr)
@@ -601,27 +1138,20 @@ Ogre::String CacheSystem::StripSHA1fromString(Ogre::String sha1str)
     return sha1str;
 }
 
-void CacheSystem::AddFile(String group, Ogre::FileInfo f, String ext)
+void CacheSystem::ScanFile(Ogre::Archive* archive, CacheScanResult& res)
 {
-    String type = f.archive ? f.archive->getType() : "FileSystem";
-    String path = f.archive ? f.archive->getName() : "";
-
-    if (std::find_if(m_entries.begin(), m_entries.end(), [&](CacheEntry& e)
-                { return !e.deleted && e.fname == f.filename && e.resource_bundle_path == path; }) != m_entries.end())
-        return;
-
-    RoR::LogFormat("[RoR|CacheSystem] Preparing to add file '%f'", f.filename.c_str());
-
+    const String& filename = res.csr_file.filename;
+    const String& ext = res.csr_ext;
     try
     {
-        DataStreamPtr ds = ResourceGroupManager::getSingleton().openResource(f.filename, group);
+        DataStreamPtr ds = archive->open(filename);
         // ds closes automatically, so do _not_ close it explicitly below
 
-        std::vector<CacheEntry> new_entries;
+        std::vector<CacheEntry>& new_entries = res.csr_entries;
         if (ext == "terrn2")
         {
             new_entries.resize(1);
-            FillTerrainDetailInfo(new_entries.back(), ds, f.filename);
+            FillTerrainDetailInfo(new_entries.back(), ds, filename);
         }
         else if (ext == "skin")
         {
@@ -649,36 +1179,69 @@ void CacheSystem::AddFile(String group, Ogre::FileInfo f, String ext)
         else
         {
             new_entries.resize(1);
-            FillTruckDetailInfo(new_entries.back(), ds, f.filename, group);
+            FillTruckDetailInfo(new_entries.back(), ds, filename, ""); // No resource group - texture checks are skipped
         }
 
-        for (auto& entry: new_entries)
+        res.csr_thumbnails.resize(new_entries.size());
+        for (size_t i = 0; i < new_entries.size(); i++)
         {
+            CacheEntry& entry = new_entries[i];
             Ogre::StringUtil::toLowerCase(entry.guid); // Important for comparsion
-            entry.fpath = f.path;
-            entry.fname = f.filename;
-            entry.fname_without_uid = StripUIDfromString(f.filename);
+            entry.fpath = res.csr_file.path;
+            entry.fname = filename;
+            entry.fname_without_uid = StripUIDfromString(filename);
             entry.fext = ext;
-            if (type == "Zip")
+            entry.resource_bundle_type = archive->getType();
+            entry.resource_bundle_path = archive->getName();
+            if (entry.resource_bundle_type == "Zip")
             {
-                entry.filetime = RoR::GetFileLastModifiedTime(path);
+                entry.filetime = RoR::GetFileLastModifiedTime(entry.resource_bundle_path);
             }
             else
             {
-                entry.filetime = RoR::GetFileLastModifiedTime(PathCombine(path, f.filename));
+                entry.filetime = RoR::GetFileLastModifiedTime(PathCombine(entry.resource_bundle_path, filename));
             }
-            entry.resource_bundle_type = type;
-            entry.resource_bundle_path = path;
-            entry.number = static_cast<int>(m_entries.size() + 1); // Let's number mods from 1
-            entry.addtimestamp = m_update_time;
-            this->GenerateFileCache(entry, group);
-            m_entries.push_back(entry);
+            this->ReadFileCache(archive, entry, res.csr_thumbnails[i]);
         }
     }
     catch (Ogre::Exception& e)
+    {
+        res.csr_entries.clear();
+        res.csr_thumbnails.clear();
+        res.csr_error = e.getFullDescription();
+    }
+    catch (std::exception& e) // Must not escape the worker thread
+    {
+        res.csr_entries.clear();
+        res.csr_thumbnails.clear();
+        res.csr_error = e.what();
+    }
+}
+
+void CacheSystem::MergeScanResult(CacheScanResult& res)
+{
+    if (!res.csr_error.empty())
     {
         RoR::LogFormat("[RoR|CacheSystem] Error processing file '%s', message :%s",
-            f.filename.c_str(), e.getFullDescription().c_str());
+            res.csr_file.filename.c_str(), res.csr_error.c_str());
+        return;
+    }
+
+    if (res.csr_entries.empty())
+        return;
+
+    const CacheEntry& first = res.csr_entries.front();
+    if (std::find_if(m_entries.begin(), m_entries.end(), [&](CacheEntry& e)
+                { return !e.deleted && e.fname == first.fname && e.resource_bundle_path == first.resource_bundle_path; }) != m_entries.end())
+        return;
+
+    for (size_t i = 0; i < res.csr_entries.size(); i++)
+    {
+        CacheEntry& entry = res.csr_entries[i];
+        entry.number = static_cast<int>(m_entries.size() + 1); // Let's number mods from 1
+        entry.addtimestamp = m_update_time;
+        this->WriteFileCache(entry, res.csr_thumbnails[i]);
+        m_entries.push_back(entry);
     }
 }
 
@@ -865,15 +1428,15 @@ void CacheSystem::FillTruckDetailInfo(CacheEntry& entry, Ogre::DataStreamPtr str
     /* NOTE: std::shared_ptr cleans everything up. */
 }
 
-Ogre::String detectMiniType(String filename, String group)
+Ogre::String detectMiniType(String filename, Ogre::Archive* archive)
 {
-    if (ResourceGroupManager::getSingleton().resourceExists(group, filename + "dds"))
+    if (archive->exists(filename + "dds"))
         return "dds";
 
-    if (ResourceGroupManager::getSingleton().resourceExists(group, filename + "png"))
+    if (archive->exists(filename + "png"))
         return "png";
 
-    if (ResourceGroupManager::getSingleton().resourceExists(group, filename + "jpg"))
+    if (archive->exists(filename + "jpg"))
         return "jpg";
 
     return "";
@@ -887,7 +1450,7 @@ void CacheSystem::RemoveFileCache(CacheEntry& entry)
     }
 }
 
-void CacheSystem::GenerateFileCache(CacheEntry& entry, String group)
+void CacheSystem::ReadFileCache(Ogre::Archive* archive, CacheEntry& entry, std::vector<char>& out_data)
 {
     if (entry.fname.empty())
         return;
@@ -911,7 +1474,7 @@ void CacheSystem::GenerateFileCache(CacheEntry& entry, String group)
         String fbase, fext;
         StringUtil::splitBaseFilename(entry.fname, fbase, fext);
         String minifn = fbase + "-mini.";
-        String minitype = detectMiniType(minifn, group);
+        String minitype = detectMiniType(minifn, archive);
         if (minitype.empty())
             return;
         src_path = minifn + minitype;
@@ -920,22 +1483,36 @@ void CacheSystem::GenerateFileCache(CacheEntry& entry, String group)
 
     try
     {
-        DataStreamPtr src_ds = ResourceGroupManager::getSingleton().openResource(src_path, group);
-        DataStreamPtr dst_ds = ResourceGroupManager::getSingleton().createResource(dst_path, RGN_CACHE, true);
-        std::vector<char> buf(src_ds->size());
-        size_t read = src_ds->read(buf.data(), src_ds->size());
-        if (read > 0)
+        DataStreamPtr src_ds = archive->open(src_path);
+        out_data.resize(src_ds->size());
+        out_data.resize(src_ds->read(out_data.data(), out_data.size()));
+        if (!out_data.empty())
         {
-            dst_ds->write(buf.data(), read); 
             entry.filecachename = dst_path;
         }
     }
+    catch (Ogre::Exception&)
+    {
+        out_data.clear();
+        entry.filecachename.clear();
+    }
+}
+
+void CacheSystem::WriteFileCache(CacheEntry& entry, std::vector<char> const& data)
+{
+    if (entry.filecachename.empty())
+        return;
+
+    try
+    {
+        DataStreamPtr dst_ds = ResourceGroupManager::getSingleton().createResource(entry.filecachename, RGN_CACHE, true);
+        dst_ds->write(data.data(), data.size());
+    }
     catch (Ogre::Exception& e)
     {
         LOG("error while generating file cache: " + e.getFullDescription());
+        entry.filecachename.clear();
     }
-
-    LOG("done generating file cache!");
 }
 
 void CacheSystem::ParseZipArchives(String group)
@@ -945,57 +1522,137 @@ void CacheSystem::ParseZipArchives(String group)
     for (const auto& skinzip : *skinzips)
         files->push_back(skinzip);
 
-    int i = 0, count = static_cast<int>(files->size());
+    std::vector<String> paths;
     for (const auto& file : *files)
     {
-        int progress = ((float)i++ / (float)count) * 100;
+        String path = PathCombine(file.archive->getName(), file.filename);
+        if (m_resource_paths.find(path) == m_resource_paths.end())
+        {
+            paths.push_back(path);
+        }
+    }
+
+    // Scan all archives on the thread pool; merge them in listing order as they complete,
+    // so the resulting entries (and their numbers) don't depend on thread scheduling.
+    std::vector<std::vector<CacheScanResult>> results(paths.size());
+    std::vector<TaskHandle> tasks;
+    tasks.reserve(paths.size());
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        tasks.push_back(App::GetThreadPool()->RunTask([this, &paths, &results, i]
+        {
+            this->ScanArchive(paths[i], results[i]);
+        }));
+    }
+
+    int count = static_cast<int>(paths.size());
+    for (int i = 0; i < count; i++)
+    {
+        int progress = ((float)i / (float)count) * 100;
+        String filename, dirname;
+        StringUtil::splitFilename(paths[i], filename, dirname);
         UTFString tmp = _L("Loading zips in group ") + ANSI_TO_UTF(group) + L"\n" +
-            ANSI_TO_UTF(file.filename) + L"\n" + ANSI_TO_UTF(TOSTRING(i)) + L"/" + ANSI_TO_UTF(TOSTRING(count));
+            ANSI_TO_UTF(filename) + L"\n" + ANSI_TO_UTF(TOSTRING(i + 1)) + L"/" + ANSI_TO_UTF(TOSTRING(count));
         RoR::App::GetGuiManager()->GetLoadingWindow()->SetProgress(progress, tmp);
 
-        String path = PathCombine(file.archive->getName(), file.filename);
-        this->ParseSingleZip(path);
+        tasks[i]->join();
+        tasks[i].reset();
+
+        RoR::LogFormat("[RoR|ModCache] Adding archive '%s'", paths[i].c_str());
+        if (results[i].empty())
+        {
+            LOG("No usable content in: '" + paths[i] + "'");
+        }
+        for (CacheScanResult& res : results[i])
+        {
+            this->MergeScanResult(res);
+        }
+        results[i].clear();
+        results[i].shrink_to_fit(); // Thumbnails and skin defs add up
+        m_resource_paths.insert(paths[i]);
     }
 
     RoR::App::GetGuiManager()->SetVisible_LoadingWindow(false);
     App::GetGuiManager()->GetMainMenu()->CacheUpdatedNotice();
 }
 
-void CacheSystem::ParseSingleZip(String path)
+void CacheSystem::ScanArchive(String path, std::vector<CacheScanResult>& out_results)
 {
-    if (std::find(m_resource_paths.begin(), m_resource_paths.end(), path) == m_resource_paths.end())
+    // Creating the archive through the factory keeps it out of `ArchiveManager`
+    // and the resource groups, neither of which may be used from worker threads.
+    Ogre::ZipArchiveFactory factory;
+    Ogre::Archive* archive = nullptr;
+    try
     {
-        RoR::LogFormat("[RoR|ModCache] Adding archive '%s'", path.c_str());
-        ResourceGroupManager::getSingleton().createResourceGroup(RGN_TEMP, false);
-        try
+        archive = factory.createInstance(path, /*readOnly=*/true);
+        archive->load();
+
+        for (auto ext : m_known_extensions)
         {
-            ResourceGroupManager::getSingleton().addResourceLocation(path, "Zip", RGN_TEMP);
-            if (ParseKnownFiles(RGN_TEMP))
+            auto files = archive->findFileInfo("*." + ext, /*recursive=*/false);
+            for (const auto& file : *files)
             {
-                LOG("No usable content in: '" + path + "'");
+                out_results.emplace_back();
+                out_results.back().csr_file = file;
+                out_results.back().csr_file.archive = archive;
+                out_results.back().csr_ext = ext;
+                this->ScanFile(archive, out_results.back());
             }
         }
-        catch (Ogre::Exception& e)
-        {
-            LOG("Error while opening archive: '" + path + "': " + e.getFullDescription());
-        }
-        ResourceGroupManager::getSingleton().destroyResourceGroup(RGN_TEMP);
-        m_resource_paths.insert(path);
+    }
+    catch (Ogre::Exception& e)
+    {
+        out_results.clear();
+        out_results.emplace_back();
+        out_results.back().csr_file.filename = path;
+        out_results.back().csr_error = "Error while opening archive: " + e.getFullDescription();
+    }
+
+    if (archive != nullptr)
+    {
+        archive->unload();
+        factory.destroyInstance(archive);
+    }
+
+    for (CacheScanResult& res : out_results)
+    {
+        res.csr_file.archive = nullptr; // Dangling from now on
     }
 }
 
 bool CacheSystem::ParseKnownFiles(Ogre::String group)
 {
     bool empty = true;
+    std::vector<CacheScanResult> results;
     for (auto ext : m_known_extensions)
     {
         auto files = ResourceGroupManager::getSingleton().findResourceFileInfo(group, "*." + ext);
         for (const auto& file : *files)
         {
-            this->AddFile(group, file, ext);
             empty = false;
+            String path = file.archive->getName();
+            if (std::find_if(m_entries.begin(), m_entries.end(), [&](CacheEntry& e)
+                        { return !e.deleted && e.fname == file.filename && e.resource_bundle_path == path; }) != m_entries.end())
+                continue;
+
+            results.emplace_back();
+            results.back().csr_file = file;
+            results.back().csr_ext = ext;
         }
     }
+
+    // Filesystem archives only create a fresh stream per `open()`, so they're safe to share between tasks.
+    std::vector<std::function<void()>> tasks;
+    for (CacheScanResult& res : results)
+    {
+        tasks.push_back([this, &res] { this->ScanFile(res.csr_file.archive, res); });
+    }
+    App::GetThreadPool()->Parallelize(tasks);
+
+    for (CacheScanResult& res : results)
+    {
+        this->MergeScanResult(res);
+    }
     return empty;
 }
 
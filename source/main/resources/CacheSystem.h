@@ -34,8 +34,10 @@
 #include <Ogre.h>
 #include <rapidjson/document.h>
 #include <string>
+#include <unordered_map>
 
-#define CACHE_FILE "mods.cache"
+#define CACHE_FILE "mods.cache" // JSON, human-readable copy of CACHE_FILE_BINARY; only read if the binary file is missing
+#define CACHE_FILE_BINARY "mods.cache.bin"
 #define CACHE_FILE_FORMAT 11
 #define CACHE_FILE_FRESHNESS 86400 // 60*60*24 = one day
 
@@ -170,6 +172,16 @@ struct CacheQuery
     std::time_t                    cqy_res_last_update = std::time_t();
 };
 
+/// Result of scanning one content file on a worker thread, see `CacheSystem::ScanFile()`.
+struct CacheScanResult
+{
+    Ogre::FileInfo                  csr_file;
+    Ogre::String                    csr_ext;
+    std::vector<CacheEntry>         csr_entries;
+    std::vector<std::vector<char>>  csr_thumbnails; //!< Parallel to `csr_entries`, destination name is `CacheEntry::filecachename`; empty = none
+    std::string                     csr_error;      //!< Non-empty if the file (or whole archive) could not be processed
+};
+
 enum class CacheValidity
 {
     UNKNOWN,
@@ -183,7 +195,9 @@ enum class CacheValidity
 ///    RoR users usually have A LOT of content installed. Traversing it all on every game startup would be a pain.
 /// HOW IT WORKS:
 ///    For each recognized resource type (vehicle, terrain, skin...) an instance of 'CacheEntry' is created.
-///       These entries are persisted in file CACHE_FILE (see above)
+///       These entries are persisted in file CACHE_FILE_BINARY (see above), which is memory-mapped on startup.
+///       Layout: header, entry records, author records, section-config refs, string table.
+///       Records are fixed-size; strings are (offset, length) refs into the deduplicated string table.
 ///    Associated media live in a "resource bundle" (ZIP archive or subdirectory) in content directory (ROR_HOME/mods) and subdirectories.
 ///       If multiple CacheEntries share a bundle, the bundle is loaded only once. Each bundle has dedicated OGRE resource group.
 class CacheSystem : public ZeroedMemoryAllocator
@@ -218,21 +232,27 @@ private:
 
     void WriteCacheFileJson();
     void ExportEntryToJson(rapidjson::Value& j_entries, rapidjson::Document& j_doc, CacheEntry const & entry);
-    void LoadCacheFileJson();
+    bool LoadCacheFileJson(); //!< Returns false if missing or invalid
     void ImportEntryFromJson(rapidjson::Value& j_entry, CacheEntry & out_entry);
 
+    void WriteCacheFileBinary();
+    bool LoadCacheFileBinary(); //!< Returns false if missing, damaged or of different format version
+    void ImportCategory(int category_id, CacheEntry & out_entry);
+
     static Ogre::String StripUIDfromString(Ogre::String uidstr); 
     static Ogre::String StripSHA1fromString(Ogre::String sha1str);
 
     void ParseZipArchives(Ogre::String group);
     bool ParseKnownFiles(Ogre::String group); // returns true if no known files are found
-    void ParseSingleZip(Ogre::String path);
+
+    // Scanning runs on the thread pool and must not touch `m_entries`; results are merged on the main thread.
+    void ScanArchive(Ogre::String path, std::vector<CacheScanResult>& out_results); //!< Opens the ZIP directly, bypassing the OGRE resource system.
+    void ScanFile(Ogre::Archive* archive, CacheScanResult& res);
+    void MergeScanResult(CacheScanResult& res);
 
     void ClearCache(); // removes                   all files from the cache
     void PruneCache(); // removes modified (or deleted) files from the cache
 
-    void AddFile(Ogre::String group, Ogre::FileInfo f, Ogre::String ext);
-
     void DetectDuplicates();
 
     void FillTerrainDetailInfo(CacheEntry &entry, Ogre::DataStreamPtr ds, Ogre::String fname);
@@ -240,16 +260,29 @@ private:
 
     void GenerateHashFromFilenames();         //!< For quick detection of added/removed content
 
-    void GenerateFileCache(CacheEntry &entry, Ogre::String group);
+    void ResetFilenameIndex();
+    void UpdateFilenameIndex();               //!< Indexes entries appended since the last call
+    static uint32_t MakeTrigram(const char* str);
+
+    void ReadFileCache(Ogre::Archive* archive, CacheEntry &entry, std::vector<char>& out_data); //!< Worker thread: picks the thumbnail and reads it from the bundle
+    void WriteFileCache(CacheEntry &entry, std::vector<char> const& data); //!< Main thread: stores the thumbnail in the cache directory
     void RemoveFileCache(CacheEntry &entry);
 
     bool Match(size_t& out_score, std::string data, std::string const& query, size_t );
 
     std::time_t                          m_update_time;      //!< Ensures that all inserted files share the same timestamp
     std::string                          m_filenames_hash;   //!< stores hash over the content, for quick update detection
+    std::string                          m_cache_file_hash;  //!< `m_filenames_hash` stored in the last loaded cache file
+    bool                                 m_cache_file_loaded = false; //!< `m_entries` holds the cache file as read by `EvaluateCacheValidity()`, reused by `LoadModCache()`
     std::vector<CacheEntry>              m_entries;
     std::vector<Ogre::String>            m_known_extensions; //!< the extensions we track in the cache system
     std::set<Ogre::String>               m_resource_paths;   //!< A temporary list of existing resource paths
+
+    // Lookup index for `FindEntryByFilename()`, [0] = actors, [1] = terrains; rebuilt lazily, see `UpdateFilenameIndex()`
+    std::unordered_map<std::string, size_t>            m_fname_index[2];        //!< Lowercase fname and fname_without_uid -> first entry index
+    std::unordered_map<uint32_t, std::vector<size_t>>  m_fname_trigrams[2];     //!< Trigram of lowercase fname -> entry indices, ascending
+    std::vector<size_t>                                m_fname_kind_entries[2]; //!< All entry indices, for queries shorter than a trigram
+    std::vector<std::string>                           m_fname_lower;           //!< Lowercase fname per indexed entry
     std::map<int, Ogre::String>          m_categories = {
             // these are the category numbers from the repository. do not modify them!
 
@@ -2105,7 +2105,7 @@ struct File
 
     File();
 
-    /** IMPORTANT! If you add a value here, you must also modify Regexes::IDENTIFY_KEYWORD, it relies on numeric values of this enum. */
+    /** IMPORTANT! If you add a value here, you must also modify KEYWORD_TABLE in RigDef_Parser.cpp, it relies on numeric values of this enum. */
     enum Keyword
     {
         KEYWORD_ADD_ANIMATION = 1,
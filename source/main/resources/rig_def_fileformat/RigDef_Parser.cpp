@@ -33,6 +33,10 @@
 #include "RigDef_Regexes.h"
 #include "Utils.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
 #include <OgreException.h>
 #include <OgreString.h>
 #include <OgreStringVector.h>
@@ -63,6 +67,121 @@ inline bool StrEqualsNocase(std::string const & s1, std::string const & s2)
     return true;
 }
 
+/// Fast path for `Ogre::StringConverter::parseReal()` (std::stringstream + strtof, very slow).
+/// Only handles input where plain float math gives the same, correctly rounded result:
+/// up to 24 significant bits of mantissa and decimal exponent within +-10.
+/// Returns false for anything else (including malformed input) - use Ogre then.
+static bool ParseFloatFast(const char* str, const char* end, float& out)
+{
+    static const float POW10[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+    while (str != end && IsWhitespace(*str)) { ++str; }
+    bool negative = false;
+    if (str != end && (*str == '-' || *str == '+'))
+    {
+        negative = (*str == '-');
+        ++str;
+    }
+
+    uint64_t mantissa = 0;
+    int num_digits = 0;
+    int exponent = 0;
+    bool any_digit = false;
+    for (; str != end && *str >= '0' && *str <= '9'; ++str)
+    {
+        any_digit = true;
+        if (mantissa == 0 && *str == '0') { continue; } // Leading zero
+        if (++num_digits > 18) { return false; }
+        mantissa = (mantissa * 10) + (*str - '0');
+    }
+    if (str != end && *str == '.')
+    {
+        for (++str; str != end && *str >= '0' && *str <= '9'; ++str)
+        {
+            any_digit = true;
+            --exponent;
+            if (mantissa == 0 && *str == '0') { continue; } // Leading zero
+            if (++num_digits > 18) { return false; }
+            mantissa = (mantissa * 10) + (*str - '0');
+        }
+    }
+    if (!any_digit)
+    {
+        return false;
+    }
+    if (str != end && (*str == 'e' || *str == 'E'))
+    {
+        ++str;
+        bool exp_negative = false;
+        if (str != end && (*str == '-' || *str == '+'))
+        {
+            exp_negative = (*str == '-');
+            ++str;
+        }
+        int exp_value = 0;
+        int exp_digits = 0;
+        for (; str != end && *str >= '0' && *str <= '9'; ++str)
+        {
+            if (++exp_digits > 3) { return false; }
+            exp_value = (exp_value * 10) + (*str - '0');
+        }
+        if (exp_digits == 0) { return false; } // Stringstream rejects "1e" - let Ogre handle it
+        exponent += (exp_negative) ? -exp_value : exp_value;
+    }
+    // Stringstream stops at the first character which doesn't fit; leave anything suspicious to Ogre
+    if (str != end && (strchr("0123456789.eE+-", *str) != nullptr))
+    {
+        return false;
+    }
+
+    if (mantissa == 0)
+    {
+        out = (negative) ? -0.f : 0.f;
+        return true;
+    }
+    while (mantissa % 10 == 0)
+    {
+        mantissa /= 10;
+        ++exponent;
+    }
+    if (mantissa > (1u << 24) || exponent < -10 || exponent > 10)
+    {
+        return false;
+    }
+    // Both operands are exact floats, so the result is correctly rounded like strtof()
+    float value = static_cast<float>(mantissa);
+    value = (exponent < 0) ? (value / POW10[-exponent]) : (value * POW10[exponent]);
+    out = (negative) ? -value : value;
+    return true;
+}
+
+/// Fast path for decimal integers: optional sign and up to 9 digits (no overflow possible).
+/// Returns false if there are no digits or too many - use strtol()/Ogre then.
+/// On success, `out_end` points to the first character after the digits.
+static bool ParseIntFast(const char* str, const char* end, long& out, const char*& out_end)
+{
+    bool negative = false;
+    if (str != end && (*str == '-' || *str == '+'))
+    {
+        negative = (*str == '-');
+        ++str;
+    }
+    long value = 0;
+    int num_digits = 0;
+    for (; str != end && *str >= '0' && *str <= '9'; ++str)
+    {
+        if (++num_digits > 9) { return false; }
+        value = (value * 10) + (*str - '0');
+    }
+    if (num_digits == 0)
+    {
+        return false;
+    }
+    out = (negative) ? -value : value;
+    out_end = str;
+    return true;
+}
+
 #define STR_PARSE_INT(_STR_)  Ogre::StringConverter::parseInt(_STR_)
 
 #define STR_PARSE_REAL(_STR_) Ogre::StringConverter::parseReal(_STR_)
@@ -2427,7 +2546,12 @@ Node::Ref Parser::_ParseNodeRef(std::string const & node_id_str)
     if (m_sequential_importer.IsEnabled())
     {
         // Import of legacy fileformatversion
-        int node_id_num = STR_PARSE_INT(node_id_str);
+        long node_id_num = 0;
+        const char* node_id_end = nullptr;
+        if (!ParseIntFast(node_id_str.c_str(), node_id_str.c_str() + node_id_str.size(), node_id_num, node_id_end))
+        {
+            node_id_num = STR_PARSE_INT(node_id_str);
+        }
         if (node_id_num < 0)
         {
             Str<2000> msg;
@@ -2951,22 +3075,26 @@ void Parser::ParseManagedMaterials()
         return;
     }
 
-    Ogre::ResourceGroupManager& rgm = Ogre::ResourceGroupManager::getSingleton();
-
-    if (!rgm.resourceExists(m_resource_group, managed_mat.diffuse_map))
-    {
-        this->AddMessage(Message::TYPE_WARNING, "Missing texture file: " + managed_mat.diffuse_map);
-        return;
-    }
-    if (managed_mat.HasDamagedDiffuseMap() && !rgm.resourceExists(m_resource_group, managed_mat.damaged_diffuse_map))
-    {
-        this->AddMessage(Message::TYPE_WARNING, "Missing texture file: " + managed_mat.damaged_diffuse_map);
-        managed_mat.damaged_diffuse_map = "-";
-    }
-    if (managed_mat.HasSpecularMap() && !rgm.resourceExists(m_resource_group, managed_mat.specular_map))
+    // No resource group = parsing on a worker thread (ModCache scan, async actor spawn); the resource system is off limits there.
+    if (!m_resource_group.empty())
     {
-        this->AddMessage(Message::TYPE_WARNING, "Missing texture file: " + managed_mat.specular_map);
-        managed_mat.specular_map = "-";
+        Ogre::ResourceGroupManager& rgm = Ogre::ResourceGroupManager::getSingleton();
+
+        if (!rgm.resourceExists(m_resource_group, managed_mat.diffuse_map))
+        {
+            this->AddMessage(Message::TYPE_WARNING, "Missing texture file: " + managed_mat.diffuse_map);
+            return;
+        }
+        if (managed_mat.HasDamagedDiffuseMap() && !rgm.resourceExists(m_resource_group, managed_mat.damaged_diffuse_map))
+        {
+            this->AddMessage(Message::TYPE_WARNING, "Missing texture file: " + managed_mat.damaged_diffuse_map);
+            managed_mat.damaged_diffuse_map = "-";
+        }
+        if (managed_mat.HasSpecularMap() && !rgm.resourceExists(m_resource_group, managed_mat.specular_map))
+        {
+            this->AddMessage(Message::TYPE_WARNING, "Missing texture file: " + managed_mat.specular_map);
+            managed_mat.specular_map = "-";
+        }
     }
 
     m_current_module->managed_materials.push_back(managed_mat);
@@ -3224,6 +3352,181 @@ void Parser::AddMessage(std::string const & line, Message::Type type, std::strin
     RoR::App::GetConsole()->putMessage(RoR::Console::CONSOLE_MSGTYPE_ACTOR, cm_type, txt.ToCStr());
 }
 
+// -------------------------------------------------------------------------- //
+// Keyword identification                                                     //
+// -------------------------------------------------------------------------- //
+
+enum KeywordKind
+{
+    KEYWORD_KIND_BLOCK,            //!< Keyword on it's own line, i.e. "beams"
+    KEYWORD_KIND_INLINE,           //!< Keyword followed by space and values, i.e. "author chassis -1 ..."
+    KEYWORD_KIND_INLINE_TOLERANT,  //!< Like inline, but values can also be delimited by comma
+};
+
+constexpr size_t KeywordStrlen(const char* str)
+{
+    return (*str == '\0') ? 0 : 1 + KeywordStrlen(str + 1);
+}
+
+constexpr char KeywordToLower(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? (c - 'A' + 'a') : c;
+}
+
+struct KeywordEntry
+{
+    constexpr KeywordEntry(const char* _name, KeywordKind _kind): name(_name), length(KeywordStrlen(_name)), kind(_kind) {}
+
+    const char*  name;
+    size_t       length;
+    KeywordKind  kind;
+};
+
+/// Position N holds `File::Keyword` N+1; IMPORTANT! If you add a value here, you must also modify File::Keyword enum.
+/// Must stay grouped by first letter, the lookup only searches entries with the matching letter.
+static constexpr KeywordEntry KEYWORD_TABLE[] =
+{
+    { "add_animation",                 KEYWORD_KIND_INLINE_TOLERANT  }, // KEYWORD_ADD_ANIMATION
+    { "airbrakes",                     KEYWORD_KIND_BLOCK            }, // KEYWORD_AIRBRAKES
+    { "animators",                     KEYWORD_KIND_BLOCK            }, // KEYWORD_ANIMATORS
+    { "AntiLockBrakes",                KEYWORD_KIND_INLINE           }, // KEYWORD_ANTI_LOCK_BRAKES
+    { "axles",                         KEYWORD_KIND_BLOCK            }, // KEYWORD_AXLES
+    { "author",                        KEYWORD_KIND_INLINE           }, // KEYWORD_AUTHOR
+    { "backmesh",                      KEYWORD_KIND_BLOCK            }, // KEYWORD_BACKMESH
+    { "beams",                         KEYWORD_KIND_BLOCK            }, // KEYWORD_BEAMS
+    { "brakes",                        KEYWORD_KIND_BLOCK            }, // KEYWORD_BRAKES
+    { "cab",                           KEYWORD_KIND_BLOCK            }, // KEYWORD_CAB
+    { "camerarail",                    KEYWORD_KIND_BLOCK            }, // KEYWORD_CAMERARAIL
+    { "cameras",                       KEYWORD_KIND_BLOCK            }, // KEYWORD_CAMERAS
+    { "cinecam",                       KEYWORD_KIND_BLOCK            }, // KEYWORD_CINECAM
+    { "collisionboxes",                KEYWORD_KIND_BLOCK            }, // KEYWORD_COLLISIONBOXES
+    { "commands",                      KEYWORD_KIND_BLOCK            }, // KEYWORD_COMMANDS
+    { "commands2",                     KEYWORD_KIND_BLOCK            }, // KEYWORD_COMMANDS2
+    { "contacters",                    KEYWORD_KIND_BLOCK            }, // KEYWORD_CONTACTERS
+    { "cruisecontrol",                 KEYWORD_KIND_INLINE           }, // KEYWORD_CRUISECONTROL
+    { "description",                   KEYWORD_KIND_BLOCK            }, // KEYWORD_DESCRIPTION
+    { "detacher_group",                KEYWORD_KIND_INLINE           }, // KEYWORD_DETACHER_GROUP
+    { "disabledefaultsounds",          KEYWORD_KIND_BLOCK            }, // KEYWORD_DISABLEDEFAULTSOUNDS
+    { "enable_advanced_deformation",   KEYWORD_KIND_BLOCK            }, // KEYWORD_ENABLE_ADVANCED_DEFORM
+    { "end",                           KEYWORD_KIND_BLOCK            }, // KEYWORD_END
+    { "end_section",                   KEYWORD_KIND_BLOCK            }, // KEYWORD_END_SECTION
+    { "engine",                        KEYWORD_KIND_BLOCK            }, // KEYWORD_ENGINE
+    { "engoption",                     KEYWORD_KIND_BLOCK            }, // KEYWORD_ENGOPTION
+    { "engturbo",                      KEYWORD_KIND_BLOCK            }, // KEYWORD_ENGTURBO
+    { "envmap",                        KEYWORD_KIND_BLOCK            }, // KEYWORD_ENVMAP
+    { "exhausts",                      KEYWORD_KIND_BLOCK            }, // KEYWORD_EXHAUSTS
+    { "extcamera",                     KEYWORD_KIND_INLINE           }, // KEYWORD_EXTCAMERA
+    { "fileformatversion",             KEYWORD_KIND_INLINE           }, // KEYWORD_FILEFORMATVERSION
+    { "fileinfo",                      KEYWORD_KIND_INLINE           }, // KEYWORD_FILEINFO
+    { "fixes",                         KEYWORD_KIND_BLOCK            }, // KEYWORD_FIXES
+    { "flares",                        KEYWORD_KIND_BLOCK            }, // KEYWORD_FLARES
+    { "flares2",                       KEYWORD_KIND_BLOCK            }, // KEYWORD_FLARES2
+    { "flexbodies",                    KEYWORD_KIND_BLOCK            }, // KEYWORD_FLEXBODIES
+    { "flexbody_camera_mode",          KEYWORD_KIND_INLINE           }, // KEYWORD_FLEXBODY_CAMERA_MODE
+    { "flexbodywheels",                KEYWORD_KIND_BLOCK            }, // KEYWORD_FLEXBODYWHEELS
+    { "forwardcommands",               KEYWORD_KIND_BLOCK            }, // KEYWORD_FORWARDCOMMANDS
+    { "fusedrag",                      KEYWORD_KIND_BLOCK            }, // KEYWORD_FUSEDRAG
+    { "globals",                       KEYWORD_KIND_BLOCK            }, // KEYWORD_GLOBALS
+    { "guid",                          KEYWORD_KIND_INLINE           }, // KEYWORD_GUID
+    { "guisettings",                   KEYWORD_KIND_BLOCK            }, // KEYWORD_GUISETTINGS
+    { "help",                          KEYWORD_KIND_BLOCK            }, // KEYWORD_HELP
+    { "hideInChooser",                 KEYWORD_KIND_BLOCK            }, // KEYWORD_HIDE_IN_CHOOSER
+    { "hookgroup",                     KEYWORD_KIND_BLOCK            }, // KEYWORD_HOOKGROUP
+    { "hooks",                         KEYWORD_KIND_BLOCK            }, // KEYWORD_HOOKS
+    { "hydros",                        KEYWORD_KIND_BLOCK            }, // KEYWORD_HYDROS
+    { "importcommands",                KEYWORD_KIND_BLOCK            }, // KEYWORD_IMPORTCOMMANDS
+    { "interaxles",                    KEYWORD_KIND_BLOCK            }, // KEYWORD_INTERAXLES
+    { "lockgroups",                    KEYWORD_KIND_BLOCK            }, // KEYWORD_LOCKGROUPS
+    { "lockgroup_default_nolock",      KEYWORD_KIND_BLOCK            }, // KEYWORD_LOCKGROUP_DEFAULT_NOLOCK
+    { "managedmaterials",              KEYWORD_KIND_BLOCK            }, // KEYWORD_MANAGEDMATERIALS
+    { "materialflarebindings",         KEYWORD_KIND_BLOCK            }, // KEYWORD_MATERIALFLAREBINDINGS
+    { "meshwheels",                    KEYWORD_KIND_BLOCK            }, // KEYWORD_MESHWHEELS
+    { "meshwheels2",                   KEYWORD_KIND_BLOCK            }, // KEYWORD_MESHWHEELS2
+    { "minimass",                      KEYWORD_KIND_BLOCK            }, // KEYWORD_MINIMASS
+    { "nodecollision",                 KEYWORD_KIND_BLOCK            }, // KEYWORD_NODECOLLISION
+    { "nodes",                         KEYWORD_KIND_BLOCK            }, // KEYWORD_NODES
+    { "nodes2",                        KEYWORD_KIND_BLOCK            }, // KEYWORD_NODES2
+    { "particles",                     KEYWORD_KIND_BLOCK            }, // KEYWORD_PARTICLES
+    { "pistonprops",                   KEYWORD_KIND_BLOCK            }, // KEYWORD_PISTONPROPS
+    { "prop_camera_mode",              KEYWORD_KIND_INLINE           }, // KEYWORD_PROP_CAMERA_MODE
+    { "props",                         KEYWORD_KIND_BLOCK            }, // KEYWORD_PROPS
+    { "railgroups",                    KEYWORD_KIND_BLOCK            }, // KEYWORD_RAILGROUPS
+    { "rescuer",                       KEYWORD_KIND_BLOCK            }, // KEYWORD_RESCUER
+    { "rigidifiers",                   KEYWORD_KIND_BLOCK            }, // KEYWORD_RIGIDIFIERS
+    { "rollon",                        KEYWORD_KIND_BLOCK            }, // KEYWORD_ROLLON
+    { "ropables",                      KEYWORD_KIND_BLOCK            }, // KEYWORD_ROPABLES
+    { "ropes",                         KEYWORD_KIND_BLOCK            }, // KEYWORD_ROPES
+    { "rotators",                      KEYWORD_KIND_BLOCK            }, // KEYWORD_ROTATORS
+    { "rotators2",                     KEYWORD_KIND_BLOCK            }, // KEYWORD_ROTATORS2
+    { "screwprops",                    KEYWORD_KIND_BLOCK            }, // KEYWORD_SCREWPROPS
+    { "section",                       KEYWORD_KIND_INLINE           }, // KEYWORD_SECTION
+    { "sectionconfig",                 KEYWORD_KIND_INLINE           }, // KEYWORD_SECTIONCONFIG
+    { "set_beam_defaults",             KEYWORD_KIND_INLINE           }, // KEYWORD_SET_BEAM_DEFAULTS
+    { "set_beam_defaults_scale",       KEYWORD_KIND_INLINE           }, // KEYWORD_SET_BEAM_DEFAULTS_SCALE
+    { "set_collision_range",           KEYWORD_KIND_INLINE           }, // KEYWORD_SET_COLLISION_RANGE
+    { "set_default_minimass",          KEYWORD_KIND_INLINE           }, // KEYWORD_SET_DEFAULT_MINIMASS
+    { "set_inertia_defaults",          KEYWORD_KIND_INLINE           }, // KEYWORD_SET_INERTIA_DEFAULTS
+    { "set_managedmaterials_options",  KEYWORD_KIND_INLINE           }, // KEYWORD_SET_MANAGEDMATS_OPTIONS
+    { "set_node_defaults",             KEYWORD_KIND_INLINE           }, // KEYWORD_SET_NODE_DEFAULTS
+    { "set_shadows",                   KEYWORD_KIND_BLOCK            }, // KEYWORD_SET_SHADOWS
+    { "set_skeleton_settings",         KEYWORD_KIND_INLINE           }, // KEYWORD_SET_SKELETON_SETTINGS
+    { "shocks",                        KEYWORD_KIND_BLOCK            }, // KEYWORD_SHOCKS
+    { "shocks2",                       KEYWORD_KIND_BLOCK            }, // KEYWORD_SHOCKS2
+    { "shocks3",                       KEYWORD_KIND_BLOCK            }, // KEYWORD_SHOCKS3
+    { "slidenode_connect_instantly",   KEYWORD_KIND_BLOCK            }, // KEYWORD_SLIDENODE_CONNECT_INSTANT
+    { "slidenodes",                    KEYWORD_KIND_BLOCK            }, // KEYWORD_SLIDENODES
+    { "SlopeBrake",                    KEYWORD_KIND_INLINE           }, // KEYWORD_SLOPE_BRAKE
+    { "soundsources",                  KEYWORD_KIND_BLOCK            }, // KEYWORD_SOUNDSOURCES
+    { "soundsources2",                 KEYWORD_KIND_BLOCK            }, // KEYWORD_SOUNDSOURCES2
+    { "speedlimiter",                  KEYWORD_KIND_INLINE           }, // KEYWORD_SPEEDLIMITER
+    { "submesh",                       KEYWORD_KIND_BLOCK            }, // KEYWORD_SUBMESH
+    { "submesh_groundmodel",           KEYWORD_KIND_INLINE           }, // KEYWORD_SUBMESH_GROUNDMODEL
+    { "texcoords",                     KEYWORD_KIND_BLOCK            }, // KEYWORD_TEXCOORDS
+    { "ties",                          KEYWORD_KIND_BLOCK            }, // KEYWORD_TIES
+    { "torquecurve",                   KEYWORD_KIND_BLOCK            }, // KEYWORD_TORQUECURVE
+    { "TractionControl",               KEYWORD_KIND_INLINE           }, // KEYWORD_TRACTION_CONTROL
+    { "transfercase",                  KEYWORD_KIND_BLOCK            }, // KEYWORD_TRANSFER_CASE
+    { "triggers",                      KEYWORD_KIND_BLOCK            }, // KEYWORD_TRIGGERS
+    { "turbojets",                     KEYWORD_KIND_BLOCK            }, // KEYWORD_TURBOJETS
+    { "turboprops",                    KEYWORD_KIND_BLOCK            }, // KEYWORD_TURBOPROPS
+    { "turboprops2",                   KEYWORD_KIND_BLOCK            }, // KEYWORD_TURBOPROPS2
+    { "videocamera",                   KEYWORD_KIND_BLOCK            }, // KEYWORD_VIDEOCAMERA
+    { "wheeldetachers",                KEYWORD_KIND_BLOCK            }, // KEYWORD_WHEELDETACHERS
+    { "wheels",                        KEYWORD_KIND_BLOCK            }, // KEYWORD_WHEELS
+    { "wheels2",                       KEYWORD_KIND_BLOCK            }, // KEYWORD_WHEELS2
+    { "wings",                         KEYWORD_KIND_BLOCK            }, // KEYWORD_WINGS
+};
+
+static constexpr int NUM_KEYWORDS = sizeof(KEYWORD_TABLE) / sizeof(KeywordEntry);
+static_assert(NUM_KEYWORDS == File::KEYWORD_WINGS, "KEYWORD_TABLE doesn't match File::Keyword enum");
+
+constexpr bool IsKeywordTableGrouped(int i)
+{
+    return (i + 1 >= NUM_KEYWORDS) ||
+        (KeywordToLower(KEYWORD_TABLE[i].name[0]) <= KeywordToLower(KEYWORD_TABLE[i + 1].name[0]) && IsKeywordTableGrouped(i + 1));
+}
+static_assert(IsKeywordTableGrouped(0), "KEYWORD_TABLE must be grouped by first letter");
+
+/// Index of the first entry starting with letter `c` or any later letter.
+constexpr int FindFirstKeywordWithLetter(char c, int i)
+{
+    return (i >= NUM_KEYWORDS || KeywordToLower(KEYWORD_TABLE[i].name[0]) >= c) ? i : FindFirstKeywordWithLetter(c, i + 1);
+}
+
+/// Entries starting with letter L are [KEYWORD_BUCKETS[L - 'a'], KEYWORD_BUCKETS[L - 'a' + 1])
+static constexpr int KEYWORD_BUCKETS[] =
+{
+    FindFirstKeywordWithLetter('a', 0), FindFirstKeywordWithLetter('b', 0), FindFirstKeywordWithLetter('c', 0),
+    FindFirstKeywordWithLetter('d', 0), FindFirstKeywordWithLetter('e', 0), FindFirstKeywordWithLetter('f', 0),
+    FindFirstKeywordWithLetter('g', 0), FindFirstKeywordWithLetter('h', 0), FindFirstKeywordWithLetter('i', 0),
+    FindFirstKeywordWithLetter('j', 0), FindFirstKeywordWithLetter('k', 0), FindFirstKeywordWithLetter('l', 0),
+    FindFirstKeywordWithLetter('m', 0), FindFirstKeywordWithLetter('n', 0), FindFirstKeywordWithLetter('o', 0),
+    FindFirstKeywordWithLetter('p', 0), FindFirstKeywordWithLetter('q', 0), FindFirstKeywordWithLetter('r', 0),
+    FindFirstKeywordWithLetter('s', 0), FindFirstKeywordWithLetter('t', 0), FindFirstKeywordWithLetter('u', 0),
+    FindFirstKeywordWithLetter('v', 0), FindFirstKeywordWithLetter('w', 0), FindFirstKeywordWithLetter('x', 0),
+    FindFirstKeywordWithLetter('y', 0), FindFirstKeywordWithLetter('z', 0), NUM_KEYWORDS
+};
+
 File::Keyword Parser::IdentifyKeywordInCurrentLine()
 {
     // Quick check - keyword always starts with ASCII letter
@@ -3233,42 +3536,63 @@ File::Keyword Parser::IdentifyKeywordInCurrentLine()
         return File::KEYWORD_INVALID;
     }
 
-    // Search with correct lettercase
-    std::smatch results;
-    std::string line(m_current_line);
-    std::regex_search(line, results, Regexes::IDENTIFY_KEYWORD_RESPECT_CASE); // Always returns true.
-    File::Keyword keyword = FindKeywordMatch(results);
-    if (keyword != File::KEYWORD_INVALID)
+    // The keyword ends with blank or comma; what follows must fit the keyword's kind
+    const size_t length = strcspn(m_current_line, " \t,");
+    const char* rest = m_current_line + length;
+
+    // Find the keyword, ignoring lettercase (no two keywords differ only by lettercase)
+    int found = -1;
+    for (int i = KEYWORD_BUCKETS[c - 'a']; i < KEYWORD_BUCKETS[c - 'a' + 1]; ++i)
     {
-        return keyword;
+        if (KEYWORD_TABLE[i].length != length)
+        {
+            continue;
+        }
+        size_t pos = 1; // First letter already matched
+        while (pos < length && KeywordToLower(KEYWORD_TABLE[i].name[pos]) == KeywordToLower(m_current_line[pos]))
+        {
+            ++pos;
+        }
+        if (pos == length)
+        {
+            found = i;
+            break;
+        }
     }
-
-    // Search and ignore lettercase
-    std::regex_search(line, results, Regexes::IDENTIFY_KEYWORD_IGNORE_CASE); // Always returns true.
-    keyword = FindKeywordMatch(results);
-    if (keyword != File::KEYWORD_INVALID)
+    if (found == -1)
     {
-        this->AddMessage(line, Message::TYPE_WARNING,
-            "Keyword has invalid lettercase. Correct form is: " + std::string(File::KeywordToString(keyword)));
+        return File::KEYWORD_INVALID;
     }
-    return keyword;
-}
 
-File::Keyword Parser::FindKeywordMatch(std::smatch& search_results)
-{
-    // The 'results' array contains a complete match at positon [0] and sub-matches starting with [1], 
-    //    so we get exact positions in Regexes::IDENTIFY_KEYWORD, which again match File::Keyword enum members
-
-    for (unsigned int i = 1; i < search_results.size(); i++)
+    switch (KEYWORD_TABLE[found].kind)
     {
-        std::ssub_match sub  = search_results[i];
-        if (sub.matched)
+    case KEYWORD_KIND_BLOCK:
+        if (rest[strspn(rest, " \t")] != '\0')
+        {
+            return File::KEYWORD_INVALID;
+        }
+        break;
+    case KEYWORD_KIND_INLINE:
+        if (rest[0] != ' ' && rest[0] != '\t')
         {
-            // Build enum value directly from result offset
-            return File::Keyword(i);
+            return File::KEYWORD_INVALID;
         }
+        break;
+    case KEYWORD_KIND_INLINE_TOLERANT:
+        if (rest[0] == '\0')
+        {
+            return File::KEYWORD_INVALID;
+        }
+        break;
     }
-    return File::KEYWORD_INVALID;
+
+    File::Keyword keyword = File::Keyword(found + 1);
+    if (strncmp(KEYWORD_TABLE[found].name, m_current_line, length) != 0)
+    {
+        this->AddMessage(m_current_line, Message::TYPE_WARNING,
+            "Keyword has invalid lettercase. Correct form is: " + std::string(File::KeywordToString(keyword)));
+    }
+    return keyword;
 }
 
 void Parser::Prepare()
@@ -3442,6 +3766,14 @@ MeshWheel::Side Parser::GetArgWheelSide(int index)
 
 long Parser::GetArgLong(int index)
 {
+    long fast_res = 0;
+    const char* fast_end = nullptr;
+    const char* arg_end = m_args[index].start + m_args[index].length;
+    if (ParseIntFast(m_args[index].start, arg_end, fast_res, fast_end) && fast_end == arg_end)
+    {
+        return fast_res;
+    }
+
     errno = 0;
     char* out_end = nullptr;
     const int MSG_LEN = 200;
@@ -3514,7 +3846,7 @@ Node::Ref Parser::GetArgNodeRef(int index)
 
 Node::Ref Parser::GetArgNullableNode(int index)
 {
-    if (! (Ogre::StringConverter::parseReal(this->GetArgStr(index)) == -1.f))
+    if (! (this->GetArgFloat(index) == -1.f))
     {
         return this->GetArgNodeRef(index);
     }
@@ -3549,11 +3881,21 @@ FlareType Parser::GetArgFlareType(int index)
 
 float Parser::GetArgFloat(int index)
 {
+    float res = 0.f;
+    if (ParseFloatFast(m_args[index].start, m_args[index].start + m_args[index].length, res))
+    {
+        return res;
+    }
     return (float) Ogre::StringConverter::parseReal(this->GetArgStr(index), 0.f);
 }
 
 float Parser::ParseArgFloat(const char* str)
 {
+    float res = 0.f;
+    if (ParseFloatFast(str, str + strlen(str), res))
+    {
+        return res;
+    }
     return (float) Ogre::StringConverter::parseReal(str, 0.f);
 }
 
@@ -3658,32 +4000,71 @@ void Parser::ProcessOgreStream(Ogre::DataStream* stream, Ogre::String resource_g
     m_resource_group = resource_group;
     m_filename = stream->getName();
 
-    char raw_line_buf[LINE_BUFFER_LENGTH];
-    while (!stream->eof())
+    // Work on the whole file in memory; memory streams (spawning from cache) are used directly, without a copy.
+    std::string contents;
+    const char* data = nullptr;
+    size_t data_len = 0;
+    Ogre::MemoryDataStream* mem_stream = dynamic_cast<Ogre::MemoryDataStream*>(stream);
+    if (mem_stream != nullptr)
+    {
+        data = reinterpret_cast<const char*>(mem_stream->getCurrentPtr());
+        data_len = mem_stream->size() - mem_stream->tell();
+    }
+    else
     {
         try
         {
-            stream->readLine(raw_line_buf, LINE_BUFFER_LENGTH);
+            contents = stream->getAsString();
         }
         catch (Ogre::Exception &ex)
         {
             std::string msg = "Error reading truckfile! Message:\n";
             msg += ex.getFullDescription();
             this->AddMessage(Message::TYPE_FATAL_ERROR, msg.c_str());
-            break;
+            return;
+        }
+        data = contents.data();
+        data_len = contents.size();
+    }
+
+    // Split lines like `Ogre::DataStream::readLine()` did: trailing CR is removed, overlong lines are wrapped.
+    const char* data_end = data + data_len;
+    const char* line_start = data;
+    while (line_start < data_end)
+    {
+        const size_t window = std::min<size_t>(data_end - line_start, LINE_BUFFER_LENGTH);
+        const char* newline = static_cast<const char*>(memchr(line_start, '\n', window));
+        const char* line_end = nullptr;
+        const char* next_line = nullptr;
+        if (newline != nullptr)
+        {
+            line_end = newline;
+            next_line = newline + 1;
+            if (line_end != line_start && *(line_end - 1) == '\r')
+            {
+                --line_end;
+            }
+        }
+        else
+        {
+            line_end = line_start + std::min<size_t>(window, LINE_BUFFER_LENGTH - 1);
+            next_line = line_end;
         }
 
-        this->ProcessRawLine(raw_line_buf);
+        this->ProcessRawLine(line_start, line_end);
+        line_start = next_line;
     }
 }
 
 void Parser::ProcessRawLine(const char* raw_line_buf)
 {
-    const char* raw_start = raw_line_buf;
-    const char* raw_end = raw_line_buf + strnlen(raw_line_buf, LINE_BUFFER_LENGTH);
+    this->ProcessRawLine(raw_line_buf, raw_line_buf + strnlen(raw_line_buf, LINE_BUFFER_LENGTH - 1));
+}
 
+void Parser::ProcessRawLine(const char* raw_start, const char* raw_end)
+{
     // Trim leading whitespace
-    while (IsWhitespace(*raw_start) && (raw_start != raw_end))
+    while ((raw_start != raw_end) && IsWhitespace(*raw_start))
     {
         ++raw_start;
     }
@@ -3695,10 +4076,10 @@ void Parser::ProcessRawLine(const char* raw_line_buf)
         return;
     }
 
-    // Sanitize UTF-8
-    memset(m_current_line, 0, LINE_BUFFER_LENGTH);
-    char* out_start = m_current_line;
-    utf8::replace_invalid(raw_start, raw_end, out_start, '?');
+    // Sanitize UTF-8; embedded NUL terminates the line, same as with C-string input.
+    raw_end = std::find(raw_start, raw_end, '\0');
+    char* out_end = utf8::replace_invalid(raw_start, raw_end, m_current_line, '?');
+    *out_end = '\0';
 
     // Process
     this->ProcessCurrentLine();
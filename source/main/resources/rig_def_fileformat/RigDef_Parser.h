@@ -195,6 +195,7 @@ private:
 //  Utilities
 // --------------------------------------------------------------------------
 
+    void             ProcessRawLine(const char* raw_start, const char* raw_end); //!< Line must fit into `m_current_line`
     void             ProcessCurrentLine();
     int              TokenizeCurrentLine();
     bool             CheckNumArguments(int num_required_args);
@@ -230,9 +231,6 @@ private:
     /// Keyword scan function. 
     File::Keyword IdentifyKeywordInCurrentLine();
 
-    /// Keyword scan utility function. 
-    File::Keyword FindKeywordMatch(std::smatch& search_results);
-
     /// Adds a message to console
     void AddMessage(std::string const & line, Message::Type type, std::string const & message);
     void AddMessage(Message::Type type, const char* msg)
@@ -49,6 +49,7 @@ void Console::cVarSetupBuiltins()
     App::sim_replay_enabled      = this->cVarCreate("sim_replay_enabled",      "Replay mode",                CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::sim_replay_length       = this->cVarCreate("sim_replay_length",       "Replay length",              CVAR_ARCHIVE | CVAR_TYPE_INT,     "200");
     App::sim_replay_stepping     = this->cVarCreate("sim_replay_stepping",     "Replay Steps per second",    CVAR_ARCHIVE | CVAR_TYPE_INT,     "1000");
+    App::sim_replay_memory       = this->cVarCreate("sim_replay_memory",       "Replay memory (MB)",         CVAR_ARCHIVE | CVAR_TYPE_INT,     "256");
     App::sim_realistic_commands  = this->cVarCreate("sim_realistic_commands",  "Realistic forward commands", CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::sim_races_enabled       = this->cVarCreate("sim_races_enabled",       "Races",                      CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
     App::sim_no_collisions       = this->cVarCreate("sim_no_collisions",       "DisableCollisions",          CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
@@ -56,6 +57,7 @@ void Console::cVarSetupBuiltins()
     App::sim_gearbox_mode        = this->cVarCreate("sim_gearbox_mode",        "GearboxMode",                CVAR_ARCHIVE | CVAR_TYPE_INT);
     App::sim_soft_reset_mode     = this->cVarCreate("sim_soft_reset_mode",     "",                                          CVAR_TYPE_BOOL,    "false");
     App::sim_quickload_dialog    = this->cVarCreate("sim_quickload_dialog",    "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
+    App::sim_legacy_collision_hash = this->cVarCreate("sim_legacy_collision_hash", "Legacy collision hash",  CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
 
     App::mp_state                = this->cVarCreate("mp_state",                "",                                          CVAR_TYPE_INT,     "0"/*(int)MpState::DISABLED*/);
     App::mp_join_on_startup      = this->cVarCreate("mp_join_on_startup",      "Auto connect",               CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
@@ -63,6 +65,7 @@ void Console::cVarSetupBuiltins()
     App::mp_hide_net_labels      = this->cVarCreate("mp_hide_net_labels",      "Hide net labels",            CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::mp_hide_own_net_label   = this->cVarCreate("mp_hide_own_net_label",   "Hide own net label",         CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
     App::mp_pseudo_collisions    = this->cVarCreate("mp_pseudo_collisions",    "Multiplayer collisions",     CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
+    App::mp_wheel_update_range   = this->cVarCreate("mp_wheel_update_range",   "Remote wheel update range",  CVAR_ARCHIVE | CVAR_TYPE_INT,     "250");
     App::mp_server_host          = this->cVarCreate("mp_server_host",          "Server name",                CVAR_ARCHIVE);
     App::mp_server_port          = this->cVarCreate("mp_server_port",          "Server port",                CVAR_ARCHIVE | CVAR_TYPE_INT);
     App::mp_server_password      = this->cVarCreate("mp_server_password",      "Server password",            CVAR_ARCHIVE | CVAR_NO_LOG);
@@ -35,6 +35,10 @@
 #include <OgreLight.h>
 #include <Terrain/OgreTerrainGroup.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#endif
+
 using namespace Ogre;
 using namespace RoR;
 
@@ -136,6 +140,9 @@ Ogre::MaterialPtr Terrn2CustomMaterial::Profile::generate(const Ogre::Terrain* t
 
 TerrainGeometryManager::TerrainGeometryManager(TerrainManager* terrainManager)
     : mHeightData(nullptr)
+    , m_field_origin_x(0.0f)
+    , m_field_origin_z(0.0f)
+    , m_field_inv_scale(1.0f)
     , mIsFlat(false)
     , mMinHeight(0.0f)
     , mMaxHeight(std::numeric_limits<float>::min())
@@ -250,6 +257,144 @@ Ogre::Vector3 TerrainGeometryManager::getNormalAt(float x, float y, float z)
     return normal;
 }
 
+// Collision heightfield: the same triangulation as getHeightAtTerrainPosition(), but each triangle is
+// written as `h = base + u * grad_u + w * grad_w` over cell-local coordinates (u, w), so the height and
+// the (constant) triangle normal fall out of one evaluation without building planes.
+//   even row: w > u      -> triangle 0-2-3; else 0-1-2
+//   odd row:  u + w < 1  -> triangle 0-1-3; else 1-2-3
+// The normal is that of the triangle, which `getNormalAt()` approximates by finite differences.
+
+void TerrainGeometryManager::getHeightAndNormalAt(float x, float z, float& out_height, Ogre::Vector3& out_normal)
+{
+    out_normal = Vector3::UNIT_Y;
+    if (m_spec->is_flat)
+    {
+        out_height = 0.0f;
+        return;
+    }
+
+    const float fx = (x - m_field_origin_x) * m_field_inv_scale;
+    const float fz = (m_field_origin_z - z) * m_field_inv_scale;
+    const float max_coord = static_cast<float>(mSize - 1);
+    if (!(fx > 0.0f && fz > 0.0f && fx < max_coord && fz < max_coord))
+    {
+        out_height = terrainManager->GetDef().water_bottom_height;
+        return;
+    }
+    else if (mIsFlat)
+    {
+        out_height = mMinHeight;
+        return;
+    }
+
+    const int cell_x = static_cast<int>(fx);
+    const int cell_z = static_cast<int>(fz);
+    const float u = fx - cell_x;
+    const float w = fz - cell_z;
+
+    const float* row0 = mHeightData + (cell_z * mSize + cell_x);
+    const float* row1 = row0 + mSize;
+    const float h0 = row0[0];
+    const float h1 = row0[1];
+    const float h2 = row1[1];
+    const float h3 = row1[0];
+
+    const bool odd = (cell_z & 1) != 0;
+    const bool second = odd ? (u + w < 1.0f) : (w > u);
+    const float grad_u = (second != odd) ? (h2 - h3) : (h1 - h0);
+    const float grad_w = second ? (h3 - h0) : (h2 - h1);
+    const float base = (odd && !second) ? (h1 + h3 - h2) : h0;
+
+    out_height = base + u * grad_u + w * grad_w;
+    out_normal = Vector3(-grad_u, mScale, grad_w);
+    out_normal.normalise();
+}
+
+void TerrainGeometryManager::getHeightsAndNormalsAt(size_t count, const float* x, const float* z, float* out_height, Ogre::Vector3* out_normal)
+{
+    size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    if (!m_spec->is_flat && !mIsFlat && mHeightData != nullptr)
+    {
+        const __m128 origin_x  = _mm_set1_ps(m_field_origin_x);
+        const __m128 origin_z  = _mm_set1_ps(m_field_origin_z);
+        const __m128 inv_scale = _mm_set1_ps(m_field_inv_scale);
+        const __m128 max_coord = _mm_set1_ps(static_cast<float>(mSize - 1));
+        const __m128 zero      = _mm_setzero_ps();
+        const __m128 one       = _mm_set1_ps(1.0f);
+        const __m128 scale     = _mm_set1_ps(mScale);
+        const __m128 outside_height = _mm_set1_ps(terrainManager->GetDef().water_bottom_height);
+
+        alignas(16) int32_t cell_x[4];
+        alignas(16) int32_t cell_z[4];
+        alignas(16) float h[4][4];
+        alignas(16) float res[4][4];
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128 fx = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(x + i), origin_x), inv_scale);
+            const __m128 fz = _mm_mul_ps(_mm_sub_ps(origin_z, _mm_loadu_ps(z + i)), inv_scale);
+            const __m128 inside = _mm_and_ps(
+                _mm_and_ps(_mm_cmpgt_ps(fx, zero), _mm_cmpgt_ps(fz, zero)),
+                _mm_and_ps(_mm_cmplt_ps(fx, max_coord), _mm_cmplt_ps(fz, max_coord)));
+
+            // Lanes outside the terrain sample cell 0 (keeps the loads in bounds), their result is replaced below
+            const __m128 cx = _mm_and_ps(fx, inside);
+            const __m128 cz = _mm_and_ps(fz, inside);
+            const __m128i icx = _mm_cvttps_epi32(cx);
+            const __m128i icz = _mm_cvttps_epi32(cz);
+            const __m128 u = _mm_sub_ps(cx, _mm_cvtepi32_ps(icx));
+            const __m128 w = _mm_sub_ps(cz, _mm_cvtepi32_ps(icz));
+
+            _mm_store_si128(reinterpret_cast<__m128i*>(cell_x), icx);
+            _mm_store_si128(reinterpret_cast<__m128i*>(cell_z), icz);
+            for (int lane = 0; lane < 4; lane++)
+            {
+                const float* row0 = mHeightData + (cell_z[lane] * mSize + cell_x[lane]);
+                const float* row1 = row0 + mSize;
+                h[0][lane] = row0[0];
+                h[1][lane] = row0[1];
+                h[2][lane] = row1[1];
+                h[3][lane] = row1[0];
+            }
+            const __m128 h0 = _mm_load_ps(h[0]);
+            const __m128 h1 = _mm_load_ps(h[1]);
+            const __m128 h2 = _mm_load_ps(h[2]);
+            const __m128 h3 = _mm_load_ps(h[3]);
+
+            const __m128 odd = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(icz, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+            const __m128 second = _mm_or_ps(
+                _mm_and_ps(odd, _mm_cmplt_ps(_mm_add_ps(u, w), one)),
+                _mm_andnot_ps(odd, _mm_cmpgt_ps(w, u)));
+            const __m128 use_23 = _mm_xor_ps(second, odd);
+            const __m128 grad_u = _mm_or_ps(_mm_and_ps(use_23, _mm_sub_ps(h2, h3)), _mm_andnot_ps(use_23, _mm_sub_ps(h1, h0)));
+            const __m128 grad_w = _mm_or_ps(_mm_and_ps(second, _mm_sub_ps(h3, h0)), _mm_andnot_ps(second, _mm_sub_ps(h2, h1)));
+            const __m128 base_123 = _mm_andnot_ps(second, odd);
+            const __m128 base = _mm_or_ps(_mm_and_ps(base_123, _mm_sub_ps(_mm_add_ps(h1, h3), h2)), _mm_andnot_ps(base_123, h0));
+
+            const __m128 height = _mm_add_ps(base, _mm_add_ps(_mm_mul_ps(u, grad_u), _mm_mul_ps(w, grad_w)));
+            _mm_storeu_ps(out_height + i, _mm_or_ps(_mm_and_ps(inside, height), _mm_andnot_ps(inside, outside_height)));
+
+            // Normal (-grad_u, scale, grad_w), flat up outside
+            const __m128 nx = _mm_and_ps(inside, _mm_sub_ps(zero, grad_u));
+            const __m128 nz = _mm_and_ps(inside, grad_w);
+            const __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(scale, scale)), _mm_mul_ps(nz, nz)));
+            _mm_store_ps(res[0], _mm_div_ps(nx, len));
+            _mm_store_ps(res[1], _mm_div_ps(scale, len));
+            _mm_store_ps(res[2], _mm_div_ps(nz, len));
+            for (int lane = 0; lane < 4; lane++)
+            {
+                out_normal[i + lane] = Vector3(res[0][lane], res[1][lane], res[2][lane]);
+            }
+        }
+    }
+#endif // SSE2
+    for (; i < count; i++)
+    {
+        this->getHeightAndNormalAt(x[i], z[i], out_height[i], out_normal[i]);
+    }
+}
+
 bool TerrainGeometryManager::InitTerrain(std::string otc_filename)
 {
     OTCParser otc_parser;
@@ -337,6 +482,9 @@ bool TerrainGeometryManager::InitTerrain(std::string otc_filename)
     mBase = -world_size * 0.5f;
     mScale = world_size / (Real)(mSize - 1);
     mPos = terrain->getPosition();
+    m_field_origin_x = mBase + mPos.x;
+    m_field_origin_z = mPos.z - mBase;
+    m_field_inv_scale = 1.0f / mScale;
 
     // terrain->getMinHeight() / terrain->getMaxHeight() seem to be unreliable ~ ulteq 12/18
     for (int x = 0; x < mSize; x++)
@@ -46,6 +46,12 @@ public:
 
     Ogre::Vector3 getNormalAt(float x, float y, float z);
 
+    /// Terrain height and surface normal in one lookup; same surface as `getHeightAt()`.
+    void getHeightAndNormalAt(float x, float z, float& out_height, Ogre::Vector3& out_normal);
+
+    /// Batch version of `getHeightAndNormalAt()`, processes 4 points at once with SSE2.
+    void getHeightsAndNormalsAt(size_t count, const float* x, const float* z, float* out_height, Ogre::Vector3* out_normal);
+
     Ogre::Vector3 getMaxTerrainSize();
 
     bool isFlat() { return mIsFlat; };
@@ -78,6 +84,11 @@ private:
     Ogre::uint16 mSize;
     float* mHeightData;
 
+    // Collision heightfield lookup (world -> grid coordinates), see getHeightAndNormalAt()
+    float m_field_origin_x;
+    float m_field_origin_z;
+    float m_field_inv_scale;
+
     bool  mIsFlat;
     float mMinHeight;
     float mMaxHeight;
@@ -508,6 +508,11 @@ Ogre::Vector3 TerrainManager::GetNormalAt(float x, float y, float z)
     return m_geometry_manager->getNormalAt(x, y, z);
 }
 
+void TerrainManager::GetHeightsAndNormalsAt(size_t count, const float* x, const float* z, float* out_height, Ogre::Vector3* out_normal)
+{
+    m_geometry_manager->getHeightsAndNormalsAt(count, x, z, out_height, out_normal);
+}
+
 SkyManager* TerrainManager::getSkyManager()
 {
     return m_sky_manager;
@@ -79,6 +79,7 @@ public:
     float                   getGravity() const            { return m_cur_gravity; }
     float                   GetHeightAt(float x, float z);
     Ogre::Vector3           GetNormalAt(float x, float y, float z);
+    void                    GetHeightsAndNormalsAt(size_t count, const float* x, const float* z, float* out_height, Ogre::Vector3* out_normal);
     Ogre::Vector3           getMaxTerrainSize();
     Ogre::AxisAlignedBox    getTerrainCollisionAAB();
 
@@ -0,0 +1,127 @@
+/*
+    This source file is part of Rigs of Rods
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief Uniform-resolution lookup tables for curves evaluated every physics step.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace RoR {
+
+/// A 1D function sampled at uniform resolution over [min_x, max_x].
+///
+/// Baked once when the source curve (torque spline, airfoil table, formula) is loaded;
+/// evaluation is branchless - clamp (or wrap) the argument, then interpolate linearly
+/// between the two nearest samples - so batches of it vectorize.
+class BakedCurve
+{
+public:
+    /// Samples `func(x)` at `num_samples` uniformly spaced points; `num_samples` must be at least 2.
+    template <typename FUNC>
+    void Bake(float min_x, float max_x, size_t num_samples, FUNC func)
+    {
+        m_samples.resize(num_samples);
+        const float step = (max_x - min_x) / (float)(num_samples - 1);
+        for (size_t i = 0; i < num_samples; i++)
+        {
+            m_samples[i] = func(min_x + step * (float)i);
+        }
+        this->SetRange(min_x, max_x);
+    }
+
+    /// Takes over at least 2 uniformly spaced samples, the first at `min_x`, the last at `max_x`.
+    void Assign(float min_x, float max_x, const float* samples, size_t num_samples)
+    {
+        m_samples.assign(samples, samples + num_samples);
+        this->SetRange(min_x, max_x);
+    }
+
+    /// A constant function.
+    void BakeConstant(float value)
+    {
+        m_samples.assign(2, value);
+        this->SetRange(0.f, 1.f);
+    }
+
+    void Clear()              { m_samples.clear(); }
+    bool IsBaked() const      { return !m_samples.empty(); }
+    float GetMinX() const     { return m_min_x; }
+    float GetMaxX() const     { return m_max_x; }
+
+    /// Arguments outside of the baked range are clamped.
+    float Evaluate(float x) const
+    {
+        const float pos = std::min(std::max((x - m_min_x) * m_inv_step, 0.f), m_last_pos);
+        return this->Interpolate(pos);
+    }
+
+    /// For periodic functions (like angles): arguments outside of the baked range are wrapped.
+    /// Valid for arguments within +/- 2^31 periods.
+    float EvaluatePeriodic(float x) const
+    {
+        const float periods = (x - m_min_x) / (m_max_x - m_min_x);
+        float whole_periods = (float)(int)periods;
+        whole_periods -= (whole_periods > periods) ? 1.f : 0.f; // Truncation rounds negative values up, we need floor()
+        const float pos = std::min(std::max((x - m_min_x - whole_periods * (m_max_x - m_min_x)) * m_inv_step, 0.f), m_last_pos);
+        return this->Interpolate(pos);
+    }
+
+    void EvaluateBatch(const float* x, size_t count, float* out) const
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = this->Evaluate(x[i]);
+        }
+    }
+
+    void EvaluatePeriodicBatch(const float* x, size_t count, float* out) const
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = this->EvaluatePeriodic(x[i]);
+        }
+    }
+
+private:
+    void SetRange(float min_x, float max_x)
+    {
+        m_min_x = min_x;
+        m_max_x = max_x;
+        m_last_pos = (float)(m_samples.size() - 1);
+        m_inv_step = (max_x > min_x) ? (m_last_pos / (max_x - min_x)) : 0.f;
+    }
+
+    /// `pos` is the fractional sample index, within [0, num_samples - 1].
+    float Interpolate(float pos) const
+    {
+        const int index = std::min((int)pos, (int)m_samples.size() - 2);
+        const float frac = pos - (float)index;
+        return m_samples[index] + (m_samples[index + 1] - m_samples[index]) * frac;
+    }
+
+    std::vector<float> m_samples;
+    float              m_min_x = 0.f;
+    float              m_max_x = 0.f;
+    float              m_inv_step = 0.f; //!< Samples per unit of x
+    float              m_last_pos = 0.f; //!< Index of the last sample, as float
+};
+
+} // namespace RoR
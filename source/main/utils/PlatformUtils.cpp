@@ -33,11 +33,14 @@
 #else
     #include <sys/types.h>
     #include <sys/stat.h>
+    #include <sys/mman.h> // mmap()
+    #include <fcntl.h> // open()
     #include <unistd.h> // readlink()
 #endif
 
 #include <OgrePlatform.h>
 #include <OgreFileSystem.h>
+#include <cstdint>
 #include <string>
 
 namespace RoR {
@@ -148,6 +151,128 @@ std::string GetExecutablePath()
     return MSW_WcharToUtf8(out_wstr.c_str());
 }
 
+bool MappedFile::Open(const char* path)
+{
+    this->Close();
+
+    std::wstring wpath = MSW_Utf8ToWchar(path);
+    HANDLE file = CreateFileW(wpath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<const char*>(data);
+    m_size = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data != nullptr)
+    {
+        UnmapViewOfFile(m_data);
+        CloseHandle(m_mapping);
+        CloseHandle(m_file);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_file = nullptr;
+    m_mapping = nullptr;
+}
+
+bool MappedScratchFile::Open(const char* path)
+{
+    this->Close();
+
+    std::wstring wpath = MSW_Utf8ToWchar(path);
+    HANDLE file = CreateFileW(wpath.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+        FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    m_file = file;
+    m_is_open = true;
+    return true;
+}
+
+char* MappedScratchFile::AddSegment(size_t size)
+{
+    if (!m_is_open || size == 0 || (size % SEGMENT_ALIGNMENT) != 0)
+    {
+        return nullptr;
+    }
+
+    // Creating a mapping bigger than the file extends the file.
+    const uint64_t new_size = static_cast<uint64_t>(m_size) + size;
+    HANDLE mapping = CreateFileMappingW(m_file, nullptr, PAGE_READWRITE,
+        static_cast<DWORD>(new_size >> 32), static_cast<DWORD>(new_size & 0xFFFFFFFF), nullptr);
+    if (mapping == nullptr)
+    {
+        return nullptr;
+    }
+
+    const uint64_t offset = static_cast<uint64_t>(m_size);
+    void* data = MapViewOfFile(mapping, FILE_MAP_WRITE,
+        static_cast<DWORD>(offset >> 32), static_cast<DWORD>(offset & 0xFFFFFFFF), size);
+    if (data == nullptr)
+    {
+        CloseHandle(mapping);
+        return nullptr;
+    }
+
+    Segment segment;
+    segment.data = static_cast<char*>(data);
+    segment.size = size;
+    segment.mapping = mapping;
+    m_segments.push_back(segment);
+    m_size += size;
+    return segment.data;
+}
+
+void MappedScratchFile::Close()
+{
+    for (Segment& segment: m_segments)
+    {
+        UnmapViewOfFile(segment.data);
+        CloseHandle(segment.mapping);
+    }
+    m_segments.clear();
+    if (m_is_open)
+    {
+        CloseHandle(m_file); // Deletes the file
+    }
+    m_file = nullptr;
+    m_size = 0;
+    m_is_open = false;
+}
+
 #else
 
 // -------------------------- File/path utils for Linux/*nix --------------------------
@@ -190,6 +315,104 @@ std::string GetExecutablePath()
     return std::move(buf_str);
 }
 
+bool MappedFile::Open(const char* path)
+{
+    this->Close();
+
+    int fd = open(path, O_RDONLY);
+    if (fd == -1)
+    {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping stays valid
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    m_data = static_cast<const char*>(data);
+    m_size = static_cast<size_t>(st.st_size);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data != nullptr)
+    {
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+}
+
+bool MappedScratchFile::Open(const char* path)
+{
+    this->Close();
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (fd == -1)
+    {
+        return false;
+    }
+    unlink(path); // Data stays accessible until closed
+
+    m_fd = fd;
+    m_is_open = true;
+    return true;
+}
+
+char* MappedScratchFile::AddSegment(size_t size)
+{
+    if (!m_is_open || size == 0 || (size % SEGMENT_ALIGNMENT) != 0)
+    {
+        return nullptr;
+    }
+
+    if (ftruncate(m_fd, static_cast<off_t>(m_size + size)) != 0)
+    {
+        return nullptr;
+    }
+
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, static_cast<off_t>(m_size));
+    if (data == MAP_FAILED)
+    {
+        ftruncate(m_fd, static_cast<off_t>(m_size));
+        return nullptr;
+    }
+
+    Segment segment;
+    segment.data = static_cast<char*>(data);
+    segment.size = size;
+    m_segments.push_back(segment);
+    m_size += size;
+    return segment.data;
+}
+
+void MappedScratchFile::Close()
+{
+    for (Segment& segment: m_segments)
+    {
+        munmap(segment.data, segment.size);
+    }
+    m_segments.clear();
+    if (m_is_open)
+    {
+        close(m_fd);
+    }
+    m_fd = -1;
+    m_size = 0;
+    m_is_open = false;
+}
+
 #endif // _MSC_VER
 
 // -------------------------- File/path common utils --------------------------
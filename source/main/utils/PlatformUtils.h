@@ -30,8 +30,10 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <ctime>
+#include <vector>
 
 namespace RoR {
 
@@ -53,4 +55,67 @@ std::string GetParentDirectory(const char* path); //!< Returns UTF-8 path withou
 
 std::time_t GetFileLastModifiedTime(std::string const & path);
 
+/// Read-only memory mapping of a whole file.
+class MappedFile
+{
+public:
+    MappedFile() {}
+    ~MappedFile() { this->Close(); }
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    bool        Open(const char* path); //!< Path must be UTF-8 encoded. Returns false on error or empty file.
+    void        Close();
+    const char* GetData() const { return m_data; }
+    size_t      GetSize() const { return m_size; }
+
+private:
+    const char* m_data = nullptr;
+    size_t      m_size = 0;
+#ifdef _MSC_VER
+    void*       m_file = nullptr;    //!< HANDLE
+    void*       m_mapping = nullptr; //!< HANDLE
+#endif
+};
+
+/// Read-write scratch file (deleted when closed), mapped into memory in segments.
+/// Existing segments stay mapped at their address when the file grows.
+class MappedScratchFile
+{
+public:
+    MappedScratchFile() {}
+    ~MappedScratchFile() { this->Close(); }
+
+    MappedScratchFile(MappedScratchFile const&) = delete;
+    MappedScratchFile& operator=(MappedScratchFile const&) = delete;
+
+    static const size_t SEGMENT_ALIGNMENT = 64 * 1024; //!< Windows allocation granularity, a multiple of page size elsewhere.
+
+    bool        Open(const char* path); //!< Path must be UTF-8 encoded. Overwrites existing file.
+    void        Close();                //!< Unmaps all segments.
+    char*       AddSegment(size_t size); //!< Grows the file and maps the new part; size must be a multiple of `SEGMENT_ALIGNMENT`. Returns nullptr on error.
+    bool        IsOpen() const { return m_is_open; }
+    size_t      GetSize() const { return m_size; }
+
+private:
+    struct Segment
+    {
+        char*   data;
+        size_t  size;
+#ifdef _MSC_VER
+        void*   mapping; //!< HANDLE
+#endif
+    };
+
+    std::vector<Segment> m_segments;
+    size_t               m_size = 0;
+    bool                 m_is_open = false;
+#ifdef _MSC_VER
+    void*                m_file = nullptr; //!< HANDLE
+#else
+    int                  m_fd = -1;
+#endif
+};
+
 } // namespace RoR
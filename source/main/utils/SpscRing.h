@@ -0,0 +1,91 @@
+/*
+    This source file is part of Rigs of Rods
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace RoR {
+
+/// Fixed-capacity lock-free queue for exactly one producer thread and one consumer thread.
+/// Slots are allocated by `Reset()` and reused; the producer fills them in place
+/// (`BeginPush()` + `EndPush()`), the consumer reads them in place (`Peek()`) and then releases them (`Pop()`).
+template <class T>
+class SpscRing
+{
+public:
+    /// Not threadsafe; call while neither side is running. Capacity must be a power of two (or 0 to free the slots).
+    void Reset(size_t capacity)
+    {
+        assert((capacity & (capacity - 1)) == 0);
+        std::vector<T>(capacity).swap(m_slots);
+        m_mask = (capacity > 0) ? capacity - 1 : 0;
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
+    }
+
+    size_t GetCapacity() const { return m_slots.size(); }
+
+    /// Number of elements pushed but not yet popped; exact on the consumer side, a lower bound on the producer side.
+    size_t GetNumAvailable() const
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    // ----- Producer -----
+
+    /// Returns the slot to fill, or nullptr if the ring is full. The slot holds stale data.
+    T* BeginPush()
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) >= m_slots.size())
+            return nullptr;
+        return &m_slots[tail & m_mask];
+    }
+
+    /// Publishes the slot returned by `BeginPush()`.
+    void EndPush()
+    {
+        m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // ----- Consumer -----
+
+    /// The i-th oldest element; `i < GetNumAvailable()`.
+    T& Peek(size_t i)
+    {
+        return m_slots[(m_head.load(std::memory_order_relaxed) + i) & m_mask];
+    }
+
+    /// Returns the `count` oldest slots to the producer.
+    void Pop(size_t count)
+    {
+        m_head.store(m_head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+private:
+    std::vector<T>       m_slots;
+    size_t               m_mask = 0;
+    std::atomic<size_t>  m_head{0};     //!< Consumer-owned; total number of popped elements
+    char                 m_pad[64];     //!< Keeps `m_head` and `m_tail` on separate cache lines
+    std::atomic<size_t>  m_tail{0};     //!< Producer-owned; total number of pushed elements
+};
+
+} // namespace RoR
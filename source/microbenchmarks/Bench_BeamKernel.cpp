@@ -0,0 +1,778 @@
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <immintrin.h>
+#endif
+
+// Scalar beam forces of `Actor::CalcBeams()` vs. a packed SSE2/AVX2 kernel for unbounded beams, on a real truckfile:
+// nodes, beams, shocks, commands2 and triggers are loaded from the file given in env. var ROR_BENCH_TRUCKFILE
+// (default: the railroad switch 'resources/beamobjects/rail1tPnt190r634dtri.fixed', run from the repo root).
+// Range argument = number of copies of the truck, to get to heavy-truck beam counts.
+// The object is dropped on a flat ground with a little spin and integrated at 2 kHz.
+//
+// The packed path keeps the beam order: runs of unbounded beams (found at spawn) are evaluated 8 at a time,
+// node vectors are gathered with 4x4 transposes, forces are scattered sequentially; a group in which any beam
+// deforms or breaks is redone on the scalar path.
+// 'Bench_Beams_Compare' evaluates both paths on the same state every step and reports the number of force/stress
+// values which are not bit-identical plus the largest difference relative to `k * L`; it fails above `TOLERANCE`.
+// Without -ffast-math and FMA contraction (-ffp-contract=off) the results are bit-identical, with -ffast-math
+// (our release flags) or -mfma they differ by ~1e-6.
+//
+// Result: the packed path is no faster than the scalar one (SSE2 and AVX2, 80 to 5k beams, also with the node data
+// in L1), because the time goes into node loads and the sequential force scatter, not the math. So it's not used
+// in the simulation; revisit together with a structure-of-arrays node layout.
+// The scalar code is copied from 'source/main/physics/ActorForcesEuler.cpp', the beam loader is a minimal stand-in
+// for RigDef::Parser + ActorSpawner (no wheels, no node/beam options besides 'l', 'r', 's').
+
+static const float PHYSICS_DT = 0.0005f;
+static const float TOLERANCE = 1e-5f;          //!< Relative to `k * L` of the beams
+
+static const float DEFAULT_SPRING     = 9000000.0f;
+static const float DEFAULT_DAMP       = 12000.0f;
+static const float DEFAULT_MINIMASS   = 50.0f;
+static const float MIN_BEAM_LENGTH    = 0.1f;
+static const float BEAM_BREAK         = 1000000.0f;
+static const float BEAM_DEFORM        = 400000.0f;
+static const float BEAM_CREAK_DEFAULT = 100000.0f;
+
+enum { NOSHOCK, SHOCK1, SHOCK2, SUPPORTBEAM, ROPE, TRIGGER, SHOCK3 };
+
+struct Vector3
+{
+    Vector3() {}
+    Vector3(float _x, float _y, float _z): x(_x), y(_y), z(_z) {}
+    Vector3 operator-(const Vector3& v) const { return Vector3(x - v.x, y - v.y, z - v.z); }
+    Vector3 operator*(float s) const          { return Vector3(x * s, y * s, z * s); }
+    Vector3& operator+=(const Vector3& v)     { x += v.x; y += v.y; z += v.z; return *this; }
+    Vector3& operator-=(const Vector3& v)     { x -= v.x; y -= v.y; z -= v.z; return *this; }
+    Vector3& operator*=(float s)              { x *= s; y *= s; z *= s; return *this; }
+    float dotProduct(const Vector3& v) const  { return x * v.x + y * v.y + z * v.z; }
+    float squaredLength() const               { return x * x + y * y + z * z; }
+    float x = 0.f, y = 0.f, z = 0.f;
+};
+
+inline float fast_invSqrt(const float v) // As in 'physics/ApproxMath.h', with memcpy() instead of the pointer casts
+{
+    int i;
+    std::memcpy(&i, &v, sizeof(float));
+    i = 0x5f3759df - (i >> 1);
+    float y;
+    std::memcpy(&y, &i, sizeof(float));
+
+    y *= (1.5f - (0.5f * v * y * y));
+    return y;
+}
+
+struct node_t // Same size and leading members as the real one
+{
+    Vector3 RelPosition;
+    Vector3 AbsPosition;
+    Vector3 Velocity;
+    Vector3 Forces;
+    float   mass = DEFAULT_MINIMASS;
+    float   other_attributes[15];
+};
+
+struct beam_t
+{
+    node_t* p1 = nullptr;
+    node_t* p2 = nullptr;
+    float   k = DEFAULT_SPRING;
+    float   d = DEFAULT_DAMP;
+    float   L = 0.f;
+    float   minmaxposnegstress = BEAM_DEFORM;
+    float   maxposstress = BEAM_DEFORM;
+    float   maxnegstress = -BEAM_DEFORM;
+    float   strength = BEAM_BREAK;
+    float   plastic_coef = 0.f;
+    float   stress = 0.f;
+    float   shortbound = 0.f;
+    float   longbound = 0.f;
+    int     bounded = NOSHOCK;
+    bool    bm_disabled = false;
+    bool    bm_broken = false;
+};
+
+struct Truck
+{
+    std::vector<node_t> nodes;
+    std::vector<beam_t> beams;
+    std::vector<std::pair<int, int>> beam_kernel_runs; //!< [first, end) ranges of consecutive unbounded beams
+
+    Truck() {}
+    Truck(const Truck& other): nodes(other.nodes), beams(other.beams), beam_kernel_runs(other.beam_kernel_runs)
+    {
+        for (beam_t& beam: beams) // Re-point to our own nodes
+        {
+            beam.p1 = &nodes[beam.p1 - &other.nodes[0]];
+            beam.p2 = &nodes[beam.p2 - &other.nodes[0]];
+        }
+    }
+};
+
+// ------------------------------ Truckfile loader ------------------------------
+
+static std::vector<std::string> SplitArgs(const std::string& line)
+{
+    std::vector<std::string> args;
+    std::string arg;
+    std::istringstream s(line);
+    while (std::getline(s, arg, ','))
+    {
+        std::istringstream a(arg);
+        std::string word;
+        while (a >> word) { args.push_back(word); }
+    }
+    return args;
+}
+
+static bool LoadTruck(const char* path, int num_copies, Truck& truck)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+        return false;
+
+    struct Def { std::string section; std::vector<std::string> args; float spring, damp, deform, brk; };
+    std::vector<Def> defs;
+    std::string section, line;
+    float spring = DEFAULT_SPRING, damp = DEFAULT_DAMP, deform = BEAM_DEFORM, brk = BEAM_BREAK;
+    bool advanced_deformation = false;
+    while (std::getline(file, line))
+    {
+        line.erase(std::find(line.begin(), line.end(), ';'), line.end());
+        std::vector<std::string> args = SplitArgs(line);
+        if (args.empty())
+            continue;
+        if (args[0] == "set_beam_defaults" && args.size() >= 5)
+        {
+            const float values[] = { std::stof(args[1]), std::stof(args[2]), std::stof(args[3]), std::stof(args[4]) };
+            spring = (values[0] < 0.f) ? DEFAULT_SPRING : values[0];
+            damp   = (values[1] < 0.f) ? DEFAULT_DAMP   : values[1];
+            deform = (values[2] < 0.f) ? BEAM_DEFORM    : values[2];
+            brk    = (values[3] < 0.f) ? BEAM_BREAK     : values[3];
+            if (!advanced_deformation && deform < BEAM_DEFORM)
+                deform = BEAM_DEFORM;
+            deform = std::max(deform, BEAM_CREAK_DEFAULT);
+        }
+        else if (args[0] == "enable_advanced_deformation")
+            advanced_deformation = true;
+        else if (args.size() == 1 && std::isalpha(args[0][0]))
+            section = args[0];
+        else if (std::isdigit(args[0][0]) || args[0][0] == '-')
+            defs.push_back(Def{section, args, spring, damp, deform, brk});
+    }
+
+    // Same section order as ActorSpawner
+    const char* sections[] = { "beams", "shocks", "commands2", "triggers" };
+    for (int copy = 0; copy < num_copies; copy++)
+    {
+        const int first_node = static_cast<int>(truck.nodes.size());
+        for (const Def& def: defs)
+        {
+            if (def.section != "nodes" || def.args.size() < 4)
+                continue;
+            node_t node;
+            node.RelPosition = Vector3(std::stof(def.args[1]) + copy * 20.f, std::stof(def.args[2]) + 1.f, std::stof(def.args[3]));
+            if (def.args.size() >= 6 && def.args[4].find('l') != std::string::npos)
+                node.mass = std::max(DEFAULT_MINIMASS, std::stof(def.args[5]));
+            truck.nodes.push_back(node);
+        }
+        for (const char* sec: sections)
+        {
+            for (const Def& def: defs)
+            {
+                if (def.section != sec || def.args.size() < 2)
+                    continue;
+                beam_t beam; // Node pointers hold indices until all nodes exist
+                beam.p1 = reinterpret_cast<node_t*>(static_cast<intptr_t>(first_node + std::stoi(def.args[0])));
+                beam.p2 = reinterpret_cast<node_t*>(static_cast<intptr_t>(first_node + std::stoi(def.args[1])));
+                beam.k = def.spring;
+                beam.d = def.damp;
+                beam.minmaxposnegstress = def.deform;
+                beam.maxposstress = def.deform;
+                beam.maxnegstress = -def.deform;
+                beam.strength = def.brk;
+                const std::string options = (def.args.size() >= 3) ? def.args[2] : "";
+                if (def.section == "beams")
+                {
+                    if (options.find('r') != std::string::npos) { beam.bounded = ROPE; }
+                    if (options.find('s') != std::string::npos) { beam.bounded = SUPPORTBEAM; }
+                }
+                else if (def.section == "shocks" && def.args.size() >= 6)
+                {
+                    beam.bounded = SHOCK1;
+                    beam.k = std::stof(def.args[2]);
+                    beam.d = std::stof(def.args[3]);
+                    beam.shortbound = std::stof(def.args[4]);
+                    beam.longbound = std::stof(def.args[5]);
+                }
+                else if (def.section == "triggers")
+                {
+                    beam.bounded = TRIGGER; // Evaluated as a plain beam here, but on the scalar path like in the sim
+                }
+                truck.beams.push_back(beam);
+            }
+        }
+    }
+
+    for (beam_t& beam: truck.beams)
+    {
+        const size_t n1 = static_cast<size_t>(reinterpret_cast<intptr_t>(beam.p1));
+        const size_t n2 = static_cast<size_t>(reinterpret_cast<intptr_t>(beam.p2));
+        if (n1 >= truck.nodes.size() || n2 >= truck.nodes.size())
+            return false;
+        beam.p1 = &truck.nodes[n1];
+        beam.p2 = &truck.nodes[n2];
+        beam.L = std::sqrt((beam.p1->RelPosition - beam.p2->RelPosition).squaredLength());
+    }
+
+    // Runs of unbounded beams for the packed kernel
+    for (int i = 0; i < static_cast<int>(truck.beams.size()); i++)
+    {
+        if (truck.beams[i].bounded != NOSHOCK)
+            continue;
+        if (!truck.beam_kernel_runs.empty() && truck.beam_kernel_runs.back().second == i)
+            truck.beam_kernel_runs.back().second = i + 1;
+        else
+            truck.beam_kernel_runs.push_back(std::make_pair(i, i + 1));
+    }
+
+    // Give it a spin and some vibration, so the beams see a changing load
+    for (node_t& node: truck.nodes)
+    {
+        node.Velocity = Vector3(-node.RelPosition.z * 0.5f, -1.f, node.RelPosition.x * 0.1f);
+        node.Velocity.y += 0.05f * std::sin(node.RelPosition.x * 7.f + node.RelPosition.z * 3.f);
+    }
+    return !truck.beams.empty();
+}
+
+// ------------------------------ Scalar path ------------------------------
+
+/// Body of the `Actor::CalcBeams()` loop without the shock2/3, trigger and detacher logic, sounds and logging.
+static void CalcBeam(Truck& truck, int i)
+{
+    beam_t* ar_beams = truck.beams.data();
+
+    // Calculate beam length
+    Vector3 dis = ar_beams[i].p1->RelPosition - ar_beams[i].p2->RelPosition;
+
+    float dislen = dis.squaredLength();
+    float inverted_dislen = fast_invSqrt(dislen);
+
+    dislen *= inverted_dislen;
+
+    // Calculate beam's deviation from normal
+    float difftoBeamL = dislen - ar_beams[i].L;
+
+    float k = ar_beams[i].k;
+    float d = ar_beams[i].d;
+
+    // Calculate beam's rate of change
+    float v = (ar_beams[i].p1->Velocity - ar_beams[i].p2->Velocity).dotProduct(dis) * inverted_dislen;
+
+    if (ar_beams[i].bounded == SHOCK1)
+    {
+        float interp_ratio = 0.0f;
+
+        // Following code interpolates between defined beam parameters and default beam parameters
+        if (difftoBeamL > ar_beams[i].longbound * ar_beams[i].L)
+            interp_ratio = difftoBeamL - ar_beams[i].longbound * ar_beams[i].L;
+        else if (difftoBeamL < -ar_beams[i].shortbound * ar_beams[i].L)
+            interp_ratio = -difftoBeamL - ar_beams[i].shortbound * ar_beams[i].L;
+
+        if (interp_ratio != 0.0f)
+        {
+            k += (DEFAULT_SPRING - k) * interp_ratio;
+            d += (DEFAULT_DAMP - d) * interp_ratio;
+        }
+    }
+    else if (ar_beams[i].bounded == SUPPORTBEAM)
+    {
+        if (difftoBeamL > 0.0f)
+        {
+            k = 0.0f;
+            d *= 0.1f;
+        }
+    }
+    else if (ar_beams[i].bounded == ROPE)
+    {
+        if (difftoBeamL < 0.0f)
+        {
+            k = 0.0f;
+            d *= 0.1f;
+        }
+    }
+
+    float slen = -k * difftoBeamL - d * v;
+    ar_beams[i].stress = slen;
+
+    // Fast test for deformation
+    float len = std::abs(slen);
+    if (len > ar_beams[i].minmaxposnegstress)
+    {
+        if (ar_beams[i].bounded != SHOCK1 && k != 0.0f)
+        {
+            // Actual deformation tests
+            if (slen > ar_beams[i].maxposstress && difftoBeamL < 0.0f) // compression
+            {
+                float yield_length = ar_beams[i].maxposstress / k;
+                float deform = difftoBeamL + yield_length * (1.0f - ar_beams[i].plastic_coef);
+                float Lold = ar_beams[i].L;
+                ar_beams[i].L += deform;
+                ar_beams[i].L = std::max(MIN_BEAM_LENGTH, ar_beams[i].L);
+                slen = slen - (slen - ar_beams[i].maxposstress) * 0.5f;
+                len = slen;
+                if (ar_beams[i].L > 0.0f && Lold > ar_beams[i].L)
+                {
+                    ar_beams[i].maxposstress *= Lold / ar_beams[i].L;
+                    ar_beams[i].minmaxposnegstress = std::min(ar_beams[i].maxposstress, -ar_beams[i].maxnegstress);
+                    ar_beams[i].minmaxposnegstress = std::min(ar_beams[i].minmaxposnegstress, ar_beams[i].strength);
+                }
+            }
+            else if (slen < ar_beams[i].maxnegstress && difftoBeamL > 0.0f) // expansion
+            {
+                float yield_length = ar_beams[i].maxnegstress / k;
+                float deform = difftoBeamL + yield_length * (1.0f - ar_beams[i].plastic_coef);
+                float Lold = ar_beams[i].L;
+                ar_beams[i].L += deform;
+                slen = slen - (slen - ar_beams[i].maxnegstress) * 0.5f;
+                len = -slen;
+                if (Lold > 0.0f && ar_beams[i].L > Lold)
+                {
+                    ar_beams[i].maxnegstress *= ar_beams[i].L / Lold;
+                    ar_beams[i].minmaxposnegstress = std::min(ar_beams[i].maxposstress, -ar_beams[i].maxnegstress);
+                    ar_beams[i].minmaxposnegstress = std::min(ar_beams[i].minmaxposnegstress, ar_beams[i].strength);
+                }
+                ar_beams[i].strength -= deform * k;
+            }
+        }
+
+        // Test if the beam should break
+        if (len > ar_beams[i].strength)
+        {
+            slen = 0.0f;
+            ar_beams[i].bm_broken = true;
+            ar_beams[i].bm_disabled = true;
+        }
+    }
+
+    // At last update the beam forces
+    Vector3 f = dis;
+    f *= (slen * inverted_dislen);
+    ar_beams[i].p1->Forces += f;
+    ar_beams[i].p2->Forces -= f;
+}
+
+static void CalcBeamsScalar(Truck& truck)
+{
+    for (int i = 0; i < static_cast<int>(truck.beams.size()); i++)
+    {
+        if (!truck.beams[i].bm_disabled)
+        {
+            CalcBeam(truck, i);
+        }
+    }
+}
+
+// ------------------------------ Packed path ------------------------------
+
+static const int BEAM_KERNEL_WIDTH = 8;
+
+struct BeamKernelLanes
+{
+    // Inputs; node vectors are read 4 floats at a time (x, y, z and the first float of the next member)
+    const float* p1[BEAM_KERNEL_WIDTH];   //!< `&node_t::RelPosition.x`
+    const float* p2[BEAM_KERNEL_WIDTH];
+    const float* v1[BEAM_KERNEL_WIDTH];   //!< `&node_t::Velocity.x`
+    const float* v2[BEAM_KERNEL_WIDTH];
+    alignas(32) float L[BEAM_KERNEL_WIDTH], k[BEAM_KERNEL_WIDTH], d[BEAM_KERNEL_WIDTH];
+    alignas(32) float minmaxposnegstress[BEAM_KERNEL_WIDTH];
+    // Outputs
+    alignas(32) float stress[BEAM_KERNEL_WIDTH];
+    alignas(32) float fx[BEAM_KERNEL_WIDTH], fy[BEAM_KERNEL_WIDTH], fz[BEAM_KERNEL_WIDTH];
+};
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+/// Loads 4 node vectors and transposes them into x, y and z of 4 lanes.
+static inline void GatherLanes(const float* const* src, __m128& x, __m128& y, __m128& z) // Internal helper
+{
+    __m128 r0 = _mm_loadu_ps(src[0]);
+    __m128 r1 = _mm_loadu_ps(src[1]);
+    __m128 r2 = _mm_loadu_ps(src[2]);
+    __m128 r3 = _mm_loadu_ps(src[3]);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    x = r0; y = r1; z = r2;
+}
+
+#endif
+
+#if defined(__AVX2__)
+
+static inline void GatherLanes(const float* const* src, __m256& x, __m256& y, __m256& z) // Internal helper
+{
+    __m128 lx, ly, lz, hx, hy, hz;
+    GatherLanes(src, lx, ly, lz);
+    GatherLanes(src + 4, hx, hy, hz);
+    x = _mm256_insertf128_ps(_mm256_castps128_ps256(lx), hx, 1);
+    y = _mm256_insertf128_ps(_mm256_castps128_ps256(ly), hy, 1);
+    z = _mm256_insertf128_ps(_mm256_castps128_ps256(lz), hz, 1);
+}
+
+/// @return Bitmask of lanes which exceeded `minmaxposnegstress` and need the scalar path.
+static int ComputeBeamLanes(BeamKernelLanes& b)
+{
+    __m256 p1x, p1y, p1z, p2x, p2y, p2z;
+    GatherLanes(b.p1, p1x, p1y, p1z);
+    GatherLanes(b.p2, p2x, p2y, p2z);
+    const __m256 dx = _mm256_sub_ps(p1x, p2x);
+    const __m256 dy = _mm256_sub_ps(p1y, p2y);
+    const __m256 dz = _mm256_sub_ps(p1z, p2z);
+    const __m256 len2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+
+    // fast_invSqrt()
+    __m256 inv = _mm256_castsi256_ps(_mm256_sub_epi32(_mm256_set1_epi32(0x5f3759df), _mm256_srai_epi32(_mm256_castps_si256(len2), 1)));
+    inv = _mm256_mul_ps(inv, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), len2), inv), inv)));
+
+    const __m256 difftoBeamL = _mm256_sub_ps(_mm256_mul_ps(len2, inv), _mm256_load_ps(b.L));
+    __m256 v1x, v1y, v1z, v2x, v2y, v2z;
+    GatherLanes(b.v1, v1x, v1y, v1z);
+    GatherLanes(b.v2, v2x, v2y, v2z);
+    const __m256 dvx = _mm256_sub_ps(v1x, v2x);
+    const __m256 dvy = _mm256_sub_ps(v1y, v2y);
+    const __m256 dvz = _mm256_sub_ps(v1z, v2z);
+    const __m256 dot = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dvx, dx), _mm256_mul_ps(dvy, dy)), _mm256_mul_ps(dvz, dz));
+    const __m256 v = _mm256_mul_ps(dot, inv);
+
+    const __m256 neg_k = _mm256_xor_ps(_mm256_load_ps(b.k), _mm256_set1_ps(-0.f)); // -k, exact also for k == 0
+    const __m256 slen = _mm256_sub_ps(_mm256_mul_ps(neg_k, difftoBeamL), _mm256_mul_ps(_mm256_load_ps(b.d), v));
+    _mm256_store_ps(b.stress, slen);
+
+    const __m256 abs_slen = _mm256_andnot_ps(_mm256_set1_ps(-0.f), slen);
+    const int slow_lanes = _mm256_movemask_ps(_mm256_cmp_ps(abs_slen, _mm256_load_ps(b.minmaxposnegstress), _CMP_GT_OQ));
+
+    const __m256 scale = _mm256_mul_ps(slen, inv);
+    _mm256_store_ps(b.fx, _mm256_mul_ps(dx, scale));
+    _mm256_store_ps(b.fy, _mm256_mul_ps(dy, scale));
+    _mm256_store_ps(b.fz, _mm256_mul_ps(dz, scale));
+    return slow_lanes;
+}
+
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+/// @return Bitmask of lanes which exceeded `minmaxposnegstress` and need the scalar path.
+static int ComputeBeamLanes(BeamKernelLanes& b)
+{
+    int slow_lanes = 0;
+    for (int o = 0; o < BEAM_KERNEL_WIDTH; o += 4)
+    {
+        __m128 p1x, p1y, p1z, p2x, p2y, p2z;
+        GatherLanes(b.p1 + o, p1x, p1y, p1z);
+        GatherLanes(b.p2 + o, p2x, p2y, p2z);
+        const __m128 dx = _mm_sub_ps(p1x, p2x);
+        const __m128 dy = _mm_sub_ps(p1y, p2y);
+        const __m128 dz = _mm_sub_ps(p1z, p2z);
+        const __m128 len2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+        // fast_invSqrt()
+        __m128 inv = _mm_castsi128_ps(_mm_sub_epi32(_mm_set1_epi32(0x5f3759df), _mm_srai_epi32(_mm_castps_si128(len2), 1)));
+        inv = _mm_mul_ps(inv, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), len2), inv), inv)));
+
+        const __m128 difftoBeamL = _mm_sub_ps(_mm_mul_ps(len2, inv), _mm_load_ps(b.L + o));
+        __m128 v1x, v1y, v1z, v2x, v2y, v2z;
+        GatherLanes(b.v1 + o, v1x, v1y, v1z);
+        GatherLanes(b.v2 + o, v2x, v2y, v2z);
+        const __m128 dvx = _mm_sub_ps(v1x, v2x);
+        const __m128 dvy = _mm_sub_ps(v1y, v2y);
+        const __m128 dvz = _mm_sub_ps(v1z, v2z);
+        const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dvx, dx), _mm_mul_ps(dvy, dy)), _mm_mul_ps(dvz, dz));
+        const __m128 v = _mm_mul_ps(dot, inv);
+
+        const __m128 neg_k = _mm_xor_ps(_mm_load_ps(b.k + o), _mm_set1_ps(-0.f)); // -k, exact also for k == 0
+        const __m128 slen = _mm_sub_ps(_mm_mul_ps(neg_k, difftoBeamL), _mm_mul_ps(_mm_load_ps(b.d + o), v));
+        _mm_store_ps(b.stress + o, slen);
+
+        const __m128 abs_slen = _mm_andnot_ps(_mm_set1_ps(-0.f), slen);
+        slow_lanes |= _mm_movemask_ps(_mm_cmpgt_ps(abs_slen, _mm_load_ps(b.minmaxposnegstress + o))) << o;
+
+        const __m128 scale = _mm_mul_ps(slen, inv);
+        _mm_store_ps(b.fx + o, _mm_mul_ps(dx, scale));
+        _mm_store_ps(b.fy + o, _mm_mul_ps(dy, scale));
+        _mm_store_ps(b.fz + o, _mm_mul_ps(dz, scale));
+    }
+    return slow_lanes;
+}
+
+#else // Portable fallback
+
+/// @return Bitmask of lanes which exceeded `minmaxposnegstress` and need the scalar path.
+static int ComputeBeamLanes(BeamKernelLanes& b)
+{
+    int slow_lanes = 0;
+    for (int i = 0; i < BEAM_KERNEL_WIDTH; i++)
+    {
+        const Vector3 dis(b.p1[i][0] - b.p2[i][0], b.p1[i][1] - b.p2[i][1], b.p1[i][2] - b.p2[i][2]);
+        float dislen = dis.squaredLength();
+        const float inverted_dislen = fast_invSqrt(dislen);
+        dislen *= inverted_dislen;
+        const float difftoBeamL = dislen - b.L[i];
+        const Vector3 dv(b.v1[i][0] - b.v2[i][0], b.v1[i][1] - b.v2[i][1], b.v1[i][2] - b.v2[i][2]);
+        const float v = dv.dotProduct(dis) * inverted_dislen;
+        const float slen = -b.k[i] * difftoBeamL - b.d[i] * v;
+        b.stress[i] = slen;
+        if (std::abs(slen) > b.minmaxposnegstress[i])
+            slow_lanes |= (1 << i);
+        const Vector3 f = dis * (slen * inverted_dislen);
+        b.fx[i] = f.x; b.fy[i] = f.y; b.fz[i] = f.z;
+    }
+    return slow_lanes;
+}
+
+#endif
+
+static void CalcBeamsPacked(Truck& truck)
+{
+    beam_t* ar_beams = truck.beams.data();
+    const int ar_num_beams = static_cast<int>(truck.beams.size());
+
+    BeamKernelLanes lanes;
+    int lane_beams[BEAM_KERNEL_WIDTH];
+    int num_lanes = 0;
+
+    auto flush_lanes = [&]()
+    {
+        if (num_lanes == 0)
+            return;
+
+        // Unused lanes get a harmless unit-length dummy.
+        static const float dummy_p1[4] = { 1.f, 0.f, 0.f, 0.f };
+        static const float dummy_zero[4] = { 0.f, 0.f, 0.f, 0.f };
+        for (int l = 0; l < BEAM_KERNEL_WIDTH; l++)
+        {
+            if (l < num_lanes)
+            {
+                const beam_t* beam = &ar_beams[lane_beams[l]];
+                lanes.p1[l] = &beam->p1->RelPosition.x;
+                lanes.p2[l] = &beam->p2->RelPosition.x;
+                lanes.v1[l] = &beam->p1->Velocity.x;
+                lanes.v2[l] = &beam->p2->Velocity.x;
+                lanes.L[l] = beam->L;
+                lanes.k[l] = beam->k;
+                lanes.d[l] = beam->d;
+                lanes.minmaxposnegstress[l] = beam->minmaxposnegstress;
+            }
+            else
+            {
+                lanes.p1[l] = dummy_p1;
+                lanes.p2[l] = dummy_zero;
+                lanes.v1[l] = dummy_zero;
+                lanes.v2[l] = dummy_zero;
+                lanes.L[l] = 1.f;
+                lanes.k[l] = 0.f;
+                lanes.d[l] = 0.f;
+                lanes.minmaxposnegstress[l] = 1.f;
+            }
+        }
+
+        const int active_lanes = (1 << num_lanes) - 1;
+        if (ComputeBeamLanes(lanes) & active_lanes)
+        {
+            for (int l = 0; l < num_lanes; l++)
+            {
+                const int i = lane_beams[l];
+                if (!ar_beams[i].bm_disabled)
+                {
+                    CalcBeam(truck, i);
+                }
+            }
+        }
+        else
+        {
+            for (int l = 0; l < num_lanes; l++)
+            {
+                beam_t& beam = ar_beams[lane_beams[l]];
+                beam.stress = lanes.stress[l];
+                const Vector3 f(lanes.fx[l], lanes.fy[l], lanes.fz[l]);
+                beam.p1->Forces += f;
+                beam.p2->Forces -= f;
+            }
+        }
+        num_lanes = 0;
+    };
+
+    int i = 0;
+    for (const std::pair<int, int>& run: truck.beam_kernel_runs)
+    {
+        for (; i < run.first; i++)
+        {
+            if (!ar_beams[i].bm_disabled)
+            {
+                CalcBeam(truck, i);
+            }
+        }
+        for (; i < run.second; i++)
+        {
+            if (!ar_beams[i].bm_disabled)
+            {
+                lane_beams[num_lanes++] = i;
+                if (num_lanes == BEAM_KERNEL_WIDTH)
+                    flush_lanes();
+            }
+        }
+        flush_lanes();
+    }
+    for (; i < ar_num_beams; i++)
+    {
+        if (!ar_beams[i].bm_disabled)
+        {
+            CalcBeam(truck, i);
+        }
+    }
+}
+
+// ------------------------------ Harness ------------------------------
+
+static void ResetForces(Truck& truck)
+{
+    for (node_t& node: truck.nodes)
+    {
+        node.Forces = Vector3(0.f, -9.807f * node.mass, 0.f);
+    }
+}
+
+/// Explicit Euler as in `Actor::CalcNodes()`, plus a penalty contact with the ground at y = 0.
+static void Integrate(Truck& truck)
+{
+    for (node_t& node: truck.nodes)
+    {
+        if (node.RelPosition.y < 0.f)
+        {
+            node.Forces.y += -node.RelPosition.y * 2000000.f - node.Velocity.y * 2000.f;
+        }
+        node.Velocity += node.Forces * (PHYSICS_DT / node.mass);
+        node.RelPosition += node.Velocity * PHYSICS_DT;
+    }
+}
+
+static bool LoadBenchTruck(benchmark::State& state, Truck& truck)
+{
+    const char* path = std::getenv("ROR_BENCH_TRUCKFILE");
+    if (!LoadTruck((path != nullptr) ? path : "resources/beamobjects/rail1tPnt190r634dtri.fixed", static_cast<int>(state.range(0)), truck))
+    {
+        state.SkipWithError("Cannot load the truckfile, set ROR_BENCH_TRUCKFILE or run from the repo root");
+        return false;
+    }
+    int packed_beams = 0;
+    for (const std::pair<int, int>& run: truck.beam_kernel_runs)
+    {
+        packed_beams += run.second - run.first;
+    }
+    state.counters["beams"] = static_cast<double>(truck.beams.size());
+    state.counters["unbounded_beams"] = static_cast<double>(packed_beams);
+    return true;
+}
+
+static void Bench_Beams_Compare(benchmark::State& state)
+{
+    Truck truck;
+    if (!LoadBenchTruck(state, truck))
+        return;
+
+    // Both paths see the same state every step; the scalar result drives the simulation.
+    uint64_t values = 0, mismatches = 0;
+    float max_rel_error = 0.f;
+    for (auto _ : state)
+    {
+        Truck packed(truck);
+        ResetForces(truck);
+        ResetForces(packed);
+        CalcBeamsScalar(truck);
+        CalcBeamsPacked(packed);
+
+        // Stress is k * (length - L), so a rounding difference in the length is scaled by k * L. Node forces are sums
+        // of beam forces which mostly cancel out. Both are compared relative to the load scale of their beams.
+        std::vector<float> node_load(truck.nodes.size(), 1.f);
+        for (size_t i = 0; i < truck.beams.size(); i++)
+        {
+            const beam_t& beam = truck.beams[i];
+            const float a = beam.stress, b = packed.beams[i].stress;
+            const float load = beam.k * beam.L + std::abs(a) + 1.f;
+            mismatches += (std::memcmp(&a, &b, sizeof(float)) != 0);
+            mismatches += (beam.bm_disabled != packed.beams[i].bm_disabled);
+            max_rel_error = std::max(max_rel_error, std::abs(a - b) / load);
+            node_load[beam.p1 - &truck.nodes[0]] += load;
+            node_load[beam.p2 - &truck.nodes[0]] += load;
+        }
+        for (size_t i = 0; i < truck.nodes.size(); i++)
+        {
+            const Vector3& a = truck.nodes[i].Forces;
+            const Vector3& b = packed.nodes[i].Forces;
+            mismatches += (std::memcmp(&a, &b, sizeof(Vector3)) != 0);
+            max_rel_error = std::max(max_rel_error, std::sqrt((a - b).squaredLength()) / node_load[i]);
+        }
+        values += truck.nodes.size() + truck.beams.size();
+        Integrate(truck);
+    }
+    state.counters["mismatches"] = static_cast<double>(mismatches);
+    state.counters["mismatch_ratio"] = static_cast<double>(mismatches) / std::max(values, (uint64_t)1);
+    state.counters["max_rel_error"] = max_rel_error;
+    if (max_rel_error > TOLERANCE)
+    {
+        state.SkipWithError("Packed beam forces differ from the scalar path");
+    }
+}
+BENCHMARK(Bench_Beams_Compare)->Arg(1)->Iterations(4000);
+
+static void Bench_Beams_Scalar(benchmark::State& state)
+{
+    Truck truck;
+    if (!LoadBenchTruck(state, truck))
+        return;
+    for (int i = 0; i < 400; i++) // Let it land
+    {
+        ResetForces(truck);
+        CalcBeamsScalar(truck);
+        Integrate(truck);
+    }
+    for (auto _ : state)
+    {
+        ResetForces(truck);
+        CalcBeamsScalar(truck);
+        benchmark::DoNotOptimize(truck.nodes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * truck.beams.size());
+}
+BENCHMARK(Bench_Beams_Scalar)->Arg(1)->Arg(16)->Arg(64);
+
+static void Bench_Beams_Packed(benchmark::State& state)
+{
+    Truck truck;
+    if (!LoadBenchTruck(state, truck))
+        return;
+    for (int i = 0; i < 400; i++) // Let it land - same state as the scalar benchmark
+    {
+        ResetForces(truck);
+        CalcBeamsScalar(truck);
+        Integrate(truck);
+    }
+    for (auto _ : state)
+    {
+        ResetForces(truck);
+        CalcBeamsPacked(truck);
+        benchmark::DoNotOptimize(truck.nodes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * truck.beams.size());
+}
+BENCHMARK(Bench_Beams_Packed)->Arg(1)->Arg(16)->Arg(64);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,643 @@
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// CPU side of the Hydrax water surface, without a GPU: the projected grid is built in a plain
+// vertex array (the buffer `Mesh::updateGeometry()` would upload) instead of a hardware buffer.
+// Reports vertices per second of one moving-camera frame (projection, Perlin heights, smoothing,
+// normals, choppy waves) and updates per second of the Perlin noise tables, for the original
+// single-threaded code and the row-range version which runs on the thread pool.
+// Noise code is copied from 'source/main/gfx/hydrax/Perlin.cpp', grid code from
+// 'source/main/gfx/hydrax/ProjectedGrid.cpp' (NM_VERTEX, Ogre vectors replaced by small structs),
+// `Parallel::forEachRowRange()` from 'source/main/gfx/hydrax/Help.cpp'.
+// The thread pool is a minimal fork/join stand-in for `App::GetThreadPool()->Parallelize()`.
+
+// ------------------------------ Thread pool stand-in ------------------------------
+
+class ForkJoinPool
+{
+public:
+    explicit ForkJoinPool(int num_workers)
+    {
+        for (int i = 0; i < num_workers; i++)
+        {
+            m_threads.emplace_back([this]{ this->WorkerThreadBody(); });
+        }
+    }
+
+    ~ForkJoinPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_terminate = true;
+        }
+        m_wake_cv.notify_all();
+        for (auto& t : m_threads) { t.join(); }
+    }
+
+    size_t GetNumWorkers() const { return m_threads.size(); }
+
+    void Parallelize(const std::vector<std::function<void()>>& task_funcs)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks = &task_funcs;
+            m_next_index = 0;
+            m_num_busy = m_threads.size();
+            m_generation++;
+        }
+        m_wake_cv.notify_all();
+        this->RunBatch(task_funcs); // The calling thread helps out
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done_cv.wait(lock, [this]{ return m_num_busy == 0; });
+    }
+
+private:
+    void RunBatch(const std::vector<std::function<void()>>& task_funcs)
+    {
+        for (size_t i = m_next_index++; i < task_funcs.size(); i = m_next_index++)
+        {
+            task_funcs[i]();
+        }
+    }
+
+    void WorkerThreadBody()
+    {
+        uint64_t seen_generation = 0;
+        for (;;)
+        {
+            const std::vector<std::function<void()>>* task_funcs = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake_cv.wait(lock, [this, seen_generation]{ return m_terminate || m_generation != seen_generation; });
+                if (m_terminate)
+                    return;
+                seen_generation = m_generation;
+                task_funcs = m_tasks;
+            }
+            this->RunBatch(*task_funcs);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (--m_num_busy == 0)
+                    m_done_cv.notify_one();
+            }
+        }
+    }
+
+    std::vector<std::thread>                    m_threads;
+    std::mutex                                  m_mutex;
+    std::condition_variable                     m_wake_cv;
+    std::condition_variable                     m_done_cv;
+    const std::vector<std::function<void()>>*   m_tasks = nullptr;
+    std::atomic<size_t>                         m_next_index{0};
+    size_t                                      m_num_busy = 0;
+    uint64_t                                    m_generation = 0;
+    bool                                        m_terminate = false;
+};
+
+static ForkJoinPool* GetThreadPool()
+{
+    // Same worker count as `ThreadPool::DetectNumWorkersAndCreate()` picks by default
+    static ForkJoinPool pool(std::max(1, std::min((int)std::thread::hardware_concurrency() - 1, 8)));
+    return &pool;
+}
+
+static void ForEachRowRange(int row_begin, int row_end, int min_rows_per_range, const std::function<void(const int&, const int&)>& func)
+{
+    const int rows = row_end - row_begin;
+    const int max_ranges = 2 * ((int)GetThreadPool()->GetNumWorkers() + 1);
+    const int rows_per_range = std::max(min_rows_per_range, (rows + max_ranges - 1) / max_ranges);
+
+    if (rows <= rows_per_range)
+    {
+        if (rows > 0)
+            func(row_begin, row_end);
+        return;
+    }
+
+    std::vector<std::function<void()>> tasks;
+    for (int begin = row_begin; begin < row_end; begin += rows_per_range)
+    {
+        const int end = std::min(begin + rows_per_range, row_end);
+        tasks.push_back([&func, begin, end]() { func(begin, end); });
+    }
+    GetThreadPool()->Parallelize(tasks);
+}
+
+// ------------------------------ Perlin noise ------------------------------
+
+#define n_bits              5
+#define n_size              (1<<(n_bits-1))
+#define n_size_m1           (n_size - 1)
+#define n_size_sq           (n_size*n_size)
+#define n_packsize          4
+#define np_bits             (n_bits+n_packsize-1)
+#define np_size             (1<<(np_bits-1))
+#define np_size_m1          (np_size-1)
+#define np_size_sq          (np_size*np_size)
+#define n_dec_bits          12
+#define n_dec_magn          4096
+#define n_dec_magn_m1       4095
+#define max_octaves         32
+#define noise_frames        256
+#define noise_frames_m1     (noise_frames-1)
+#define noise_decimalbits   15
+#define noise_magnitude     (1<<(noise_decimalbits-1))
+#define scale_decimalbits   15
+#define scale_magnitude     (1<<(scale_decimalbits-1))
+
+static const int PERLIN_VALUES_BATCH = 64;
+
+struct Perlin
+{
+    // Defaults from 'resources/hydrax/HydraxDefault.hdx'
+    int    octaves   = 8;
+    float  scale     = 0.5f;
+    float  falloff   = 0.49f;
+    float  timemulti = 1.27f;
+    double time      = 0.0;
+
+    int    noise[n_size_sq*noise_frames];
+    int    o_noise[n_size_sq*max_octaves];
+    int    p_noise[np_size_sq*(max_octaves>>(n_packsize-1))];
+    int*   r_noise = nullptr; // Only used by the original getValue()
+    float  magnitude = n_dec_magn * 0.5f;
+
+    Perlin()
+    {
+        srand(1234);
+        std::vector<float> tempnoise(n_size_sq*noise_frames);
+        for (size_t i = 0; i < tempnoise.size(); i++)
+        {
+            tempnoise[i] = 4*(static_cast<float>(rand())/RAND_MAX - 0.5f);
+        }
+        for (int frame = 0; frame < noise_frames; frame++)
+        {
+            for (int v = 0; v < n_size; v++)
+            {
+                for (int u = 0; u < n_size; u++)
+                {
+                    const int v0 = ((v-1)&n_size_m1)*n_size, v1 = v*n_size, v2 = ((v+1)&n_size_m1)*n_size;
+                    const int u0 = ((u-1)&n_size_m1), u1 = u, u2 = ((u+1)&n_size_m1);
+                    const int f = frame*n_size_sq;
+                    const float temp = (1.0f/14.0f) *
+                       (tempnoise[f + v0 + u0] +      tempnoise[f + v0 + u1] + tempnoise[f + v0 + u2] +
+                        tempnoise[f + v1 + u0] + 6.0f*tempnoise[f + v1 + u1] + tempnoise[f + v1 + u2] +
+                        tempnoise[f + v2 + u0] +      tempnoise[f + v2 + u1] + tempnoise[f + v2 + u2]);
+                    noise[frame*n_size_sq + v*n_size + u] = noise_magnitude*temp;
+                }
+            }
+        }
+    }
+
+    void CalculeOctaves()
+    {
+        int amount[3];
+        unsigned int image[3];
+        float sum = 0.0f, f_multitable[max_octaves];
+        double dImage, fraction;
+
+        for (int i = 0; i < octaves; i++)
+        {
+            f_multitable[i] = powf(falloff, 1.0f*i);
+            sum += f_multitable[i];
+        }
+        for (int i = 0; i < octaves; i++)
+        {
+            f_multitable[i] /= sum;
+        }
+
+        double r_timemulti = 1.0;
+        const float PI_3 = 3.14159265f/3;
+        for (int o = 0; o < octaves; o++)
+        {
+            fraction = modf(time*r_timemulti, &dImage);
+            const int iImage = static_cast<int>(dImage);
+            amount[0] = scale_magnitude*f_multitable[o]*(pow(sin((fraction+2)*PI_3),2)/1.5);
+            amount[1] = scale_magnitude*f_multitable[o]*(pow(sin((fraction+1)*PI_3),2)/1.5);
+            amount[2] = scale_magnitude*f_multitable[o]*(pow(sin((fraction  )*PI_3),2)/1.5);
+            image[0] = (iImage  ) & noise_frames_m1;
+            image[1] = (iImage+1) & noise_frames_m1;
+            image[2] = (iImage+2) & noise_frames_m1;
+            for (int i = 0; i < n_size_sq; i++)
+            {
+                o_noise[i + n_size_sq*o] = (
+                   ((amount[0] * noise[i + n_size_sq * image[0]])>>scale_decimalbits) +
+                   ((amount[1] * noise[i + n_size_sq * image[1]])>>scale_decimalbits) +
+                   ((amount[2] * noise[i + n_size_sq * image[2]])>>scale_decimalbits));
+            }
+            r_timemulti *= timemulti;
+        }
+    }
+
+    int MapSample(int u, int v, int upsamplepower, int octave) const
+    {
+        const int magn = 1<<upsamplepower,
+            pu = u >> upsamplepower, pv = v >> upsamplepower,
+            fu = u & (magn-1),       fv = v & (magn-1),
+            fu_m = magn - fu,        fv_m = magn - fv,
+            o = fu_m*fv_m*o_noise[octave*n_size_sq + ((pv)  &n_size_m1)*n_size + ((pu)  &n_size_m1)] +
+                fu*  fv_m*o_noise[octave*n_size_sq + ((pv)  &n_size_m1)*n_size + ((pu+1)&n_size_m1)] +
+                fu_m*fv*  o_noise[octave*n_size_sq + ((pv+1)&n_size_m1)*n_size + ((pu)  &n_size_m1)] +
+                fu*  fv*  o_noise[octave*n_size_sq + ((pv+1)&n_size_m1)*n_size + ((pu+1)&n_size_m1)];
+        return o >> (upsamplepower+upsamplepower);
+    }
+
+    void CalculeNoiseLegacy()
+    {
+        this->CalculeOctaves();
+        int octavepack = 0;
+        for (int o = 0; o < octaves; o += n_packsize)
+        {
+            for (int v = 0; v < np_size; v++)
+            {
+                for (int u = 0; u < np_size; u++)
+                {
+                    p_noise[v*np_size+u+octavepack*np_size_sq]  = o_noise[(o+3)*n_size_sq + (v&n_size_m1)*n_size + (u&n_size_m1)];
+                    p_noise[v*np_size+u+octavepack*np_size_sq] += MapSample(u, v, 3, o);
+                    p_noise[v*np_size+u+octavepack*np_size_sq] += MapSample(u, v, 2, o+1);
+                    p_noise[v*np_size+u+octavepack*np_size_sq] += MapSample(u, v, 1, o+2);
+                }
+            }
+            octavepack++;
+        }
+    }
+
+    void CalculeNoiseRowRanges()
+    {
+        this->CalculeOctaves();
+        ForEachRowRange(0, np_size, 16, [this](const int& row_begin, const int& row_end)
+        {
+            int octavepack = 0;
+            for (int o = 0; o < octaves; o += n_packsize)
+            {
+                for (int v = row_begin; v < row_end; v++)
+                {
+                    int* p_row = p_noise + octavepack*np_size_sq + v*np_size;
+                    const int* o_row = o_noise + (o+3)*n_size_sq + (v&n_size_m1)*n_size;
+                    for (int u = 0; u < np_size; u++)
+                    {
+                        p_row[u] = o_row[u&n_size_m1] + MapSample(u, v, 3, o) + MapSample(u, v, 2, o+1) + MapSample(u, v, 1, o+2);
+                    }
+                }
+                octavepack++;
+            }
+        });
+    }
+
+    static int ReadTexelLinearDual(const int* r_noise, int u, int v)
+    {
+        const int iu  = (u>>n_dec_bits)&np_size_m1,
+                  iv  = ((v>>n_dec_bits)&np_size_m1)*np_size,
+                  iup = ((u>>n_dec_bits) + 1)&np_size_m1,
+                  ivp = (((v>>n_dec_bits) + 1)&np_size_m1)*np_size,
+                  fu  = u & n_dec_magn_m1,
+                  fv  = v & n_dec_magn_m1,
+                  ut01 = ((n_dec_magn-fu)*r_noise[iv + iu] + fu*r_noise[iv + iup])>>n_dec_bits,
+                  ut23 = ((n_dec_magn-fu)*r_noise[ivp + iu] + fu*r_noise[ivp + iup])>>n_dec_bits;
+        return ((n_dec_magn-fv)*ut01 + fv*ut23) >> n_dec_bits;
+    }
+
+    float GetValueLegacy(float u, float v) // Not threadsafe: walks the member `r_noise`
+    {
+        r_noise = p_noise;
+        int ui = u*magnitude, vi = v*magnitude, value = 0;
+        const int hoct = octaves / n_packsize;
+        for (int i = 0; i < hoct; i++)
+        {
+            value += ReadTexelLinearDual(r_noise, ui, vi);
+            ui = ui << n_packsize;
+            vi = vi << n_packsize;
+            r_noise += np_size_sq;
+        }
+        return static_cast<float>(value)/noise_magnitude;
+    }
+
+    void GetValues(const float* x, const float* y, int count, float* values) const
+    {
+        int ui[PERLIN_VALUES_BATCH], vi[PERLIN_VALUES_BATCH], value[PERLIN_VALUES_BATCH];
+        const int hoct = octaves / n_packsize;
+        for (int start = 0; start < count; start += PERLIN_VALUES_BATCH)
+        {
+            const int num = std::min(PERLIN_VALUES_BATCH, count - start);
+            for (int k = 0; k < num; k++)
+            {
+                ui[k] = x[start + k]*magnitude;
+                vi[k] = y[start + k]*magnitude;
+                value[k] = 0;
+            }
+            const int* octave_noise = p_noise;
+            for (int i = 0; i < hoct; i++)
+            {
+                for (int k = 0; k < num; k++)
+                {
+                    value[k] += ReadTexelLinearDual(octave_noise, ui[k], vi[k]);
+                    ui[k] = ui[k] << n_packsize;
+                    vi[k] = vi[k] << n_packsize;
+                }
+                octave_noise += np_size_sq;
+            }
+            for (int k = 0; k < num; k++)
+            {
+                values[start + k] = static_cast<float>(value[k])/noise_magnitude;
+            }
+        }
+    }
+};
+
+// ------------------------------ Projected grid ------------------------------
+
+struct Vec2
+{
+    float x, y;
+    Vec2 operator-(const Vec2& o) const { return Vec2{x - o.x, y - o.y}; }
+    Vec2 operator+(const Vec2& o) const { return Vec2{x + o.x, y + o.y}; }
+    Vec2 operator*(const Vec2& o) const { return Vec2{x * o.x, y * o.y}; }
+    Vec2 operator*(float f) const       { return Vec2{x * f, y * f}; }
+    float length() const                { return std::sqrt(x*x + y*y); }
+};
+
+struct Vec3
+{
+    float x, y, z;
+    Vec3 crossProduct(const Vec3& o) const { return Vec3{y*o.z - z*o.y, z*o.x - x*o.z, x*o.y - y*o.x}; }
+    Vec3 normalisedCopy() const
+    {
+        const float len = std::sqrt(x*x + y*y + z*z);
+        return (len > 1e-08f) ? Vec3{x/len, y/len, z/len} : *this;
+    }
+};
+
+struct Vec4 { float x, y, z, w; };
+
+struct Vertex { float x, y, z, nx, ny, nz; }; // Mesh::POS_NORM_VERTEX
+
+struct Grid
+{
+    explicit Grid(int complexity)
+        : complexity(complexity), vertices(complexity*complexity), choppy_buffer(complexity*complexity)
+    {
+        // Camera 10m above the water looking ahead: near edge 5m, far edge 2km away
+        corners[0] = Vec4{ -20.f, 0.f,    5.f, 1.f  };
+        corners[1] = Vec4{  20.f, 0.f,    5.f, 1.f  };
+        corners[2] = Vec4{ -30.f, 0.f,   20.f, 0.01f };
+        corners[3] = Vec4{  30.f, 0.f,   20.f, 0.01f };
+    }
+
+    // Defaults from 'resources/hydrax/HydraxDefault.hdx'
+    int                 complexity;
+    float               strength = 3.5f;
+    float               choppy_strength = 0.375f;
+    float               height = 0.f;       // -mBasePlane.d
+    Vec3                world_pos = Vec3{1000.f, 10.f, 1000.f};
+    Vec2                dir = Vec2{0.6f, 0.8f};
+    Vec2                perp = Vec2{0.8f, 0.6f};
+    int                 underwater = 1;
+    Vec4                corners[4];
+    std::vector<Vertex> vertices;
+    std::vector<Vertex> choppy_buffer;
+};
+
+// Original `ProjectedGrid::_renderGeometry()` + `_calculeNormals()` + `_performChoppyWaves()`
+
+static void GridFrameLegacy(Grid& g, Perlin& n)
+{
+    const int C = g.complexity;
+    const Vec4 &c0 = g.corners[0], &c1 = g.corners[1], &c2 = g.corners[2], &c3 = g.corners[3];
+    float du = 1.0f/(C-1), dv = 1.0f/(C-1), u, v = 0.0f, _1_u, _1_v = 1.0f, divide;
+    Vec4 result;
+    Vertex* Vertices = g.vertices.data();
+    int i = 0;
+
+    for (int iv = 0; iv < C; iv++)
+    {
+        u = 0.0f;
+        _1_u = 1.0f;
+        for (int iu = 0; iu < C; iu++)
+        {
+            result.x = _1_v*(_1_u*c0.x + u*c1.x) + v*(_1_u*c2.x + u*c3.x);
+            result.z = _1_v*(_1_u*c0.z + u*c1.z) + v*(_1_u*c2.z + u*c3.z);
+            result.w = _1_v*(_1_u*c0.w + u*c1.w) + v*(_1_u*c2.w + u*c3.w);
+            divide = 1.0f/result.w;
+            result.x *= divide;
+            result.z *= divide;
+            Vertices[i].x = result.x;
+            Vertices[i].z = result.z;
+            Vertices[i].y = g.height + n.GetValueLegacy(g.world_pos.x + result.x, g.world_pos.z + result.z)*g.strength;
+            i++;
+            u += du;
+            _1_u = 1.0f-u;
+        }
+        v += dv;
+        _1_v = 1.0f-v;
+    }
+
+    for (int k = 0; k < C*C; k++)
+    {
+        g.choppy_buffer[k] = Vertices[k];
+    }
+
+    for (int iv = 1; iv < C-1; iv++) // Smoothing, in place
+    {
+        for (int iu = 1; iu < C-1; iu++)
+        {
+            Vertices[iv*C + iu].y = 0.2f *
+                (Vertices[iv*C + iu].y + Vertices[iv*C + iu+1].y + Vertices[iv*C + iu-1].y + Vertices[(iv+1)*C + iu].y + Vertices[(iv-1)*C + iu].y);
+        }
+    }
+
+    for (int iv = 1; iv < C-1; iv++) // Normals
+    {
+        for (int iu = 1; iu < C-1; iu++)
+        {
+            const Vec3 vec1{ Vertices[iv*C + iu+1].x - Vertices[iv*C + iu-1].x, Vertices[iv*C + iu+1].y - Vertices[iv*C + iu-1].y, Vertices[iv*C + iu+1].z - Vertices[iv*C + iu-1].z };
+            const Vec3 vec2{ Vertices[(iv+1)*C + iu].x - Vertices[(iv-1)*C + iu].x, Vertices[(iv+1)*C + iu].y - Vertices[(iv-1)*C + iu].y, Vertices[(iv+1)*C + iu].z - Vertices[(iv-1)*C + iu].z };
+            const Vec3 normal = vec2.crossProduct(vec1);
+            Vertices[iv*C + iu].nx = normal.x;
+            Vertices[iv*C + iu].ny = normal.y;
+            Vertices[iv*C + iu].nz = normal.z;
+        }
+    }
+
+    const Vertex* Choppy = g.choppy_buffer.data();
+    for (int iv = 1; iv < C-1; iv++) // Choppy waves
+    {
+        const float Dis1 = (Vec2{Choppy[iv*C + 1].x, Choppy[iv*C + 1].z} - Vec2{Choppy[(iv+1)*C + 1].x, Choppy[(iv+1)*C + 1].z}).length();
+        for (int iu = 1; iu < C-1; iu++)
+        {
+            const float Dis2 = (Vec2{Choppy[iv*C + iu].x, Choppy[iv*C + iu].z} - Vec2{Choppy[iv*C + iu+1].x, Choppy[iv*C + iu+1].z}).length();
+            const Vec3 Norm = Vec3{Vertices[iv*C + iu].nx, Vertices[iv*C + iu].ny, Vertices[iv*C + iu].nz}.normalisedCopy();
+            const Vec2 Norm2 = Vec2{Norm.x, Norm.z} * ((g.dir * Dis1) + (g.perp * Dis2)) * g.choppy_strength;
+            Vertices[iv*C + iu].x = Choppy[iv*C + iu].x + Norm2.x * g.underwater;
+            Vertices[iv*C + iu].z = Choppy[iv*C + iu].z + Norm2.y * g.underwater;
+        }
+    }
+}
+
+// Row-range version
+
+static void ProjectRows(Grid& g, int row_begin, int row_end)
+{
+    const int C = g.complexity;
+    const Vec4 &c0 = g.corners[0], &c1 = g.corners[1], &c2 = g.corners[2], &c3 = g.corners[3];
+    const float d = 1.0f/(C-1);
+    for (int iv = row_begin; iv < row_end; iv++)
+    {
+        const float v = iv*d, _1_v = 1.0f-v,
+                    Lx = _1_v*c0.x + v*c2.x, Lz = _1_v*c0.z + v*c2.z, Lw = _1_v*c0.w + v*c2.w,
+                    Rx = _1_v*c1.x + v*c3.x, Rz = _1_v*c1.z + v*c3.z, Rw = _1_v*c1.w + v*c3.w;
+        Vertex* Row = g.vertices.data() + iv*C;
+        for (int iu = 0; iu < C; iu++)
+        {
+            const float u = iu*d, _1_u = 1.0f-u, divide = 1.0f/(_1_u*Lw + u*Rw);
+            Row[iu].x = (_1_u*Lx + u*Rx)*divide;
+            Row[iu].z = (_1_u*Lz + u*Rz)*divide;
+        }
+    }
+}
+
+static void CalculeHeights(Grid& g, const Perlin& n, int row_begin, int row_end)
+{
+    const int C = g.complexity;
+    std::vector<float> X(C), Z(C), Y(C);
+    for (int v = row_begin; v < row_end; v++)
+    {
+        Vertex* Row = g.vertices.data() + v*C;
+        for (int u = 0; u < C; u++)
+        {
+            X[u] = g.world_pos.x + Row[u].x;
+            Z[u] = g.world_pos.z + Row[u].z;
+        }
+        n.GetValues(X.data(), Z.data(), C, Y.data());
+        for (int u = 0; u < C; u++)
+        {
+            Row[u].y = g.height + Y[u]*g.strength;
+        }
+    }
+}
+
+static void GridFrameRowRanges(Grid& g, const Perlin& n)
+{
+    const int C = g.complexity;
+    Vertex* Vertices = g.vertices.data();
+    Vertex* Choppy = g.choppy_buffer.data();
+
+    ForEachRowRange(0, C, 8, [&g, &n, C, Vertices, Choppy](const int& row_begin, const int& row_end)
+    {
+        ProjectRows(g, row_begin, row_end);
+        CalculeHeights(g, n, row_begin, row_end);
+        for (int i = row_begin*C; i < row_end*C; i++)
+        {
+            Choppy[i] = Vertices[i];
+        }
+    });
+
+    for (int iv = 1; iv < C-1; iv++) // Smoothing, in place - stays on one thread, see `_PG_smoothHeights()`
+    {
+        for (int iu = 1; iu < C-1; iu++)
+        {
+            Vertices[iv*C + iu].y = 0.2f *
+                (Vertices[iv*C + iu].y + Vertices[iv*C + iu+1].y + Vertices[iv*C + iu-1].y + Vertices[(iv+1)*C + iu].y + Vertices[(iv-1)*C + iu].y);
+        }
+    }
+
+    ForEachRowRange(1, C-1, 8, [C, Vertices](const int& row_begin, const int& row_end)
+    {
+        for (int iv = row_begin; iv < row_end; iv++)
+        {
+            for (int iu = 1; iu < C-1; iu++)
+            {
+                const Vec3 vec1{ Vertices[iv*C + iu+1].x - Vertices[iv*C + iu-1].x, Vertices[iv*C + iu+1].y - Vertices[iv*C + iu-1].y, Vertices[iv*C + iu+1].z - Vertices[iv*C + iu-1].z };
+                const Vec3 vec2{ Vertices[(iv+1)*C + iu].x - Vertices[(iv-1)*C + iu].x, Vertices[(iv+1)*C + iu].y - Vertices[(iv-1)*C + iu].y, Vertices[(iv+1)*C + iu].z - Vertices[(iv-1)*C + iu].z };
+                const Vec3 normal = vec2.crossProduct(vec1);
+                Vertices[iv*C + iu].nx = normal.x;
+                Vertices[iv*C + iu].ny = normal.y;
+                Vertices[iv*C + iu].nz = normal.z;
+            }
+        }
+    });
+
+    ForEachRowRange(1, C-1, 8, [&g, C, Vertices, Choppy](const int& row_begin, const int& row_end)
+    {
+        for (int iv = row_begin; iv < row_end; iv++)
+        {
+            const float Dis1 = (Vec2{Choppy[iv*C + 1].x, Choppy[iv*C + 1].z} - Vec2{Choppy[(iv+1)*C + 1].x, Choppy[(iv+1)*C + 1].z}).length();
+            for (int iu = 1; iu < C-1; iu++)
+            {
+                const float Dis2 = (Vec2{Choppy[iv*C + iu].x, Choppy[iv*C + iu].z} - Vec2{Choppy[iv*C + iu+1].x, Choppy[iv*C + iu+1].z}).length();
+                const Vec3 Norm = Vec3{Vertices[iv*C + iu].nx, Vertices[iv*C + iu].ny, Vertices[iv*C + iu].nz}.normalisedCopy();
+                const Vec2 Norm2 = Vec2{Norm.x, Norm.z} * ((g.dir * Dis1) + (g.perp * Dis2)) * g.choppy_strength;
+                Vertices[iv*C + iu].x = Choppy[iv*C + iu].x + Norm2.x * g.underwater;
+                Vertices[iv*C + iu].z = Choppy[iv*C + iu].z + Norm2.y * g.underwater;
+            }
+        }
+    });
+}
+
+// ------------------------------ Benchmarks ------------------------------
+
+static void Bench_Hydrax_PerlinUpdate_Legacy(benchmark::State& state)
+{
+    Perlin noise;
+    for (auto _ : state)
+    {
+        noise.time += 1.4 / 60.0;
+        noise.CalculeNoiseLegacy();
+        benchmark::DoNotOptimize(noise.p_noise);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void Bench_Hydrax_PerlinUpdate_RowRanges(benchmark::State& state)
+{
+    Perlin noise;
+    for (auto _ : state)
+    {
+        noise.time += 1.4 / 60.0;
+        noise.CalculeNoiseRowRanges();
+        benchmark::DoNotOptimize(noise.p_noise);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void Bench_Hydrax_GridFrame_Legacy(benchmark::State& state)
+{
+    Perlin noise;
+    noise.CalculeNoiseLegacy();
+    Grid grid(static_cast<int>(state.range(0)));
+    for (auto _ : state)
+    {
+        GridFrameLegacy(grid, noise);
+        benchmark::DoNotOptimize(grid.vertices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * grid.vertices.size());
+}
+
+static void Bench_Hydrax_GridFrame_RowRanges(benchmark::State& state)
+{
+    Perlin noise;
+    noise.CalculeNoiseLegacy();
+    Grid grid(static_cast<int>(state.range(0)));
+    for (auto _ : state)
+    {
+        GridFrameRowRanges(grid, noise);
+        benchmark::DoNotOptimize(grid.vertices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * grid.vertices.size());
+}
+
+BENCHMARK(Bench_Hydrax_PerlinUpdate_Legacy)->UseRealTime();
+BENCHMARK(Bench_Hydrax_PerlinUpdate_RowRanges)->UseRealTime();
+BENCHMARK(Bench_Hydrax_GridFrame_Legacy)->Arg(128)->Arg(200)->Arg(256)->UseRealTime();
+BENCHMARK(Bench_Hydrax_GridFrame_RowRanges)->Arg(128)->Arg(200)->Arg(256)->UseRealTime();
+
+BENCHMARK_MAIN();
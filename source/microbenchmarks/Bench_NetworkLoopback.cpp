@@ -0,0 +1,402 @@
+#include "benchmark/benchmark.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Loopback harness for the client send path: a stand-in server thread accepts one TCP connection
+// on 127.0.0.1 and parses RoRnet headers + payloads, counting packets. Each benchmark iteration
+// queues a burst of packets (one frame worth, `state.range(0)` packets) from the benchmark thread
+// and waits until the server has received all of them. Reports packets per second for the
+// original send queue (mutex + std::deque, one write per packet) and the lock-free SpscRing
+// with coalesced writes. POSIX sockets only.
+// SpscRing is copied verbatim from 'source/main/utils/SpscRing.h', the send logic from
+// 'source/main/network/Network.cpp' (SocketW's fsend() replaced by a send() loop).
+
+#define RORNET_MAX_MESSAGE_LENGTH 8192
+
+namespace RoRnet {
+
+#pragma pack(push, 1)
+
+struct Header
+{
+    uint32_t command;
+    int32_t  source;
+    uint32_t streamid;
+    uint32_t size;
+};
+
+#pragma pack(pop)
+
+enum { MSG2_STREAM_DATA = 1025 };
+
+} // namespace RoRnet
+
+struct NetSendPacket
+{
+    char buffer[RORNET_MAX_MESSAGE_LENGTH];
+    int size;
+};
+
+namespace RoR {
+
+/// Fixed-capacity lock-free queue for exactly one producer thread and one consumer thread.
+/// Slots are allocated by `Reset()` and reused; the producer fills them in place
+/// (`BeginPush()` + `EndPush()`), the consumer reads them in place (`Peek()`) and then releases them (`Pop()`).
+template <class T>
+class SpscRing
+{
+public:
+    /// Not threadsafe; call while neither side is running. Capacity must be a power of two (or 0 to free the slots).
+    void Reset(size_t capacity)
+    {
+        assert((capacity & (capacity - 1)) == 0);
+        std::vector<T>(capacity).swap(m_slots);
+        m_mask = (capacity > 0) ? capacity - 1 : 0;
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
+    }
+
+    size_t GetCapacity() const { return m_slots.size(); }
+
+    /// Number of elements pushed but not yet popped; exact on the consumer side, a lower bound on the producer side.
+    size_t GetNumAvailable() const
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    // ----- Producer -----
+
+    /// Returns the slot to fill, or nullptr if the ring is full. The slot holds stale data.
+    T* BeginPush()
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) >= m_slots.size())
+            return nullptr;
+        return &m_slots[tail & m_mask];
+    }
+
+    /// Publishes the slot returned by `BeginPush()`.
+    void EndPush()
+    {
+        m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // ----- Consumer -----
+
+    /// The i-th oldest element; `i < GetNumAvailable()`.
+    T& Peek(size_t i)
+    {
+        return m_slots[(m_head.load(std::memory_order_relaxed) + i) & m_mask];
+    }
+
+    /// Returns the `count` oldest slots to the producer.
+    void Pop(size_t count)
+    {
+        m_head.store(m_head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+private:
+    std::vector<T>       m_slots;
+    size_t               m_mask = 0;
+    std::atomic<size_t>  m_head{0};     //!< Consumer-owned; total number of popped elements
+    char                 m_pad[64];     //!< Keeps `m_head` and `m_tail` on separate cache lines
+    std::atomic<size_t>  m_tail{0};     //!< Producer-owned; total number of pushed elements
+};
+
+} // namespace RoR
+
+// ------------------------------ Server stand-in ------------------------------
+
+static bool RecvAll(int fd, char* buf, size_t len)
+{
+    while (len > 0)
+    {
+        ssize_t n = recv(fd, buf, len, 0);
+        if (n <= 0)
+            return false;
+        buf += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+static bool SendAll(int fd, const char* buf, size_t len)
+{
+    while (len > 0)
+    {
+        ssize_t n = send(fd, buf, len, MSG_NOSIGNAL);
+        if (n <= 0)
+            return false;
+        buf += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+class LoopbackServer
+{
+public:
+    /// Returns the connected client socket.
+    int Start()
+    {
+        int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        bind(listen_fd, (sockaddr*)&addr, sizeof(addr));
+        listen(listen_fd, 1);
+        socklen_t addr_len = sizeof(addr);
+        getsockname(listen_fd, (sockaddr*)&addr, &addr_len);
+
+        int client_fd = socket(AF_INET, SOCK_STREAM, 0);
+        connect(client_fd, (sockaddr*)&addr, sizeof(addr));
+        int nodelay = 1; // SocketW doesn't touch Nagle either way, but we want to count syscalls, not delays
+        setsockopt(client_fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+        m_fd = accept(listen_fd, nullptr, nullptr);
+        close(listen_fd);
+
+        m_thread = std::thread([this]()
+        {
+            RoRnet::Header header;
+            char payload[RORNET_MAX_MESSAGE_LENGTH];
+            while (RecvAll(m_fd, (char*)&header, sizeof(header)) && RecvAll(m_fd, payload, header.size))
+            {
+                m_num_received.fetch_add(1, std::memory_order_release);
+            }
+        });
+        return client_fd;
+    }
+
+    void Stop(int client_fd)
+    {
+        shutdown(client_fd, SHUT_RDWR);
+        close(client_fd);
+        m_thread.join();
+        close(m_fd);
+    }
+
+    void WaitFor(size_t count)
+    {
+        while (m_num_received.load(std::memory_order_acquire) < count)
+            std::this_thread::yield();
+    }
+
+private:
+    int                 m_fd = -1;
+    std::thread         m_thread;
+    std::atomic<size_t> m_num_received{0};
+};
+
+static void FillPacket(NetSendPacket& packet, int len)
+{
+    RoRnet::Header* head = (RoRnet::Header*)packet.buffer;
+    memset(head, 0, sizeof(RoRnet::Header));
+    head->command  = RoRnet::MSG2_STREAM_DATA;
+    head->size     = len;
+    head->streamid = 10;
+    memset(packet.buffer + sizeof(RoRnet::Header), 0x5A, len);
+    packet.size = len + sizeof(RoRnet::Header);
+}
+
+// ------------------------------ Original queue ------------------------------
+
+class LegacySender
+{
+public:
+    explicit LegacySender(int fd): m_fd(fd), m_thread(&LegacySender::SendThread, this) {}
+
+    ~LegacySender()
+    {
+        m_shutdown = true;
+        m_cv.notify_one();
+        m_thread.join();
+    }
+
+    void AddPacket(int len)
+    {
+        NetSendPacket packet;
+        memset(&packet, 0, sizeof(NetSendPacket));
+        FillPacket(packet, len);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queue.push_back(packet);
+        }
+        m_cv.notify_one();
+    }
+
+private:
+    void SendThread()
+    {
+        while (!m_shutdown)
+        {
+            NetSendPacket packet;
+            {
+                std::unique_lock<std::mutex> queue_lock(m_mutex);
+                while (m_queue.empty() && !m_shutdown)
+                {
+                    m_cv.wait(queue_lock);
+                }
+                if (m_shutdown)
+                {
+                    break;
+                }
+                packet = m_queue.front();
+                m_queue.pop_front();
+            }
+            SendAll(m_fd, packet.buffer, packet.size);
+        }
+    }
+
+    int                       m_fd;
+    std::atomic<bool>         m_shutdown{false};
+    std::mutex                m_mutex;
+    std::condition_variable   m_cv;
+    std::deque<NetSendPacket> m_queue;
+    std::thread               m_thread;
+};
+
+// ------------------------------ SpscRing + batching ------------------------------
+
+static const size_t NET_SEND_RING_SIZE  = 256;
+static const size_t NET_SEND_BATCH_SIZE = 64 * 1024;
+
+class RingSender
+{
+public:
+    explicit RingSender(int fd): m_fd(fd)
+    {
+        m_ring.Reset(NET_SEND_RING_SIZE);
+        m_thread = std::thread(&RingSender::SendThread, this);
+    }
+
+    ~RingSender()
+    {
+        m_shutdown = true;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_cv.notify_one();
+        }
+        m_thread.join();
+    }
+
+    void AddPacket(int len)
+    {
+        NetSendPacket* packet = m_ring.BeginPush();
+        while (packet == nullptr)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            packet = m_ring.BeginPush();
+        }
+        FillPacket(*packet, len);
+        m_ring.EndPush();
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_waiting)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_cv.notify_one();
+        }
+    }
+
+private:
+    void SendThread()
+    {
+        m_batch.reserve(NET_SEND_BATCH_SIZE);
+        while (!m_shutdown)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_waiting = true;
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                while (m_ring.GetNumAvailable() == 0 && !m_shutdown)
+                {
+                    m_cv.wait(lock);
+                }
+                m_waiting = false;
+                if (m_shutdown)
+                {
+                    break;
+                }
+            }
+
+            const size_t num_packets = m_ring.GetNumAvailable();
+            for (size_t i = 0; i < num_packets; i++)
+            {
+                const NetSendPacket& packet = m_ring.Peek(i);
+                if (m_batch.size() + packet.size > NET_SEND_BATCH_SIZE)
+                {
+                    SendAll(m_fd, m_batch.data(), m_batch.size());
+                    m_batch.clear();
+                }
+                m_batch.insert(m_batch.end(), packet.buffer, packet.buffer + packet.size);
+            }
+            m_ring.Pop(num_packets);
+
+            if (!m_batch.empty())
+            {
+                SendAll(m_fd, m_batch.data(), m_batch.size());
+                m_batch.clear();
+            }
+        }
+    }
+
+    int                         m_fd;
+    std::atomic<bool>           m_shutdown{false};
+    std::atomic<bool>           m_waiting{false};
+    std::mutex                  m_mutex;
+    std::condition_variable     m_cv;
+    RoR::SpscRing<NetSendPacket> m_ring;
+    std::vector<char>           m_batch;
+    std::thread                 m_thread;
+};
+
+// ------------------------------ Benchmarks ------------------------------
+
+static const int PAYLOAD_SIZE = 900; // Roughly one bit-packed actor update
+
+template <class SENDER>
+static void Bench_Send(benchmark::State& state)
+{
+    const int burst = static_cast<int>(state.range(0));
+    LoopbackServer server;
+    int fd = server.Start();
+    size_t total = 0;
+    {
+        SENDER sender(fd);
+        for (auto _ : state)
+        {
+            for (int i = 0; i < burst; i++)
+            {
+                sender.AddPacket(PAYLOAD_SIZE);
+            }
+            total += burst;
+            server.WaitFor(total);
+        }
+    }
+    server.Stop(fd);
+    state.SetItemsProcessed(static_cast<int64_t>(total));
+}
+
+static void Bench_NetSend_Legacy(benchmark::State& state)     { Bench_Send<LegacySender>(state); }
+static void Bench_NetSend_SpscRing(benchmark::State& state)   { Bench_Send<RingSender>(state); }
+
+BENCHMARK(Bench_NetSend_Legacy)->Arg(1)->Arg(16)->Arg(64)->UseRealTime();
+BENCHMARK(Bench_NetSend_SpscRing)->Arg(1)->Arg(16)->Arg(64)->UseRealTime();
+
+BENCHMARK_MAIN();
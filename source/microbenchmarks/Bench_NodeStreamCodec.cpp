@@ -0,0 +1,647 @@
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+// Loopback harness for actor node streams: a synthetic truck (box lattice of nodes, spatially
+// ordered like real truckfiles) drives a curve with some body vibration; every update goes
+// through encoder -> packets -> decoder. Reports bytes per update for the legacy layout
+// (3 shorts per node) and the bit-packed keyframe/delta layout, plus encode/decode time.
+// The codec is copied verbatim from 'source/main/network/NodeStreamCodec.{h,cpp}',
+// the wire structs from 'source/main/network/RoRnet.h'.
+
+#define BITMASK( x ) ( 1 << ( (x) - 1 ) )
+#define RORNET_MAX_MESSAGE_LENGTH   8192
+#define RORNET_NODESTREAM_MAGIC     0xB7
+
+namespace RoRnet {
+
+enum NodeStreamFlags
+{
+    NODESTREAM_KEYFRAME   = BITMASK(1),
+    NODESTREAM_LAST_CHUNK = BITMASK(2)
+};
+
+#pragma pack(push, 1)
+
+struct Header
+{
+    uint32_t command;
+    int32_t  source;
+    uint32_t streamid;
+    uint32_t size;
+};
+
+struct VehicleState
+{
+    int32_t  time;
+    float    engine_speed;
+    float    engine_force;
+    float    engine_clutch;
+    int32_t  engine_gear;
+    float    hydrodirstate;
+    float    brake;
+    float    wheelspeed;
+    uint32_t flagmask;
+};
+
+struct NodeStreamHeader
+{
+    float    refpos[3];
+    uint16_t first_node;
+    uint16_t num_nodes;
+    uint8_t  magic;
+    uint8_t  flags;
+    uint8_t  keyframe_id;
+    uint8_t  reserved;
+};
+
+#pragma pack(pop)
+
+} // namespace RoRnet
+
+// ---------------------------------------- Codec ----------------------------------------
+
+namespace RoR {
+
+/// Node positions travel as integers: offset from node 0, multiplied by `Actor::m_net_node_compression`.
+///
+/// Nodes are packed in blocks of `BLOCK_NODES`. Each value is predicted from the previous node
+/// (and, for delta updates, from the keyframe), zigzag-encoded and stored with the smallest bit width
+/// which fits the whole block. A resting actor costs 2 bytes per block, a rigidly moving one a few bits per node.
+/// Updates larger than one packet are split into chunks at block boundaries, see `RoRnet::NodeStreamHeader`.
+struct NodeStreamCodec
+{
+    static const int     BLOCK_NODES = 16;
+    static const int     KEYFRAME_INTERVAL = 10;        //!< Updates; a late joiner waits at most this long
+    static const int32_t QUANT_LIMIT = (1 << 28) - 1;   //!< Keeps the residuals within 31 bits
+
+    static int32_t Quantize(float value, float scale);
+};
+
+class NodeStreamEncoder
+{
+public:
+    struct Chunk
+    {
+        int            first_node;
+        int            num_nodes;
+        const uint8_t* data;
+        size_t         size;
+    };
+
+    void     Resize(int num_nodes);
+    int32_t* GetInput() { return m_input.data(); }   //!< Fill with 3 quantized values (x,y,z) per node, then call `Encode()`
+
+    /// Encodes `GetInput()`; switches to a keyframe periodically or when a delta would not be smaller.
+    void     Encode(size_t max_chunk_bytes);
+
+    bool     IsKeyframe() const                      { return m_is_keyframe; }
+    uint8_t  GetKeyframeId() const                   { return m_keyframe_id; }
+    size_t   GetNumChunks() const                    { return m_chunks.size(); }
+    Chunk    GetChunk(size_t i) const;
+    size_t   GetPayloadSize() const                  { return m_payload.size(); }
+
+private:
+    void     Pack(const int32_t* reference, size_t max_chunk_bytes);
+
+    struct ChunkRange { int first_node; int num_nodes; size_t offset; size_t size; };
+
+    int                     m_num_nodes = 0;
+    std::vector<int32_t>    m_input;
+    std::vector<int32_t>    m_keyframe;           //!< Quantized positions of the last keyframe
+    std::vector<uint8_t>    m_payload;
+    std::vector<ChunkRange> m_chunks;
+    size_t                  m_keyframe_size = 0;  //!< Payload bytes of the last keyframe
+    int                     m_updates_since_keyframe = 0;
+    uint8_t                 m_keyframe_id = 0;
+    bool                    m_has_keyframe = false;
+    bool                    m_is_keyframe = false;
+};
+
+class NodeStreamDecoder
+{
+public:
+    enum class Result
+    {
+        PENDING,   //!< Chunk accepted (or skipped) but no complete update yet
+        COMPLETE,  //!< `GetOutput()` holds a complete update
+        MISMATCH   //!< Stream doesn't fit this actor
+    };
+
+    void           Resize(int num_nodes);
+
+    /// @param time  `VehicleState::time` of the packet; chunks of one update share it.
+    Result         DecodeChunk(int32_t time, const RoRnet::NodeStreamHeader& header, const uint8_t* data, size_t size);
+
+    const int32_t* GetOutput() const { return m_output.data(); } //!< 3 quantized values (x,y,z) per node
+
+private:
+    int                     m_num_nodes = 0;
+    std::vector<int32_t>    m_output;
+    std::vector<int32_t>    m_keyframe;
+    uint8_t                 m_keyframe_id = 0;
+    bool                    m_has_keyframe = false;
+
+    // Update being assembled
+    int32_t                 m_asm_time = 0;
+    int                     m_asm_next_node = -1;  //!< -1 = no update in progress
+    int32_t                 m_asm_prev[3] = {};    //!< Predictor carried across chunks
+    bool                    m_asm_keyframe = false;
+};
+
+/// False for node stream chunks the receiver must not drop (keyframes and parts of multi-packet updates);
+/// true for single-packet deltas and anything which isn't node stream data.
+bool IsDiscardableStreamData(const char* data, size_t size);
+
+} // namespace RoR
+
+using namespace RoR;
+
+namespace {
+
+const int WIDTH_BITS = 5; // Per axis and block; widths never exceed 31, see `QUANT_LIMIT`
+
+inline uint32_t ZigZag(int32_t v)
+{
+    return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+inline int32_t UnZigZag(uint32_t u)
+{
+    return static_cast<int32_t>((u >> 1) ^ (0u - (u & 1u)));
+}
+
+inline int BitWidth(uint32_t v)
+{
+    int width = 0;
+    while (v != 0)
+    {
+        ++width;
+        v >>= 1;
+    }
+    return width;
+}
+
+struct BitWriter
+{
+    explicit BitWriter(std::vector<uint8_t>& out): bw_out(out) {}
+
+    void Write(uint32_t value, int num_bits)
+    {
+        bw_acc |= static_cast<uint64_t>(value) << bw_bits;
+        bw_bits += num_bits;
+        while (bw_bits >= 8)
+        {
+            bw_out.push_back(static_cast<uint8_t>(bw_acc));
+            bw_acc >>= 8;
+            bw_bits -= 8;
+        }
+    }
+
+    void Align()
+    {
+        if (bw_bits > 0)
+        {
+            bw_out.push_back(static_cast<uint8_t>(bw_acc));
+        }
+        bw_acc = 0;
+        bw_bits = 0;
+    }
+
+    std::vector<uint8_t>& bw_out;
+    uint64_t              bw_acc = 0;
+    int                   bw_bits = 0;
+};
+
+struct BitReader
+{
+    BitReader(const uint8_t* data, size_t size): br_data(data), br_size(size) {}
+
+    uint32_t Read(int num_bits)
+    {
+        while (br_bits < num_bits)
+        {
+            if (br_pos == br_size)
+            {
+                br_overrun = true;
+                return 0;
+            }
+            br_acc |= static_cast<uint64_t>(br_data[br_pos++]) << br_bits;
+            br_bits += 8;
+        }
+        const uint32_t value = static_cast<uint32_t>(br_acc & ((uint64_t(1) << num_bits) - 1));
+        br_acc >>= num_bits;
+        br_bits -= num_bits;
+        return value;
+    }
+
+    void Align()
+    {
+        br_acc = 0;
+        br_bits = 0;
+    }
+
+    const uint8_t* br_data;
+    size_t         br_size;
+    size_t         br_pos = 0;
+    uint64_t       br_acc = 0;
+    int            br_bits = 0;
+    bool           br_overrun = false;
+};
+
+} // namespace
+
+int32_t NodeStreamCodec::Quantize(float value, float scale)
+{
+    const float q = std::max(-float(QUANT_LIMIT), std::min(float(QUANT_LIMIT), value * scale));
+    return static_cast<int32_t>(q + ((q >= 0.f) ? 0.5f : -0.5f));
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Encoder
+
+void NodeStreamEncoder::Resize(int num_nodes)
+{
+    m_num_nodes = num_nodes;
+    m_input.assign(num_nodes * 3, 0);
+    m_keyframe.assign(num_nodes * 3, 0);
+    m_payload.clear();
+    m_payload.reserve(num_nodes * 3 * sizeof(int32_t) + num_nodes); // Worst case incl. block headers
+    m_chunks.clear();
+    m_has_keyframe = false;
+    m_updates_since_keyframe = 0;
+}
+
+void NodeStreamEncoder::Encode(size_t max_chunk_bytes)
+{
+    m_is_keyframe = !m_has_keyframe || m_updates_since_keyframe >= NodeStreamCodec::KEYFRAME_INTERVAL;
+    if (!m_is_keyframe)
+    {
+        this->Pack(m_keyframe.data(), max_chunk_bytes);
+        m_is_keyframe = (m_payload.size() >= m_keyframe_size); // Moved too far from the keyframe
+    }
+
+    if (m_is_keyframe)
+    {
+        this->Pack(nullptr, max_chunk_bytes);
+        std::copy(m_input.begin(), m_input.end(), m_keyframe.begin());
+        m_keyframe_size = m_payload.size();
+        m_keyframe_id++;
+        m_has_keyframe = true;
+        m_updates_since_keyframe = 0;
+    }
+    else
+    {
+        m_updates_since_keyframe++;
+    }
+}
+
+void NodeStreamEncoder::Pack(const int32_t* reference, size_t max_chunk_bytes)
+{
+    const int B = NodeStreamCodec::BLOCK_NODES;
+
+    m_payload.clear();
+    m_chunks.clear();
+
+    BitWriter writer(m_payload);
+    int32_t prev[3] = {0, 0, 0};
+    uint32_t residuals[3][B];
+    for (int block_first = 0; block_first < m_num_nodes; block_first += B)
+    {
+        const int count = std::min(B, m_num_nodes - block_first);
+        uint32_t combined[3] = {0, 0, 0};
+        for (int i = 0; i < count; ++i)
+        {
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                const int idx = (block_first + i) * 3 + axis;
+                const int32_t value = (reference != nullptr) ? (m_input[idx] - reference[idx]) : m_input[idx];
+                residuals[axis][i] = ZigZag(value - prev[axis]);
+                combined[axis] |= residuals[axis][i];
+                prev[axis] = value;
+            }
+        }
+
+        int width[3];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            width[axis] = BitWidth(combined[axis]);
+        }
+
+        const size_t block_bytes = (WIDTH_BITS * 3 + count * (width[0] + width[1] + width[2]) + 7) / 8;
+        if (m_chunks.empty() || m_chunks.back().size + block_bytes > max_chunk_bytes)
+        {
+            ChunkRange chunk;
+            chunk.first_node = block_first;
+            chunk.num_nodes = 0;
+            chunk.offset = m_payload.size();
+            chunk.size = 0;
+            m_chunks.push_back(chunk);
+        }
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            writer.Write(static_cast<uint32_t>(width[axis]), WIDTH_BITS);
+        }
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (width[axis] == 0)
+                continue;
+            for (int i = 0; i < count; ++i)
+            {
+                writer.Write(residuals[axis][i], width[axis]);
+            }
+        }
+        writer.Align();
+
+        m_chunks.back().num_nodes += count;
+        m_chunks.back().size += block_bytes;
+    }
+}
+
+NodeStreamEncoder::Chunk NodeStreamEncoder::GetChunk(size_t i) const
+{
+    Chunk chunk;
+    chunk.first_node = m_chunks[i].first_node;
+    chunk.num_nodes  = m_chunks[i].num_nodes;
+    chunk.data       = m_payload.data() + m_chunks[i].offset;
+    chunk.size       = m_chunks[i].size;
+    return chunk;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Decoder
+
+void NodeStreamDecoder::Resize(int num_nodes)
+{
+    m_num_nodes = num_nodes;
+    m_output.assign(num_nodes * 3, 0);
+    m_keyframe.assign(num_nodes * 3, 0);
+    m_has_keyframe = false;
+    m_asm_next_node = -1;
+}
+
+NodeStreamDecoder::Result NodeStreamDecoder::DecodeChunk(int32_t time, const RoRnet::NodeStreamHeader& header, const uint8_t* data, size_t size)
+{
+    const int B = NodeStreamCodec::BLOCK_NODES;
+    const int first = header.first_node;
+    const int count = header.num_nodes;
+    const bool is_keyframe = (header.flags & RoRnet::NODESTREAM_KEYFRAME) != 0;
+    const bool is_last = (header.flags & RoRnet::NODESTREAM_LAST_CHUNK) != 0;
+
+    if (header.magic != RORNET_NODESTREAM_MAGIC || count <= 0 || (first % B) != 0 ||
+        first + count > m_num_nodes || (is_last != (first + count == m_num_nodes)) || (!is_last && (count % B) != 0))
+    {
+        m_asm_next_node = -1;
+        return Result::MISMATCH;
+    }
+
+    if (first == 0)
+    {
+        m_asm_time = time;
+        m_asm_keyframe = is_keyframe;
+        m_asm_prev[0] = m_asm_prev[1] = m_asm_prev[2] = 0;
+    }
+    else if (first != m_asm_next_node || time != m_asm_time || is_keyframe != m_asm_keyframe)
+    {
+        m_asm_next_node = -1; // Lost a chunk - wait for the next update
+        return Result::PENDING;
+    }
+
+    if (!is_keyframe && (!m_has_keyframe || header.keyframe_id != m_keyframe_id))
+    {
+        m_asm_next_node = -1; // Missed the keyframe - wait for the next one
+        return Result::PENDING;
+    }
+
+    const int32_t* reference = (is_keyframe) ? nullptr : m_keyframe.data();
+    BitReader reader(data, size);
+    for (int block_first = first; block_first < first + count; block_first += B)
+    {
+        const int block_count = std::min(B, first + count - block_first);
+        int width[3];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            width[axis] = static_cast<int>(reader.Read(WIDTH_BITS));
+        }
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            int32_t value = m_asm_prev[axis];
+            for (int i = 0; i < block_count; ++i)
+            {
+                const int idx = (block_first + i) * 3 + axis;
+                if (width[axis] != 0)
+                {
+                    value += UnZigZag(reader.Read(width[axis]));
+                }
+                m_output[idx] = (reference != nullptr) ? (value + reference[idx]) : value;
+            }
+            m_asm_prev[axis] = value;
+        }
+        reader.Align();
+    }
+
+    if (reader.br_overrun)
+    {
+        m_asm_next_node = -1;
+        return Result::MISMATCH;
+    }
+
+    if (!is_last)
+    {
+        m_asm_next_node = first + count;
+        return Result::PENDING;
+    }
+
+    m_asm_next_node = -1;
+    if (is_keyframe)
+    {
+        std::copy(m_output.begin(), m_output.end(), m_keyframe.begin());
+        m_keyframe_id = header.keyframe_id;
+        m_has_keyframe = true;
+    }
+    return Result::COMPLETE;
+}
+
+bool RoR::IsDiscardableStreamData(const char* data, size_t size)
+{
+    if (size < sizeof(RoRnet::VehicleState) + sizeof(RoRnet::NodeStreamHeader))
+        return true;
+
+    RoRnet::NodeStreamHeader header;
+    std::memcpy(&header, data + sizeof(RoRnet::VehicleState), sizeof(RoRnet::NodeStreamHeader));
+    if (header.magic != RORNET_NODESTREAM_MAGIC)
+        return true;
+
+    return !(header.flags & RoRnet::NODESTREAM_KEYFRAME) && (header.first_node == 0) && (header.flags & RoRnet::NODESTREAM_LAST_CHUNK);
+}
+
+
+// ---------------------------------------- Harness ----------------------------------------
+
+struct Vec3 { float x, y, z; };
+
+/// Box lattice, `nx * ny * nz` nodes, 0.3m spacing; node order follows the lattice like a truckfile would.
+static std::vector<Vec3> MakeTruck(int nx, int ny, int nz)
+{
+    std::vector<Vec3> nodes;
+    for (int x = 0; x < nx; ++x)
+        for (int z = 0; z < nz; ++z)
+            for (int y = 0; y < ny; ++y)
+                nodes.push_back(Vec3{x * 0.3f, y * 0.3f, z * 0.3f});
+    return nodes;
+}
+
+/// Pose at update `t` (10 updates per second): driving a curve at ~15 m/s, body vibrating slightly.
+static void PoseTruck(const std::vector<Vec3>& rest, int t, std::vector<Vec3>& out)
+{
+    const float yaw = t * 0.02f;
+    const float c = std::cos(yaw), s = std::sin(yaw);
+    const Vec3 pos{t * 1.5f * c, 0.f, t * 1.5f * s};
+    out.resize(rest.size());
+    for (size_t i = 0; i < rest.size(); ++i)
+    {
+        const float wobble = 0.004f * std::sin(t * 1.3f + i * 0.37f);
+        const Vec3& r = rest[i];
+        out[i] = Vec3{pos.x + c * r.x - s * r.z + wobble, pos.y + r.y + wobble, pos.z + s * r.x + c * r.z};
+    }
+}
+
+static float Compression(const std::vector<Vec3>& rest)
+{
+    float max_dim = 1.f;
+    for (const Vec3& v : rest)
+        max_dim = std::max(max_dim, std::max(v.x, std::max(v.y, v.z)));
+    return 32767 / std::ceil(max_dim * 1.5f);
+}
+
+static const size_t MAX_PAYLOAD = RORNET_MAX_MESSAGE_LENGTH - sizeof(RoRnet::Header);
+static const int    NUM_WHEELS = 4;
+
+static void Bench_NodeStream_Legacy(benchmark::State& state)
+{
+    const std::vector<Vec3> rest = MakeTruck(static_cast<int>(state.range(0)), 4, 6);
+    const float compression = Compression(rest);
+    std::vector<Vec3> pose;
+    std::vector<char> packet(sizeof(RoRnet::VehicleState) + 12 + (rest.size() - 1) * 6 + NUM_WHEELS * 4);
+    std::vector<Vec3> decoded(rest.size());
+    size_t bytes = 0;
+    int t = 0;
+    while (state.KeepRunning())
+    {
+        PoseTruck(rest, t++, pose);
+        char* ptr = packet.data() + sizeof(RoRnet::VehicleState);
+        std::memcpy(ptr, &pose[0], 12);
+        short* sbuf = reinterpret_cast<short*>(ptr + 12);
+        for (size_t i = 1; i < pose.size(); ++i)
+        {
+            sbuf[(i - 1) * 3 + 0] = (short)((pose[i].x - pose[0].x) * compression);
+            sbuf[(i - 1) * 3 + 1] = (short)((pose[i].y - pose[0].y) * compression);
+            sbuf[(i - 1) * 3 + 2] = (short)((pose[i].z - pose[0].z) * compression);
+        }
+        for (size_t i = 1; i < pose.size(); ++i)
+        {
+            decoded[i].x = pose[0].x + sbuf[(i - 1) * 3 + 0] / compression;
+            decoded[i].y = pose[0].y + sbuf[(i - 1) * 3 + 1] / compression;
+            decoded[i].z = pose[0].z + sbuf[(i - 1) * 3 + 2] / compression;
+        }
+        benchmark::DoNotOptimize(decoded.data());
+        // Over the limit the old code calls exit(126); count it anyway for comparison
+        bytes += packet.size() + sizeof(RoRnet::Header);
+    }
+    state.counters["nodes"] = static_cast<double>(rest.size());
+    state.counters["bytes_per_update"] = static_cast<double>(bytes) / state.iterations();
+}
+BENCHMARK(Bench_NodeStream_Legacy)->Arg(10)->Arg(40)->Arg(160);
+
+static void Bench_NodeStream_Codec(benchmark::State& state)
+{
+    const std::vector<Vec3> rest = MakeTruck(static_cast<int>(state.range(0)), 4, 6);
+    const int num_nodes = static_cast<int>(rest.size());
+    const float compression = Compression(rest);
+    std::vector<Vec3> pose;
+    std::vector<char> packet(MAX_PAYLOAD);
+    std::vector<Vec3> decoded(rest.size());
+
+    RoR::NodeStreamEncoder encoder;
+    RoR::NodeStreamDecoder decoder;
+    encoder.Resize(num_nodes);
+    decoder.Resize(num_nodes);
+
+    const size_t header_bytes = sizeof(RoRnet::VehicleState) + sizeof(RoRnet::NodeStreamHeader);
+    size_t bytes = 0;
+    size_t packets = 0;
+    int t = 0;
+    int errors = 0;
+    while (state.KeepRunning())
+    {
+        PoseTruck(rest, t, pose);
+        int32_t* q = encoder.GetInput();
+        for (int i = 0; i < num_nodes; ++i)
+        {
+            q[i * 3 + 0] = RoR::NodeStreamCodec::Quantize(pose[i].x - pose[0].x, compression);
+            q[i * 3 + 1] = RoR::NodeStreamCodec::Quantize(pose[i].y - pose[0].y, compression);
+            q[i * 3 + 2] = RoR::NodeStreamCodec::Quantize(pose[i].z - pose[0].z, compression);
+        }
+        encoder.Encode(MAX_PAYLOAD - header_bytes - NUM_WHEELS * sizeof(float));
+
+        for (size_t c = 0; c < encoder.GetNumChunks(); ++c)
+        {
+            const RoR::NodeStreamEncoder::Chunk chunk = encoder.GetChunk(c);
+            const bool is_last = (c + 1 == encoder.GetNumChunks());
+            RoRnet::NodeStreamHeader header;
+            std::memset(&header, 0, sizeof(header));
+            header.refpos[0] = pose[0].x;
+            header.refpos[1] = pose[0].y;
+            header.refpos[2] = pose[0].z;
+            header.first_node = static_cast<uint16_t>(chunk.first_node);
+            header.num_nodes = static_cast<uint16_t>(chunk.num_nodes);
+            header.magic = RORNET_NODESTREAM_MAGIC;
+            header.keyframe_id = encoder.GetKeyframeId();
+            header.flags = (encoder.IsKeyframe() ? RoRnet::NODESTREAM_KEYFRAME : 0) | (is_last ? RoRnet::NODESTREAM_LAST_CHUNK : 0);
+            std::memcpy(packet.data() + sizeof(RoRnet::VehicleState), &header, sizeof(header));
+            std::memcpy(packet.data() + header_bytes, chunk.data, chunk.size);
+            const size_t len = header_bytes + chunk.size + (is_last ? NUM_WHEELS * sizeof(float) : 0);
+            bytes += len + sizeof(RoRnet::Header);
+            packets++;
+
+            // Receive
+            RoRnet::NodeStreamHeader rx_header;
+            std::memcpy(&rx_header, packet.data() + sizeof(RoRnet::VehicleState), sizeof(rx_header));
+            const RoR::NodeStreamDecoder::Result res = decoder.DecodeChunk(t,
+                rx_header, reinterpret_cast<const uint8_t*>(packet.data() + header_bytes), chunk.size);
+            if (res == RoR::NodeStreamDecoder::Result::COMPLETE)
+            {
+                const int32_t* out = decoder.GetOutput();
+                for (int i = 0; i < num_nodes; ++i)
+                {
+                    decoded[i].x = rx_header.refpos[0] + out[i * 3 + 0] / compression;
+                    decoded[i].y = rx_header.refpos[1] + out[i * 3 + 1] / compression;
+                    decoded[i].z = rx_header.refpos[2] + out[i * 3 + 2] / compression;
+                }
+                errors += (std::memcmp(out, q, num_nodes * 3 * sizeof(int32_t)) != 0);
+            }
+            else if (is_last)
+            {
+                errors++;
+            }
+        }
+        benchmark::DoNotOptimize(decoded.data());
+        t++;
+    }
+    state.counters["nodes"] = static_cast<double>(num_nodes);
+    state.counters["bytes_per_update"] = static_cast<double>(bytes) / state.iterations();
+    state.counters["packets_per_update"] = static_cast<double>(packets) / state.iterations();
+    if (errors != 0)
+    {
+        state.SkipWithError("Decoded positions differ from the input");
+    }
+}
+BENCHMARK(Bench_NodeStream_Codec)->Arg(10)->Arg(40)->Arg(160);
+
+BENCHMARK_MAIN();
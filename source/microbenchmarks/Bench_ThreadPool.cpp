@@ -0,0 +1,704 @@
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Compares the original mutex/condvar ThreadPool (single shared queue, heap-allocated
+// `shared_ptr<Task>` per task) against the work-stealing ThreadPool (per-worker deques,
+// recycled tasks, fork/join Parallelize()) on empty and small tasks.
+// Both implementations are copied from 'source/main/threadpool/ThreadPool.h' (before and after the rewrite),
+// minus `DetectNumWorkersAndCreate()` which needs the app's CVars, and with `ROR_ASSERT` replaced by `assert`.
+
+namespace Legacy {
+
+
+/** /brief Handle for a task executed by ThreadPool
+ *
+ * Returned by ThreadPool instance when submitting a new task to run.
+ * Provides a thin wrapper around the callable object which implements the actual task.
+ * Allows for synchronization, i.e. to wait for the associated task to finish (see join()).
+ *
+ * \see ThreadPool
+ */
+class Task
+{
+    friend class ThreadPool;
+    public:
+    /// Block the current thread and wait for the associated task to finish.
+    void join() const
+    {
+        // Wait until the tasks is_finished property is set to true by the ThreadPool instance.
+        // Three possible scenarios:
+        // 1) Execution of task has not started yet
+        //    - locks task_mutex
+        //    - is_finished will be false
+        //    - therefore unlocks task_mutex again and waits until signaled by thread pool
+        //    - then is_finished will be true (except in case of spurious wakeups for which the waiting continues)
+        // 2) Task is being executed
+        //    - will try to lock task_mutex, but will fail
+        //    - task_mutex is locked while the task is still running
+        //    - is_finished will be true after aquiring the lock
+        // 3) Task has already finished execution
+        //    - locks task_mutex
+        //    - is_finished will be true
+        std::unique_lock<std::mutex> lock(m_task_mutex);
+        m_finish_cv.wait(lock, [this]{ return m_is_finished; });
+    }
+
+    private:
+    // Only constructable by friend class ThreadPool
+    Task(std::function<void()> task_func) : m_task_func(task_func) {}
+    Task(Task &) = delete;
+    Task & operator=(Task &) = delete;
+
+    bool m_is_finished = false;                   //!< Indicates whether the task execution has finished.
+    mutable std::condition_variable m_finish_cv;  //!< Used to signal the current thread when the task has finished.
+    mutable std::mutex m_task_mutex;              //!< Mutex which is locked while the task is running.
+    const std::function<void()> m_task_func;      //!< Callable object which implements the task to execute.
+};
+
+/** \brief Facilitates execution of (small) tasks on separate threads.
+ *
+ * Implements a "rent-a-thread" model where each submitted task is assigned to one of several worker threads managed by the thread pool instance.
+ * This is especially useful for short running tasks as it avoids the runtime cost of creating and launching a new thread. Notice, there
+ * still is a certain overhead present due to the synchronization of threads required in the internal implementation.
+ *
+ * Usage example 1:
+ * \code
+ *  ThreadPool tp;
+ *  auto task_handle = tp.RunTask([]{ SomeWork() };  // Start asynchronous task
+ *  SomeOtherWork();
+ *  task_handle.join(); // Wait for async task to finish
+ * \endcode
+ *
+ * Usage example 2:
+ * \code
+ *  ThreadPool tp;
+ *  auto task1 = []{ ... };
+ *  auto task2 = std::bind(my_func, arg1, arg2);
+ *  tp.Parallelize({task1, task2});  // Run tasks in parallel and wait until all have finished
+ * \endcode
+ *
+ * \see Task
+ */
+class ThreadPool {
+public:
+    /** \brief Construct thread pool and launch worker threads.
+     *
+     * @param num_threads Number of worker threads to use
+     */
+    ThreadPool(int num_threads)
+    {
+        assert(num_threads > 0);
+
+        // Generic function (to be run on a separate thread) within which submitted tasks
+        // are executed. It implements an endless loop (only returning when the ThreadPool
+        // instance itself is destructed) which constantly checks the task queue, grabbing
+        // and executing the frontmost task while the queue is not empty.
+        auto thread_body = [this]{ 
+            while (true) {
+                // Get next task from queue (synchronized access via taskqueue_mutex).
+                // If the queue is empty wait until either
+                //   - being signaled about an available task.
+                //   - the terminate flag is true (i.e. the ThreadPool instance is being destructed).
+                //     In this case return from the running thread.
+                std::unique_lock<std::mutex> queue_lock(m_taskqueue_mutex);
+                while (m_taskqueue.empty()) {
+                    if (m_terminate.load()) { return; }
+                    m_task_available_cv.wait(queue_lock);
+                }
+                const auto current_task = m_taskqueue.front();
+                m_taskqueue.pop();
+                queue_lock.unlock();
+
+                // Execute the actual task and signal the associated Task instance when finished.
+                {
+                    std::lock_guard<std::mutex> task_lock(current_task->m_task_mutex);
+                    current_task->m_task_func();
+                    current_task->m_is_finished = true;
+                }
+                current_task->m_finish_cv.notify_all();
+            }
+        };
+
+        // Launch the specified number of threads
+        for (int i = 0; i < num_threads; ++i) {
+            m_threads.emplace_back(thread_body);
+        }
+    }
+
+    ~ThreadPool() {
+        // Indicate termination and signal potential waiting threads to wake up.
+        // Then wait for all threads to finish their work and return properly.
+        m_terminate = true;
+        m_task_available_cv.notify_all();
+        for (auto &t : m_threads) { t.join(); }
+    }
+
+    /// Submit new asynchronous task to thread pool and return Task handle to allow for synchronization.
+    std::shared_ptr<Task> RunTask(const std::function<void()> &task_func) {
+        // Wrap provided task callable object in task handle. Then append it to the task queue and
+        // notify a waiting worker thread (if any) about the newly available task
+        auto task = std::shared_ptr<Task>(new Task(task_func));
+        {
+            std::lock_guard<std::mutex> lock(m_taskqueue_mutex);
+            m_taskqueue.push(task);
+        }
+        m_task_available_cv.notify_one();
+
+        // Return task handle for later synchronization
+        return task;
+    }
+
+    /// Run collection of tasks in parallel and wait until all have finished.
+    void Parallelize(const std::vector<std::function<void()>> &task_funcs)
+    {
+        if (task_funcs.empty()) return;
+
+        // Launch all provided tasks (except for the first) in parallel and store the associated handles
+        auto it = begin(task_funcs);
+        const auto first_task = it++;
+        std::vector<std::shared_ptr<Task>> handles;
+        for(; it != end(task_funcs); ++it)
+        { 
+            handles.push_back(RunTask(*it));
+        }
+
+        // Run the first task locally on the current thread
+        (*first_task)();
+
+        // Synchronize, i.e. wait for all parallelized tasks to complete
+        for(const auto &h : handles) { h->join(); }
+    }
+
+    std::atomic_bool m_terminate{false};            //!< Indicates destruction of ThreadPool instance to worker threads
+    std::vector<std::thread> m_threads;             //!< Collection of worker threads to run tasks
+    std::queue<std::shared_ptr<Task>> m_taskqueue;  //!< Queue of submitted tasks pending for execution
+    std::mutex m_taskqueue_mutex;                   //!< Protects task queue from concurrent access.
+    std::condition_variable m_task_available_cv;    //!< Used to signal threads that a new task was submitted and is ready to run.
+};
+
+} // namespace Legacy
+
+namespace WorkStealing {
+
+class ThreadPool;
+
+/** /brief Task executed by ThreadPool
+ *
+ * Task objects are recycled by the owning ThreadPool instance (see ThreadPool::AllocTask()),
+ * user code only ever deals with them through TaskHandle.
+ *
+ * The task state advances PENDING -> RUNNING -> FINISHED exactly once. Whoever wins the
+ * PENDING -> RUNNING transition (a worker thread or a thread calling join()) executes the task.
+ *
+ * \see TaskHandle
+ */
+class Task
+{
+    friend class ThreadPool;
+    friend class TaskHandle;
+    public:
+    /// Wait for the associated task to finish. If it didn't start yet, run it on the current thread.
+    inline void join() const;
+
+    /// Non-blocking check whether the task function has returned.
+    bool IsFinished() const { return m_state.load(std::memory_order_acquire) == STATE_FINISHED; }
+
+    private:
+    enum State
+    {
+        STATE_PENDING,
+        STATE_RUNNING,
+        STATE_FINISHED
+    };
+
+    // Only constructable by friend class ThreadPool
+    Task(ThreadPool* pool): m_pool(pool) {}
+    Task(Task &) = delete;
+    Task & operator=(Task &) = delete;
+
+    /// Attempt the PENDING -> RUNNING transition, run the task function on success.
+    inline bool TryExecute();
+
+    ThreadPool*            m_pool;                     //!< Owning pool, receives the task back when no longer referenced.
+    std::atomic<int>       m_state{STATE_PENDING};     //!< See enum State
+    std::atomic<int>       m_refcount{0};              //!< Number of TaskHandle instances + 1 while the task sits in a queue.
+    std::function<void()>  m_task_func;                //!< Callable object which implements the task to execute.
+    Task*                  m_next_free = nullptr;      //!< Link in the pool's free list.
+};
+
+/** /brief Handle for a task executed by ThreadPool
+ *
+ * Returned by ThreadPool instance when submitting a new task to run.
+ * Behaves like a (intrusive, non-allocating) shared pointer to the Task.
+ * Allows for synchronization, i.e. to wait for the associated task to finish (see Task::join()).
+ */
+class TaskHandle
+{
+    friend class ThreadPool;
+    public:
+    TaskHandle() {}
+    TaskHandle(const TaskHandle& other): m_task(other.m_task)     { this->AddRef(); }
+    TaskHandle(TaskHandle&& other): m_task(other.m_task)          { other.m_task = nullptr; }
+    ~TaskHandle()                                                 { this->Release(); }
+
+    TaskHandle& operator=(TaskHandle other)                       { std::swap(m_task, other.m_task); return *this; }
+
+    const Task*    operator->() const                             { return m_task; }
+    explicit       operator bool() const                          { return m_task != nullptr; }
+    void           reset()                                        { this->Release(); m_task = nullptr; }
+
+    private:
+    explicit TaskHandle(Task* task): m_task(task)                 { this->AddRef(); }
+
+    void           AddRef()                                       { if (m_task) { m_task->m_refcount.fetch_add(1, std::memory_order_relaxed); } }
+    inline void    Release();
+
+    Task*          m_task = nullptr;
+};
+
+/** \brief Facilitates execution of (small) tasks on separate threads.
+ *
+ * Implements a "rent-a-thread" model where each submitted task is assigned to one of several worker threads managed by the thread pool instance.
+ * This is especially useful for short running tasks as it avoids the runtime cost of creating and launching a new thread.
+ *
+ * Scheduling is work-stealing: every worker owns a task deque. Tasks submitted from a worker go to the back of its own deque,
+ * tasks submitted from outside are distributed round-robin. Workers pop their own deque from the back (LIFO, cache-warm)
+ * and steal from the front of other workers' deques when idle. Idle workers sleep on a condition variable only after a short
+ * spin, so bursts of small tasks (i.e. physics steps) don't pay for a kernel round-trip every time.
+ *
+ * Destruction runs all tasks which are still queued, then stops the worker threads. Task objects are owned by the pool,
+ * so no TaskHandle may outlive it, and no tasks may be submitted from other threads while it's being destroyed.
+ *
+ * Usage example 1:
+ * \code
+ *  ThreadPool tp;
+ *  auto task_handle = tp.RunTask([]{ SomeWork() };  // Start asynchronous task
+ *  SomeOtherWork();
+ *  task_handle->join(); // Wait for async task to finish
+ * \endcode
+ *
+ * Usage example 2:
+ * \code
+ *  ThreadPool tp;
+ *  auto task1 = []{ ... };
+ *  auto task2 = std::bind(my_func, arg1, arg2);
+ *  tp.Parallelize({task1, task2});  // Run tasks in parallel and wait until all have finished
+ * \endcode
+ *
+ * \see Task
+ */
+class ThreadPool {
+    friend class Task;
+    friend class TaskHandle;
+public:
+    /** \brief Construct thread pool and launch worker threads.
+     *
+     * @param num_threads Number of worker threads to use
+     */
+    ThreadPool(int num_threads)
+        : m_queues(num_threads)
+    {
+        assert(num_threads > 0);
+
+        // Launch the specified number of threads
+        for (int i = 0; i < num_threads; ++i) {
+            m_threads.emplace_back([this, i]{ this->WorkerThreadBody(i); });
+        }
+    }
+
+    ~ThreadPool() {
+        // Indicate termination and signal potential waiting threads to wake up.
+        // Then wait for all threads to drain the queues and return properly.
+        {
+            std::lock_guard<std::mutex> lock(m_idle_mutex);
+            m_terminate = true;
+        }
+        m_idle_cv.notify_all();
+        for (auto &t : m_threads) { t.join(); }
+
+        // Free the recycled task objects - by now, all of them must be back in the free list.
+        int num_freed = 0;
+        while (m_free_tasks != nullptr)
+        {
+            Task* t = m_free_tasks;
+            m_free_tasks = t->m_next_free;
+            delete t;
+            num_freed++;
+        }
+        assert(num_freed == m_num_tasks); // Otherwise a TaskHandle outlives the pool
+    }
+
+    /// Submit new asynchronous task to thread pool and return Task handle to allow for synchronization.
+    TaskHandle RunTask(const std::function<void()> &task_func) {
+        Task* task = this->AllocTask();
+        task->m_task_func = task_func;
+        TaskHandle handle(task); // Reference held by the caller
+        this->Submit(task);      // Reference held by the queue
+        return handle;
+    }
+
+    /** \brief Run collection of tasks in parallel and wait until all have finished.
+     *
+     * Fork/join: the tasks are not copied; a handful of helper jobs (at most one per worker)
+     * claim task indices from a shared counter, and the calling thread claims indices too
+     * instead of idling until the helpers finish.
+     */
+    void Parallelize(const std::vector<std::function<void()>> &task_funcs)
+    {
+        if (task_funcs.empty()) return;
+
+        if (task_funcs.size() == 1)
+        {
+            task_funcs[0]();
+            return;
+        }
+
+        std::atomic<size_t> next_index{0};
+        auto run_batch = [&task_funcs, &next_index]
+        {
+            for (size_t i = next_index++; i < task_funcs.size(); i = next_index++)
+            {
+                task_funcs[i]();
+            }
+        };
+
+        // Launch helpers; the calling thread counts as one of the participants.
+        const size_t num_helpers = std::min(task_funcs.size() - 1, m_threads.size());
+        TaskHandle helpers[MAX_PARALLELIZE_HELPERS];
+        const size_t num_handles = std::min(num_helpers, (size_t)MAX_PARALLELIZE_HELPERS);
+        for (size_t i = 0; i < num_handles; ++i)
+        {
+            helpers[i] = this->RunTask(run_batch);
+        }
+
+        // Help out on the current thread
+        run_batch();
+
+        // Synchronize - helpers which didn't start yet are run inline (the batch is already drained, so they return immediately).
+        // This also guarantees no helper touches `next_index` after we return.
+        for (size_t i = 0; i < num_handles; ++i) { helpers[i]->join(); }
+    }
+
+    size_t GetNumWorkers() const { return m_threads.size(); }
+
+private:
+    static const int SPIN_COUNT = 64;               //!< Iterations a thread spins (yielding) before going to sleep.
+    static const int MAX_PARALLELIZE_HELPERS = 64;  //!< Upper bound of helper jobs spawned by a single Parallelize() call.
+
+    struct WorkerQueue
+    {
+        std::mutex          wq_mutex;  //!< Short critical sections only; contended by the owner and occasional thieves.
+        std::deque<Task*>   wq_tasks;
+    };
+
+    void WorkerThreadBody(int worker_index)
+    {
+        CurrentPool() = this;
+        CurrentWorkerIndex() = worker_index;
+
+        while (true)
+        {
+            Task* task = this->FindTask(worker_index);
+            if (task != nullptr)
+            {
+                this->ExecuteQueuedTask(task);
+                continue;
+            }
+
+            // Nothing to do - spin a little before parking the thread.
+            for (int i = 0; i < SPIN_COUNT && task == nullptr; ++i)
+            {
+                std::this_thread::yield();
+                if (m_num_pending.load() > 0)
+                {
+                    task = this->FindTask(worker_index);
+                }
+            }
+            if (task != nullptr)
+            {
+                this->ExecuteQueuedTask(task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> idle_lock(m_idle_mutex);
+            m_num_sleeping++;
+            while (m_num_pending.load() == 0 && !m_terminate)
+            {
+                m_idle_cv.wait(idle_lock);
+            }
+            m_num_sleeping--;
+            if (m_terminate && m_num_pending.load() == 0)
+            {
+                return; // Only once the queues are drained
+            }
+        }
+    }
+
+    /// Pop from own queue (back), else steal from the others (front).
+    Task* FindTask(int worker_index)
+    {
+        const int num_queues = static_cast<int>(m_queues.size());
+        for (int i = 0; i < num_queues; ++i)
+        {
+            const int qi = (worker_index + i) % num_queues;
+            WorkerQueue& q = m_queues[qi];
+            std::lock_guard<std::mutex> lock(q.wq_mutex);
+            if (!q.wq_tasks.empty())
+            {
+                Task* task = nullptr;
+                if (i == 0)
+                {
+                    task = q.wq_tasks.back();
+                    q.wq_tasks.pop_back();
+                }
+                else
+                {
+                    task = q.wq_tasks.front();
+                    q.wq_tasks.pop_front();
+                }
+                m_num_pending--;
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    void Submit(Task* task)
+    {
+        task->m_refcount.fetch_add(1, std::memory_order_relaxed);
+
+        // Prefer the submitting worker's own queue, distribute external submissions round-robin.
+        const size_t qi = (CurrentPool() == this)
+            ? static_cast<size_t>(CurrentWorkerIndex())
+            : (m_next_queue++ % m_queues.size());
+        {
+            std::lock_guard<std::mutex> lock(m_queues[qi].wq_mutex);
+            m_queues[qi].wq_tasks.push_back(task);
+        }
+        m_num_pending++;
+
+        // Only touch the idle mutex if somebody is (about to be) asleep.
+        // Pairs with the increment of `m_num_sleeping` + re-check of `m_num_pending` in WorkerThreadBody().
+        if (m_num_sleeping.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(m_idle_mutex);
+            m_idle_cv.notify_one();
+        }
+    }
+
+    void ExecuteQueuedTask(Task* task)
+    {
+        task->TryExecute(); // Fails if a joining thread already claimed the task - nothing to do then.
+        this->ReleaseTask(task);
+    }
+
+    void NotifyTaskFinished()
+    {
+        // Pairs with the increment of `m_num_joining` + re-check of task state in WaitForTask().
+        if (m_num_joining.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(m_finish_mutex);
+            m_finish_cv.notify_all();
+        }
+    }
+
+    void WaitForTask(const Task* task)
+    {
+        for (int i = 0; i < SPIN_COUNT; ++i)
+        {
+            if (task->m_state.load() == Task::STATE_FINISHED) { return; }
+            std::this_thread::yield();
+        }
+
+        std::unique_lock<std::mutex> lock(m_finish_mutex);
+        m_num_joining++;
+        while (task->m_state.load() != Task::STATE_FINISHED)
+        {
+            m_finish_cv.wait(lock);
+        }
+        m_num_joining--;
+    }
+
+    Task* AllocTask()
+    {
+        std::lock_guard<std::mutex> lock(m_free_tasks_mutex);
+        if (m_free_tasks != nullptr)
+        {
+            Task* task = m_free_tasks;
+            m_free_tasks = task->m_next_free;
+            task->m_next_free = nullptr;
+            task->m_state.store(Task::STATE_PENDING, std::memory_order_relaxed);
+            return task;
+        }
+        m_num_tasks++;
+        return new Task(this);
+    }
+
+    void ReleaseTask(Task* task)
+    {
+        if (task->m_refcount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            task->m_task_func = nullptr; // Free the captures right away
+            std::lock_guard<std::mutex> lock(m_free_tasks_mutex);
+            task->m_next_free = m_free_tasks;
+            m_free_tasks = task;
+        }
+    }
+
+    std::vector<std::thread>     m_threads;                 //!< Collection of worker threads to run tasks
+    std::vector<WorkerQueue>     m_queues;                  //!< One task deque per worker thread
+    std::atomic<size_t>          m_next_queue{0};           //!< Round-robin counter for submissions from non-worker threads
+    std::atomic<int>             m_num_pending{0};          //!< Number of tasks sitting in queues
+    std::atomic<int>             m_num_sleeping{0};         //!< Number of workers (about to be) parked on `m_idle_cv`
+    std::atomic<int>             m_num_joining{0};          //!< Number of threads (about to be) parked on `m_finish_cv`
+    bool                         m_terminate = false;       //!< Indicates destruction of ThreadPool instance to worker threads; protected by `m_idle_mutex`
+    std::mutex                   m_idle_mutex;
+    std::condition_variable      m_idle_cv;                 //!< Used to signal threads that a new task was submitted and is ready to run.
+    std::mutex                   m_finish_mutex;
+    std::condition_variable      m_finish_cv;               //!< Used to signal joining threads that a task has finished.
+    std::mutex                   m_free_tasks_mutex;
+    Task*                        m_free_tasks = nullptr;    //!< Recycled task objects (singly linked list)
+    int                          m_num_tasks = 0;           //!< Task objects allocated so far; protected by `m_free_tasks_mutex`
+
+    /// Pool owning the current thread (nullptr for non-worker threads)
+    static ThreadPool*& CurrentPool()        { static thread_local ThreadPool* pool = nullptr; return pool; }
+    /// Index of the current worker thread within `CurrentPool()`
+    static int&         CurrentWorkerIndex() { static thread_local int index = -1; return index; }
+};
+
+// ------------------------------------------------------------------------------------------------
+// Inline definitions
+
+bool Task::TryExecute()
+{
+    int expected = STATE_PENDING;
+    if (!m_state.compare_exchange_strong(expected, STATE_RUNNING))
+    {
+        return false;
+    }
+    m_task_func();
+    m_state.store(STATE_FINISHED);
+    m_pool->NotifyTaskFinished();
+    return true;
+}
+
+void Task::join() const
+{
+    // Three possible scenarios:
+    // 1) Execution of task has not started yet - claim it and run it right here.
+    // 2) Task is being executed by a worker - spin briefly, then sleep until signaled by the thread pool.
+    // 3) Task has already finished execution - return right away.
+    if (!const_cast<Task*>(this)->TryExecute())
+    {
+        m_pool->WaitForTask(this);
+    }
+}
+
+void TaskHandle::Release()
+{
+    if (m_task)
+    {
+        m_task->m_pool->ReleaseTask(m_task);
+    }
+}
+
+} // namespace WorkStealing
+
+const int NUM_WORKERS = 4;
+std::atomic<int> g_counter{0};
+
+void EmptyTask() {}
+
+void SmallTask()
+{
+    // Roughly the cost of a tiny actor's step - a few hundred flops
+    float acc = 0.f;
+    for (int i = 0; i < 200; ++i)
+    {
+        acc += (float)i * 0.5f;
+    }
+    g_counter += (int)acc & 1;
+}
+
+template <typename POOL>
+static void Bench_Parallelize(benchmark::State& state, POOL& pool, void(*func)())
+{
+    std::vector<std::function<void()>> tasks(state.range(0), func);
+    while (state.KeepRunning())
+    {
+        pool.Parallelize(tasks);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static Legacy::ThreadPool*       g_legacy_pool = nullptr;
+static WorkStealing::ThreadPool* g_ws_pool = nullptr;
+
+static void Bench_Legacy_Parallelize_Empty(benchmark::State& state)       { Bench_Parallelize(state, *g_legacy_pool, EmptyTask); }
+static void Bench_WorkStealing_Parallelize_Empty(benchmark::State& state) { Bench_Parallelize(state, *g_ws_pool, EmptyTask); }
+static void Bench_Legacy_Parallelize_Small(benchmark::State& state)       { Bench_Parallelize(state, *g_legacy_pool, SmallTask); }
+static void Bench_WorkStealing_Parallelize_Small(benchmark::State& state) { Bench_Parallelize(state, *g_ws_pool, SmallTask); }
+
+BENCHMARK(Bench_Legacy_Parallelize_Empty)->Arg(2)->Arg(8)->Arg(24)->Arg(80);
+BENCHMARK(Bench_WorkStealing_Parallelize_Empty)->Arg(2)->Arg(8)->Arg(24)->Arg(80);
+BENCHMARK(Bench_Legacy_Parallelize_Small)->Arg(2)->Arg(8)->Arg(24)->Arg(80);
+BENCHMARK(Bench_WorkStealing_Parallelize_Small)->Arg(2)->Arg(8)->Arg(24)->Arg(80);
+
+// Submit a whole batch before joining, so the workers pick up the tasks
+// (joining right after RunTask() would just run the task inline in the work-stealing pool).
+template <typename POOL>
+static void Bench_RunTaskJoin(benchmark::State& state, POOL& pool)
+{
+    std::vector<decltype(pool.RunTask(SmallTask))> handles(state.range(0));
+    while (state.KeepRunning())
+    {
+        for (auto& handle : handles)
+        {
+            handle = pool.RunTask(SmallTask);
+        }
+        for (auto& handle : handles)
+        {
+            handle->join();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void Bench_Legacy_RunTaskJoin(benchmark::State& state)       { Bench_RunTaskJoin(state, *g_legacy_pool); }
+static void Bench_WorkStealing_RunTaskJoin(benchmark::State& state) { Bench_RunTaskJoin(state, *g_ws_pool); }
+
+BENCHMARK(Bench_Legacy_RunTaskJoin)->Arg(8)->Arg(80);
+BENCHMARK(Bench_WorkStealing_RunTaskJoin)->Arg(8)->Arg(80);
+
+int main(int argc, char** argv)
+{
+    using namespace std;
+
+    // prepare
+    cout << "Preparing..." << endl;
+    g_legacy_pool = new Legacy::ThreadPool(NUM_WORKERS);
+    g_ws_pool = new WorkStealing::ThreadPool(NUM_WORKERS);
+
+    // benchmark
+    ::benchmark::Initialize(&argc, argv);
+    ::benchmark::RunSpecifiedBenchmarks();
+
+    delete g_legacy_pool;
+    delete g_ws_pool;
+#ifdef _MSC_VER
+    system("pause");
+#endif
+    return g_counter.load() & 1;
+}
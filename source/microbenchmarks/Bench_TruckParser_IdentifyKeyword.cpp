@@ -1,5 +1,7 @@
 
 #include "benchmark/benchmark.h"
+#include <climits>
+#include <cstring>
 #include <regex>
 #include <iostream>
 
@@ -1451,6 +1453,9 @@ static int keyword;
 
 #define E_DELIMITER_SPACE "[[:blank:]]+"
 
+#define DEFINE_REGEX(_NAME_,_REGEXP_) \
+    const std::regex _NAME_ = std::regex( _REGEXP_, std::regex::ECMAScript);
+
 #define DEFINE_REGEX_IGNORECASE(_NAME_,_REGEXP_) \
     const std::regex _NAME_ = std::regex( _REGEXP_, std::regex::ECMAScript | std::regex::icase);
 
@@ -1646,6 +1651,7 @@ BENCHMARK(Bench_sol1d_RegexPreCondIsAlpha);
 // ################################# Solution 2 - switch ######################################
 
 #ifndef WIN32 
+  #include <strings.h>
   #define stricmp strcasecmp
   #define strnicmp strncasecmp
 #endif
@@ -1841,6 +1847,290 @@ static void Bench_sol2b_SwitchPreCond(benchmark::State& state)
 }
 BENCHMARK(Bench_sol2b_SwitchPreCond);
 
+// ################################# Solution 3 - keyword table ######################################
+// Copied from 'source/main/resources/rig_def_fileformat/RigDef_Parser.cpp'
+
+enum KeywordKind
+{
+    KEYWORD_KIND_BLOCK,            //!< Keyword on it's own line, i.e. "beams"
+    KEYWORD_KIND_INLINE,           //!< Keyword followed by space and values, i.e. "author chassis -1 ..."
+    KEYWORD_KIND_INLINE_TOLERANT,  //!< Like inline, but values can also be delimited by comma
+};
+
+constexpr size_t KeywordStrlen(const char* str)
+{
+    return (*str == '\0') ? 0 : 1 + KeywordStrlen(str + 1);
+}
+
+constexpr char KeywordToLower(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? (c - 'A' + 'a') : c;
+}
+
+struct KeywordEntry
+{
+    constexpr KeywordEntry(const char* _name, KeywordKind _kind): name(_name), length(KeywordStrlen(_name)), kind(_kind) {}
+
+    const char*  name;
+    size_t       length;
+    KeywordKind  kind;
+};
+
+/// Position N holds `File::Keyword` N+1 (enum of RigDef_File.h, not the outdated one above).
+/// Must stay grouped by first letter, the lookup only searches entries with the matching letter.
+static constexpr KeywordEntry KEYWORD_TABLE[] =
+{
+    { "add_animation",                 KEYWORD_KIND_INLINE_TOLERANT  }, // KEYWORD_ADD_ANIMATION
+    { "airbrakes",                     KEYWORD_KIND_BLOCK            }, // KEYWORD_AIRBRAKES
+    { "animators",                     KEYWORD_KIND_BLOCK            }, // KEYWORD_ANIMATORS
+    { "AntiLockBrakes",                KEYWORD_KIND_INLINE           }, // KEYWORD_ANTI_LOCK_BRAKES
+    { "axles",                         KEYWORD_KIND_BLOCK            }, // KEYWORD_AXLES
+    { "author",                        KEYWORD_KIND_INLINE           }, // KEYWORD_AUTHOR
+    { "backmesh",                      KEYWORD_KIND_BLOCK            }, // KEYWORD_BACKMESH
+    { "beams",                         KEYWORD_KIND_BLOCK            }, // KEYWORD_BEAMS
+    { "brakes",                        KEYWORD_KIND_BLOCK            }, // KEYWORD_BRAKES
+    { "cab",                           KEYWORD_KIND_BLOCK            }, // KEYWORD_CAB
+    { "camerarail",                    KEYWORD_KIND_BLOCK            }, // KEYWORD_CAMERARAIL
+    { "cameras",                       KEYWORD_KIND_BLOCK            }, // KEYWORD_CAMERAS
+    { "cinecam",                       KEYWORD_KIND_BLOCK            }, // KEYWORD_CINECAM
+    { "collisionboxes",                KEYWORD_KIND_BLOCK            }, // KEYWORD_COLLISIONBOXES
+    { "commands",                      KEYWORD_KIND_BLOCK            }, // KEYWORD_COMMANDS
+    { "commands2",                     KEYWORD_KIND_BLOCK            }, // KEYWORD_COMMANDS2
+    { "contacters",                    KEYWORD_KIND_BLOCK            }, // KEYWORD_CONTACTERS
+    { "cruisecontrol",                 KEYWORD_KIND_INLINE           }, // KEYWORD_CRUISECONTROL
+    { "description",                   KEYWORD_KIND_BLOCK            }, // KEYWORD_DESCRIPTION
+    { "detacher_group",                KEYWORD_KIND_INLINE           }, // KEYWORD_DETACHER_GROUP
+    { "disabledefaultsounds",          KEYWORD_KIND_BLOCK            }, // KEYWORD_DISABLEDEFAULTSOUNDS
+    { "enable_advanced_deformation",   KEYWORD_KIND_BLOCK            }, // KEYWORD_ENABLE_ADVANCED_DEFORM
+    { "end",                           KEYWORD_KIND_BLOCK            }, // KEYWORD_END
+    { "end_section",                   KEYWORD_KIND_BLOCK            }, // KEYWORD_END_SECTION
+    { "engine",                        KEYWORD_KIND_BLOCK            }, // KEYWORD_ENGINE
+    { "engoption",                     KEYWORD_KIND_BLOCK            }, // KEYWORD_ENGOPTION
+    { "engturbo",                      KEYWORD_KIND_BLOCK            }, // KEYWORD_ENGTURBO
+    { "envmap",                        KEYWORD_KIND_BLOCK            }, // KEYWORD_ENVMAP
+    { "exhausts",                      KEYWORD_KIND_BLOCK            }, // KEYWORD_EXHAUSTS
+    { "extcamera",                     KEYWORD_KIND_INLINE           }, // KEYWORD_EXTCAMERA
+    { "fileformatversion",             KEYWORD_KIND_INLINE           }, // KEYWORD_FILEFORMATVERSION
+    { "fileinfo",                      KEYWORD_KIND_INLINE           }, // KEYWORD_FILEINFO
+    { "fixes",                         KEYWORD_KIND_BLOCK            }, // KEYWORD_FIXES
+    { "flares",                        KEYWORD_KIND_BLOCK            }, // KEYWORD_FLARES
+    { "flares2",                       KEYWORD_KIND_BLOCK            }, // KEYWORD_FLARES2
+    { "flexbodies",                    KEYWORD_KIND_BLOCK            }, // KEYWORD_FLEXBODIES
+    { "flexbody_camera_mode",          KEYWORD_KIND_INLINE           }, // KEYWORD_FLEXBODY_CAMERA_MODE
+    { "flexbodywheels",                KEYWORD_KIND_BLOCK            }, // KEYWORD_FLEXBODYWHEELS
+    { "forwardcommands",               KEYWORD_KIND_BLOCK            }, // KEYWORD_FORWARDCOMMANDS
+    { "fusedrag",                      KEYWORD_KIND_BLOCK            }, // KEYWORD_FUSEDRAG
+    { "globals",                       KEYWORD_KIND_BLOCK            }, // KEYWORD_GLOBALS
+    { "guid",                          KEYWORD_KIND_INLINE           }, // KEYWORD_GUID
+    { "guisettings",                   KEYWORD_KIND_BLOCK            }, // KEYWORD_GUISETTINGS
+    { "help",                          KEYWORD_KIND_BLOCK            }, // KEYWORD_HELP
+    { "hideInChooser",                 KEYWORD_KIND_BLOCK            }, // KEYWORD_HIDE_IN_CHOOSER
+    { "hookgroup",                     KEYWORD_KIND_BLOCK            }, // KEYWORD_HOOKGROUP
+    { "hooks",                         KEYWORD_KIND_BLOCK            }, // KEYWORD_HOOKS
+    { "hydros",                        KEYWORD_KIND_BLOCK            }, // KEYWORD_HYDROS
+    { "importcommands",                KEYWORD_KIND_BLOCK            }, // KEYWORD_IMPORTCOMMANDS
+    { "interaxles",                    KEYWORD_KIND_BLOCK            }, // KEYWORD_INTERAXLES
+    { "lockgroups",                    KEYWORD_KIND_BLOCK            }, // KEYWORD_LOCKGROUPS
+    { "lockgroup_default_nolock",      KEYWORD_KIND_BLOCK            }, // KEYWORD_LOCKGROUP_DEFAULT_NOLOCK
+    { "managedmaterials",              KEYWORD_KIND_BLOCK            }, // KEYWORD_MANAGEDMATERIALS
+    { "materialflarebindings",         KEYWORD_KIND_BLOCK            }, // KEYWORD_MATERIALFLAREBINDINGS
+    { "meshwheels",                    KEYWORD_KIND_BLOCK            }, // KEYWORD_MESHWHEELS
+    { "meshwheels2",                   KEYWORD_KIND_BLOCK            }, // KEYWORD_MESHWHEELS2
+    { "minimass",                      KEYWORD_KIND_BLOCK            }, // KEYWORD_MINIMASS
+    { "nodecollision",                 KEYWORD_KIND_BLOCK            }, // KEYWORD_NODECOLLISION
+    { "nodes",                         KEYWORD_KIND_BLOCK            }, // KEYWORD_NODES
+    { "nodes2",                        KEYWORD_KIND_BLOCK            }, // KEYWORD_NODES2
+    { "particles",                     KEYWORD_KIND_BLOCK            }, // KEYWORD_PARTICLES
+    { "pistonprops",                   KEYWORD_KIND_BLOCK            }, // KEYWORD_PISTONPROPS
+    { "prop_camera_mode",              KEYWORD_KIND_INLINE           }, // KEYWORD_PROP_CAMERA_MODE
+    { "props",                         KEYWORD_KIND_BLOCK            }, // KEYWORD_PROPS
+    { "railgroups",                    KEYWORD_KIND_BLOCK            }, // KEYWORD_RAILGROUPS
+    { "rescuer",                       KEYWORD_KIND_BLOCK            }, // KEYWORD_RESCUER
+    { "rigidifiers",                   KEYWORD_KIND_BLOCK            }, // KEYWORD_RIGIDIFIERS
+    { "rollon",                        KEYWORD_KIND_BLOCK            }, // KEYWORD_ROLLON
+    { "ropables",                      KEYWORD_KIND_BLOCK            }, // KEYWORD_ROPABLES
+    { "ropes",                         KEYWORD_KIND_BLOCK            }, // KEYWORD_ROPES
+    { "rotators",                      KEYWORD_KIND_BLOCK            }, // KEYWORD_ROTATORS
+    { "rotators2",                     KEYWORD_KIND_BLOCK            }, // KEYWORD_ROTATORS2
+    { "screwprops",                    KEYWORD_KIND_BLOCK            }, // KEYWORD_SCREWPROPS
+    { "section",                       KEYWORD_KIND_INLINE           }, // KEYWORD_SECTION
+    { "sectionconfig",                 KEYWORD_KIND_INLINE           }, // KEYWORD_SECTIONCONFIG
+    { "set_beam_defaults",             KEYWORD_KIND_INLINE           }, // KEYWORD_SET_BEAM_DEFAULTS
+    { "set_beam_defaults_scale",       KEYWORD_KIND_INLINE           }, // KEYWORD_SET_BEAM_DEFAULTS_SCALE
+    { "set_collision_range",           KEYWORD_KIND_INLINE           }, // KEYWORD_SET_COLLISION_RANGE
+    { "set_default_minimass",          KEYWORD_KIND_INLINE           }, // KEYWORD_SET_DEFAULT_MINIMASS
+    { "set_inertia_defaults",          KEYWORD_KIND_INLINE           }, // KEYWORD_SET_INERTIA_DEFAULTS
+    { "set_managedmaterials_options",  KEYWORD_KIND_INLINE           }, // KEYWORD_SET_MANAGEDMATS_OPTIONS
+    { "set_node_defaults",             KEYWORD_KIND_INLINE           }, // KEYWORD_SET_NODE_DEFAULTS
+    { "set_shadows",                   KEYWORD_KIND_BLOCK            }, // KEYWORD_SET_SHADOWS
+    { "set_skeleton_settings",         KEYWORD_KIND_INLINE           }, // KEYWORD_SET_SKELETON_SETTINGS
+    { "shocks",                        KEYWORD_KIND_BLOCK            }, // KEYWORD_SHOCKS
+    { "shocks2",                       KEYWORD_KIND_BLOCK            }, // KEYWORD_SHOCKS2
+    { "shocks3",                       KEYWORD_KIND_BLOCK            }, // KEYWORD_SHOCKS3
+    { "slidenode_connect_instantly",   KEYWORD_KIND_BLOCK            }, // KEYWORD_SLIDENODE_CONNECT_INSTANT
+    { "slidenodes",                    KEYWORD_KIND_BLOCK            }, // KEYWORD_SLIDENODES
+    { "SlopeBrake",                    KEYWORD_KIND_INLINE           }, // KEYWORD_SLOPE_BRAKE
+    { "soundsources",                  KEYWORD_KIND_BLOCK            }, // KEYWORD_SOUNDSOURCES
+    { "soundsources2",                 KEYWORD_KIND_BLOCK            }, // KEYWORD_SOUNDSOURCES2
+    { "speedlimiter",                  KEYWORD_KIND_INLINE           }, // KEYWORD_SPEEDLIMITER
+    { "submesh",                       KEYWORD_KIND_BLOCK            }, // KEYWORD_SUBMESH
+    { "submesh_groundmodel",           KEYWORD_KIND_INLINE           }, // KEYWORD_SUBMESH_GROUNDMODEL
+    { "texcoords",                     KEYWORD_KIND_BLOCK            }, // KEYWORD_TEXCOORDS
+    { "ties",                          KEYWORD_KIND_BLOCK            }, // KEYWORD_TIES
+    { "torquecurve",                   KEYWORD_KIND_BLOCK            }, // KEYWORD_TORQUECURVE
+    { "TractionControl",               KEYWORD_KIND_INLINE           }, // KEYWORD_TRACTION_CONTROL
+    { "transfercase",                  KEYWORD_KIND_BLOCK            }, // KEYWORD_TRANSFER_CASE
+    { "triggers",                      KEYWORD_KIND_BLOCK            }, // KEYWORD_TRIGGERS
+    { "turbojets",                     KEYWORD_KIND_BLOCK            }, // KEYWORD_TURBOJETS
+    { "turboprops",                    KEYWORD_KIND_BLOCK            }, // KEYWORD_TURBOPROPS
+    { "turboprops2",                   KEYWORD_KIND_BLOCK            }, // KEYWORD_TURBOPROPS2
+    { "videocamera",                   KEYWORD_KIND_BLOCK            }, // KEYWORD_VIDEOCAMERA
+    { "wheeldetachers",                KEYWORD_KIND_BLOCK            }, // KEYWORD_WHEELDETACHERS
+    { "wheels",                        KEYWORD_KIND_BLOCK            }, // KEYWORD_WHEELS
+    { "wheels2",                       KEYWORD_KIND_BLOCK            }, // KEYWORD_WHEELS2
+    { "wings",                         KEYWORD_KIND_BLOCK            }, // KEYWORD_WINGS
+};
+
+static constexpr int NUM_KEYWORDS = sizeof(KEYWORD_TABLE) / sizeof(KeywordEntry);
+
+constexpr bool IsKeywordTableGrouped(int i)
+{
+    return (i + 1 >= NUM_KEYWORDS) ||
+        (KeywordToLower(KEYWORD_TABLE[i].name[0]) <= KeywordToLower(KEYWORD_TABLE[i + 1].name[0]) && IsKeywordTableGrouped(i + 1));
+}
+static_assert(IsKeywordTableGrouped(0), "KEYWORD_TABLE must be grouped by first letter");
+
+/// Index of the first entry starting with letter `c` or any later letter.
+constexpr int FindFirstKeywordWithLetter(char c, int i)
+{
+    return (i >= NUM_KEYWORDS || KeywordToLower(KEYWORD_TABLE[i].name[0]) >= c) ? i : FindFirstKeywordWithLetter(c, i + 1);
+}
+
+/// Entries starting with letter L are [KEYWORD_BUCKETS[L - 'a'], KEYWORD_BUCKETS[L - 'a' + 1])
+static constexpr int KEYWORD_BUCKETS[] =
+{
+    FindFirstKeywordWithLetter('a', 0), FindFirstKeywordWithLetter('b', 0), FindFirstKeywordWithLetter('c', 0),
+    FindFirstKeywordWithLetter('d', 0), FindFirstKeywordWithLetter('e', 0), FindFirstKeywordWithLetter('f', 0),
+    FindFirstKeywordWithLetter('g', 0), FindFirstKeywordWithLetter('h', 0), FindFirstKeywordWithLetter('i', 0),
+    FindFirstKeywordWithLetter('j', 0), FindFirstKeywordWithLetter('k', 0), FindFirstKeywordWithLetter('l', 0),
+    FindFirstKeywordWithLetter('m', 0), FindFirstKeywordWithLetter('n', 0), FindFirstKeywordWithLetter('o', 0),
+    FindFirstKeywordWithLetter('p', 0), FindFirstKeywordWithLetter('q', 0), FindFirstKeywordWithLetter('r', 0),
+    FindFirstKeywordWithLetter('s', 0), FindFirstKeywordWithLetter('t', 0), FindFirstKeywordWithLetter('u', 0),
+    FindFirstKeywordWithLetter('v', 0), FindFirstKeywordWithLetter('w', 0), FindFirstKeywordWithLetter('x', 0),
+    FindFirstKeywordWithLetter('y', 0), FindFirstKeywordWithLetter('z', 0), NUM_KEYWORDS
+};
+
+int IdentifyKeywordTable(const char* m_current_line, bool& lettercase_warning)
+{
+    // Quick check - keyword always starts with ASCII letter
+    char c = tolower(m_current_line[0]); // Note: line comes in trimmed
+    if (c > 'z' || c < 'a')
+    {
+        return -1;
+    }
+
+    // The keyword ends with blank or comma; what follows must fit the keyword's kind
+    const size_t length = strcspn(m_current_line, " \t,");
+    const char* rest = m_current_line + length;
+
+    // Find the keyword, ignoring lettercase (no two keywords differ only by lettercase)
+    int found = -1;
+    for (int i = KEYWORD_BUCKETS[c - 'a']; i < KEYWORD_BUCKETS[c - 'a' + 1]; ++i)
+    {
+        if (KEYWORD_TABLE[i].length != length)
+        {
+            continue;
+        }
+        size_t pos = 1; // First letter already matched
+        while (pos < length && KeywordToLower(KEYWORD_TABLE[i].name[pos]) == KeywordToLower(m_current_line[pos]))
+        {
+            ++pos;
+        }
+        if (pos == length)
+        {
+            found = i;
+            break;
+        }
+    }
+    if (found == -1)
+    {
+        return -1;
+    }
+
+    switch (KEYWORD_TABLE[found].kind)
+    {
+    case KEYWORD_KIND_BLOCK:
+        if (rest[strspn(rest, " \t")] != '\0')
+        {
+            return -1;
+        }
+        break;
+    case KEYWORD_KIND_INLINE:
+        if (rest[0] != ' ' && rest[0] != '\t')
+        {
+            return -1;
+        }
+        break;
+    case KEYWORD_KIND_INLINE_TOLERANT:
+        if (rest[0] == '\0')
+        {
+            return -1;
+        }
+        break;
+    }
+
+    int keyword = found + 1;
+    if (strncmp(KEYWORD_TABLE[found].name, m_current_line, length) != 0)
+    {
+        lettercase_warning = true;
+    }
+    return keyword;
+}
+
+DEFINE_REGEX( IDENTIFY_KEYWORD_RESPECT_CASE, IDENTIFY_KEYWORD_REGEX_STRING )
+
+// The former RigDef::Parser path: copy line to std::string, search with correct lettercase, then ignore lettercase.
+static void Bench_sol3a_RegexParserPath(benchmark::State& state)
+{
+    std::smatch results;
+    while (state.KeepRunning())
+    {
+        int count = sizeof(trucklines)/sizeof(const char*);
+        for (int i = 0; i < count; ++i)
+        {
+            char c = tolower(trucklines[i][0]);
+            if (c > 'z' || c < 'a')
+            {
+                keyword = (int) KEYWORD_INVALID;
+                continue;
+            }
+            std::string line(trucklines[i]);
+            std::regex_search(line, results, IDENTIFY_KEYWORD_RESPECT_CASE); // Always returns true.
+            keyword = FindKeywordMatch(results);
+            if (keyword == INT_MAX)
+            {
+                std::regex_search(line, results, IDENTIFY_KEYWORD_IGNORE_CASE);
+                keyword = FindKeywordMatch(results);
+            }
+        }
+    }
+}
+BENCHMARK(Bench_sol3a_RegexParserPath);
+
+static void Bench_sol3b_KeywordTable(benchmark::State& state)
+{
+    bool lettercase_warning = false;
+    while (state.KeepRunning())
+    {
+        int count = sizeof(trucklines)/sizeof(const char*);
+        for (int i = 0; i < count; ++i)
+        {
+            keyword = IdentifyKeywordTable(trucklines[i], lettercase_warning);
+        }
+    }
+}
+BENCHMARK(Bench_sol3b_KeywordTable);
+
 int main(int argc, char** argv)
 {
     using namespace std;
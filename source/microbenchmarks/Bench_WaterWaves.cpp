@@ -0,0 +1,220 @@
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Under-water test of all nodes of an actor, as done by `Actor::CalcNodes()` every physics step.
+// Nodes form a boat-sized box lattice near the water level; the wave trains are the defaults
+// from 'resources/skeleton/config/wavefield.cfg'. Reports evaluations (nodes) per second for
+// the original per-node `Water::IsUnderWater()` (wall-clock time, libm sin() per wave train)
+// and the batched, sim-time-driven `Water::IsUnderWaterBatch()`.
+// The wave math is copied from 'source/main/gfx/Water.cpp'; the OGRE timer is replaced by std::chrono.
+
+static const float TWO_PI = 6.283185307f;
+static const float PHYSICS_DT = 0.0005f;
+static const size_t WAVE_BATCH_SIZE = 64;
+
+struct WaveTrain
+{
+    float amplitude;
+    float maxheight;
+    float wavelength;
+    float wavespeed;
+    float direction;
+    float dir_sin;
+    float dir_cos;
+    float cycles_x;
+    float cycles_z;
+};
+
+struct WaveField
+{
+    WaveField()
+    {
+        const float defs[][4] = { // wavelength, amplitude factor, maximum amplitude, direction
+            { 180.0f, 1.0f,  4.0f, 90.0f },
+            {  87.0f, 0.5f,  2.0f, 45.0f },
+            {  11.0f, 0.25f, 0.5f, 22.0f },
+            {   4.0f, 2.0f,  0.1f,  0.0f },
+            {   4.1f, 2.0f,  0.1f, 90.0f } };
+        for (auto& def: defs)
+        {
+            WaveTrain wavetrain;
+            wavetrain.wavelength = def[0];
+            wavetrain.amplitude = def[1];
+            wavetrain.maxheight = def[2];
+            wavetrain.direction = def[3] / 57.0;
+            wavetrain.dir_sin = sin(wavetrain.direction);
+            wavetrain.dir_cos = cos(wavetrain.direction);
+            wavetrain.wavespeed = 1.25 * sqrt(wavetrain.wavelength);
+            wavetrain.cycles_x = wavetrain.dir_sin / wavetrain.wavelength;
+            wavetrain.cycles_z = wavetrain.dir_cos / wavetrain.wavelength;
+            wavetrain_defs.push_back(wavetrain);
+            max_ampl += wavetrain.maxheight;
+        }
+    }
+
+    float GetWaveHeight(float x, float y, float z) const
+    {
+        const float dx = x - center_x, dy = y - water_height, dz = z - center_z;
+        return (dx * dx + dy * dy + dz * dz) / 3000000.0 + waves_height;
+    }
+
+    std::vector<WaveTrain> wavetrain_defs;
+    float water_height = 15.f;
+    float waves_height = 0.5f;
+    float max_ampl = 0.f;
+    float center_x = 1000.f;
+    float center_z = 1000.f;
+};
+
+// ------------------------------ Original ------------------------------
+
+static const auto g_start_time = std::chrono::steady_clock::now();
+
+static unsigned long GetMilliseconds() // Stand-in for `Ogre::Timer::getMilliseconds()`
+{
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - g_start_time).count();
+}
+
+static float LegacyCalcWavesHeight(const WaveField& w, float x, float y, float z)
+{
+    const float time_sec = (float)(GetMilliseconds() * 0.001);
+
+    if (y > w.water_height + w.max_ampl)
+        return w.water_height;
+
+    float waveheight = w.GetWaveHeight(x, y, z);
+    float result = w.water_height;
+    for (size_t i = 0; i < w.wavetrain_defs.size(); i++)
+    {
+        float amp = std::min(w.wavetrain_defs[i].amplitude * waveheight, w.wavetrain_defs[i].maxheight);
+        result += amp * sin(TWO_PI * ((time_sec * w.wavetrain_defs[i].wavespeed + w.wavetrain_defs[i].dir_sin * x + w.wavetrain_defs[i].dir_cos * z) / w.wavetrain_defs[i].wavelength));
+    }
+    return result;
+}
+
+static bool LegacyIsUnderWater(const WaveField& w, float x, float y, float z)
+{
+    float waveheight = w.GetWaveHeight(x, y, z);
+    if (y > w.water_height + w.max_ampl * waveheight || y > w.water_height + w.max_ampl)
+        return false;
+
+    return y < LegacyCalcWavesHeight(w, x, y, z);
+}
+
+// ------------------------------ Batched ------------------------------
+
+static inline float WaveSinCycles(float u)
+{
+    u -= (float)(int)(u + ((u < 0.f) ? -0.5f : 0.5f));
+    u = std::min(u, 0.5f - u);
+    u = std::max(u, -0.5f - u);
+    const float x = u * TWO_PI;
+    const float x2 = x * x;
+    return x * (1.f + x2 * (-1.f / 6.f + x2 * (1.f / 120.f + x2 * (-1.f / 5040.f + x2 * (1.f / 362880.f)))));
+}
+
+static inline float WavePhaseCycles(double time_sec, float wavespeed, float wavelength)
+{
+    const double cycles = time_sec * wavespeed / wavelength;
+    return (float)(cycles - std::floor(cycles));
+}
+
+static void CalcWavesHeightBatch(const WaveField& w, double time_sec, const float* pos_x, const float* pos_y, const float* pos_z, size_t count, float* out_height)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        out_height[i] = w.water_height;
+    }
+
+    for (const WaveTrain& train: w.wavetrain_defs)
+    {
+        const float phase = WavePhaseCycles(time_sec, train.wavespeed, train.wavelength);
+        for (size_t i = 0; i < count; i++)
+        {
+            const float dx = pos_x[i] - w.center_x;
+            const float dy = pos_y[i] - w.water_height;
+            const float dz = pos_z[i] - w.center_z;
+            const float waveheight = (dx * dx + dy * dy + dz * dz) / 3000000.f + w.waves_height;
+            const float amp = std::min(train.amplitude * waveheight, train.maxheight);
+            out_height[i] += amp * WaveSinCycles(phase + train.cycles_x * pos_x[i] + train.cycles_z * pos_z[i]);
+        }
+    }
+}
+
+static void IsUnderWaterBatch(const WaveField& w, double time_sec, const float* pos_x, const float* pos_y, const float* pos_z, size_t count, uint8_t* out_under_water)
+{
+    float heights[WAVE_BATCH_SIZE];
+    for (size_t start = 0; start < count; start += WAVE_BATCH_SIZE)
+    {
+        const size_t num = std::min(WAVE_BATCH_SIZE, count - start);
+        CalcWavesHeightBatch(w, time_sec, pos_x + start, pos_y + start, pos_z + start, num, heights);
+        for (size_t i = 0; i < num; i++)
+        {
+            const float x = pos_x[start + i];
+            const float y = pos_y[start + i];
+            const float z = pos_z[start + i];
+            const float waveheight = ((x - w.center_x) * (x - w.center_x) + (y - w.water_height) * (y - w.water_height) + (z - w.center_z) * (z - w.center_z)) / 3000000.f + w.waves_height;
+            const bool above_waves = (y > w.water_height + w.max_ampl * waveheight) || (y > w.water_height + w.max_ampl);
+            out_under_water[start + i] = (!above_waves && y < heights[i]) ? 1 : 0;
+        }
+    }
+}
+
+// ------------------------------ Benchmarks ------------------------------
+
+struct Nodes
+{
+    explicit Nodes(int count)
+    {
+        // 2 x 4 x N lattice, 0.5m spacing, straddling the water line
+        for (int i = 0; i < count; i++)
+        {
+            x.push_back(1200.f + 0.5f * (i / 8));
+            y.push_back(14.f + 0.5f * (i % 2));
+            z.push_back(800.f + 0.5f * ((i / 2) % 4));
+        }
+    }
+
+    std::vector<float> x, y, z;
+};
+
+static void Bench_Waves_IsUnderWater_Legacy(benchmark::State& state)
+{
+    WaveField water;
+    Nodes nodes(static_cast<int>(state.range(0)));
+    std::vector<uint8_t> result(nodes.x.size());
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < nodes.x.size(); i++)
+        {
+            result[i] = LegacyIsUnderWater(water, nodes.x[i], nodes.y[i], nodes.z[i]) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(state.iterations() * nodes.x.size());
+}
+
+static void Bench_Waves_IsUnderWater_Batch(benchmark::State& state)
+{
+    WaveField water;
+    Nodes nodes(static_cast<int>(state.range(0)));
+    std::vector<uint8_t> result(nodes.x.size());
+    uint64_t wave_steps = 0;
+    for (auto _ : state)
+    {
+        wave_steps++;
+        IsUnderWaterBatch(water, wave_steps * (double)PHYSICS_DT, nodes.x.data(), nodes.y.data(), nodes.z.data(), nodes.x.size(), result.data());
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(state.iterations() * nodes.x.size());
+}
+
+BENCHMARK(Bench_Waves_IsUnderWater_Legacy)->Arg(100)->Arg(400)->Arg(1600);
+BENCHMARK(Bench_Waves_IsUnderWater_Batch)->Arg(100)->Arg(400)->Arg(1600);
+
+BENCHMARK_MAIN();